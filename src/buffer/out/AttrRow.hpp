@@ -56,6 +56,7 @@ public:
 
     friend bool operator==(const ATTR_ROW& a, const ATTR_ROW& b) noexcept;
     friend class ROW;
+    friend class TextBufferSnapshot;
 
 private:
     void Reset(const TextAttribute attr);
@@ -47,6 +47,7 @@ void CharRow::Reset() noexcept
     {
         cell.Reset();
     }
+    _maxRight = 0;
 }
 
 // Routine Description:
@@ -61,6 +62,8 @@ void CharRow::Reset() noexcept
     {
         const value_type insertVals;
         _data.resize(newSize, insertVals);
+        // New cells are spaces, so we only need to clamp _maxRight when shrinking.
+        _maxRight = std::min(_maxRight, newSize);
     }
     CATCH_RETURN();
 
@@ -69,6 +72,8 @@ void CharRow::Reset() noexcept
 
 typename CharRow::iterator CharRow::begin() noexcept
 {
+    // We can't track writes through a mutable iterator.
+    _maxRight = _data.size();
     return _data.begin();
 }
 
@@ -79,6 +84,7 @@ typename CharRow::const_iterator CharRow::cbegin() const noexcept
 
 typename CharRow::iterator CharRow::end() noexcept
 {
+    _maxRight = _data.size();
     return _data.end();
 }
 
@@ -95,12 +101,15 @@ typename CharRow::const_iterator CharRow::cend() const noexcept
 // - The calculated left boundary of the internal string.
 size_t CharRow::MeasureLeft() const noexcept
 {
-    const_iterator it = _data.cbegin();
-    while (it != _data.cend() && it->IsSpace())
+    const auto end = _data.cbegin() + _maxRight;
+    auto it = _data.cbegin();
+    while (it != end && it->IsSpace())
     {
         ++it;
     }
-    return it - _data.cbegin();
+    // Everything past _maxRight is a space. If we didn't find
+    // any text before it, the whole row consists of spaces.
+    return it == end ? _data.size() : it - _data.cbegin();
 }
 
 // Routine Description:
@@ -111,7 +120,8 @@ size_t CharRow::MeasureLeft() const noexcept
 // - The calculated right boundary of the internal string.
 size_t CharRow::MeasureRight() const
 {
-    const_reverse_iterator it = _data.crbegin();
+    // Skip the cells that are known to be spaces.
+    const_reverse_iterator it = _data.crbegin() + (_data.size() - _maxRight);
     while (it != _data.crend() && it->IsSpace())
     {
         ++it;
@@ -132,14 +142,8 @@ void CharRow::ClearCell(const size_t column)
 // - True if there is valid text in this row. False otherwise.
 bool CharRow::ContainsText() const noexcept
 {
-    for (const value_type& cell : _data)
-    {
-        if (!cell.IsSpace())
-        {
-            return true;
-        }
-    }
-    return false;
+    const auto end = _data.cbegin() + _maxRight;
+    return std::any_of(_data.cbegin(), end, [](const value_type& cell) { return !cell.IsSpace(); });
 }
 
 // Routine Description:
@@ -163,7 +167,9 @@ const DbcsAttribute& CharRow::DbcsAttrAt(const size_t column) const
 // Note: will throw exception if column is out of bounds
 DbcsAttribute& CharRow::DbcsAttrAt(const size_t column)
 {
-    return _data.at(column).DbcsAttr();
+    auto& attr = _data.at(column).DbcsAttr();
+    _maxRight = std::max(_maxRight, column + 1);
+    return attr;
 }
 
 // Routine Description:
@@ -201,6 +207,7 @@ const CharRow::reference CharRow::GlyphAt(const size_t column) const
 CharRow::reference CharRow::GlyphAt(const size_t column)
 {
     THROW_HR_IF(E_INVALIDARG, column >= _data.size());
+    _maxRight = std::max(_maxRight, column + 1);
     return { *this, column };
 }
 
@@ -228,26 +235,81 @@ std::wstring CharRow::GetText() const
 // - used for double click selection and uia word navigation
 // Arguments:
 // - column: column to get text data for
-// - wordDelimiters: the delimiters defined as a part of the DelimiterClass::DelimiterChar
+// - classifier: the precomputed lookup for the user's word delimiters
 // Return Value:
 // - the delimiter class for the given char
-const DelimiterClass CharRow::DelimiterClassAt(const size_t column, const std::wstring_view wordDelimiters) const
+const DelimiterClass CharRow::DelimiterClassAt(const size_t column, const DelimiterClassifier& classifier) const
 {
     THROW_HR_IF(E_INVALIDARG, column >= _data.size());
+    return classifier.Classify(_LeadingCharAt(column));
+}
+
+// Method Description:
+// - splits the row into runs of cells sharing the same delimiter class, in a single pass
+// - used for double click selection and uia word navigation, which
+//   would otherwise have to classify the same cells over and over again
+// Arguments:
+// - classifier: the precomputed lookup for the user's word delimiters
+// - runs: receives the runs, ordered from left to right. Together they cover the entire row.
+//         Existing contents are discarded, but the capacity is reused.
+void CharRow::GetDelimiterRuns(const DelimiterClassifier& classifier, std::vector<DelimiterRun>& runs) const
+{
+    runs.clear();
+
+    const auto width = _data.size();
+    if (width == 0)
+    {
+        return;
+    }
+
+    // Everything at or beyond _maxRight is a space and thus a ControlChar.
+    // There's no need to look at those cells individually.
+    const auto right = std::min(_maxRight, width);
+    size_t start = 0;
+    auto currentClass = DelimiterClass::ControlChar;
 
-    const auto glyph = *GlyphAt(column).begin();
-    if (glyph <= UNICODE_SPACE)
+    for (size_t col = 0; col < right; ++col)
     {
-        return DelimiterClass::ControlChar;
+        const auto cls = classifier.Classify(_LeadingCharAt(col));
+        if (col == 0)
+        {
+            currentClass = cls;
+        }
+        else if (cls != currentClass)
+        {
+            runs.push_back({ start, col, currentClass });
+            start = col;
+            currentClass = cls;
+        }
+    }
+
+    if (right != 0 && currentClass != DelimiterClass::ControlChar)
+    {
+        runs.push_back({ start, right, currentClass });
+        start = right;
     }
-    else if (wordDelimiters.find(glyph) != std::wstring_view::npos)
+
+    if (start != width)
     {
-        return DelimiterClass::DelimiterChar;
+        runs.push_back({ start, width, DelimiterClass::ControlChar });
     }
-    else
+}
+
+// Routine Description:
+// - gets the first code unit of the glyph at the given column, without
+//   constructing a CharRowCellReference unless the glyph is out-of-line
+// Arguments:
+// - column: the column to look at. Must be in bounds.
+// Return Value:
+// - the first UTF-16 code unit of the glyph
+wchar_t CharRow::_LeadingCharAt(const size_t column) const
+{
+    const auto& cell = _data[column];
+    if (cell.DbcsAttr().IsGlyphStored())
     {
-        return DelimiterClass::RegularChar;
+        return *GlyphAt(column).begin();
     }
+    return cell.Char();
 }
 
 UnicodeStorage& CharRow::GetUnicodeStorage() noexcept
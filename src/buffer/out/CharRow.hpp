@@ -24,16 +24,10 @@ Revision History:
 #include "CharRowCellReference.hpp"
 #include "CharRowCell.hpp"
 #include "UnicodeStorage.hpp"
+#include "DelimiterClassifier.hpp"
 
 class ROW;
 
-enum class DelimiterClass
-{
-    ControlChar,
-    DelimiterChar,
-    RegularChar
-};
-
 // the characters of one row of screen buffer
 // we keep the following values so that we don't write
 // more pixels to the screen than we have to:
@@ -65,7 +59,8 @@ public:
     DbcsAttribute& DbcsAttrAt(const size_t column);
     void ClearGlyph(const size_t column);
 
-    const DelimiterClass DelimiterClassAt(const size_t column, const std::wstring_view wordDelimiters) const;
+    const DelimiterClass DelimiterClassAt(const size_t column, const DelimiterClassifier& classifier) const;
+    void GetDelimiterRuns(const DelimiterClassifier& classifier, std::vector<DelimiterRun>& runs) const;
 
     // working with glyphs
     const reference GlyphAt(const size_t column) const;
@@ -88,16 +83,24 @@ public:
 
     friend CharRowCellReference;
     friend class ROW;
+    friend class TextBufferSnapshot;
 
 private:
     void Reset() noexcept;
     void ClearCell(const size_t column);
+    wchar_t _LeadingCharAt(const size_t column) const;
     std::wstring GetText() const;
 
 protected:
     // storage for glyph data and dbcs attributes
     boost::container::small_vector<value_type, 120> _data;
 
+    // All cells at or beyond this column are known to be spaces.
+    // It's an upper bound for MeasureRight(), raised whenever a cell is handed
+    // out for writing and reset to 0 by Reset(). This allows us to answer
+    // MeasureRight() and ContainsText() for empty rows in O(1).
+    size_t _maxRight = 0;
+
     // ROW that this CharRow belongs to
     ROW* _pParent;
 };
@@ -0,0 +1,29 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "DelimiterClassifier.hpp"
+
+// Routine Description:
+// - constructor
+// Arguments:
+// - wordDelimiters - the characters that are considered a part of DelimiterClass::DelimiterChar
+// Return Value:
+// - instantiated object
+DelimiterClassifier::DelimiterClassifier(const std::wstring_view wordDelimiters)
+{
+    for (const auto wch : wordDelimiters)
+    {
+        if (wch < 128)
+        {
+            _ascii[wch >> 6] |= uint64_t{ 1 } << (wch & 63);
+        }
+        else
+        {
+            _fallback.push_back(wch);
+        }
+    }
+
+    std::sort(_fallback.begin(), _fallback.end());
+    _fallback.erase(std::unique(_fallback.begin(), _fallback.end()), _fallback.end());
+}
@@ -0,0 +1,63 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- DelimiterClassifier.hpp
+
+Abstract:
+- A precomputed lookup for the delimiter class of a character, used by
+  double click selection and UIA word navigation.
+- The user's word delimiters are usually plain ASCII punctuation, which we
+  store in a 128-bit bitmap. Anything outside of the ASCII range is kept in
+  a small sorted fallback set. This turns the linear search through the
+  delimiter string we used to do for every single cell into a bit test.
+--*/
+
+#pragma once
+
+#include "unicode.hpp"
+
+enum class DelimiterClass
+{
+    ControlChar,
+    DelimiterChar,
+    RegularChar
+};
+
+// A run of consecutive cells in a row sharing the same delimiter class.
+// The range is [start, end).
+struct DelimiterRun
+{
+    size_t start;
+    size_t end;
+    DelimiterClass delimiterClass;
+};
+
+class DelimiterClassifier final
+{
+public:
+    explicit DelimiterClassifier(const std::wstring_view wordDelimiters);
+
+    DelimiterClass Classify(const wchar_t wch) const noexcept
+    {
+        if (wch <= UNICODE_SPACE)
+        {
+            return DelimiterClass::ControlChar;
+        }
+        return _IsDelimiter(wch) ? DelimiterClass::DelimiterChar : DelimiterClass::RegularChar;
+    }
+
+private:
+    bool _IsDelimiter(const wchar_t wch) const noexcept
+    {
+        if (wch < 128)
+        {
+            return (_ascii[wch >> 6] >> (wch & 63)) & 1;
+        }
+        return !_fallback.empty() && std::binary_search(_fallback.begin(), _fallback.end(), wch);
+    }
+
+    uint64_t _ascii[2]{};
+    std::wstring _fallback;
+};
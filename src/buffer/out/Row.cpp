@@ -24,6 +24,7 @@ ROW::ROW(const SHORT rowId, const unsigned short rowWidth, const TextAttribute f
     _lineRendition{ LineRendition::SingleWidth },
     _wrapForced{ false },
     _doubleBytePadded{ false },
+    _generation{ 0 },
     _pParent{ pParent }
 {
 }
@@ -94,6 +95,242 @@ const UnicodeStorage& ROW::GetUnicodeStorage() const noexcept
     return _pParent->GetUnicodeStorage();
 }
 
+// Routine Description:
+// - copies a span of cells from the given row into this one, including their
+//   attributes and any glyphs kept in the UnicodeStorage.
+// - the source may be this row itself. Overlapping spans are copied like memmove.
+// Arguments:
+// - source - the row to copy the cells from
+// - sourceColumn - first column of the span in the source row
+// - targetColumn - first column of the span in this row
+// - count - the number of cells to copy
+// Return Value:
+// - <none>
+void ROW::CopyCells(const ROW& source, const size_t sourceColumn, const size_t targetColumn, const size_t count)
+{
+    THROW_HR_IF(E_INVALIDARG, sourceColumn + count > source._charRow.size());
+    THROW_HR_IF(E_INVALIDARG, targetColumn + count > _charRow.size());
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    // Glyphs that don't fit into a single cell are keyed by their position. They have
+    // to be picked up before the target span is overwritten and the old keys are erased.
+    auto& unicodeStorage = GetUnicodeStorage();
+    std::vector<std::pair<size_t, UnicodeStorage::mapped_type>> glyphs;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (source._charRow._data[sourceColumn + i].DbcsAttr().IsGlyphStored())
+        {
+            glyphs.emplace_back(targetColumn + i, unicodeStorage.GetText(source._charRow.GetStorageKey(sourceColumn + i)));
+        }
+    }
+    for (auto column = targetColumn; column < targetColumn + count; ++column)
+    {
+        if (_charRow._data[column].DbcsAttr().IsGlyphStored())
+        {
+            unicodeStorage.Erase(_charRow.GetStorageKey(column));
+        }
+    }
+
+    const auto sourceBegin = source._charRow._data.cbegin() + sourceColumn;
+    const auto targetBegin = _charRow._data.begin() + targetColumn;
+    if (&source == this && targetColumn > sourceColumn)
+    {
+        std::copy_backward(sourceBegin, sourceBegin + count, targetBegin + count);
+    }
+    else
+    {
+        std::copy(sourceBegin, sourceBegin + count, targetBegin);
+    }
+    _charRow._maxRight = std::max(_charRow._maxRight, targetColumn + count);
+
+    // slice() returns a copy of the runs, so it's fine if the spans overlap.
+    const auto attributes = source._attrRow._data.slice(gsl::narrow_cast<uint16_t>(sourceColumn), gsl::narrow_cast<uint16_t>(sourceColumn + count));
+    _attrRow._data.replace(gsl::narrow_cast<uint16_t>(targetColumn), gsl::narrow_cast<uint16_t>(targetColumn + count), attributes.runs());
+
+    // Like WriteCells, don't leave half of a wide glyph at either edge of the row.
+    if (targetColumn == 0 && _charRow._data.front().DbcsAttr().IsTrailing())
+    {
+        _charRow.ClearCell(0);
+    }
+    if (targetColumn + count == _charRow.size() && _charRow._data.back().DbcsAttr().IsLeading())
+    {
+        _charRow.ClearCell(_charRow.size() - 1);
+        SetDoubleBytePadded(true);
+    }
+
+    for (const auto& [column, glyph] : glyphs)
+    {
+        if (_charRow._data[column].DbcsAttr().IsGlyphStored())
+        {
+            unicodeStorage.StoreGlyph(_charRow.GetStorageKey(column), glyph);
+        }
+    }
+}
+
+// Routine Description:
+// - fills a span of the row with a single (narrow) character and attribute.
+// - the cells are reset in bulk and the attributes are replaced with a single run.
+// Arguments:
+// - beginIndex - first column to fill
+// - endIndex - column after the last one to fill
+// - wch - the character to fill the cells with
+// - attr - the attribute to fill the cells with
+// Return Value:
+// - <none>
+void ROW::FillCells(const size_t beginIndex, const size_t endIndex, const wchar_t wch, const TextAttribute& attr)
+{
+    THROW_HR_IF(E_INVALIDARG, beginIndex > endIndex || endIndex > _charRow.size());
+
+    if (beginIndex == endIndex)
+    {
+        return;
+    }
+
+    auto& unicodeStorage = GetUnicodeStorage();
+    for (auto column = beginIndex; column < endIndex; ++column)
+    {
+        if (_charRow._data[column].DbcsAttr().IsGlyphStored())
+        {
+            unicodeStorage.Erase(_charRow.GetStorageKey(column));
+        }
+    }
+
+    std::fill(_charRow._data.begin() + beginIndex, _charRow._data.begin() + endIndex, CharRow::value_type{ wch, DbcsAttribute{} });
+
+    // Everything at or beyond _maxRight is a space. Filling the end of
+    // the row with spaces lowers it, filling it with anything else raises it.
+    if (wch != UNICODE_SPACE)
+    {
+        _charRow._maxRight = std::max(_charRow._maxRight, endIndex);
+    }
+    else if (endIndex >= _charRow._maxRight)
+    {
+        _charRow._maxRight = std::min(_charRow._maxRight, beginIndex);
+    }
+
+    _attrRow.Replace(gsl::narrow_cast<uint16_t>(beginIndex), gsl::narrow_cast<uint16_t>(endIndex), attr);
+}
+
+// Routine Description:
+// - converts a span of the row into the CHAR_INFO format of the console API.
+// - the attribute runs are walked alongside the cells, so that the legacy
+//   attributes are only computed once per run instead of once per cell.
+// Arguments:
+// - column - first column of the span
+// - target - receives one CHAR_INFO per cell. Its size is the length of the span.
+// Return Value:
+// - <none>
+void ROW::ReadCharInfos(const size_t column, const gsl::span<CHAR_INFO> target) const
+{
+    THROW_HR_IF(E_INVALIDARG, column + target.size() > _charRow.size());
+
+    const auto end = column + target.size();
+    auto out = target.begin();
+    size_t runEnd = 0;
+    for (const auto& run : _attrRow._data.runs())
+    {
+        const auto runBegin = runEnd;
+        runEnd += run.length;
+        if (runEnd <= column)
+        {
+            continue;
+        }
+
+        const auto legacyAttributes = run.value.GetLegacyAttributes();
+        for (auto i = std::max(runBegin, column); i < std::min(runEnd, end); ++i, ++out)
+        {
+            const auto& cell = _charRow._data[i];
+
+            // Glyphs in the UnicodeStorage are made of more than one UTF-16 code unit
+            // and a CHAR_INFO can't hold them. Utf16ToUcs2() replaces them just the same.
+            out->Char.UnicodeChar = cell.DbcsAttr().IsGlyphStored() ? UNICODE_REPLACEMENT : cell.Char();
+            out->Attributes = legacyAttributes | cell.DbcsAttr().GeneratePublicApiAttributeFormat();
+        }
+
+        if (runEnd >= end)
+        {
+            break;
+        }
+    }
+}
+
+// Routine Description:
+// - writes a span of cells in the CHAR_INFO format of the console API to the row.
+// - the cells are stored directly and consecutive cells with the same
+//   attributes are committed to the attribute row as a single run.
+// - like WriteCells, a trailing half of a wide glyph in the first column or a
+//   leading half in the last one is replaced by a space. The span never spills over.
+// Arguments:
+// - column - first column of the span
+// - source - the cells to write. Its size is the length of the span.
+// Return Value:
+// - <none>
+void ROW::WriteCharInfos(const size_t column, const gsl::span<const CHAR_INFO> source)
+{
+    THROW_HR_IF(E_INVALIDARG, column + source.size() > _charRow.size());
+
+    if (source.empty())
+    {
+        return;
+    }
+
+    const auto end = column + source.size();
+    auto& unicodeStorage = GetUnicodeStorage();
+    for (auto i = column; i < end; ++i)
+    {
+        if (_charRow._data[i].DbcsAttr().IsGlyphStored())
+        {
+            unicodeStorage.Erase(_charRow.GetStorageKey(i));
+        }
+    }
+
+    std::vector<ATTR_ROW::rle_vector::rle_type> runs;
+    WORD runAttributes = 0;
+    auto cell = _charRow._data.begin() + column;
+    for (const auto& charInfo : source)
+    {
+        // OutputCellIterator gives the leading byte precedence if both are set.
+        DbcsAttribute dbcsAttr;
+        if (WI_IsFlagSet(charInfo.Attributes, COMMON_LVB_LEADING_BYTE))
+        {
+            dbcsAttr.SetLeading();
+        }
+        else if (WI_IsFlagSet(charInfo.Attributes, COMMON_LVB_TRAILING_BYTE))
+        {
+            dbcsAttr.SetTrailing();
+        }
+        *cell++ = CharRow::value_type{ charInfo.Char.UnicodeChar, dbcsAttr };
+
+        const auto attributes = gsl::narrow_cast<WORD>(charInfo.Attributes & ~COMMON_LVB_SBCSDBCS);
+        if (!runs.empty() && attributes == runAttributes)
+        {
+            ++runs.back().length;
+        }
+        else
+        {
+            runs.emplace_back(TextAttribute{ attributes }, gsl::narrow_cast<uint16_t>(1));
+            runAttributes = attributes;
+        }
+    }
+
+    if (column == 0 && _charRow._data.front().DbcsAttr().IsTrailing())
+    {
+        _charRow.ClearCell(0);
+    }
+    if (end == _charRow.size() && _charRow._data.back().DbcsAttr().IsLeading())
+    {
+        _charRow.ClearCell(end - 1);
+        SetDoubleBytePadded(true);
+    }
+
+    _charRow._maxRight = std::max(_charRow._maxRight, end);
+    _attrRow._data.replace(gsl::narrow_cast<uint16_t>(column), gsl::narrow_cast<uint16_t>(end), runs);
+}
+
 // Routine Description:
 // - writes cell data to the row
 // Arguments:
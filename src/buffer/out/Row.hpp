@@ -54,6 +54,9 @@ public:
     SHORT GetId() const noexcept { return _id; }
     void SetId(const SHORT id) noexcept { _id = id; }
 
+    uint32_t GetGeneration() const noexcept { return _generation; }
+    void SetGeneration(const uint32_t generation) noexcept { _generation = generation; }
+
     bool Reset(const TextAttribute Attr);
     [[nodiscard]] HRESULT Resize(const unsigned short width);
 
@@ -64,6 +67,10 @@ public:
     const UnicodeStorage& GetUnicodeStorage() const noexcept;
 
     OutputCellIterator WriteCells(OutputCellIterator it, const size_t index, const std::optional<bool> wrap = std::nullopt, std::optional<size_t> limitRight = std::nullopt);
+    void CopyCells(const ROW& source, const size_t sourceColumn, const size_t targetColumn, const size_t count);
+    void FillCells(const size_t beginIndex, const size_t endIndex, const wchar_t wch, const TextAttribute& attr);
+    void ReadCharInfos(const size_t column, const gsl::span<CHAR_INFO> target) const;
+    void WriteCharInfos(const size_t column, const gsl::span<const CHAR_INFO> source);
 
 #ifdef UNIT_TESTING
     friend constexpr bool operator==(const ROW& a, const ROW& b) noexcept;
@@ -80,6 +87,9 @@ private:
     bool _wrapForced;
     // Occurs when the user runs out of text to support a double byte character and we're forced to the next line
     bool _doubleBytePadded;
+    // The TextBuffer generation this row was last cleared or written in.
+    // Rows from an older generation are stale and get reset on first use.
+    uint32_t _generation;
     TextBuffer* _pParent; // non ownership pointer
 };
 
@@ -31,31 +31,27 @@ class TextAttribute final
 {
 public:
     constexpr TextAttribute() noexcept :
-        _wAttrLegacy{ 0 },
         _foreground{},
         _background{},
-        _extendedAttrs{ ExtendedAttributes::Normal },
+        _attrs{ 0 },
         _hyperlinkId{ 0 }
     {
     }
 
     explicit constexpr TextAttribute(const WORD wLegacyAttr) noexcept :
-        _wAttrLegacy{ gsl::narrow_cast<WORD>(wLegacyAttr & META_ATTRS) },
         _foreground{ s_LegacyIndexOrDefault(wLegacyAttr & FG_ATTRS, s_legacyDefaultForeground) },
         _background{ s_LegacyIndexOrDefault((wLegacyAttr & BG_ATTRS) >> 4, s_legacyDefaultBackground) },
-        _extendedAttrs{ ExtendedAttributes::Normal },
+        // If we're given lead/trailing byte information with the legacy color, strip it.
+        _attrs{ gsl::narrow_cast<uint16_t>(wLegacyAttr & META_ATTRS & ~COMMON_LVB_SBCSDBCS) },
         _hyperlinkId{ 0 }
     {
-        // If we're given lead/trailing byte information with the legacy color, strip it.
-        WI_ClearAllFlags(_wAttrLegacy, COMMON_LVB_SBCSDBCS);
     }
 
     constexpr TextAttribute(const COLORREF rgbForeground,
                             const COLORREF rgbBackground) noexcept :
-        _wAttrLegacy{ 0 },
         _foreground{ rgbForeground },
         _background{ rgbBackground },
-        _extendedAttrs{ ExtendedAttributes::Normal },
+        _attrs{ 0 },
         _hyperlinkId{ 0 }
     {
     }
@@ -149,20 +145,20 @@ public:
         const auto checkForeground = (inverted != IsReverseVideo());
         return !IsAnyGridLineEnabled() && // grid lines have a visual representation
                // crossed out, doubly and singly underlined have a visual representation
-               WI_AreAllFlagsClear(_extendedAttrs, ExtendedAttributes::CrossedOut | ExtendedAttributes::DoublyUnderlined | ExtendedAttributes::Underlined) &&
+               WI_AreAllFlagsClear(_GetExtendedAttrs(), ExtendedAttributes::CrossedOut | ExtendedAttributes::DoublyUnderlined | ExtendedAttributes::Underlined) &&
                // hyperlinks have a visual representation
                !IsHyperlink() &&
                // all other attributes do not have a visual representation
-               (_wAttrLegacy & META_ATTRS) == (other._wAttrLegacy & META_ATTRS) &&
+               // (the meta and extended attributes share a single word, so we can compare them at once)
+               _attrs == other._attrs &&
                ((checkForeground && _foreground == other._foreground) ||
                 (!checkForeground && _background == other._background)) &&
-               _extendedAttrs == other._extendedAttrs &&
                IsHyperlink() == other.IsHyperlink();
     }
 
     constexpr bool IsAnyGridLineEnabled() const noexcept
     {
-        return WI_IsAnyFlagSet(_wAttrLegacy, COMMON_LVB_GRID_HORIZONTAL | COMMON_LVB_GRID_LVERTICAL | COMMON_LVB_GRID_RVERTICAL | COMMON_LVB_UNDERSCORE);
+        return WI_IsAnyFlagSet(_attrs, COMMON_LVB_GRID_HORIZONTAL | COMMON_LVB_GRID_LVERTICAL | COMMON_LVB_GRID_RVERTICAL | COMMON_LVB_UNDERSCORE);
     }
 
 private:
@@ -171,14 +167,33 @@ private:
         return requestedIndex == defaultIndex ? TextColor{} : TextColor{ requestedIndex, true };
     }
 
+    // The lower byte of a legacy attribute WORD contains the colors, which we
+    // store in _foreground and _background instead. We reuse it for the
+    // ExtendedAttributes, while the upper byte holds the legacy META_ATTRS.
+    static constexpr uint16_t s_extendedAttrsMask = 0x00ff;
+
+    constexpr ExtendedAttributes _GetExtendedAttrs() const noexcept
+    {
+        return static_cast<ExtendedAttributes>(_attrs & s_extendedAttrsMask);
+    }
+
+    void _SetExtendedAttr(const ExtendedAttributes attr, const bool isSet) noexcept
+    {
+        const auto bits = static_cast<uint16_t>(attr);
+        _attrs = gsl::narrow_cast<uint16_t>(isSet ? (_attrs | bits) : (_attrs & ~bits));
+    }
+
     static BYTE s_legacyDefaultForeground;
     static BYTE s_legacyDefaultBackground;
 
-    uint16_t _wAttrLegacy; // sizeof: 2, alignof: 2
+    // The members are ordered and packed such that the entire struct fits
+    // into 12 bytes without any padding. This allows us to compare two
+    // attributes with just 3 integer comparisons and keeps ATTR_ROW's
+    // run-length pairs at 16 bytes.
+    TextColor _foreground; // sizeof: 4, alignof: 4
+    TextColor _background; // sizeof: 4, alignof: 4
+    uint16_t _attrs; // sizeof: 2, alignof: 2
     uint16_t _hyperlinkId; // sizeof: 2, alignof: 2
-    TextColor _foreground; // sizeof: 4, alignof: 1
-    TextColor _background; // sizeof: 4, alignof: 1
-    ExtendedAttributes _extendedAttrs; // sizeof: 1, alignof: 1
 
 #ifdef UNIT_TESTING
     friend class TextBufferTests;
@@ -197,10 +212,9 @@ enum class TextAttributeBehavior
 
 constexpr bool operator==(const TextAttribute& a, const TextAttribute& b) noexcept
 {
-    return a._wAttrLegacy == b._wAttrLegacy &&
-           a._foreground == b._foreground &&
+    return a._foreground == b._foreground &&
            a._background == b._background &&
-           a._extendedAttrs == b._extendedAttrs &&
+           a._attrs == b._attrs &&
            a._hyperlinkId == b._hyperlinkId;
 }
 
@@ -229,8 +243,8 @@ namespace WEX
                     VerifyOutputTraits<TextColor>::ToString(attr._foreground).GetBuffer(),
                     VerifyOutputTraits<TextColor>::ToString(attr._background).GetBuffer(),
                     attr.IsBold(),
-                    attr._wAttrLegacy,
-                    static_cast<DWORD>(attr._extendedAttrs));
+                    attr._attrs & META_ATTRS,
+                    static_cast<DWORD>(attr.GetExtendedAttributes()));
             }
         };
     }
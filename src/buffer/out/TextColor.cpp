@@ -57,27 +57,27 @@ bool TextColor::CanBeBrightened() const noexcept
 
 bool TextColor::IsLegacy() const noexcept
 {
-    return IsIndex16() || (IsIndex256() && _index < 16);
+    return IsIndex16() || (IsIndex256() && GetIndex() < 16);
 }
 
 bool TextColor::IsIndex16() const noexcept
 {
-    return _meta == ColorType::IsIndex16;
+    return _GetType() == ColorType::IsIndex16;
 }
 
 bool TextColor::IsIndex256() const noexcept
 {
-    return _meta == ColorType::IsIndex256;
+    return _GetType() == ColorType::IsIndex256;
 }
 
 bool TextColor::IsDefault() const noexcept
 {
-    return _meta == ColorType::IsDefault;
+    return _GetType() == ColorType::IsDefault;
 }
 
 bool TextColor::IsRgb() const noexcept
 {
-    return _meta == ColorType::IsRgb;
+    return _GetType() == ColorType::IsRgb;
 }
 
 // Method Description:
@@ -89,10 +89,7 @@ bool TextColor::IsRgb() const noexcept
 // - <none>
 void TextColor::SetColor(const COLORREF rgbColor) noexcept
 {
-    _meta = ColorType::IsRgb;
-    _red = GetRValue(rgbColor);
-    _green = GetGValue(rgbColor);
-    _blue = GetBValue(rgbColor);
+    _data = s_Pack(ColorType::IsRgb, rgbColor & s_payloadMask);
 }
 
 // Method Description:
@@ -104,8 +101,7 @@ void TextColor::SetColor(const COLORREF rgbColor) noexcept
 // - <none>
 void TextColor::SetIndex(const BYTE index, const bool isIndex256) noexcept
 {
-    _meta = isIndex256 ? ColorType::IsIndex256 : ColorType::IsIndex16;
-    _index = index;
+    _data = s_Pack(isIndex256 ? ColorType::IsIndex256 : ColorType::IsIndex16, index);
 }
 
 // Method Description:
@@ -117,7 +113,7 @@ void TextColor::SetIndex(const BYTE index, const bool isIndex256) noexcept
 // - <none>
 void TextColor::SetDefault() noexcept
 {
-    _meta = ColorType::IsDefault;
+    _data = s_Pack(ColorType::IsDefault, 0);
 }
 
 // Method Description:
@@ -173,11 +169,11 @@ COLORREF TextColor::GetColor(gsl::span<const COLORREF> colorTable,
     }
     else if (IsIndex16() && brighten)
     {
-        return til::at(colorTable, _index | 8);
+        return til::at(colorTable, GetIndex() | 8);
     }
     else
     {
-        return til::at(colorTable, _index);
+        return til::at(colorTable, GetIndex());
     }
 }
 
@@ -205,9 +201,10 @@ BYTE TextColor::GetLegacyIndex(const BYTE defaultIndex) const noexcept
     {
         // We compress the RGB down to an 8-bit value and use that to
         // lookup a representative 16-color index from a hard-coded table.
-        const BYTE compressedRgb = (_red & 0b11100000) +
-                                   ((_green >> 3) & 0b00011100) +
-                                   ((_blue >> 6) & 0b00000011);
+        const auto rgb = GetRGB();
+        const BYTE compressedRgb = (GetRValue(rgb) & 0b11100000) +
+                                   ((GetGValue(rgb) >> 3) & 0b00011100) +
+                                   ((GetBValue(rgb) >> 6) & 0b00000011);
         return CompressedRgbToIndex16.at(compressedRgb);
     }
 }
@@ -221,5 +218,5 @@ BYTE TextColor::GetLegacyIndex(const BYTE defaultIndex) const noexcept
 // - a COLORREF containing our stored value
 COLORREF TextColor::GetRGB() const noexcept
 {
-    return RGB(_red, _green, _blue);
+    return _data & s_payloadMask;
 }
@@ -45,30 +45,30 @@ enum class ColorType : BYTE
     IsRgb = 0x3
 };
 
+// A TextColor is bit-packed into a single 32-bit integer, so that it can be
+// copied and compared with a single instruction. The layout is:
+//   bits  0- 7: the red component, or the color table index
+//   bits  8-15: the green component (zero for non-RGB colors)
+//   bits 16-23: the blue component (zero for non-RGB colors)
+//   bits 24-31: the ColorType
+// The lower 24 bits thus have the same layout as a COLORREF.
+// The payload of non-RGB colors is always kept zeroed, which ensures
+// that two colors are equal if and only if their bits are identical.
 struct TextColor
 {
 public:
     constexpr TextColor() noexcept :
-        _meta{ ColorType::IsDefault },
-        _red{ 0 },
-        _green{ 0 },
-        _blue{ 0 }
+        _data{ s_Pack(ColorType::IsDefault, 0) }
     {
     }
 
     constexpr TextColor(const BYTE index, const bool isIndex256) noexcept :
-        _meta{ isIndex256 ? ColorType::IsIndex256 : ColorType::IsIndex16 },
-        _index{ index },
-        _green{ 0 },
-        _blue{ 0 }
+        _data{ s_Pack(isIndex256 ? ColorType::IsIndex256 : ColorType::IsIndex16, index) }
     {
     }
 
     constexpr TextColor(const COLORREF rgb) noexcept :
-        _meta{ ColorType::IsRgb },
-        _red{ GetRValue(rgb) },
-        _green{ GetGValue(rgb) },
-        _blue{ GetBValue(rgb) }
+        _data{ s_Pack(ColorType::IsRgb, rgb & s_payloadMask) }
     {
     }
 
@@ -94,19 +94,46 @@ public:
 
     constexpr BYTE GetIndex() const noexcept
     {
-        return _index;
+        return static_cast<BYTE>(_data);
     }
 
     COLORREF GetRGB() const noexcept;
 
+    // Returns false if the bits don't follow the layout described above,
+    // which can only happen for colors read from untrusted data.
+    constexpr bool IsValid() const noexcept
+    {
+        const auto payload = _data & s_payloadMask;
+        switch (_GetType())
+        {
+        case ColorType::IsIndex256:
+            return payload <= 0xff;
+        case ColorType::IsIndex16:
+            return payload < 16;
+        case ColorType::IsDefault:
+            return payload == 0;
+        case ColorType::IsRgb:
+            return true;
+        default:
+            return false;
+        }
+    }
+
 private:
-    union
+    static constexpr uint32_t s_payloadMask = 0x00ffffff;
+    static constexpr uint32_t s_typeShift = 24;
+
+    static constexpr uint32_t s_Pack(const ColorType type, const uint32_t payload) noexcept
     {
-        BYTE _red, _index;
-    };
-    BYTE _green;
-    BYTE _blue;
-    ColorType _meta;
+        return (static_cast<uint32_t>(type) << s_typeShift) | payload;
+    }
+
+    constexpr ColorType _GetType() const noexcept
+    {
+        return static_cast<ColorType>(_data >> s_typeShift);
+    }
+
+    uint32_t _data;
 
 #ifdef UNIT_TESTING
     friend class TextBufferTests;
@@ -117,10 +144,7 @@ private:
 
 bool constexpr operator==(const TextColor& a, const TextColor& b) noexcept
 {
-    return a._meta == b._meta &&
-           a._red == b._red &&
-           a._green == b._green &&
-           a._blue == b._blue;
+    return a._data == b._data;
 }
 
 bool constexpr operator!=(const TextColor& a, const TextColor& b) noexcept
@@ -150,7 +174,7 @@ namespace WEX
                 }
                 else
                 {
-                    return WEX::Common::NoThrowString().Format(L"{index:0x%04x}", color._red);
+                    return WEX::Common::NoThrowString().Format(L"{index:0x%04x}", color.GetIndex());
                 }
             }
         };
@@ -158,4 +182,4 @@ namespace WEX
 }
 #endif
 
-static_assert(sizeof(TextColor) <= 4 * sizeof(BYTE), "We should only need 4B for an entire TextColor. Any more than that is just waste");
+static_assert(sizeof(TextColor) == 4 * sizeof(BYTE), "We should only need 4B for an entire TextColor. Any more than that is just waste");
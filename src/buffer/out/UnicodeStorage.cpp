@@ -40,6 +40,35 @@ void UnicodeStorage::Erase(const key_type key) noexcept
     _map.erase(key);
 }
 
+// Routine Description:
+// - erases all stored glyphs
+void UnicodeStorage::Clear() noexcept
+{
+    _map.clear();
+}
+
+// Routine Description:
+// - erases all stored glyphs that don't belong to the given range of rows
+// Arguments:
+// - firstRow - the ID of the first row to keep
+// - rowCount - the number of rows to keep. The range wraps around at totalRows.
+// - totalRows - the total number of rows in the circular text buffer
+void UnicodeStorage::EraseRowsOutside(const SHORT firstRow, const SHORT rowCount, const SHORT totalRows) noexcept
+{
+    for (auto it = _map.begin(); it != _map.end();)
+    {
+        const auto offset = (it->first.Y - firstRow + totalRows) % totalRows;
+        if (offset >= rowCount)
+        {
+            it = _map.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
 // Routine Description:
 // - Remaps all of the stored items to new coordinate positions
 //   based on a bulk rearrangement of row IDs and potential row width resize.
@@ -55,6 +55,10 @@ public:
 
     void Erase(const key_type key) noexcept;
 
+    void Clear() noexcept;
+
+    void EraseRowsOutside(const SHORT firstRow, const SHORT rowCount, const SHORT totalRows) noexcept;
+
     void Remap(const std::unordered_map<SHORT, SHORT>& rowMap, const std::optional<SHORT> width);
 
 private:
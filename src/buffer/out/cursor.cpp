@@ -288,6 +288,30 @@ void Cursor::CopyProperties(const Cursor& OtherCursor) noexcept
     _color = OtherCursor._color;
 }
 
+// Routine Description:
+// - Restores the position and state flags of the cursor to their initial values.
+// - The style of the cursor (size, color and type) is retained.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void Cursor::Reset() noexcept
+{
+    _cPosition = { 0 };
+    _fHasMoved = false;
+    _fIsVisible = true;
+    _fIsOn = true;
+    _fIsDouble = false;
+    _fBlinkingAllowed = true;
+    _fDelay = false;
+    _fIsConversionArea = false;
+    _fIsPopupShown = false;
+    _fDelayedEolWrap = false;
+    _coordDelayedAt = { 0 };
+    _fDeferCursorRedraw = false;
+    _fHaveDeferredCursorRedraw = false;
+}
+
 void Cursor::DelayEOLWrap(const COORD coordDelayedAt) noexcept
 {
     _coordDelayedAt = coordDelayedAt;
@@ -32,6 +32,9 @@ TextBuffer::TextBuffer(const COORD screenBufferSize,
                        const UINT cursorSize,
                        Microsoft::Console::Render::IRenderTarget& renderTarget) :
     _firstRow{ 0 },
+    _generation{ 0 },
+    _clearAttributes{ defaultAttributes },
+    _blankRow{},
     _currentAttributes{ defaultAttributes },
     _cursor{ cursorSize, *this },
     _storage{},
@@ -87,7 +90,7 @@ const ROW& TextBuffer::GetRowByOffset(const size_t index) const
 
     // Rows are stored circularly, so the index you ask for is offset by the start position and mod the total of rows.
     const size_t offsetIndex = (_firstRow + index) % totalRows;
-    return _storage.at(offsetIndex);
+    return _GetPhysicalRow(offsetIndex);
 }
 
 // Routine Description:
@@ -103,7 +106,7 @@ ROW& TextBuffer::GetRowByOffset(const size_t index)
 
     // Rows are stored circularly, so the index you ask for is offset by the start position and mod the total of rows.
     const size_t offsetIndex = (_firstRow + index) % totalRows;
-    return _storage.at(offsetIndex);
+    return _GetPhysicalRow(offsetIndex);
 }
 
 // Routine Description:
@@ -569,9 +572,13 @@ bool TextBuffer::IncrementCircularBuffer(const bool inVtMode)
         // the current background color, but with no meta attributes set.
         fillAttributes.SetStandardErase();
     }
-    const bool fSuccess = _storage.at(_firstRow).Reset(fillAttributes);
+    auto& firstRow = _storage.at(_firstRow);
+    const bool fSuccess = firstRow.Reset(fillAttributes);
     if (fSuccess)
     {
+        // The row was just cleared, so it's no longer stale (if it was).
+        firstRow.SetGeneration(_generation);
+
         // Now proceed to increment.
         // Incrementing it will cause the next line down to become the new "top" of the window (the new "0" in logical coordinates)
         _firstRow++;
@@ -782,6 +789,143 @@ void TextBuffer::ScrollRows(const SHORT firstRow, const SHORT size, const SHORT
     _RefreshRowIDs(std::nullopt);
 }
 
+// Routine Description:
+// - Copies a rectangle of cells to another position in the buffer, a row span at a time.
+// - The source and the target may overlap. The rows are walked in the direction
+//   that copies every span before it's overwritten, so this behaves like memmove.
+// Arguments:
+// - source - the rectangle to copy. It must be within the buffer.
+// - targetOrigin - the top left corner of the target rectangle. The whole target must be within the buffer, too.
+// Return Value:
+// - <none>
+void TextBuffer::CopyRectangle(const Viewport& source, const COORD targetOrigin)
+{
+    const auto target = Viewport::FromDimensions(targetOrigin, source.Dimensions());
+    THROW_HR_IF(E_INVALIDARG, !_size.IsInBounds(source) || !_size.IsInBounds(target));
+
+    const auto width = gsl::narrow_cast<size_t>(source.Width());
+    const auto copyRow = [&](const SHORT offset) {
+        const auto& sourceRow = GetRowByOffset(source.Top() + offset);
+        auto& targetRow = GetRowByOffset(target.Top() + offset);
+        targetRow.CopyCells(sourceRow, source.Left(), target.Left(), width);
+    };
+
+    // When moving down, the bottom rows have to go first, or else they'd be
+    // overwritten by the rows above them before they're copied. And vice versa.
+    if (target.Top() > source.Top())
+    {
+        for (auto offset = source.Height(); offset-- > 0;)
+        {
+            copyRow(offset);
+        }
+    }
+    else
+    {
+        for (SHORT offset = 0; offset < source.Height(); ++offset)
+        {
+            copyRow(offset);
+        }
+    }
+
+    _NotifyPaint(target);
+}
+
+// Routine Description:
+// - Fills a rectangle of the buffer with a single character and attribute, like an erase.
+// - Each row span is filled in bulk, instead of writing the cells one at a time.
+// - Rows that are filled up to the right edge of the buffer aren't wrapped anymore.
+// Arguments:
+// - rect - the rectangle to fill. It must be within the buffer.
+// - fillChar - the character to fill the cells with. It must not be a wide glyph.
+// - fillAttrs - the attribute to fill the cells with
+// Return Value:
+// - <none>
+void TextBuffer::FillRectangle(const Viewport& rect, const wchar_t fillChar, const TextAttribute& fillAttrs)
+{
+    THROW_HR_IF(E_INVALIDARG, !_size.IsInBounds(rect));
+
+    const auto left = gsl::narrow_cast<size_t>(rect.Left());
+    const auto right = gsl::narrow_cast<size_t>(rect.RightExclusive());
+    const auto clearsWrap = rect.RightExclusive() == _size.RightExclusive();
+    for (auto y = rect.Top(); y < rect.BottomExclusive(); ++y)
+    {
+        auto& row = GetRowByOffset(y);
+        row.FillCells(left, right, fillChar, fillAttrs);
+        if (clearsWrap)
+        {
+            row.SetWrapForced(false);
+        }
+    }
+
+    _NotifyPaint(rect);
+}
+
+// Routine Description:
+// - Reads a rectangle of the buffer into CHAR_INFOs, like ReadConsoleOutput does.
+// - Each row span is converted in bulk, instead of walking the cells with an iterator.
+// Arguments:
+// - source - the rectangle to read. It must be within the buffer.
+// - target - receives the cells. The first row starts at its beginning.
+// - targetWidth - the distance between the rows in the target, at least the width of the source.
+// Return Value:
+// - <none>
+void TextBuffer::ReadCharInfos(const Viewport& source, const gsl::span<CHAR_INFO> target, const size_t targetWidth) const
+{
+    if (source.Width() <= 0 || source.Height() <= 0)
+    {
+        return;
+    }
+
+    THROW_HR_IF(E_INVALIDARG, !_size.IsInBounds(source));
+
+    const auto width = gsl::narrow_cast<size_t>(source.Width());
+    THROW_HR_IF(E_INVALIDARG, targetWidth < width);
+    THROW_HR_IF(E_INVALIDARG, (source.Height() - 1) * targetWidth + width > target.size());
+
+    for (SHORT offset = 0; offset < source.Height(); ++offset)
+    {
+        const auto& row = GetRowByOffset(source.Top() + offset);
+        row.ReadCharInfos(source.Left(), target.subspan(offset * targetWidth, width));
+    }
+}
+
+// Routine Description:
+// - Writes a rectangle of CHAR_INFOs into the buffer, like WriteConsoleOutput does.
+// - Each row span is converted and stored in bulk, instead of going through an OutputCellIterator.
+// - Like Write(), rows that are written up to the right edge of the buffer are marked as wrapped.
+// Arguments:
+// - source - the cells to write. The first row starts at its beginning.
+// - sourceWidth - the distance between the rows in the source, at least the width of the target.
+// - target - the rectangle to write to. It must be within the buffer.
+// Return Value:
+// - <none>
+void TextBuffer::WriteCharInfos(const gsl::span<const CHAR_INFO> source, const size_t sourceWidth, const Viewport& target)
+{
+    if (target.Width() <= 0 || target.Height() <= 0)
+    {
+        return;
+    }
+
+    THROW_HR_IF(E_INVALIDARG, !_size.IsInBounds(target));
+
+    const auto width = gsl::narrow_cast<size_t>(target.Width());
+    THROW_HR_IF(E_INVALIDARG, sourceWidth < width);
+    THROW_HR_IF(E_INVALIDARG, (target.Height() - 1) * sourceWidth + width > source.size());
+
+    const auto setsWrap = target.RightExclusive() == _size.RightExclusive();
+    for (SHORT offset = 0; offset < target.Height(); ++offset)
+    {
+        auto& row = GetRowByOffset(target.Top() + offset);
+        row.WriteCharInfos(target.Left(), source.subspan(offset * sourceWidth, width));
+        if (setsWrap)
+        {
+            row.SetWrapForced(true);
+        }
+    }
+
+    _NotifyPaint(target);
+}
+
 Cursor& TextBuffer::GetCursor() noexcept
 {
     return _cursor;
@@ -884,6 +1028,107 @@ void TextBuffer::Reset()
     for (auto& row : _storage)
     {
         row.Reset(attr);
+        row.SetGeneration(_generation);
+    }
+
+    // Every row is up to date now, so there's nothing left to clear lazily.
+    _blankRow.reset();
+}
+
+// Routine Description:
+// - Returns the buffer to the state it had right after construction, without
+//   reallocating any of its rows. This allows a buffer of the same size to be
+//   recycled instead of being destroyed and recreated (e.g. for the alt buffer).
+// - The cursor's style and any registered patterns are retained.
+// Arguments:
+// - defaultAttributes - the attributes to clear the buffer with. They also become the new current attributes.
+void TextBuffer::Reinitialize(const TextAttribute defaultAttributes)
+{
+    _currentAttributes = defaultAttributes;
+    Reset();
+
+    // The row IDs are the indices into _storage, so the
+    // buffer can simply restart at the first allocated row.
+    _SetFirstRowIndex(0);
+    _unicodeStorage.Clear();
+
+    _hyperlinkMap.clear();
+    _hyperlinkCustomIdMap.clear();
+    _currentHyperlinkId = 1;
+
+    _cursor.Reset();
+}
+
+// Routine Description:
+// - Erases everything but the viewport from the buffer and moves the viewport
+//   contents to the top of the buffer (the equivalent of "ED 3" or "cls").
+// - Instead of moving the viewport rows and resetting all other rows, this
+//   merely moves the start of the circular buffer to the top of the viewport
+//   and marks all other rows as stale. Stale rows read as blank and are reset
+//   when they're first written to. The cost is thus proportional to the
+//   viewport height and not to the size of the scrollback.
+// - Glyphs and hyperlinks that are only referenced by the erased rows are released in bulk.
+// - The cursor isn't moved. The caller is responsible for adjusting it.
+// Arguments:
+// - viewportTop - the first row of the viewport, which becomes the first row of the buffer.
+// - viewportHeight - the number of rows that are kept.
+// - fillAttributes - the attributes the erased rows are filled with.
+void TextBuffer::ClearScrollback(const SHORT viewportTop, const SHORT viewportHeight, const TextAttribute fillAttributes)
+{
+    const auto totalRows = gsl::narrow<SHORT>(TotalRowCount());
+    THROW_HR_IF(E_INVALIDARG, viewportTop < 0 || viewportHeight < 0 || viewportTop + viewportHeight > totalRows);
+
+    // The rows we keep might still be stale from a previous clear. Reset them
+    // now, as they wouldn't be recognizable as stale after the increment below.
+    for (SHORT i = viewportTop; i < viewportTop + viewportHeight; ++i)
+    {
+        GetRowByOffset(i);
+    }
+
+    if (_generation == std::numeric_limits<uint32_t>::max())
+    {
+        // Restart counting before the generation wraps around,
+        // or ancient rows could suddenly appear to be up to date.
+        _MaterializeStaleRows();
+        for (auto& row : _storage)
+        {
+            row.SetGeneration(0);
+        }
+        _generation = 0;
+    }
+    ++_generation;
+
+    _SetFirstRowIndex(gsl::narrow_cast<SHORT>((_firstRow + viewportTop) % totalRows));
+
+    // Keep the viewport rows alive and collect the hyperlinks they reference.
+    std::unordered_set<uint16_t> hyperlinks;
+    if (_currentAttributes.IsHyperlink())
+    {
+        hyperlinks.insert(_currentAttributes.GetHyperlinkId());
+    }
+    for (SHORT i = 0; i < viewportHeight; ++i)
+    {
+        auto& row = _storage.at((_firstRow + i) % totalRows);
+        row.SetGeneration(_generation);
+
+        const auto rowHyperlinks = row.GetAttrRow().GetHyperlinks();
+        hyperlinks.insert(rowHyperlinks.cbegin(), rowHyperlinks.cend());
+    }
+
+    // All other rows are stale now and read as this blank row until they're reset.
+    _clearAttributes = fillAttributes;
+    _blankRow.reset();
+    _blankRow.emplace(gsl::narrow_cast<SHORT>(0), gsl::narrow<unsigned short>(GetSize().Width()), fillAttributes, this);
+
+    _unicodeStorage.EraseRowsOutside(_firstRow, viewportHeight, totalRows);
+
+    for (auto it = _hyperlinkMap.begin(); it != _hyperlinkMap.end();)
+    {
+        it = hyperlinks.find(it->first) == hyperlinks.end() ? _hyperlinkMap.erase(it) : std::next(it);
+    }
+    for (auto it = _hyperlinkCustomIdMap.begin(); it != _hyperlinkCustomIdMap.end();)
+    {
+        it = hyperlinks.find(it->second) == hyperlinks.end() ? _hyperlinkCustomIdMap.erase(it) : std::next(it);
     }
 }
 
@@ -899,6 +1144,10 @@ void TextBuffer::Reset()
 
     try
     {
+        // Rows are moved, resized and renumbered below, which
+        // is simpler if none of them is pending a lazy clear.
+        _MaterializeStaleRows();
+
         const auto currentSize = GetSize().Dimensions();
         const auto attributes = GetCurrentAttributes();
 
@@ -989,6 +1238,61 @@ void TextBuffer::_RefreshRowIDs(std::optional<SHORT> newRowWidth)
     _unicodeStorage.Remap(rowMap, newRowWidth);
 }
 
+// Routine Description:
+// - Retrieves a row by its index in the underlying storage.
+// - If the row is stale, because the scrollback was cleared after it was last
+//   written to, a blank row is returned instead. The stale row itself is left
+//   untouched, so this is safe to call from concurrent readers.
+// Arguments:
+// - index - the index into the storage (not the offset from the first row)
+// Return Value:
+// - const reference to the row
+const ROW& TextBuffer::_GetPhysicalRow(const size_t index) const
+{
+    const auto& row = _storage.at(index);
+    if (_blankRow && row.GetGeneration() != _generation)
+    {
+        return *_blankRow;
+    }
+    return row;
+}
+
+// Routine Description:
+// - Retrieves a row by its index in the underlying storage.
+// - If the row is stale, because the scrollback was cleared after it was
+//   last written to, it's reset now, as the caller might modify it.
+// Arguments:
+// - index - the index into the storage (not the offset from the first row)
+// Return Value:
+// - reference to the row
+ROW& TextBuffer::_GetPhysicalRow(const size_t index)
+{
+    auto& row = _storage.at(index);
+    if (_blankRow && row.GetGeneration() != _generation)
+    {
+        THROW_HR_IF(E_OUTOFMEMORY, !row.Reset(_clearAttributes));
+        row.SetGeneration(_generation);
+    }
+    return row;
+}
+
+// Routine Description:
+// - Resets all rows that are still pending from a lazy scrollback clear.
+// - This is O(n), but only does work if a clear is actually pending.
+void TextBuffer::_MaterializeStaleRows()
+{
+    if (!_blankRow)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < _storage.size(); ++i)
+    {
+        _GetPhysicalRow(i);
+    }
+    _blankRow.reset();
+}
+
 void TextBuffer::_NotifyPaint(const Viewport& viewport) const
 {
     _renderTarget.TriggerRedraw(viewport);
@@ -1023,7 +1327,7 @@ ROW& TextBuffer::_GetPrevRowNoWrap(const ROW& Row)
     }
 
     THROW_HR_IF(E_FAIL, Row.GetId() == _firstRow);
-    return _storage.at(prevRowIndex);
+    return _GetPhysicalRow(prevRowIndex);
 }
 
 // Method Description:
@@ -1038,16 +1342,81 @@ Microsoft::Console::Render::IRenderTarget& TextBuffer::GetRenderTarget() noexcep
 }
 
 // Method Description:
-// - get delimiter class for buffer cell position
+// - find the run of cells sharing a delimiter class that contains the given buffer cell position
 // - used for double click selection and uia word navigation
 // Arguments:
 // - pos: the buffer cell under observation
-// - wordDelimiters: the delimiters defined as a part of the DelimiterClass::DelimiterChar
+// - classifier: the precomputed lookup for the user's word delimiters
+// - runs: receives the delimiter runs of the row pos is on. Passed in so that
+//         callers walking across multiple rows can keep reusing its allocation.
 // Return Value:
-// - the delimiter class for the given char
-const DelimiterClass TextBuffer::_GetDelimiterClassAt(const COORD pos, const std::wstring_view wordDelimiters) const
+// - the index into runs of the run covering pos.X
+size_t TextBuffer::_GetDelimiterRunIndex(const COORD pos, const DelimiterClassifier& classifier, std::vector<DelimiterRun>& runs) const
+{
+    GetRowByOffset(pos.Y).GetCharRow().GetDelimiterRuns(classifier, runs);
+
+    const auto column = gsl::narrow_cast<size_t>(pos.X);
+    const auto it = std::upper_bound(runs.begin(), runs.end(), column, [](const size_t col, const DelimiterRun& run) {
+        return col < run.end;
+    });
+    THROW_HR_IF(E_INVALIDARG, it == runs.end());
+    return gsl::narrow_cast<size_t>(it - runs.begin());
+}
+
+// Method Description:
+// - Moves to the next run of delimiter classes, continuing on the next row when reaching the end of the current one
+// Arguments:
+// - classifier: the precomputed lookup for the user's word delimiters
+// - runs: the delimiter runs of the row y is on. Refilled when moving on to the next row.
+// - index: the index of the current run. Updated to the index of the next run.
+// - y: the current row. Updated when moving on to the next row.
+// Return Value:
+// - false, if there's no next run because we are on the last run of the buffer
+bool TextBuffer::_MoveToNextDelimiterRun(const DelimiterClassifier& classifier, std::vector<DelimiterRun>& runs, size_t& index, SHORT& y) const
+{
+    if (index + 1 < runs.size())
+    {
+        ++index;
+        return true;
+    }
+
+    if (y >= GetSize().BottomInclusive())
+    {
+        return false;
+    }
+
+    ++y;
+    GetRowByOffset(y).GetCharRow().GetDelimiterRuns(classifier, runs);
+    index = 0;
+    return true;
+}
+
+// Method Description:
+// - Moves to the previous run of delimiter classes, continuing on the previous row when reaching the start of the current one
+// Arguments:
+// - classifier: the precomputed lookup for the user's word delimiters
+// - runs: the delimiter runs of the row y is on. Refilled when moving on to the previous row.
+// - index: the index of the current run. Updated to the index of the previous run.
+// - y: the current row. Updated when moving on to the previous row.
+// Return Value:
+// - false, if there's no previous run because we are on the first run of the buffer
+bool TextBuffer::_MoveToPreviousDelimiterRun(const DelimiterClassifier& classifier, std::vector<DelimiterRun>& runs, size_t& index, SHORT& y) const
 {
-    return GetRowByOffset(pos.Y).GetCharRow().DelimiterClassAt(pos.X, wordDelimiters);
+    if (index != 0)
+    {
+        --index;
+        return true;
+    }
+
+    if (y <= GetSize().Top())
+    {
+        return false;
+    }
+
+    --y;
+    GetRowByOffset(y).GetCharRow().GetDelimiterRuns(classifier, runs);
+    index = runs.size() - 1;
+    return true;
 }
 
 // Method Description:
@@ -1088,13 +1457,14 @@ const COORD TextBuffer::GetWordStart(const COORD target, const std::wstring_view
         copy = { bufferSize.RightInclusive(), bufferSize.BottomInclusive() };
     }
 
+    const DelimiterClassifier classifier{ wordDelimiters };
     if (accessibilityMode)
     {
-        return _GetWordStartForAccessibility(copy, wordDelimiters);
+        return _GetWordStartForAccessibility(copy, classifier);
     }
     else
     {
-        return _GetWordStartForSelection(copy, wordDelimiters);
+        return _GetWordStartForSelection(copy, classifier);
     }
 }
 
@@ -1102,74 +1472,64 @@ const COORD TextBuffer::GetWordStart(const COORD target, const std::wstring_view
 // - Helper method for GetWordStart(). Get the COORD for the beginning of the word (accessibility definition) you are on
 // Arguments:
 // - target - a COORD on the word you are currently on
-// - wordDelimiters - what characters are we considering for the separation of words
+// - classifier - the precomputed lookup for the characters separating words
 // Return Value:
 // - The COORD for the first character on the current/previous READABLE "word" (inclusive)
-const COORD TextBuffer::_GetWordStartForAccessibility(const COORD target, const std::wstring_view wordDelimiters) const
+const COORD TextBuffer::_GetWordStartForAccessibility(const COORD target, const DelimiterClassifier& classifier) const
 {
-    COORD result = target;
-    const auto bufferSize = GetSize();
-    bool stayAtOrigin = false;
+    std::vector<DelimiterRun> runs;
+    auto index = _GetDelimiterRunIndex(target, classifier, runs);
+    auto y = target.Y;
 
     // ignore left boundary. Continue until readable text found
-    while (_GetDelimiterClassAt(result, wordDelimiters) != DelimiterClass::RegularChar)
+    while (runs[index].delimiterClass != DelimiterClass::RegularChar)
     {
-        if (!bufferSize.DecrementInBounds(result))
+        if (!_MoveToPreviousDelimiterRun(classifier, runs, index, y))
         {
             // first char in buffer is a DelimiterChar or ControlChar
             // we can't move any further back
-            stayAtOrigin = true;
-            break;
+            return GetSize().Origin();
         }
     }
 
-    // make sure we expand to the left boundary or the beginning of the word
-    while (_GetDelimiterClassAt(result, wordDelimiters) == DelimiterClass::RegularChar)
+    // make sure we expand to the left boundary or the beginning of the word.
+    // A word wrapping around the right edge ends in the last run of the previous row.
+    while (runs[index].start == 0)
     {
-        if (!bufferSize.DecrementInBounds(result))
+        auto previousIndex = index;
+        auto previousY = y;
+        if (!_MoveToPreviousDelimiterRun(classifier, runs, previousIndex, previousY))
         {
             // first char in buffer is a RegularChar
             // we can't move any further back
             break;
         }
-    }
 
-    // move off of delimiter and onto word start
-    if (!stayAtOrigin && _GetDelimiterClassAt(result, wordDelimiters) != DelimiterClass::RegularChar)
-    {
-        bufferSize.IncrementInBounds(result);
+        if (runs[previousIndex].delimiterClass != DelimiterClass::RegularChar)
+        {
+            // the word starts at the left boundary
+            return { 0, y };
+        }
+
+        index = previousIndex;
+        y = previousY;
     }
 
-    return result;
+    return { gsl::narrow<SHORT>(runs[index].start), y };
 }
 
 // Method Description:
 // - Helper method for GetWordStart(). Get the COORD for the beginning of the word (selection definition) you are on
 // Arguments:
 // - target - a COORD on the word you are currently on
-// - wordDelimiters - what characters are we considering for the separation of words
+// - classifier - the precomputed lookup for the characters separating words
 // Return Value:
 // - The COORD for the first character on the current word or delimiter run (stopped by the left margin)
-const COORD TextBuffer::_GetWordStartForSelection(const COORD target, const std::wstring_view wordDelimiters) const
+const COORD TextBuffer::_GetWordStartForSelection(const COORD target, const DelimiterClassifier& classifier) const
 {
-    COORD result = target;
-    const auto bufferSize = GetSize();
-
-    const auto initialDelimiter = _GetDelimiterClassAt(result, wordDelimiters);
-
-    // expand left until we hit the left boundary or a different delimiter class
-    while (result.X > bufferSize.Left() && (_GetDelimiterClassAt(result, wordDelimiters) == initialDelimiter))
-    {
-        bufferSize.DecrementInBounds(result);
-    }
-
-    if (_GetDelimiterClassAt(result, wordDelimiters) != initialDelimiter)
-    {
-        // move off of delimiter
-        bufferSize.IncrementInBounds(result);
-    }
-
-    return result;
+    std::vector<DelimiterRun> runs;
+    const auto index = _GetDelimiterRunIndex(target, classifier, runs);
+    return { gsl::narrow<SHORT>(runs[index].start), target.Y };
 }
 
 // Method Description:
@@ -1200,14 +1560,15 @@ const COORD TextBuffer::GetWordEnd(const COORD target, const std::wstring_view w
         return target;
     }
 
+    const DelimiterClassifier classifier{ wordDelimiters };
     if (accessibilityMode)
     {
         const auto lastCharPos{ GetLastNonSpaceCharacter() };
-        return _GetWordEndForAccessibility(target, wordDelimiters, lastCharPos);
+        return _GetWordEndForAccessibility(target, classifier, lastCharPos);
     }
     else
     {
-        return _GetWordEndForSelection(target, wordDelimiters);
+        return _GetWordEndForSelection(target, classifier);
     }
 }
 
@@ -1215,28 +1576,33 @@ const COORD TextBuffer::GetWordEnd(const COORD target, const std::wstring_view w
 // - Helper method for GetWordEnd(). Get the COORD for the beginning of the next READABLE word
 // Arguments:
 // - target - a COORD on the word you are currently on
-// - wordDelimiters - what characters are we considering for the separation of words
+// - classifier - the precomputed lookup for the characters separating words
 // - lastCharPos - the position of the last nonspace character in the text buffer (to improve performance)
 // Return Value:
 // - The COORD for the first character of the next readable "word". If no next word, return one past the end of the buffer
-const COORD TextBuffer::_GetWordEndForAccessibility(const COORD target, const std::wstring_view wordDelimiters, const COORD lastCharPos) const
+const COORD TextBuffer::_GetWordEndForAccessibility(const COORD target, const DelimiterClassifier& classifier, const COORD lastCharPos) const
 {
     const auto bufferSize = GetSize();
-    COORD result = target;
 
     // Check if we're already on/past the last RegularChar
-    if (bufferSize.CompareInBounds(result, lastCharPos, true) >= 0)
+    if (bufferSize.CompareInBounds(target, lastCharPos, true) >= 0)
     {
         return bufferSize.EndExclusive();
     }
 
+    std::vector<DelimiterRun> runs;
+    auto index = _GetDelimiterRunIndex(target, classifier, runs);
+    auto y = target.Y;
+    COORD result = target;
+
     // ignore right boundary. Continue through readable text found
-    while (_GetDelimiterClassAt(result, wordDelimiters) == DelimiterClass::RegularChar)
+    while (runs[index].delimiterClass == DelimiterClass::RegularChar)
     {
-        if (!bufferSize.IncrementInBounds(result, true))
+        if (!_MoveToNextDelimiterRun(classifier, runs, index, y))
         {
-            break;
+            return bufferSize.EndExclusive();
         }
+        result = { gsl::narrow<SHORT>(runs[index].start), y };
     }
 
     // we are already on/past the last RegularChar
@@ -1246,15 +1612,16 @@ const COORD TextBuffer::_GetWordEndForAccessibility(const COORD target, const st
     }
 
     // make sure we expand to the beginning of the NEXT word
-    while (_GetDelimiterClassAt(result, wordDelimiters) != DelimiterClass::RegularChar)
+    while (runs[index].delimiterClass != DelimiterClass::RegularChar)
     {
-        if (!bufferSize.IncrementInBounds(result, true))
+        if (!_MoveToNextDelimiterRun(classifier, runs, index, y))
         {
             // we are at the EndInclusive COORD
             // this signifies that we must include the last char in the buffer
             // but the position of the COORD points to nothing
-            break;
+            return bufferSize.EndExclusive();
         }
+        result = { gsl::narrow<SHORT>(runs[index].start), y };
     }
 
     return result;
@@ -1264,35 +1631,20 @@ const COORD TextBuffer::_GetWordEndForAccessibility(const COORD target, const st
 // - Helper method for GetWordEnd(). Get the COORD for the beginning of the NEXT word
 // Arguments:
 // - target - a COORD on the word you are currently on
-// - wordDelimiters - what characters are we considering for the separation of words
+// - classifier - the precomputed lookup for the characters separating words
 // Return Value:
 // - The COORD for the last character of the current word or delimiter run (stopped by right margin)
-const COORD TextBuffer::_GetWordEndForSelection(const COORD target, const std::wstring_view wordDelimiters) const
+const COORD TextBuffer::_GetWordEndForSelection(const COORD target, const DelimiterClassifier& classifier) const
 {
-    const auto bufferSize = GetSize();
-
     // can't expand right
-    if (target.X == bufferSize.RightInclusive())
+    if (target.X == GetSize().RightInclusive())
     {
         return target;
     }
 
-    COORD result = target;
-    const auto initialDelimiter = _GetDelimiterClassAt(result, wordDelimiters);
-
-    // expand right until we hit the right boundary or a different delimiter class
-    while (result.X < bufferSize.RightInclusive() && (_GetDelimiterClassAt(result, wordDelimiters) == initialDelimiter))
-    {
-        bufferSize.IncrementInBounds(result);
-    }
-
-    if (_GetDelimiterClassAt(result, wordDelimiters) != initialDelimiter)
-    {
-        // move off of delimiter
-        bufferSize.DecrementInBounds(result);
-    }
-
-    return result;
+    std::vector<DelimiterRun> runs;
+    const auto index = _GetDelimiterRunIndex(target, classifier, runs);
+    return { gsl::narrow<SHORT>(runs[index].end - 1), target.Y };
 }
 
 void TextBuffer::_PruneHyperlinks()
@@ -1302,7 +1654,10 @@ void TextBuffer::_PruneHyperlinks()
     // If the buffer does not contain the same reference, we can remove that hyperlink from our map
     // This way, obsolete hyperlink references are cleared from our hyperlink map instead of hanging around
     // Get all the hyperlink references in the row we're erasing
-    const auto hyperlinks = _storage.at(_firstRow).GetAttrRow().GetHyperlinks();
+    // Stale rows read as blank, so we go through the const accessors
+    // in here, to avoid resetting the rows we're merely looking at.
+    const auto& self = std::as_const(*this);
+    const auto hyperlinks = self._GetPhysicalRow(_firstRow).GetAttrRow().GetHyperlinks();
 
     if (!hyperlinks.empty())
     {
@@ -1318,7 +1673,7 @@ void TextBuffer::_PruneHyperlinks()
         // to see if those references are anywhere else
         for (size_t i = 1; i != total; ++i)
         {
-            const auto nextRowRefs = GetRowByOffset(i).GetAttrRow().GetHyperlinks();
+            const auto nextRowRefs = self.GetRowByOffset(i).GetAttrRow().GetHyperlinks();
             for (auto id : nextRowRefs)
             {
                 if (firstRowRefs.find(id) != firstRowRefs.end())
@@ -1355,7 +1710,8 @@ bool TextBuffer::MoveToNextWord(COORD& pos, const std::wstring_view wordDelimite
     // move to the beginning of the next word
     // NOTE: _GetWordEnd...() returns the exclusive position of the "end of the word"
     //       This is also the inclusive start of the next word.
-    auto copy{ _GetWordEndForAccessibility(pos, wordDelimiters, lastCharPos) };
+    const DelimiterClassifier classifier{ wordDelimiters };
+    auto copy{ _GetWordEndForAccessibility(pos, classifier, lastCharPos) };
 
     if (copy == GetSize().EndExclusive())
     {
@@ -1386,7 +1742,7 @@ bool TextBuffer::MoveToPreviousWord(COORD& pos, std::wstring_view wordDelimiters
     }
 
     // move to the beginning of the previous word
-    pos = GetWordStart(copy, wordDelimiters, true);
+    pos = _GetWordStartForAccessibility(copy, DelimiterClassifier{ wordDelimiters });
     return true;
 }
 
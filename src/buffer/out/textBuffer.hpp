@@ -115,6 +115,10 @@ public:
     const Microsoft::Console::Types::Viewport GetSize() const noexcept;
 
     void ScrollRows(const SHORT firstRow, const SHORT size, const SHORT delta);
+    void CopyRectangle(const Microsoft::Console::Types::Viewport& source, const COORD targetOrigin);
+    void FillRectangle(const Microsoft::Console::Types::Viewport& rect, const wchar_t fillChar, const TextAttribute& fillAttrs);
+    void ReadCharInfos(const Microsoft::Console::Types::Viewport& source, const gsl::span<CHAR_INFO> target, const size_t targetWidth) const;
+    void WriteCharInfos(const gsl::span<const CHAR_INFO> source, const size_t sourceWidth, const Microsoft::Console::Types::Viewport& target);
 
     UINT TotalRowCount() const noexcept;
 
@@ -133,6 +137,8 @@ public:
     COORD BufferToScreenPosition(const COORD position) const;
 
     void Reset();
+    void Reinitialize(const TextAttribute defaultAttributes);
+    void ClearScrollback(const SHORT viewportTop, const SHORT viewportHeight, const TextAttribute fillAttributes);
 
     [[nodiscard]] HRESULT ResizeTraditional(const COORD newSize) noexcept;
 
@@ -208,6 +214,13 @@ private:
 
     SHORT _firstRow; // indexes top row (not necessarily 0)
 
+    // Clearing the scrollback doesn't touch the cleared rows. Instead, every row whose
+    // generation doesn't match ours is stale: it reads as _blankRow and is only reset
+    // (with _clearAttributes) once somebody asks for mutable access to it.
+    uint32_t _generation;
+    TextAttribute _clearAttributes;
+    std::optional<ROW> _blankRow;
+
     TextAttribute _currentAttributes;
 
     // storage location for glyphs that can't fit into the buffer normally
@@ -234,22 +247,30 @@ private:
     bool _PrepareForDoubleByteSequence(const DbcsAttribute dbcsAttribute);
     bool _AssertValidDoubleByteSequence(const DbcsAttribute dbcsAttribute);
 
+    const ROW& _GetPhysicalRow(const size_t index) const;
+    ROW& _GetPhysicalRow(const size_t index);
+    void _MaterializeStaleRows();
+
     ROW& _GetFirstRow();
     ROW& _GetPrevRowNoWrap(const ROW& row);
 
     void _ExpandTextRow(SMALL_RECT& selectionRow) const;
 
-    const DelimiterClass _GetDelimiterClassAt(const COORD pos, const std::wstring_view wordDelimiters) const;
-    const COORD _GetWordStartForAccessibility(const COORD target, const std::wstring_view wordDelimiters) const;
-    const COORD _GetWordStartForSelection(const COORD target, const std::wstring_view wordDelimiters) const;
-    const COORD _GetWordEndForAccessibility(const COORD target, const std::wstring_view wordDelimiters, const COORD lastCharPos) const;
-    const COORD _GetWordEndForSelection(const COORD target, const std::wstring_view wordDelimiters) const;
+    size_t _GetDelimiterRunIndex(const COORD pos, const DelimiterClassifier& classifier, std::vector<DelimiterRun>& runs) const;
+    bool _MoveToNextDelimiterRun(const DelimiterClassifier& classifier, std::vector<DelimiterRun>& runs, size_t& index, SHORT& y) const;
+    bool _MoveToPreviousDelimiterRun(const DelimiterClassifier& classifier, std::vector<DelimiterRun>& runs, size_t& index, SHORT& y) const;
+    const COORD _GetWordStartForAccessibility(const COORD target, const DelimiterClassifier& classifier) const;
+    const COORD _GetWordStartForSelection(const COORD target, const DelimiterClassifier& classifier) const;
+    const COORD _GetWordEndForAccessibility(const COORD target, const DelimiterClassifier& classifier, const COORD lastCharPos) const;
+    const COORD _GetWordEndForSelection(const COORD target, const DelimiterClassifier& classifier) const;
 
     void _PruneHyperlinks();
 
     std::unordered_map<size_t, std::wstring> _idsAndPatterns;
     size_t _currentPatternId;
 
+    friend class TextBufferSnapshot;
+
 #ifdef UNIT_TESTING
     friend class TextBufferTests;
     friend class UiaTextRangeTests;
@@ -0,0 +1,357 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "textBufferSnapshot.hpp"
+
+#pragma warning(disable : 26490) // reinterpret_cast is required to view the snapshot's raw bytes.
+
+using AttributeRun = til::rle_pair<TextAttribute, uint16_t>;
+
+static_assert(std::is_trivially_copyable_v<CharRowCell>, "CharRowCells are memcpy()'d into snapshots");
+static_assert(std::is_trivially_copyable_v<AttributeRun>, "attribute runs are memcpy()'d into snapshots");
+
+namespace
+{
+    const auto invalidSnapshot = HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+
+    template<typename T>
+    void Append(std::vector<BYTE>& out, const T* const data, const size_t count)
+    {
+        const auto bytes = reinterpret_cast<const BYTE*>(data);
+        out.insert(out.end(), bytes, bytes + count * sizeof(T));
+    }
+
+    template<typename T>
+    void Append(std::vector<BYTE>& out, const T& value)
+    {
+        Append(out, &value, 1);
+    }
+
+    void AppendString(std::vector<BYTE>& out, const uint16_t id, const std::wstring_view str)
+    {
+        Append(out, id);
+        Append(out, gsl::narrow<uint32_t>(str.size()));
+        Append(out, str.data(), str.size());
+    }
+
+    // Reads values out of a snapshot, making sure that we never read past its end.
+    // Snapshots come from disk, so they might be truncated or otherwise corrupt.
+    class Reader
+    {
+    public:
+        explicit Reader(gsl::span<const BYTE> data) noexcept :
+            _data{ data }
+        {
+        }
+
+        gsl::span<const BYTE> ReadBytes(const size_t count)
+        {
+            THROW_HR_IF(invalidSnapshot, count > _data.size());
+            const auto bytes = _data.first(count);
+            _data = _data.subspan(count);
+            return bytes;
+        }
+
+        template<typename T>
+        T Read()
+        {
+            T value;
+            std::memcpy(&value, ReadBytes(sizeof(T)).data(), sizeof(T));
+            return value;
+        }
+
+        template<typename T>
+        void ReadInto(T* const destination, const size_t count)
+        {
+            const auto bytes = ReadBytes(count * sizeof(T));
+            std::memcpy(destination, bytes.data(), bytes.size());
+        }
+
+        std::wstring ReadString()
+        {
+            // Check the length before allocating the string, as it could be anything.
+            const auto length = Read<uint32_t>();
+            THROW_HR_IF(invalidSnapshot, length > _data.size() / sizeof(wchar_t));
+
+            std::wstring str(length, L'\0');
+            ReadInto(str.data(), str.size());
+            return str;
+        }
+
+    private:
+        gsl::span<const BYTE> _data;
+    };
+
+    // Attributes are memcpy()'d out of the snapshot, so their colors could hold anything.
+    bool IsValidAttribute(const TextAttribute& attr) noexcept
+    {
+        return attr.GetForeground().IsValid() && attr.GetBackground().IsValid();
+    }
+}
+
+// Routine Description:
+// - Serializes the entire contents of the given buffer into a snapshot.
+// - This needs to be called while the buffer is locked, but it doesn't touch the
+//   disk, so the snapshot can be written with SaveToFile() after unlocking it.
+// Arguments:
+// - buffer - the buffer to serialize
+// Return Value:
+// - the snapshot
+std::vector<BYTE> TextBufferSnapshot::Save(const TextBuffer& buffer)
+{
+    const auto size = buffer.GetSize().Dimensions();
+    const auto& cursor = buffer.GetCursor();
+    const auto& unicodeStorage = buffer.GetUnicodeStorage();
+
+    std::vector<BYTE> snapshot;
+    // Most rows of a typical scrollback are short and consist of a single attribute
+    // run, so this is a good estimate that avoids most of the reallocations.
+    snapshot.reserve(sizeof(Header) + size.Y * (sizeof(RowHeader) + sizeof(AttributeRun) + 40 * sizeof(CharRowCell)));
+
+    Header header{};
+    header.magic = s_magic;
+    header.version = s_version;
+    header.cellSize = gsl::narrow_cast<uint8_t>(sizeof(CharRowCell));
+    header.attributeRunSize = gsl::narrow_cast<uint8_t>(sizeof(AttributeRun));
+    header.width = gsl::narrow<uint16_t>(size.X);
+    header.height = gsl::narrow<uint16_t>(size.Y);
+    header.cursorPosition = cursor.GetPosition();
+    header.cursorVisible = cursor.IsVisible();
+    header.currentHyperlinkId = buffer._currentHyperlinkId;
+    header.currentAttributes = buffer.GetCurrentAttributes();
+    header.hyperlinkCount = gsl::narrow<uint32_t>(buffer._hyperlinkMap.size());
+    header.customIdCount = gsl::narrow<uint32_t>(buffer._hyperlinkCustomIdMap.size());
+    Append(snapshot, header);
+
+    for (SHORT y = 0; y < size.Y; ++y)
+    {
+        const auto& row = buffer.GetRowByOffset(y);
+        const auto& charRow = row.GetCharRow();
+        const auto& runs = row.GetAttrRow()._data.runs();
+
+        RowHeader rowHeader{};
+        rowHeader.cellCount = gsl::narrow<uint16_t>(charRow.MeasureRight());
+        rowHeader.attributeRunCount = gsl::narrow<uint16_t>(runs.size());
+        rowHeader.lineRendition = gsl::narrow_cast<uint8_t>(row.GetLineRendition());
+        rowHeader.flags = (row.WasWrapForced() ? s_wrapForced : 0) | (row.WasDoubleBytePadded() ? s_doubleBytePadded : 0);
+
+        // The glyph count is only known after the cells have been
+        // scanned, so the header is patched once we got there.
+        const auto rowHeaderOffset = snapshot.size();
+        Append(snapshot, rowHeader);
+        Append(snapshot, charRow._data.data(), rowHeader.cellCount);
+        Append(snapshot, runs.data(), runs.size());
+
+        for (uint16_t x = 0; x < rowHeader.cellCount; ++x)
+        {
+            if (charRow._data[x].DbcsAttr().IsGlyphStored())
+            {
+                const auto& glyph = unicodeStorage.GetText(charRow.GetStorageKey(x));
+                Append(snapshot, GlyphHeader{ x, gsl::narrow<uint16_t>(glyph.size()) });
+                Append(snapshot, glyph.data(), glyph.size());
+                rowHeader.glyphCount++;
+            }
+        }
+
+        if (rowHeader.glyphCount)
+        {
+            std::memcpy(snapshot.data() + rowHeaderOffset, &rowHeader, sizeof(rowHeader));
+        }
+    }
+
+    for (const auto& [id, uri] : buffer._hyperlinkMap)
+    {
+        AppendString(snapshot, id, uri);
+    }
+    for (const auto& [customId, id] : buffer._hyperlinkCustomIdMap)
+    {
+        AppendString(snapshot, id, customId);
+    }
+
+    return snapshot;
+}
+
+// Routine Description:
+// - Replaces the contents of the given buffer with the ones of a snapshot.
+//   The buffer is resized to the snapshot's dimensions if necessary.
+// - Snapshots come from disk, so the entire snapshot is parsed and validated
+//   before the buffer is touched. Only then are the parsed rows moved into it.
+// Arguments:
+// - snapshot - a snapshot created by Save()
+// - buffer - the buffer to restore the snapshot into
+// Return Value:
+// - <none> - throws if the snapshot is corrupt or was created by an incompatible version.
+//   The buffer is left unmodified in that case. If it can't be resized to the size of
+//   the snapshot, its contents are retained, but it may be left partially resized.
+void TextBufferSnapshot::Load(gsl::span<const BYTE> snapshot, TextBuffer& buffer)
+{
+    Reader reader{ snapshot };
+
+    const auto header = reader.Read<Header>();
+    THROW_HR_IF(invalidSnapshot, header.magic != s_magic || header.version != s_version);
+    THROW_HR_IF(invalidSnapshot, header.cellSize != sizeof(CharRowCell) || header.attributeRunSize != sizeof(AttributeRun));
+    THROW_HR_IF(invalidSnapshot, header.width == 0 || header.width > SHRT_MAX || header.height == 0 || header.height > SHRT_MAX);
+    THROW_HR_IF(invalidSnapshot, !IsValidAttribute(header.currentAttributes));
+
+    std::vector<ParsedRow> rows;
+    rows.reserve(header.height);
+
+    for (uint16_t y = 0; y < header.height; ++y)
+    {
+        auto& row = rows.emplace_back();
+
+        row.header = reader.Read<RowHeader>();
+        THROW_HR_IF(invalidSnapshot, row.header.cellCount > header.width || row.header.attributeRunCount == 0);
+        THROW_HR_IF(invalidSnapshot, row.header.glyphCount > row.header.cellCount);
+        THROW_HR_IF(invalidSnapshot, row.header.lineRendition > static_cast<uint8_t>(LineRendition::DoubleHeightBottom));
+
+        row.cells.resize(row.header.cellCount);
+        reader.ReadInto(row.cells.data(), row.cells.size());
+
+        for (const auto& cell : row.cells)
+        {
+            const auto& dbcsAttr = cell.DbcsAttr();
+            THROW_HR_IF(invalidSnapshot, !dbcsAttr.IsSingle() && !dbcsAttr.IsDbcs());
+        }
+
+        row.runs.resize(row.header.attributeRunCount);
+        reader.ReadInto(row.runs.data(), row.runs.size());
+
+        // rle_vector sums up the run lengths in its 16-bit size_type, which could
+        // overflow and wrap around to the expected width. We count them ourselves.
+        size_t totalLength = 0;
+        for (const auto& run : row.runs)
+        {
+            THROW_HR_IF(invalidSnapshot, run.length == 0 || !IsValidAttribute(run.value));
+            totalLength += run.length;
+        }
+        THROW_HR_IF(invalidSnapshot, totalLength != header.width);
+
+        // Save() writes the glyphs in column order. Requiring that here makes it
+        // easy to ensure that every glyph-stored cell has exactly one glyph.
+        row.glyphs.reserve(row.header.glyphCount);
+        for (uint16_t i = 0; i < row.header.glyphCount; ++i)
+        {
+            const auto glyphHeader = reader.Read<GlyphHeader>();
+            THROW_HR_IF(invalidSnapshot, glyphHeader.column >= row.header.cellCount || glyphHeader.length == 0);
+            THROW_HR_IF(invalidSnapshot, !row.glyphs.empty() && glyphHeader.column <= row.glyphs.back().first);
+            THROW_HR_IF(invalidSnapshot, !til::at(row.cells, glyphHeader.column).DbcsAttr().IsGlyphStored());
+
+            auto& glyph = row.glyphs.emplace_back(glyphHeader.column, UnicodeStorage::mapped_type(glyphHeader.length)).second;
+            reader.ReadInto(glyph.data(), glyph.size());
+        }
+
+        // Since the glyph columns are unique and each of them is glyph-stored,
+        // this ensures that no cell claims to have a glyph that doesn't exist.
+        const auto glyphStoredCells = std::count_if(row.cells.begin(), row.cells.end(), [](const auto& cell) {
+            return cell.DbcsAttr().IsGlyphStored();
+        });
+        THROW_HR_IF(invalidSnapshot, gsl::narrow_cast<size_t>(glyphStoredCells) != row.glyphs.size());
+    }
+
+    decltype(buffer._hyperlinkMap) hyperlinkMap;
+    for (uint32_t i = 0; i < header.hyperlinkCount; ++i)
+    {
+        const auto id = reader.Read<uint16_t>();
+        hyperlinkMap.insert_or_assign(id, reader.ReadString());
+    }
+
+    decltype(buffer._hyperlinkCustomIdMap) hyperlinkCustomIdMap;
+    for (uint32_t i = 0; i < header.customIdCount; ++i)
+    {
+        const auto id = reader.Read<uint16_t>();
+        hyperlinkCustomIdMap.insert_or_assign(reader.ReadString(), id);
+    }
+
+    // The snapshot is valid. Swap its contents into the buffer.
+    // Resize it before clearing it, so that its contents survive if that fails.
+    const COORD size{ gsl::narrow_cast<SHORT>(header.width), gsl::narrow_cast<SHORT>(header.height) };
+    if (buffer.GetSize().Dimensions() != size)
+    {
+        THROW_IF_FAILED(buffer.ResizeTraditional(size));
+    }
+
+    buffer.Reinitialize(header.currentAttributes);
+
+    auto& unicodeStorage = buffer.GetUnicodeStorage();
+
+    for (SHORT y = 0; y < size.Y; ++y)
+    {
+        auto& parsed = til::at(rows, y);
+        auto& row = buffer.GetRowByOffset(y);
+        auto& charRow = row.GetCharRow();
+
+        row.SetLineRendition(static_cast<LineRendition>(parsed.header.lineRendition));
+        row.SetWrapForced(WI_IsFlagSet(parsed.header.flags, s_wrapForced));
+        row.SetDoubleBytePadded(WI_IsFlagSet(parsed.header.flags, s_doubleBytePadded));
+
+        std::copy(parsed.cells.begin(), parsed.cells.end(), charRow._data.begin());
+        charRow._maxRight = parsed.cells.size();
+
+        row.GetAttrRow()._data = ATTR_ROW::rle_vector{ std::move(parsed.runs) };
+
+        for (const auto& [column, glyph] : parsed.glyphs)
+        {
+            unicodeStorage.StoreGlyph(charRow.GetStorageKey(column), glyph);
+        }
+    }
+
+    buffer._hyperlinkMap.swap(hyperlinkMap);
+    buffer._hyperlinkCustomIdMap.swap(hyperlinkCustomIdMap);
+    buffer._currentHyperlinkId = header.currentHyperlinkId;
+
+    auto cursorPosition = header.cursorPosition;
+    buffer.GetSize().Clamp(cursorPosition);
+
+    auto& cursor = buffer.GetCursor();
+    cursor.SetPosition(cursorPosition);
+    cursor.SetIsVisible(header.cursorVisible != 0);
+}
+
+// Routine Description:
+// - Writes a snapshot to disk. This doesn't need access to the buffer
+//   the snapshot was taken from and can thus run on a background thread.
+// - The snapshot is written to a temporary file first, which then replaces
+//   the target, so that a crash while saving doesn't destroy the previous snapshot.
+// Arguments:
+// - snapshot - a snapshot created by Save()
+// - path - the file to write the snapshot to
+void TextBufferSnapshot::SaveToFile(gsl::span<const BYTE> snapshot, const std::wstring& path)
+{
+    const auto temporaryPath = path + L".tmp";
+
+    {
+        wil::unique_hfile file{ CreateFileW(temporaryPath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr) };
+        THROW_LAST_ERROR_IF(!file);
+
+        DWORD written = 0;
+        THROW_IF_WIN32_BOOL_FALSE(WriteFile(file.get(), snapshot.data(), gsl::narrow<DWORD>(snapshot.size()), &written, nullptr));
+        THROW_HR_IF(E_UNEXPECTED, written != snapshot.size());
+    }
+
+    THROW_IF_WIN32_BOOL_FALSE(MoveFileExW(temporaryPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH));
+}
+
+// Routine Description:
+// - Maps a snapshot file into memory and restores it into the given buffer.
+// Arguments:
+// - path - the file to read the snapshot from
+// - buffer - the buffer to restore the snapshot into
+void TextBufferSnapshot::LoadFromFile(const std::wstring& path, TextBuffer& buffer)
+{
+    wil::unique_hfile file{ CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr) };
+    THROW_LAST_ERROR_IF(!file);
+
+    LARGE_INTEGER fileSize{};
+    THROW_IF_WIN32_BOOL_FALSE(GetFileSizeEx(file.get(), &fileSize));
+    THROW_HR_IF(invalidSnapshot, fileSize.QuadPart < static_cast<LONGLONG>(sizeof(Header)));
+
+    wil::unique_handle mapping{ CreateFileMappingW(file.get(), nullptr, PAGE_READONLY, 0, 0, nullptr) };
+    THROW_LAST_ERROR_IF(!mapping);
+
+    wil::unique_mapview_ptr<BYTE> view{ static_cast<BYTE*>(MapViewOfFile(mapping.get(), FILE_MAP_READ, 0, 0, 0)) };
+    THROW_LAST_ERROR_IF(!view);
+
+    Load({ view.get(), gsl::narrow<size_t>(fileSize.QuadPart) }, buffer);
+}
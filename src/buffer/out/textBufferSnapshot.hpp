@@ -0,0 +1,86 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- textBufferSnapshot.hpp
+
+Abstract:
+- Serializes a TextBuffer into a compact binary snapshot and restores it again.
+  This allows a session's scrollback to survive a restart without replaying its output.
+- A snapshot contains every row (trimmed to its last non-space cell) with its
+  run-length encoded attributes, line rendition and wrap state, the glyphs kept
+  in the UnicodeStorage, the hyperlink maps, the current attributes and the cursor.
+- Cells and attribute runs are stored in their in-memory layout, so that loading
+  a snapshot is mostly a series of memcpy()s. Since snapshots are read from disk,
+  they're fully parsed and validated before the target buffer is modified.
+  The layout is recorded in the header and snapshots with a different layout
+  (or version) are rejected instead of being converted.
+--*/
+
+#pragma once
+
+#include "textBuffer.hpp"
+
+class TextBufferSnapshot final
+{
+public:
+    static std::vector<BYTE> Save(const TextBuffer& buffer);
+    static void Load(gsl::span<const BYTE> snapshot, TextBuffer& buffer);
+
+    static void SaveToFile(gsl::span<const BYTE> snapshot, const std::wstring& path);
+    static void LoadFromFile(const std::wstring& path, TextBuffer& buffer);
+
+private:
+    static constexpr uint32_t s_magic = 0x53425454; // "TTBS" in little endian
+    static constexpr uint16_t s_version = 1;
+
+    struct Header
+    {
+        uint32_t magic;
+        uint16_t version;
+        uint8_t cellSize;
+        uint8_t attributeRunSize;
+        uint16_t width;
+        uint16_t height;
+        COORD cursorPosition;
+        uint8_t cursorVisible;
+        uint8_t reserved;
+        uint16_t currentHyperlinkId;
+        TextAttribute currentAttributes;
+        uint32_t hyperlinkCount;
+        uint32_t customIdCount;
+    };
+
+    struct RowHeader
+    {
+        uint16_t cellCount;
+        uint16_t attributeRunCount;
+        uint16_t glyphCount;
+        uint8_t lineRendition;
+        uint8_t flags;
+    };
+
+    struct GlyphHeader
+    {
+        uint16_t column;
+        uint16_t length;
+    };
+
+    // A row that has been read from a snapshot and validated, but not restored yet.
+    // Load() parses the entire snapshot before it modifies the buffer.
+    struct ParsedRow
+    {
+        RowHeader header;
+        std::vector<CharRowCell> cells;
+        ATTR_ROW::rle_vector::container runs;
+        std::vector<std::pair<uint16_t, UnicodeStorage::mapped_type>> glyphs;
+    };
+
+    static constexpr uint8_t s_wrapForced = 0x1;
+    static constexpr uint8_t s_doubleBytePadded = 0x2;
+
+#ifdef UNIT_TESTING
+    friend class TextBufferSnapshotTests;
+#endif
+};
@@ -0,0 +1,84 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "../textBuffer.hpp"
+#include "../../renderer/inc/DummyRenderTarget.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+class DelimiterClassifierTests
+{
+    TEST_CLASS(DelimiterClassifierTests);
+
+    TEST_METHOD(ClassifiesAsciiAndNonAsciiDelimiters)
+    {
+        const DelimiterClassifier classifier{ L"/\\()\"'-.,:;<>~!@#$%^&*|+=[]{}~?\x2502\x00a7" };
+
+        for (const auto wch : std::wstring_view{ L"\0\t\r\n \x1f", 6 })
+        {
+            VERIFY_IS_TRUE(DelimiterClass::ControlChar == classifier.Classify(wch));
+        }
+
+        for (const auto wch : std::wstring_view{ L"/\\().,[]{}?~\x2502\x00a7" })
+        {
+            VERIFY_IS_TRUE(DelimiterClass::DelimiterChar == classifier.Classify(wch));
+        }
+
+        for (const auto wch : std::wstring_view{ L"azAZ09_\x7f\x00e9\x2500\xd83d" })
+        {
+            VERIFY_IS_TRUE(DelimiterClass::RegularChar == classifier.Classify(wch));
+        }
+    }
+
+    TEST_METHOD(EmptyDelimitersOnlyClassifyControlChars)
+    {
+        const DelimiterClassifier classifier{ L"" };
+
+        VERIFY_IS_TRUE(DelimiterClass::ControlChar == classifier.Classify(L' '));
+        VERIFY_IS_TRUE(DelimiterClass::RegularChar == classifier.Classify(L'/'));
+        VERIFY_IS_TRUE(DelimiterClass::RegularChar == classifier.Classify(L'\x2502'));
+    }
+
+    TEST_METHOD(RowIsSplitIntoRuns)
+    {
+        DummyRenderTarget target;
+        TextBuffer buffer{ { 20, 2 }, TextAttribute{ 0x7 }, 0, target };
+        buffer.WriteLine(OutputCellIterator{ L"  foo.bar  baz" }, { 0, 0 });
+
+        const DelimiterClassifier classifier{ L"." };
+        std::vector<DelimiterRun> runs;
+        buffer.GetRowByOffset(0).GetCharRow().GetDelimiterRuns(classifier, runs);
+
+        const std::vector<DelimiterRun> expected{
+            { 0, 2, DelimiterClass::ControlChar },
+            { 2, 5, DelimiterClass::RegularChar },
+            { 5, 6, DelimiterClass::DelimiterChar },
+            { 6, 9, DelimiterClass::RegularChar },
+            { 9, 11, DelimiterClass::ControlChar },
+            { 11, 14, DelimiterClass::RegularChar },
+            { 14, 20, DelimiterClass::ControlChar },
+        };
+
+        VERIFY_ARE_EQUAL(expected.size(), runs.size());
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            VERIFY_ARE_EQUAL(expected[i].start, runs[i].start);
+            VERIFY_ARE_EQUAL(expected[i].end, runs[i].end);
+            VERIFY_IS_TRUE(expected[i].delimiterClass == runs[i].delimiterClass);
+            VERIFY_IS_TRUE(runs[i].delimiterClass == buffer.GetRowByOffset(0).GetCharRow().DelimiterClassAt(runs[i].start, classifier));
+        }
+
+        // An empty row is a single run of ControlChars.
+        buffer.GetRowByOffset(1).GetCharRow().GetDelimiterRuns(classifier, runs);
+        VERIFY_ARE_EQUAL(1u, runs.size());
+        VERIFY_ARE_EQUAL(0u, runs[0].start);
+        VERIFY_ARE_EQUAL(20u, runs[0].end);
+        VERIFY_IS_TRUE(DelimiterClass::ControlChar == runs[0].delimiterClass);
+    }
+};
@@ -22,6 +22,7 @@ class TextAttributeTests
     TEST_METHOD(TestTextAttributeColorGetters);
     TEST_METHOD(TestReverseDefaultColors);
     TEST_METHOD(TestRoundtripDefaultColors);
+    TEST_METHOD(TestExtendedAndMetaAttributesAreIndependent);
 
     static const int COLOR_TABLE_SIZE = 16;
     COLORREF _colorTable[COLOR_TABLE_SIZE];
@@ -91,7 +92,7 @@ void TextAttributeTests::TestRoundtripMetaBits()
         auto attr = TextAttribute(expectedLegacy);
         VERIFY_IS_TRUE(attr.IsLegacy());
         VERIFY_ARE_EQUAL(expectedLegacy, attr.GetLegacyAttributes());
-        VERIFY_ARE_EQUAL(flag, attr._wAttrLegacy);
+        VERIFY_ARE_EQUAL(flag, attr._attrs);
     }
 }
 
@@ -272,3 +273,40 @@ void TextAttributeTests::TestRoundtripDefaultColors()
     // Reset the legacy default colors to white on black.
     TextAttribute::SetLegacyDefaultAttributes(FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE);
 }
+
+void TextAttributeTests::TestExtendedAndMetaAttributesAreIndependent()
+{
+    // The extended attributes and the legacy meta attributes share a single
+    // packed word. Ensure that setting one never affects the other.
+    const WORD legacy = FOREGROUND_BLUE | BACKGROUND_RED | COMMON_LVB_REVERSE_VIDEO | COMMON_LVB_UNDERSCORE;
+    auto attr = TextAttribute{ legacy };
+
+    attr.SetBold(true);
+    attr.SetItalic(true);
+    attr.SetFaint(true);
+    attr.SetDoublyUnderlined(true);
+    VERIFY_IS_TRUE(attr.IsReverseVideo());
+    VERIFY_IS_TRUE(attr.IsBottomHorizontalDisplayed());
+    VERIFY_IS_FALSE(attr.IsOverlined());
+    VERIFY_ARE_EQUAL(static_cast<BYTE>(ExtendedAttributes::Bold | ExtendedAttributes::Italics | ExtendedAttributes::Faint | ExtendedAttributes::DoublyUnderlined),
+                     static_cast<BYTE>(attr.GetExtendedAttributes()));
+
+    attr.SetReverseVideo(false);
+    attr.SetOverlined(true);
+    attr.SetItalic(false);
+    VERIFY_IS_TRUE(attr.IsBold());
+    VERIFY_IS_FALSE(attr.IsItalic());
+    VERIFY_IS_TRUE(attr.IsFaint());
+    VERIFY_IS_TRUE(attr.IsDoublyUnderlined());
+    VERIFY_IS_FALSE(attr.IsReverseVideo());
+    VERIFY_IS_TRUE(attr.IsOverlined());
+
+    attr.SetDefaultMetaAttrs();
+    VERIFY_ARE_EQUAL(static_cast<BYTE>(ExtendedAttributes::Normal), static_cast<BYTE>(attr.GetExtendedAttributes()));
+    VERIFY_IS_FALSE(attr.IsAnyGridLineEnabled());
+    VERIFY_IS_FALSE(attr.IsReverseVideo());
+
+    // The colors must have survived all of the above.
+    VERIFY_ARE_EQUAL(TextColor(FOREGROUND_BLUE, false), attr.GetForeground());
+    VERIFY_ARE_EQUAL(TextColor(BACKGROUND_RED >> 4, false), attr.GetBackground());
+}
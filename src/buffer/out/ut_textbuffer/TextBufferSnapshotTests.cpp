@@ -0,0 +1,261 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "../textBufferSnapshot.hpp"
+#include "../../renderer/inc/DummyRenderTarget.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+class TextBufferSnapshotTests
+{
+    TEST_CLASS(TextBufferSnapshotTests);
+
+    using AttributeRun = til::rle_pair<TextAttribute, uint16_t>;
+
+    DummyRenderTarget _target;
+
+    template<typename T>
+    static T _ReadAt(const std::vector<BYTE>& snapshot, const size_t offset)
+    {
+        T value;
+        std::memcpy(&value, snapshot.data() + offset, sizeof(T));
+        return value;
+    }
+
+    template<typename T>
+    static void _WriteAt(std::vector<BYTE>& snapshot, const size_t offset, const T& value)
+    {
+        std::memcpy(snapshot.data() + offset, &value, sizeof(T));
+    }
+
+    std::unique_ptr<TextBuffer> _CreateSampleBuffer()
+    {
+        auto buffer = std::make_unique<TextBuffer>(COORD{ 40, 12 }, TextAttribute{ 0x7 }, 0, _target);
+
+        buffer->WriteLine(OutputCellIterator{ L"plain text" }, { 0, 0 });
+
+        // Two differently colored words and a hyperlink.
+        TextAttribute red{ 0x4 };
+        buffer->WriteLine(OutputCellIterator{ L"red", red }, { 0, 1 });
+        TextAttribute rgb{ RGB(1, 2, 3), RGB(4, 5, 6) };
+        rgb.SetUnderlined(true);
+        buffer->WriteLine(OutputCellIterator{ L"rgb", rgb }, { 4, 1 });
+
+        const auto id = buffer->GetHyperlinkId(L"https://example.com", L"custom");
+        buffer->AddHyperlinkToMap(L"https://example.com", id);
+        TextAttribute link{ 0x7 };
+        link.SetHyperlinkId(id);
+        buffer->WriteLine(OutputCellIterator{ L"link", link }, { 8, 1 });
+
+        // Glyphs that don't fit into a single cell end up in the UnicodeStorage.
+        buffer->WriteLine(OutputCellIterator{ L"\xD83D\xDE00 wide \x6771\x4EAC" }, { 0, 2 });
+
+        buffer->GetRowByOffset(3).SetLineRendition(LineRendition::DoubleWidth);
+        buffer->WriteLine(OutputCellIterator{ L"double" }, { 0, 3 });
+        buffer->GetRowByOffset(4).SetWrapForced(true);
+        buffer->WriteLine(OutputCellIterator{ std::wstring(40, L'x') }, { 0, 4 });
+
+        // Make sure that the snapshot stores rows in logical and not in physical order.
+        buffer->IncrementCircularBuffer();
+        buffer->WriteLine(OutputCellIterator{ L"last row" }, { 0, 11 });
+
+        buffer->SetCurrentAttributes(red);
+        buffer->GetCursor().SetPosition({ 5, 7 });
+        return buffer;
+    }
+
+    static void _VerifyBuffersAreEqual(const TextBuffer& expected, const TextBuffer& actual)
+    {
+        VERIFY_ARE_EQUAL(expected.GetSize().Dimensions(), actual.GetSize().Dimensions());
+        VERIFY_ARE_EQUAL(expected.GetCursor().GetPosition(), actual.GetCursor().GetPosition());
+        VERIFY_ARE_EQUAL(expected.GetCurrentAttributes(), actual.GetCurrentAttributes());
+
+        const auto size = expected.GetSize();
+        for (SHORT y = 0; y < size.Height(); ++y)
+        {
+            const auto& expectedRow = expected.GetRowByOffset(y);
+            const auto& actualRow = actual.GetRowByOffset(y);
+            VERIFY_ARE_EQUAL(expectedRow.GetText(), actualRow.GetText());
+            VERIFY_IS_TRUE(expectedRow.GetAttrRow() == actualRow.GetAttrRow());
+            VERIFY_IS_TRUE(expectedRow.GetLineRendition() == actualRow.GetLineRendition());
+            VERIFY_ARE_EQUAL(expectedRow.WasWrapForced(), actualRow.WasWrapForced());
+
+            for (SHORT x = 0; x < size.Width(); ++x)
+            {
+                const auto expectedCell = expected.GetCellDataAt({ x, y });
+                const auto actualCell = actual.GetCellDataAt({ x, y });
+                VERIFY_ARE_EQUAL(expectedCell->Chars(), actualCell->Chars());
+                VERIFY_IS_TRUE(expectedCell->DbcsAttr() == actualCell->DbcsAttr());
+            }
+        }
+    }
+
+    TEST_METHOD(RoundTrip)
+    {
+        const auto original = _CreateSampleBuffer();
+        const auto snapshot = TextBufferSnapshot::Save(*original);
+
+        TextBuffer restored{ original->GetSize().Dimensions(), TextAttribute{}, 0, _target };
+        TextBufferSnapshot::Load(snapshot, restored);
+
+        _VerifyBuffersAreEqual(*original, restored);
+
+        Log::Comment(L"Saving the restored buffer should produce the same snapshot.");
+        VERIFY_IS_TRUE(snapshot == TextBufferSnapshot::Save(restored));
+
+        const auto link = restored.GetRowByOffset(0).GetAttrRow().GetAttrByColumn(8);
+        VERIFY_IS_TRUE(link.IsHyperlink());
+        VERIFY_ARE_EQUAL(L"https://example.com", restored.GetHyperlinkUriFromId(link.GetHyperlinkId()));
+
+        Log::Comment(L"Looking up the custom id again should find the restored hyperlink.");
+        VERIFY_ARE_EQUAL(link.GetHyperlinkId(), restored.GetHyperlinkId(L"https://example.com", L"custom"));
+
+        Log::Comment(L"New hyperlinks must not reuse the id of a restored one.");
+        VERIFY_ARE_NOT_EQUAL(link.GetHyperlinkId(), restored.GetHyperlinkId(L"https://example.org", L""));
+    }
+
+    TEST_METHOD(LoadResizesBuffer)
+    {
+        const auto original = _CreateSampleBuffer();
+        const auto snapshot = TextBufferSnapshot::Save(*original);
+
+        TextBuffer restored{ { 80, 3 }, TextAttribute{}, 0, _target };
+        TextBufferSnapshot::Load(snapshot, restored);
+
+        _VerifyBuffersAreEqual(*original, restored);
+
+        Log::Comment(L"Shrinking a buffer with contents and a cursor below the new height must not leave any of them behind.");
+        TextBuffer larger{ { 80, 60 }, TextAttribute{}, 0, _target };
+        larger.WriteLine(OutputCellIterator{ L"stale text", TextAttribute{ 0x2 } }, { 0, 0 });
+        larger.WriteLine(OutputCellIterator{ L"\xD83D\xDE00 stale glyph" }, { 0, 55 });
+        larger.GetCursor().SetPosition({ 10, 50 });
+        TextBufferSnapshot::Load(snapshot, larger);
+
+        _VerifyBuffersAreEqual(*original, larger);
+    }
+
+    TEST_METHOD(RejectsCorruptSnapshots)
+    {
+        const auto original = _CreateSampleBuffer();
+        const auto snapshot = TextBufferSnapshot::Save(*original);
+        TextBuffer restored{ { 80, 3 }, TextAttribute{}, 0, _target };
+        const auto pristine = TextBufferSnapshot::Save(restored);
+
+        // A failed load must leave the buffer exactly as it was.
+        const auto verifyRejected = [&](const gsl::span<const BYTE> corrupt) {
+            VERIFY_THROWS(TextBufferSnapshot::Load(corrupt, restored), wil::ResultException);
+            VERIFY_IS_TRUE(pristine == TextBufferSnapshot::Save(restored));
+        };
+
+        Log::Comment(L"A truncated snapshot should be rejected.");
+        for (const auto length : { size_t{ 0 }, size_t{ 8 }, snapshot.size() / 2, snapshot.size() - 1 })
+        {
+            verifyRejected({ snapshot.data(), length });
+        }
+
+        Log::Comment(L"So should a snapshot with a different magic number or version.");
+        auto corrupt = snapshot;
+        corrupt[0] ^= 0xff;
+        verifyRejected(corrupt);
+
+        corrupt = snapshot;
+        corrupt[4] ^= 0xff;
+        verifyRejected(corrupt);
+
+        // Row 0 is "red rgb link", which has multiple attribute runs.
+        const auto row0 = sizeof(TextBufferSnapshot::Header);
+        const auto row0Header = _ReadAt<TextBufferSnapshot::RowHeader>(snapshot, row0);
+        const auto row0Cells = row0 + sizeof(TextBufferSnapshot::RowHeader);
+        const auto row0Runs = row0Cells + row0Header.cellCount * sizeof(CharRowCell);
+        VERIFY_IS_TRUE(row0Header.attributeRunCount > 1);
+
+        Log::Comment(L"A color with an invalid type should be rejected.");
+        corrupt = snapshot;
+        corrupt[offsetof(TextBufferSnapshot::Header, currentAttributes) + 3] = 0x7;
+        verifyRejected(corrupt);
+
+        Log::Comment(L"So should a non-RGB color with a non-zero green component.");
+        corrupt = snapshot;
+        corrupt[row0Runs + 1] = 0x12;
+        verifyRejected(corrupt);
+
+        Log::Comment(L"An attribute run must not be empty, even if the row's total width is correct.");
+        corrupt = snapshot;
+        auto run0 = _ReadAt<AttributeRun>(corrupt, row0Runs);
+        auto run1 = _ReadAt<AttributeRun>(corrupt, row0Runs + sizeof(AttributeRun));
+        run1.length += run0.length;
+        run0.length = 0;
+        _WriteAt(corrupt, row0Runs, run0);
+        _WriteAt(corrupt, row0Runs + sizeof(AttributeRun), run1);
+        verifyRejected(corrupt);
+
+        Log::Comment(L"A cell can't be a leading and a trailing half at once.");
+        corrupt = snapshot;
+        corrupt[row0Cells + sizeof(wchar_t)] |= 0x3;
+        verifyRejected(corrupt);
+
+        Log::Comment(L"A cell that claims to have a stored glyph must have one.");
+        corrupt = snapshot;
+        auto cell = _ReadAt<CharRowCell>(corrupt, row0Cells);
+        cell.DbcsAttr().SetGlyphStored(true);
+        _WriteAt(corrupt, row0Cells, cell);
+        verifyRejected(corrupt);
+
+        // Row 1 starts with the emoji, which is stored in the UnicodeStorage.
+        const auto row1 = row0Runs + row0Header.attributeRunCount * sizeof(AttributeRun);
+        const auto row1Header = _ReadAt<TextBufferSnapshot::RowHeader>(snapshot, row1);
+        const auto row1Cells = row1 + sizeof(TextBufferSnapshot::RowHeader);
+        const auto row1Glyph = row1Cells + row1Header.cellCount * sizeof(CharRowCell) + row1Header.attributeRunCount * sizeof(AttributeRun);
+        const auto glyphHeader = _ReadAt<TextBufferSnapshot::GlyphHeader>(snapshot, row1Glyph);
+        VERIFY_IS_TRUE(row1Header.glyphCount > 0);
+        VERIFY_IS_TRUE(glyphHeader.length > 0);
+
+        Log::Comment(L"A stored glyph must belong to a cell that is flagged as such.");
+        corrupt = snapshot;
+        cell = _ReadAt<CharRowCell>(corrupt, row1Cells + glyphHeader.column * sizeof(CharRowCell));
+        cell.DbcsAttr().SetGlyphStored(false);
+        _WriteAt(corrupt, row1Cells + glyphHeader.column * sizeof(CharRowCell), cell);
+        verifyRejected(corrupt);
+
+        Log::Comment(L"A stored glyph must not be empty.");
+        corrupt = snapshot;
+        auto emptyGlyph = glyphHeader;
+        emptyGlyph.length = 0;
+        _WriteAt(corrupt, row1Glyph, emptyGlyph);
+        const auto glyphText = corrupt.begin() + gsl::narrow<ptrdiff_t>(row1Glyph + sizeof(TextBufferSnapshot::GlyphHeader));
+        corrupt.erase(glyphText, glyphText + glyphHeader.length * ptrdiff_t{ sizeof(wchar_t) });
+        verifyRejected(corrupt);
+
+        Log::Comment(L"The buffer should remain usable after a failed load.");
+        TextBufferSnapshot::Load(snapshot, restored);
+        _VerifyBuffersAreEqual(*original, restored);
+    }
+};
+
+        Log::Comment(L"A truncated snapshot should be rejected.");
+        for (const auto length : { size_t{ 0 }, size_t{ 8 }, snapshot.size() / 2, snapshot.size() - 1 })
+        {
+            const gsl::span<const BYTE> truncated{ snapshot.data(), length };
+            VERIFY_THROWS(TextBufferSnapshot::Load(truncated, restored), wil::ResultException);
+        }
+
+        Log::Comment(L"So should a snapshot with a different magic number or version.");
+        auto corrupt = snapshot;
+        corrupt[0] ^= 0xff;
+        VERIFY_THROWS(TextBufferSnapshot::Load(corrupt, restored), wil::ResultException);
+
+        corrupt = snapshot;
+        corrupt[4] ^= 0xff;
+        VERIFY_THROWS(TextBufferSnapshot::Load(corrupt, restored), wil::ResultException);
+
+        Log::Comment(L"The buffer should remain usable after a failed load.");
+        TextBufferSnapshot::Load(snapshot, restored);
+        _VerifyBuffersAreEqual(*original, restored);
+    }
+};
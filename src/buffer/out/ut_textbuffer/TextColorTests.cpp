@@ -22,6 +22,7 @@ class TextColorTests
     TEST_METHOD(TestBrightIndexColor);
     TEST_METHOD(TestRgbColor);
     TEST_METHOD(TestChangeColor);
+    TEST_METHOD(TestEqualityIgnoresStalePayload);
 
     static const int COLOR_TABLE_SIZE = 16;
     COLORREF _colorTable[COLOR_TABLE_SIZE];
@@ -212,3 +213,25 @@ void TextColorTests::TestChangeColor()
     color = rgbColor.GetColor(view, _defaultBg, true);
     VERIFY_ARE_EQUAL(_colorTable[15], color);
 }
+
+void TextColorTests::TestEqualityIgnoresStalePayload()
+{
+    // TextColor is compared bitwise, so changing the type of a color
+    // must not leave any remnants of its previous value behind.
+    TextColor color{ RGB(7, 8, 9) };
+    color.SetDefault();
+    VERIFY_ARE_EQUAL(TextColor{}, color);
+
+    color.SetColor(RGB(7, 8, 9));
+    color.SetIndex(7, false);
+    VERIFY_ARE_EQUAL(TextColor(7, false), color);
+    VERIFY_ARE_NOT_EQUAL(TextColor(7, true), color);
+
+    color.SetIndex(7, true);
+    VERIFY_ARE_EQUAL(TextColor(7, true), color);
+    VERIFY_ARE_EQUAL(7, color.GetIndex());
+
+    color.SetColor(RGB(7, 8, 9));
+    VERIFY_ARE_EQUAL(RGB(7, 8, 9), color.GetRGB());
+    VERIFY_ARE_NOT_EQUAL(TextColor(7, false), color);
+}
@@ -456,22 +456,30 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
                 // else we call convertUTF8ChunkToUTF16 with an empty string_view to convert possible remaining partials to U+FFFD
             }
 
-            const HRESULT result{ til::u8u16(std::string_view{ _buffer.data(), read }, _u16Str, _u8State) };
-            if (FAILED(result))
+            const std::string_view utf8{ _buffer.data(), read };
+
+            // ControlCore parses the UTF-8 output directly. We only need to
+            // convert it to UTF-16 if anyone still listens to TerminalOutput.
+            _u16Str.clear();
+            if (_TerminalOutputHandlers)
             {
-                if (_isStateAtOrBeyond(ConnectionState::Closing))
+                const HRESULT result{ til::u8u16(utf8, _u16Str, _u8State) };
+                if (FAILED(result))
                 {
-                    // This termination was expected.
-                    return 0;
-                }
+                    if (_isStateAtOrBeyond(ConnectionState::Closing))
+                    {
+                        // This termination was expected.
+                        return 0;
+                    }
 
-                // EXIT POINT
-                _indicateExitWithStatus(result); // print a message
-                _transitionToState(ConnectionState::Failed);
-                return gsl::narrow_cast<DWORD>(result);
+                    // EXIT POINT
+                    _indicateExitWithStatus(result); // print a message
+                    _transitionToState(ConnectionState::Failed);
+                    return gsl::narrow_cast<DWORD>(result);
+                }
             }
 
-            if (_u16Str.empty())
+            if (utf8.empty() && _u16Str.empty())
             {
                 return 0;
             }
@@ -493,7 +501,15 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
             }
 
             // Pass the output to our registered event handlers
-            _TerminalOutputHandlers(_u16Str);
+            if (!utf8.empty())
+            {
+#pragma warning(suppress : 26490) // The output is UTF-8 and thus a sequence of bytes.
+                _TerminalOutputUtf8Handlers(winrt::array_view<const uint8_t>{ reinterpret_cast<const uint8_t*>(utf8.data()), gsl::narrow_cast<uint32_t>(utf8.size()) });
+            }
+            if (!_u16Str.empty())
+            {
+                _TerminalOutputHandlers(_u16Str);
+            }
         }
 
         return 0;
@@ -50,6 +50,7 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
         static void NewConnection(winrt::event_token const& token);
 
         WINRT_CALLBACK(TerminalOutput, TerminalOutputHandler);
+        WINRT_CALLBACK(TerminalOutputUtf8, TerminalOutputUtf8Handler);
 
     private:
         HRESULT _LaunchAttachedClient() noexcept;
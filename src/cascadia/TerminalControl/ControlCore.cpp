@@ -44,6 +44,25 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         return initialized;
     }
 
+    // Function Description:
+    // - Makes a diagnostics file path from the environment unique to one control.
+    //   Every pane reads the same environment variable, so without this they'd all
+    //   overwrite each other's file when closed. "C:\logs\locks.txt" becomes
+    //   "C:\logs\locks.1234-5.txt", where 1234 is the process ID and 5 the
+    //   ordinal of the control within that process.
+    // Arguments:
+    // - path: the path given in the environment
+    // - controlId: the ordinal of the control
+    // Return Value:
+    // - The path to write this control's diagnostics to.
+    static std::wstring _perControlDiagnosticsPath(const std::wstring_view path, const uint32_t controlId)
+    {
+        std::filesystem::path result{ path };
+        const auto extension = result.extension();
+        result.replace_filename(fmt::format(L"{}.{}-{}{}", result.stem().native(), GetCurrentProcessId(), controlId, extension.native()));
+        return result.native();
+    }
+
     ControlCore::ControlCore(IControlSettings settings,
                              TerminalConnection::ITerminalConnection connection) :
         _connection{ connection },
@@ -55,13 +74,45 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
         _terminal = std::make_unique<::Microsoft::Terminal::Core::Terminal>();
 
+        static std::atomic<uint32_t> s_nextControlId{ 0 };
+        const auto controlId = ++s_nextControlId;
+
+        // Setting WT_LOCK_DIAGNOSTICS to a file path records how long each call site
+        // waited for and held the terminal lock. The statistics are written to a file
+        // next to it, named after the process and control, when the control is closed.
+        // This is meant for diagnosing stutters under heavy output, and costs next
+        // to nothing when it's unset.
+        if (const auto path = wil::TryGetEnvironmentVariableW(L"WT_LOCK_DIAGNOSTICS"))
+        {
+            _lockDiagnosticsPath = _perControlDiagnosticsPath(path.get(), controlId);
+            _terminal->EnableLockDiagnostics(true);
+        }
+
+        // Similarly, WT_PARSER_INSTRUMENTATION counts and times every VT sequence
+        // the parser handles and writes the totals next to the given file on close.
+        if (const auto path = wil::TryGetEnvironmentVariableW(L"WT_PARSER_INSTRUMENTATION"))
+        {
+            _parserInstrumentationPath = _perControlDiagnosticsPath(path.get(), controlId);
+            _terminal->EnableParserInstrumentation(true);
+        }
+
         // Subscribe to the connection's disconnected event and call our connection closed handlers.
         _connectionStateChangedRevoker = _connection.StateChanged(winrt::auto_revoke, [this](auto&& /*s*/, auto&& /*v*/) {
             _ConnectionStateChangedHandlers(*this, nullptr);
         });
 
+        // Connections like ConptyConnection receive UTF-8, which the Terminal
+        // can parse directly, skipping the conversion to UTF-16.
         // This event is explicitly revoked in the destructor: does not need weak_ref
-        _connectionOutputEventToken = _connection.TerminalOutput({ this, &ControlCore::_connectionOutputHandler });
+        _utf8Connection = _connection.try_as<TerminalConnection::IUtf8TerminalConnection>();
+        if (_utf8Connection)
+        {
+            _connectionOutputEventToken = _utf8Connection.TerminalOutputUtf8({ this, &ControlCore::_connectionOutputUtf8Handler });
+        }
+        else
+        {
+            _connectionOutputEventToken = _connection.TerminalOutput({ this, &ControlCore::_connectionOutputHandler });
+        }
 
         _terminal->SetWriteInputCallback([this](std::wstring& wstr) {
             _sendInputToConnection(wstr);
@@ -335,6 +386,19 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         return _terminal->SendMouseEvent(viewportPos, uiButton, states, wheelDelta, state);
     }
 
+    bool ControlCore::HasPendingMouseMotion() const
+    {
+        return _terminal != nullptr && _terminal->HasPendingMouseMotion();
+    }
+
+    void ControlCore::FlushPendingMouseMotion()
+    {
+        if (_terminal)
+        {
+            _terminal->FlushPendingMouseMotion();
+        }
+    }
+
     void ControlCore::UserScrollViewport(const int viewTop)
     {
         // Clear the regex pattern tree so the renderer does not try to render them while scrolling
@@ -1164,9 +1228,34 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         if (!_closing.exchange(true))
         {
             // Stop accepting new output and state changes before we disconnect everything.
-            _connection.TerminalOutput(_connectionOutputEventToken);
+            if (_utf8Connection)
+            {
+                _utf8Connection.TerminalOutputUtf8(_connectionOutputEventToken);
+            }
+            else
+            {
+                _connection.TerminalOutput(_connectionOutputEventToken);
+            }
             _connectionStateChangedRevoker.revoke();
 
+            if (!_lockDiagnosticsPath.empty())
+            {
+                try
+                {
+                    _terminal->DumpLockDiagnostics(_lockDiagnosticsPath);
+                }
+                CATCH_LOG();
+            }
+
+            if (!_parserInstrumentationPath.empty())
+            {
+                try
+                {
+                    _terminal->DumpParserInstrumentation(_parserInstrumentationPath);
+                }
+                CATCH_LOG();
+            }
+
             // GH#1996 - Close the connection asynchronously on a background
             // thread.
             // Since TermControl::Close is only ever triggered by the UI, we
@@ -1354,4 +1443,15 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         _ReceivedOutputHandlers(*this, nullptr);
     }
 
+    // Method Description:
+    // - Same as _connectionOutputHandler, but for connections that implement
+    //   IUtf8TerminalConnection. The output is parsed as UTF-8 directly.
+    void ControlCore::_connectionOutputUtf8Handler(const winrt::array_view<const uint8_t> utf8)
+    {
+#pragma warning(suppress : 26490) // The parser takes UTF-8 as chars.
+        _terminal->Write(std::string_view{ reinterpret_cast<const char*>(utf8.data()), utf8.size() });
+
+        _ReceivedOutputHandlers(*this, nullptr);
+    }
+
 }
@@ -106,6 +106,8 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                             const ::Microsoft::Terminal::Core::ControlKeyStates states,
                             const short wheelDelta,
                             const ::Microsoft::Console::VirtualTerminal::TerminalInput::MouseButtonState state);
+        bool HasPendingMouseMotion() const;
+        void FlushPendingMouseMotion();
         void UserScrollViewport(const int viewTop);
 #pragma endregion
 
@@ -166,11 +168,19 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         std::atomic<bool> _closing{ false };
 
         TerminalConnection::ITerminalConnection _connection{ nullptr };
+        // Set if the connection provides UTF-8 output. _connectionOutputEventToken
+        // then belongs to its TerminalOutputUtf8 event instead of TerminalOutput.
+        TerminalConnection::IUtf8TerminalConnection _utf8Connection{ nullptr };
         event_token _connectionOutputEventToken;
         TerminalConnection::ITerminalConnection::StateChanged_revoker _connectionStateChangedRevoker;
 
         std::unique_ptr<::Microsoft::Terminal::Core::Terminal> _terminal{ nullptr };
 
+        // Set through the WT_LOCK_DIAGNOSTICS and WT_PARSER_INSTRUMENTATION
+        // environment variables. See the constructor.
+        std::wstring _lockDiagnosticsPath;
+        std::wstring _parserInstrumentationPath;
+
         // NOTE: _renderEngine must be ordered before _renderer.
         //
         // As _renderer has a dependency on _renderEngine (through a raw pointer)
@@ -232,6 +242,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         void _raiseReadOnlyWarning();
         void _updateAntiAliasingMode(::Microsoft::Console::Render::DxEngine* const dxEngine);
         void _connectionOutputHandler(const hstring& hstr);
+        void _connectionOutputUtf8Handler(const winrt::array_view<const uint8_t> utf8);
 
         friend class ControlUnitTests::ControlCoreTests;
         friend class ControlUnitTests::ControlInteractivityTests;
@@ -422,6 +422,25 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             ScrollBar().Visibility(Visibility::Visible);
         }
 
+        // Mouse motion reports that the terminal holds back are flushed once the
+        // coalescing interval elapsed. Without an interval nothing is held back.
+        if (const auto interval = newSettings.MouseMotionCoalescingInterval(); interval > 0)
+        {
+            _flushMouseMotion = std::make_shared<ThrottledFuncTrailing<>>(
+                Dispatcher(),
+                std::chrono::milliseconds{ interval },
+                [weakThis = get_weak()]() {
+                    if (auto control{ weakThis.get() }; !control->_IsClosing())
+                    {
+                        control->_core->FlushPendingMouseMotion();
+                    }
+                });
+        }
+        else
+        {
+            _flushMouseMotion.reset();
+        }
+
         _interactivity->UpdateSettings();
     }
 
@@ -1107,6 +1126,11 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                                          _focused,
                                          pixelPosition);
 
+            if (_flushMouseMotion && _core->HasPendingMouseMotion())
+            {
+                _flushMouseMotion->Run();
+            }
+
             if (_focused && point.Properties().IsLeftButtonPressed())
             {
                 const double cursorBelowBottomDist = cursorPosition.Y - SwapChainPanel().Margin().Top - SwapChainPanel().ActualHeight();
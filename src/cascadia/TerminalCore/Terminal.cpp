@@ -21,16 +21,15 @@ using namespace Microsoft::Console::VirtualTerminal;
 
 using PointTree = interval_tree::IntervalTree<til::point, size_t>;
 
-static std::wstring _KeyEventsToText(std::deque<std::unique_ptr<IInputEvent>>& inEventsToWrite)
+static std::wstring _KeyEventsToText(const gsl::span<const INPUT_RECORD> inEventsToWrite)
 {
-    std::wstring wstr = L"";
+    std::wstring wstr;
+    wstr.reserve(inEventsToWrite.size());
     for (const auto& ev : inEventsToWrite)
     {
-        if (ev->EventType() == InputEventType::KeyEvent)
+        if (ev.EventType == KEY_EVENT)
         {
-            const auto& k = static_cast<KeyEvent&>(*ev);
-            const auto wch = k.GetCharData();
-            wstr += wch;
+            wstr += ev.Event.KeyEvent.uChar.UnicodeChar;
         }
     }
     return wstr;
@@ -59,7 +58,7 @@ Terminal::Terminal() :
 
     _stateMachine = std::make_unique<StateMachine>(std::move(engine));
 
-    auto passAlongInput = [&](std::deque<std::unique_ptr<IInputEvent>>& inEventsToWrite) {
+    auto passAlongInput = [&](const gsl::span<const INPUT_RECORD> inEventsToWrite) {
         if (!_pfnWriteInput)
         {
             return;
@@ -118,6 +117,7 @@ void Terminal::UpdateSettings(ICoreSettings settings)
     _trimBlockSelection = settings.TrimBlockSelection();
 
     _terminalInput->ForceDisableWin32InputMode(settings.ForceVTInput());
+    _terminalInput->SetMouseMotionCoalescing(std::chrono::milliseconds{ settings.MouseMotionCoalescingInterval() });
 
     if (settings.TabColor() == nullptr)
     {
@@ -432,6 +432,20 @@ void Terminal::Write(std::wstring_view stringView)
     _stateMachine->ProcessString(stringView);
 }
 
+// Method Description:
+// - Writes UTF-8 output, like the one read from a ConPTY pipe, through the parser.
+//   This avoids converting the entire string to UTF-16 before parsing it.
+// Arguments:
+// - utf8 - The UTF-8 encoded output. A code point may be split across two calls.
+// Return Value:
+// - <none>
+void Terminal::Write(std::string_view utf8)
+{
+    auto lock = LockForWriting();
+
+    _stateMachine->ProcessString(utf8);
+}
+
 void Terminal::WritePastedText(std::wstring_view stringView)
 {
     auto option = ::Microsoft::Console::Utils::FilterOption::CarriageReturnNewline |
@@ -479,6 +493,29 @@ bool Terminal::IsTrackingMouseInput() const noexcept
     return _terminalInput->IsTrackingMouseInput();
 }
 
+// Routine Description:
+// - Relays if there's a mouse motion report that's being held back by the
+//   motion coalescing, and needs to be flushed once the interval elapsed.
+// Parameters:
+// - <none>
+// Return value:
+// - true, if there's a pending mouse motion report. False, otherwise
+bool Terminal::HasPendingMouseMotion() const noexcept
+{
+    return _terminalInput->HasPendingMouseMotion();
+}
+
+// Routine Description:
+// - Sends the mouse motion report that's being held back, if there is one.
+// Parameters:
+// - <none>
+// Return value:
+// - true, if a report was sent. False, otherwise
+bool Terminal::FlushPendingMouseMotion()
+{
+    return _terminalInput->FlushPendingMouseMotion();
+}
+
 // Method Description:
 // - Given a coord, get the URI at that location
 // Arguments:
@@ -862,23 +899,91 @@ WORD Terminal::_TakeVirtualKeyFromLastKeyEvent(const WORD scanCode) noexcept
 }
 
 // Method Description:
-// - Acquire a read lock on the terminal.
+// - Acquire a read lock on the terminal. Any number of readers may hold
+//   the lock at the same time, but only as long as there's no writer.
+// - Only use this lock if you're not going to modify the terminal's state.
+// Arguments:
+// - site: The caller's location, used for the lock diagnostics. Leave it defaulted.
 // Return Value:
-// - a shared_lock which can be used to unlock the terminal. The shared_lock
-//      will release this lock when it's destructed.
-[[nodiscard]] std::unique_lock<til::ticket_lock> Terminal::LockForReading()
+// - a TerminalReadLock which will release this lock when it's destructed.
+[[nodiscard]] TerminalReadLock Terminal::LockForReading(const LockCallSite& site) noexcept
 {
-    return std::unique_lock{ _readWriteLock };
+    return { _readWriteLock, _lockDiagnostics, site };
 }
 
 // Method Description:
 // - Acquire a write lock on the terminal.
+// Arguments:
+// - site: The caller's location, used for the lock diagnostics. Leave it defaulted.
 // Return Value:
-// - a unique_lock which can be used to unlock the terminal. The unique_lock
-//      will release this lock when it's destructed.
-[[nodiscard]] std::unique_lock<til::ticket_lock> Terminal::LockForWriting()
+// - a TerminalWriteLock which will release this lock when it's destructed.
+[[nodiscard]] TerminalWriteLock Terminal::LockForWriting(const LockCallSite& site) noexcept
 {
-    return std::unique_lock{ _readWriteLock };
+    return { _readWriteLock, _lockDiagnostics, site };
+}
+
+// Method Description:
+// - Enables or disables the gathering of wait and hold times for the terminal lock.
+//   Statistics gathered so far are retained until ResetLockDiagnostics is called.
+void Terminal::EnableLockDiagnostics(const bool enable) noexcept
+{
+    _lockDiagnostics.Enable(enable);
+}
+
+// Method Description:
+// - Returns the lock statistics per call site, most contended first.
+std::vector<LockSiteStatistics> Terminal::GetLockDiagnostics() const
+{
+    return _lockDiagnostics.Snapshot();
+}
+
+// Method Description:
+// - Discards all lock statistics gathered so far.
+void Terminal::ResetLockDiagnostics() noexcept
+{
+    _lockDiagnostics.Reset();
+}
+
+// Method Description:
+// - Writes the lock statistics gathered so far into a text file.
+// Arguments:
+// - path - the file to write. It's replaced if it already exists.
+void Terminal::DumpLockDiagnostics(const std::wstring& path) const
+{
+    _lockDiagnostics.DumpToFile(path);
+}
+
+// Method Description:
+// - Starts or stops collecting per-sequence counts and timings in the parser.
+//   See StateMachine::EnableInstrumentation.
+void Terminal::EnableParserInstrumentation(const bool enable)
+{
+    auto lock = LockForWriting();
+    _stateMachine->EnableInstrumentation(enable);
+}
+
+// Method Description:
+// - Writes the parser statistics gathered so far into a text file.
+//   Does nothing if the parser instrumentation isn't enabled.
+// Arguments:
+// - path - the file to write. It's replaced if it already exists.
+void Terminal::DumpParserInstrumentation(const std::wstring& path)
+{
+    // Copy the statistics and write them out after releasing the lock,
+    // so that the output thread doesn't have to wait for the file I/O.
+    std::optional<ParserInstrumentation> snapshot;
+    {
+        auto lock = LockForReading();
+        if (const auto instrumentation = _stateMachine->GetInstrumentation())
+        {
+            snapshot.emplace(*instrumentation);
+        }
+    }
+
+    if (snapshot)
+    {
+        snapshot->DumpToFile(path);
+    }
 }
 
 Viewport Terminal::_GetMutableViewport() const noexcept
@@ -17,8 +17,7 @@
 #include "../../types/IUiaData.h"
 #include "../../cascadia/terminalcore/ITerminalApi.hpp"
 #include "../../cascadia/terminalcore/ITerminalInput.hpp"
-
-#include <til/ticket_lock.h>
+#include "TerminalLock.hpp"
 
 static constexpr std::wstring_view linkPattern{ LR"(\b(https?|ftp|file)://[-A-Za-z0-9+&@#/%?=~_|$!:,.;]*[A-Za-z0-9+&@#/%=~_|$])" };
 static constexpr size_t TaskbarMinProgress{ 10 };
@@ -75,12 +74,21 @@ public:
 
     // Write goes through the parser
     void Write(std::wstring_view stringView);
+    void Write(std::string_view utf8);
 
     // WritePastedText goes directly to the connection
     void WritePastedText(std::wstring_view stringView);
 
-    [[nodiscard]] std::unique_lock<til::ticket_lock> LockForReading();
-    [[nodiscard]] std::unique_lock<til::ticket_lock> LockForWriting();
+    [[nodiscard]] TerminalReadLock LockForReading(const LockCallSite& site = LockCallSite::Current()) noexcept;
+    [[nodiscard]] TerminalWriteLock LockForWriting(const LockCallSite& site = LockCallSite::Current()) noexcept;
+
+    void EnableLockDiagnostics(const bool enable) noexcept;
+    std::vector<LockSiteStatistics> GetLockDiagnostics() const;
+    void ResetLockDiagnostics() noexcept;
+    void DumpLockDiagnostics(const std::wstring& path) const;
+
+    void EnableParserInstrumentation(const bool enable);
+    void DumpParserInstrumentation(const std::wstring& path);
 
     short GetBufferHeight() const noexcept;
 
@@ -153,6 +161,8 @@ public:
 
     void TrySnapOnInput() override;
     bool IsTrackingMouseInput() const noexcept;
+    bool HasPendingMouseMotion() const noexcept;
+    bool FlushPendingMouseMotion();
 
     std::wstring GetHyperlinkAtPosition(const COORD position);
     uint16_t GetHyperlinkIdAtPosition(const COORD position);
@@ -166,8 +176,10 @@ public:
     const FontInfo& GetFontInfo() noexcept override;
     std::pair<COLORREF, COLORREF> GetAttributeColors(const TextAttribute& attr) const noexcept override;
 
-    void LockConsole() noexcept override;
+    void LockConsole(const LockCallSite& site = LockCallSite::Current()) noexcept override;
     void UnlockConsole() noexcept override;
+    void LockConsoleShared(const LockCallSite& site = LockCallSite::Current()) noexcept override;
+    void UnlockConsoleShared() noexcept override;
 #pragma endregion
 
 #pragma region IRenderData
@@ -253,7 +265,7 @@ private:
     //
     // But we can abuse the fact that the surrounding members rarely change and are huge
     // (std::function is like 64 bytes) to create some natural padding without wasting space.
-    til::ticket_lock _readWriteLock;
+    til::shared_ticket_lock _readWriteLock;
 
     std::function<void(const int, const int, const int)> _pfnScrollPositionChanged;
     std::function<void(const til::color)> _pfnBackgroundColorChanged;
@@ -261,6 +273,12 @@ private:
     std::function<void(const std::optional<til::color>)> _pfnTabColorChanged;
     std::function<void()> _pfnTaskbarProgressChanged;
 
+    // Optional wait/hold time instrumentation for _readWriteLock. See TerminalLock.hpp.
+    LockDiagnostics _lockDiagnostics;
+    LockDiagnostics::clock::time_point _consoleLockAcquired{};
+    LockDiagnostics::clock::duration _consoleLockWait{};
+    LockCallSite _consoleLockSite{};
+
     std::unique_ptr<::Microsoft::Console::VirtualTerminal::StateMachine> _stateMachine;
     std::unique_ptr<::Microsoft::Console::VirtualTerminal::TerminalInput> _terminalInput;
 
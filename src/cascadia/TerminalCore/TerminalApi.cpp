@@ -131,22 +131,11 @@ try
         return false;
     }
 
-    // Get a rectangle of the source
-    auto source = Viewport::FromDimensions(copyFromPos, width, 1);
-
-    // Get a rectangle of the target
-    const auto target = Viewport::FromDimensions(copyToPos, source.Dimensions());
-    const auto walkDirection = Viewport::DetermineWalkDirection(source, target);
-
-    auto sourcePos = source.GetWalkOrigin(walkDirection);
-    auto targetPos = target.GetWalkOrigin(walkDirection);
-
-    // Iterate over the source cell data and copy it over to the target
-    do
+    // Shift the cells to the right of the deleted ones over to the cursor.
+    if (width > 0)
     {
-        const auto data = OutputCell(*(_buffer->GetCellDataAt(sourcePos)));
-        _buffer->Write(OutputCellIterator({ &data, 1 }), targetPos);
-    } while (source.WalkInBounds(sourcePos, walkDirection) && target.WalkInBounds(targetPos, walkDirection));
+        _buffer->CopyRectangle(Viewport::FromDimensions(copyFromPos, width, 1), copyToPos);
+    }
 
     return true;
 }
@@ -164,10 +153,6 @@ CATCH_LOG_RETURN_FALSE()
 bool Terminal::InsertCharacter(const size_t count) noexcept
 try
 {
-    // NOTE: the code below is _extremely_ similar to DeleteCharacter
-    // We will want to use this same logic and implement a helper function instead
-    // that does the 'move a region from here to there' operation
-    // TODO: Github issue #2163
     SHORT dist;
     if (!SUCCEEDED(SizeTToShort(count, &dist)))
     {
@@ -176,30 +161,19 @@ try
     const auto cursorPos = _buffer->GetCursor().GetPosition();
     const auto copyFromPos = cursorPos;
     const COORD copyToPos{ cursorPos.X + dist, cursorPos.Y };
-    const auto sourceWidth = _mutableViewport.RightExclusive() - copyFromPos.X;
+    // Only the cells that still fit into the viewport after the shift are kept.
+    const auto sourceWidth = _mutableViewport.RightExclusive() - copyToPos.X;
     SHORT width;
-    if (!SUCCEEDED(UIntToShort(sourceWidth, &width)))
+    if (!SUCCEEDED(IntToShort(sourceWidth, &width)))
     {
         return false;
     }
 
-    // Get a rectangle of the source
-    auto source = Viewport::FromDimensions(copyFromPos, width, 1);
-    const auto sourceOrigin = source.Origin();
-
-    // Get a rectangle of the target
-    const auto target = Viewport::FromDimensions(copyToPos, source.Dimensions());
-    const auto walkDirection = Viewport::DetermineWalkDirection(source, target);
-
-    auto sourcePos = source.GetWalkOrigin(walkDirection);
-    auto targetPos = target.GetWalkOrigin(walkDirection);
-
-    // Iterate over the source cell data and copy it over to the target
-    do
+    // Shift the cells from the cursor onwards over to the right.
+    if (width > 0)
     {
-        const auto data = OutputCell(*(_buffer->GetCellDataAt(sourcePos)));
-        _buffer->Write(OutputCellIterator({ &data, 1 }), targetPos);
-    } while (source.WalkInBounds(sourcePos, walkDirection) && target.WalkInBounds(targetPos, walkDirection));
+        _buffer->CopyRectangle(Viewport::FromDimensions(copyFromPos, width, 1), copyToPos);
+    }
     const auto eraseIter = OutputCellIterator(UNICODE_SPACE, _buffer->GetCurrentAttributes(), dist);
     _buffer->Write(eraseIter, cursorPos);
 
@@ -214,8 +188,10 @@ try
     const auto viewport = _GetMutableViewport();
     const short distanceToRight = viewport.RightExclusive() - absoluteCursorPos.X;
     const short fillLimit = std::min(static_cast<short>(numChars), distanceToRight);
-    const auto eraseIter = OutputCellIterator(UNICODE_SPACE, _buffer->GetCurrentAttributes(), fillLimit);
-    _buffer->Write(eraseIter, absoluteCursorPos);
+    if (fillLimit > 0)
+    {
+        _buffer->FillRectangle(Viewport::FromDimensions(absoluteCursorPos, fillLimit, 1), UNICODE_SPACE, _buffer->GetCurrentAttributes());
+    }
     return true;
 }
 CATCH_LOG_RETURN_FALSE()
@@ -258,10 +234,8 @@ try
         return false;
     }
 
-    const auto eraseIter = OutputCellIterator(UNICODE_SPACE, _buffer->GetCurrentAttributes(), nlength);
-
-    // Explicitly turn off end-of-line wrap-flag-setting when erasing cells.
-    _buffer->Write(eraseIter, startPos, false);
+    // Filling up to the end of the line also turns off its wrap flag.
+    _buffer->FillRectangle(Viewport::FromDimensions(startPos, gsl::narrow<SHORT>(nlength), 1), UNICODE_SPACE, _buffer->GetCurrentAttributes());
     return true;
 }
 CATCH_LOG_RETURN_FALSE()
@@ -315,20 +289,12 @@ try
     }
     else if (eraseType == DispatchTypes::EraseType::Scrollback)
     {
-        // We only want to erase the scrollback, and leave everything else on the screen as it is
-        // so we grab the text in the viewport and rotate it up to the top of the buffer
+        // We only want to erase the scrollback, and leave everything else on the screen as it is,
+        // so the text in the viewport becomes the top of the buffer and everything else is erased.
+        // The buffer does this lazily, so this doesn't depend on the size of the scrollback.
         COORD scrollFromPos{ 0, 0 };
         _mutableViewport.ConvertFromOrigin(&scrollFromPos);
-        _buffer->ScrollRows(scrollFromPos.Y, _mutableViewport.Height(), -scrollFromPos.Y);
-
-        // Since we only did a rotation, the text that was in the scrollback is now _below_ where we are going to move the viewport
-        // and we have to make sure we erase that text
-        const auto eraseStart = _mutableViewport.Height();
-        const auto eraseEnd = _buffer->GetLastNonSpaceCharacter(_mutableViewport).Y;
-        for (SHORT i = eraseStart; i <= eraseEnd; i++)
-        {
-            _buffer->GetRowByOffset(i).Reset(_buffer->GetCurrentAttributes());
-        }
+        _buffer->ClearScrollback(scrollFromPos.Y, _mutableViewport.Height(), _buffer->GetCurrentAttributes());
 
         // Reset the scroll offset now because there's nothing for the user to 'scroll' to
         _scrollOffset = 0;
@@ -0,0 +1,117 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "pch.h"
+#include "TerminalLock.hpp"
+
+using namespace Microsoft::Terminal::Core;
+
+// Method Description:
+// - Accumulates the wait and hold time of a single lock acquisition.
+// Arguments:
+// - site: The function and line the lock was acquired from.
+// - shared: true if the lock was acquired for reading.
+// - wait: The time spent waiting for the lock.
+// - hold: The time the lock was held for.
+void LockDiagnostics::Record(const LockCallSite& site, const bool shared, const clock::duration wait, const clock::duration hold) noexcept
+try
+{
+    const std::lock_guard guard{ _mutex };
+    auto& counters = _sites[SiteKey{ site.function, site.line, shared }];
+    counters.acquisitions++;
+    counters.totalWait += wait;
+    counters.maxWait = std::max(counters.maxWait, wait);
+    counters.totalHold += hold;
+    counters.maxHold = std::max(counters.maxHold, hold);
+}
+CATCH_LOG()
+
+// Method Description:
+// - Returns a copy of the statistics gathered so far, sorted
+//   by descending total wait time (the most contended site first).
+std::vector<LockSiteStatistics> LockDiagnostics::Snapshot() const
+{
+    std::vector<LockSiteStatistics> result;
+
+    {
+        const std::lock_guard guard{ _mutex };
+        result.reserve(_sites.size());
+
+        for (const auto& [key, counters] : _sites)
+        {
+            auto& stats = result.emplace_back();
+            stats.function = key.function ? key.function : "<unknown>";
+            stats.line = key.line;
+            stats.shared = key.shared;
+            stats.acquisitions = counters.acquisitions;
+            stats.totalWait = std::chrono::duration_cast<std::chrono::nanoseconds>(counters.totalWait);
+            stats.maxWait = std::chrono::duration_cast<std::chrono::nanoseconds>(counters.maxWait);
+            stats.totalHold = std::chrono::duration_cast<std::chrono::nanoseconds>(counters.totalHold);
+            stats.maxHold = std::chrono::duration_cast<std::chrono::nanoseconds>(counters.maxHold);
+        }
+    }
+
+    std::sort(result.begin(), result.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.totalWait > rhs.totalWait;
+    });
+    return result;
+}
+
+// Method Description:
+// - Discards all statistics gathered so far.
+void LockDiagnostics::Reset() noexcept
+{
+    const std::lock_guard guard{ _mutex };
+    _sites.clear();
+}
+
+// Method Description:
+// - Formats the statistics gathered so far as a table, one call site per line.
+// Arguments:
+// - <none>
+// Return Value:
+// - the formatted statistics, most contended call site first
+std::wstring LockDiagnostics::Format() const
+{
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+
+    std::wstring text;
+    auto out = std::back_inserter(text);
+
+    fmt::format_to(out, L"{:<48}{:>6}{:>8}{:>12}{:>16}{:>14}{:>16}{:>14}\n", L"Call site", L"Line", L"Mode", L"Count", L"Wait (us)", L"Max wait", L"Hold (us)", L"Max hold");
+    for (const auto& stats : Snapshot())
+    {
+        fmt::format_to(out,
+                       L"{:<48}{:>6}{:>8}{:>12}{:>16}{:>14}{:>16}{:>14}\n",
+                       til::u8u16(stats.function),
+                       stats.line,
+                       stats.shared ? L"shared" : L"write",
+                       stats.acquisitions,
+                       duration_cast<microseconds>(stats.totalWait).count(),
+                       duration_cast<microseconds>(stats.maxWait).count(),
+                       duration_cast<microseconds>(stats.totalHold).count(),
+                       duration_cast<microseconds>(stats.maxHold).count());
+    }
+
+    return text;
+}
+
+// Method Description:
+// - Writes the formatted statistics into a UTF-8 text file.
+// Arguments:
+// - path - the file to write. It's replaced if it already exists.
+// Return Value:
+// - <none>
+void LockDiagnostics::DumpToFile(const std::wstring& path) const
+{
+    std::string utf8;
+    THROW_IF_FAILED(til::u16u8(Format(), utf8));
+
+    wil::unique_hfile file{ CreateFileW(path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr) };
+    THROW_LAST_ERROR_IF(!file);
+
+    DWORD written = 0;
+    THROW_IF_WIN32_BOOL_FALSE(WriteFile(file.get(), utf8.data(), gsl::narrow<DWORD>(utf8.size()), &written, nullptr));
+    THROW_HR_IF(E_UNEXPECTED, written != utf8.size());
+}
@@ -0,0 +1,208 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+/*++
+Module Name:
+- TerminalLock.hpp
+
+Abstract:
+- The guards returned by Terminal::LockForReading and Terminal::LockForWriting,
+  as well as the optional contention instrumentation for the terminal lock.
+- When enabled, every acquisition records how long the caller waited for the
+  lock and how long it was held, aggregated per call site. This allows us to
+  figure out which path is starving the output thread under load.
+- When disabled, the only overhead is a single relaxed atomic load per acquisition.
+--*/
+
+#pragma once
+
+#include <til/ticket_lock.h>
+#include "../../types/inc/LockCallSite.hpp"
+
+namespace Microsoft::Terminal::Core
+{
+    using LockCallSite = ::Microsoft::Console::Types::LockCallSite;
+
+    struct LockSiteStatistics
+    {
+        std::string function;
+        uint32_t line = 0;
+        bool shared = false;
+        uint64_t acquisitions = 0;
+        std::chrono::nanoseconds totalWait{};
+        std::chrono::nanoseconds maxWait{};
+        std::chrono::nanoseconds totalHold{};
+        std::chrono::nanoseconds maxHold{};
+    };
+
+    class LockDiagnostics
+    {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        void Enable(const bool enable) noexcept
+        {
+            _enabled.store(enable, std::memory_order_relaxed);
+        }
+
+        bool IsEnabled() const noexcept
+        {
+            return _enabled.load(std::memory_order_relaxed);
+        }
+
+        void Record(const LockCallSite& site, const bool shared, const clock::duration wait, const clock::duration hold) noexcept;
+        std::vector<LockSiteStatistics> Snapshot() const;
+        void Reset() noexcept;
+        std::wstring Format() const;
+        void DumpToFile(const std::wstring& path) const;
+
+    private:
+        struct SiteKey
+        {
+            const char* function;
+            uint32_t line;
+            bool shared;
+
+            bool operator==(const SiteKey& other) const noexcept
+            {
+                return function == other.function && line == other.line && shared == other.shared;
+            }
+        };
+
+        struct SiteKeyHash
+        {
+            size_t operator()(const SiteKey& key) const noexcept
+            {
+                // The function name is a string literal, so hashing its address is sufficient.
+                return std::hash<const void*>{}(key.function) ^ (size_t{ key.line } << 1) ^ size_t{ key.shared };
+            }
+        };
+
+        struct SiteCounters
+        {
+            uint64_t acquisitions = 0;
+            clock::duration totalWait{};
+            clock::duration maxWait{};
+            clock::duration totalHold{};
+            clock::duration maxHold{};
+        };
+
+        std::atomic<bool> _enabled{ false };
+        mutable std::mutex _mutex;
+        std::unordered_map<SiteKey, SiteCounters, SiteKeyHash> _sites;
+    };
+
+    // A RAII guard for the terminal's shared_ticket_lock.
+    // Shared == true acquires the lock for reading, false acquires it exclusively.
+    template<bool Shared>
+    class [[nodiscard]] TerminalLockGuard
+    {
+    public:
+        TerminalLockGuard(til::shared_ticket_lock& lock, LockDiagnostics& diagnostics, const LockCallSite& site) noexcept :
+            _lock{ &lock },
+            _site{ site }
+        {
+            if (diagnostics.IsEnabled())
+            {
+                const auto start = LockDiagnostics::clock::now();
+                _acquire();
+                _acquired = LockDiagnostics::clock::now();
+                _wait = _acquired - start;
+                _diagnostics = &diagnostics;
+            }
+            else
+            {
+                _acquire();
+            }
+        }
+
+        TerminalLockGuard(const TerminalLockGuard&) = delete;
+        TerminalLockGuard& operator=(const TerminalLockGuard&) = delete;
+
+        TerminalLockGuard(TerminalLockGuard&& other) noexcept :
+            _lock{ std::exchange(other._lock, nullptr) },
+            _diagnostics{ std::exchange(other._diagnostics, nullptr) },
+            _site{ other._site },
+            _acquired{ other._acquired },
+            _wait{ other._wait }
+        {
+        }
+
+        TerminalLockGuard& operator=(TerminalLockGuard&& other) noexcept
+        {
+            if (this != &other)
+            {
+                unlock();
+                _lock = std::exchange(other._lock, nullptr);
+                _diagnostics = std::exchange(other._diagnostics, nullptr);
+                _site = other._site;
+                _acquired = other._acquired;
+                _wait = other._wait;
+            }
+            return *this;
+        }
+
+        ~TerminalLockGuard()
+        {
+            unlock();
+        }
+
+        void unlock() noexcept
+        {
+            if (!_lock)
+            {
+                return;
+            }
+
+            if (_diagnostics)
+            {
+                // Stop the clock before releasing the lock, but record the
+                // statistics afterwards so that they don't inflate the hold time.
+                const auto hold = LockDiagnostics::clock::now() - _acquired;
+                _release();
+                _diagnostics->Record(_site, Shared, _wait, hold);
+                _diagnostics = nullptr;
+            }
+            else
+            {
+                _release();
+            }
+
+            _lock = nullptr;
+        }
+
+    private:
+        void _acquire() noexcept
+        {
+            if constexpr (Shared)
+            {
+                _lock->lock_shared();
+            }
+            else
+            {
+                _lock->lock();
+            }
+        }
+
+        void _release() noexcept
+        {
+            if constexpr (Shared)
+            {
+                _lock->unlock_shared();
+            }
+            else
+            {
+                _lock->unlock();
+            }
+        }
+
+        til::shared_ticket_lock* _lock = nullptr;
+        LockDiagnostics* _diagnostics = nullptr;
+        LockCallSite _site;
+        LockDiagnostics::clock::time_point _acquired{};
+        LockDiagnostics::clock::duration _wait{};
+    };
+
+    using TerminalReadLock = TerminalLockGuard<true>;
+    using TerminalWriteLock = TerminalLockGuard<false>;
+}
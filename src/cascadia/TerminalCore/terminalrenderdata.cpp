@@ -8,6 +8,13 @@ using namespace Microsoft::Terminal::Core;
 using namespace Microsoft::Console::Types;
 using namespace Microsoft::Console::Render;
 
+// The shared console lock may be held by multiple threads at once, which is why,
+// unlike _consoleLockAcquired/_consoleLockWait, its diagnostics are tracked per thread.
+// The lock isn't recursive, so a thread holds at most one shared console lock at a time.
+static thread_local LockDiagnostics::clock::time_point s_sharedConsoleLockAcquired{};
+static thread_local LockDiagnostics::clock::duration s_sharedConsoleLockWait{};
+static thread_local LockCallSite s_sharedConsoleLockSite{};
+
 Viewport Terminal::GetViewport() noexcept
 {
     return _GetVisibleViewport();
@@ -223,21 +230,92 @@ catch (...)
 }
 
 // Method Description:
-// - Lock the terminal for reading the contents of the buffer. Ensures that the
-//      contents of the terminal won't be changed in the middle of a paint
-//      operation.
+// - Lock the terminal exclusively. This is used by the UIA calls that modify
+//      the terminal's state through this interface, like selecting a text
+//      range or scrolling it into view.
 //   Callers should make sure to also call Terminal::UnlockConsole once
-//      they're done with any querying they need to do.
-void Terminal::LockConsole() noexcept
+//      they're done.
+// Arguments:
+// - site: The caller's location, used for the lock diagnostics. Leave it defaulted.
+void Terminal::LockConsole(const LockCallSite& site) noexcept
 {
-    _readWriteLock.lock();
+    if (_lockDiagnostics.IsEnabled())
+    {
+        const auto start = LockDiagnostics::clock::now();
+        _readWriteLock.lock();
+        _consoleLockAcquired = LockDiagnostics::clock::now();
+        _consoleLockWait = _consoleLockAcquired - start;
+        _consoleLockSite = site;
+    }
+    else
+    {
+        _readWriteLock.lock();
+        _consoleLockAcquired = {};
+    }
 }
 
 // Method Description:
 // - Unlocks the terminal after a call to Terminal::LockConsole.
 void Terminal::UnlockConsole() noexcept
 {
-    _readWriteLock.unlock();
+    // _consoleLockAcquired is only set if the diagnostics
+    // were enabled at the time LockConsole was called.
+    if (_consoleLockAcquired != LockDiagnostics::clock::time_point{})
+    {
+        const auto hold = LockDiagnostics::clock::now() - _consoleLockAcquired;
+        const auto wait = _consoleLockWait;
+        const auto site = _consoleLockSite;
+        _readWriteLock.unlock();
+        _lockDiagnostics.Record(site, false, wait, hold);
+    }
+    else
+    {
+        _readWriteLock.unlock();
+    }
+}
+
+// Method Description:
+// - Lock the terminal for reading the contents of the buffer. Ensures that the
+//      contents of the terminal won't be changed in the middle of a paint
+//      operation, while still allowing the renderer and UIA queries to read
+//      the terminal concurrently.
+//   Callers should make sure to also call Terminal::UnlockConsoleShared once
+//      they're done with any querying they need to do.
+// Arguments:
+// - site: The caller's location, used for the lock diagnostics. Leave it defaulted.
+void Terminal::LockConsoleShared(const LockCallSite& site) noexcept
+{
+    if (_lockDiagnostics.IsEnabled())
+    {
+        const auto start = LockDiagnostics::clock::now();
+        _readWriteLock.lock_shared();
+        s_sharedConsoleLockAcquired = LockDiagnostics::clock::now();
+        s_sharedConsoleLockWait = s_sharedConsoleLockAcquired - start;
+        s_sharedConsoleLockSite = site;
+    }
+    else
+    {
+        _readWriteLock.lock_shared();
+        s_sharedConsoleLockAcquired = {};
+    }
+}
+
+// Method Description:
+// - Unlocks the terminal after a call to Terminal::LockConsoleShared.
+void Terminal::UnlockConsoleShared() noexcept
+{
+    if (s_sharedConsoleLockAcquired != LockDiagnostics::clock::time_point{})
+    {
+        const auto hold = LockDiagnostics::clock::now() - s_sharedConsoleLockAcquired;
+        const auto wait = s_sharedConsoleLockWait;
+        s_sharedConsoleLockAcquired = {};
+        _readWriteLock.unlock_shared();
+        _lockDiagnostics.Record(s_sharedConsoleLockSite, true, wait, hold);
+    }
+    else
+    {
+        _readWriteLock.unlock_shared();
+    }
 }
 
 // Method Description:
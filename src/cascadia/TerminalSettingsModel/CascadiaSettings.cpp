@@ -327,6 +327,7 @@ winrt::Microsoft::Terminal::Settings::Model::Profile CascadiaSettings::Duplicate
     DUPLICATE_SETTING_MACRO(HistorySize);
     DUPLICATE_SETTING_MACRO(SnapOnInput);
     DUPLICATE_SETTING_MACRO(AltGrAliasing);
+    DUPLICATE_SETTING_MACRO(MouseMotionCoalescingInterval);
     DUPLICATE_SETTING_MACRO(BellStyle);
 
     {
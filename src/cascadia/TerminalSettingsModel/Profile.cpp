@@ -32,6 +32,7 @@ static constexpr std::string_view SuppressApplicationTitleKey{ "suppressApplicat
 static constexpr std::string_view HistorySizeKey{ "historySize" };
 static constexpr std::string_view SnapOnInputKey{ "snapOnInput" };
 static constexpr std::string_view AltGrAliasingKey{ "altGrAliasing" };
+static constexpr std::string_view MouseMotionCoalescingIntervalKey{ "experimental.mouseMotionCoalescingInterval" };
 
 static constexpr std::string_view ConnectionTypeKey{ "connectionType" };
 static constexpr std::string_view CommandlineKey{ "commandline" };
@@ -105,6 +106,7 @@ winrt::com_ptr<Profile> Profile::CopySettings(winrt::com_ptr<Profile> source)
     profile->_HistorySize = source->_HistorySize;
     profile->_SnapOnInput = source->_SnapOnInput;
     profile->_AltGrAliasing = source->_AltGrAliasing;
+    profile->_MouseMotionCoalescingInterval = source->_MouseMotionCoalescingInterval;
     profile->_BellStyle = source->_BellStyle;
     profile->_ConnectionType = source->_ConnectionType;
     profile->_Origin = source->_Origin;
@@ -352,6 +354,7 @@ void Profile::LayerJson(const Json::Value& json)
     JsonUtils::GetValueForKey(json, HistorySizeKey, _HistorySize);
     JsonUtils::GetValueForKey(json, SnapOnInputKey, _SnapOnInput);
     JsonUtils::GetValueForKey(json, AltGrAliasingKey, _AltGrAliasing);
+    JsonUtils::GetValueForKey(json, MouseMotionCoalescingIntervalKey, _MouseMotionCoalescingInterval);
     JsonUtils::GetValueForKey(json, TabTitleKey, _TabTitle);
 
     // Control Settings
@@ -549,6 +552,7 @@ Json::Value Profile::ToJson() const
     JsonUtils::SetValueForKey(json, HistorySizeKey, _HistorySize);
     JsonUtils::SetValueForKey(json, SnapOnInputKey, _SnapOnInput);
     JsonUtils::SetValueForKey(json, AltGrAliasingKey, _AltGrAliasing);
+    JsonUtils::SetValueForKey(json, MouseMotionCoalescingIntervalKey, _MouseMotionCoalescingInterval);
     JsonUtils::SetValueForKey(json, TabTitleKey, _TabTitle);
 
     // Control Settings
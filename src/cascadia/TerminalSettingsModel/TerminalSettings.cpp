@@ -270,6 +270,7 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         _HistorySize = profile.HistorySize();
         _SnapOnInput = profile.SnapOnInput();
         _AltGrAliasing = profile.AltGrAliasing();
+        _MouseMotionCoalescingInterval = profile.MouseMotionCoalescingInterval();
 
         // Fill in the remaining properties from the profile
         _ProfileName = profile.Name();
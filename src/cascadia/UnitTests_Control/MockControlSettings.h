@@ -27,6 +27,7 @@ namespace ControlUnitTests
 
         WINRT_PROPERTY(bool, SnapOnInput, true);
         WINRT_PROPERTY(bool, AltGrAliasing, true);
+        WINRT_PROPERTY(int32_t, MouseMotionCoalescingInterval, 0);
         WINRT_PROPERTY(til::color, CursorColor, DEFAULT_CURSOR_COLOR);
         WINRT_PROPERTY(winrt::Microsoft::Terminal::Core::CursorStyle, CursorShape, winrt::Microsoft::Terminal::Core::CursorStyle::Vintage);
         WINRT_PROPERTY(uint32_t, CursorHeight, DEFAULT_CURSOR_HEIGHT);
@@ -30,6 +30,7 @@ namespace TerminalCoreUnitTests
         til::color DefaultBackground() { return COLOR_BLACK; }
         bool SnapOnInput() { return false; }
         bool AltGrAliasing() { return true; }
+        int32_t MouseMotionCoalescingInterval() { return 0; }
         til::color CursorColor() { return COLOR_WHITE; }
         CursorStyle CursorShape() const noexcept { return CursorStyle::Vintage; }
         uint32_t CursorHeight() { return 42UL; }
@@ -57,6 +58,7 @@ namespace TerminalCoreUnitTests
         void DefaultBackground(til::color) {}
         void SnapOnInput(bool) {}
         void AltGrAliasing(bool) {}
+        void MouseMotionCoalescingInterval(int32_t) {}
         void CursorColor(til::color) {}
         void CursorShape(CursorStyle const&) noexcept {}
         void CursorHeight(uint32_t) {}
@@ -0,0 +1,191 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "pch.h"
+#include <WexTestClass.h>
+
+#include "../cascadia/TerminalCore/Terminal.hpp"
+#include "../renderer/inc/DummyRenderTarget.hpp"
+
+using namespace Microsoft::Terminal::Core;
+using namespace std::chrono_literals;
+
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+namespace TerminalCoreUnitTests
+{
+    class TerminalLockTests
+    {
+        BEGIN_TEST_CLASS(TerminalLockTests)
+            TEST_CLASS_PROPERTY(L"TestTimeout", L"0:0:10") // 10s timeout
+        END_TEST_CLASS()
+
+        TEST_METHOD(DiagnosticsAreOptIn);
+        TEST_METHOD(DiagnosticsCountPerCallSite);
+        TEST_METHOD(SharedConsoleLockAllowsConcurrentReaders);
+    };
+};
+
+using namespace TerminalCoreUnitTests;
+
+static const LockSiteStatistics* findSite(const std::vector<LockSiteStatistics>& stats, const std::string_view function)
+{
+    const auto it = std::find_if(stats.begin(), stats.end(), [&](const auto& s) { return s.function == function; });
+    return it == stats.end() ? nullptr : &*it;
+}
+
+void TerminalLockTests::DiagnosticsAreOptIn()
+{
+    Terminal term;
+    DummyRenderTarget emptyRT;
+    term.Create({ 80, 32 }, 0, emptyRT);
+
+    {
+        auto lock = term.LockForReading();
+    }
+    {
+        auto lock = term.LockForWriting();
+    }
+    VERIFY_IS_TRUE(term.GetLockDiagnostics().empty());
+
+    term.EnableLockDiagnostics(true);
+    {
+        auto lock = term.LockForWriting();
+    }
+    VERIFY_ARE_EQUAL(1u, term.GetLockDiagnostics().size());
+
+    Log::Comment(L"Disabling the diagnostics retains the statistics, but stops gathering new ones.");
+    term.EnableLockDiagnostics(false);
+    {
+        auto lock = term.LockForReading();
+    }
+    VERIFY_ARE_EQUAL(1u, term.GetLockDiagnostics().size());
+
+    term.ResetLockDiagnostics();
+    VERIFY_IS_TRUE(term.GetLockDiagnostics().empty());
+}
+
+void TerminalLockTests::DiagnosticsCountPerCallSite()
+{
+    // This uses the guards with a lock of its own (instead of a Terminal),
+    // so that it can look at the lock's state while another thread waits for it.
+    til::shared_ticket_lock lock;
+    LockDiagnostics diagnostics;
+    diagnostics.Enable(true);
+
+    constexpr LockCallSite readSite{ "ReadSite", 10 };
+    constexpr LockCallSite holdSite{ "HoldSite", 20 };
+    constexpr LockCallSite waitSite{ "WaitSite", 30 };
+    constexpr auto holdTime = 50ms;
+
+    for (auto i = 0; i < 3; ++i)
+    {
+        TerminalReadLock guard{ lock, diagnostics, readSite };
+    }
+
+    Log::Comment(L"Hold the lock while another thread waits for it.");
+    {
+        TerminalReadLock guard{ lock, diagnostics, holdSite };
+
+        std::thread waiter{ [&]() {
+            TerminalWriteLock waiterGuard{ lock, diagnostics, waitSite };
+        } };
+
+        // Once the waiter blocks on us, it turns away any new readers.
+        // Its clock is already running at that point, so it's
+        // going to wait for at least the entire holdTime.
+        while (lock.try_lock_shared())
+        {
+            lock.unlock_shared();
+            std::this_thread::yield();
+        }
+        std::this_thread::sleep_for(holdTime);
+
+        guard.unlock();
+        waiter.join();
+    }
+
+    const auto stats = diagnostics.Snapshot();
+    VERIFY_ARE_EQUAL(3u, stats.size());
+
+    const auto read = findSite(stats, readSite.function);
+    VERIFY_IS_NOT_NULL(read);
+    VERIFY_ARE_EQUAL(readSite.line, read->line);
+    VERIFY_IS_TRUE(read->shared);
+    VERIFY_ARE_EQUAL(3u, read->acquisitions);
+    VERIFY_IS_TRUE(read->maxWait <= read->totalWait);
+    VERIFY_IS_TRUE(read->maxHold <= read->totalHold);
+
+    const auto hold = findSite(stats, holdSite.function);
+    VERIFY_IS_NOT_NULL(hold);
+    VERIFY_IS_TRUE(hold->shared);
+    VERIFY_ARE_EQUAL(1u, hold->acquisitions);
+    VERIFY_IS_TRUE(hold->maxHold >= holdTime);
+    VERIFY_IS_TRUE(hold->maxHold == hold->totalHold);
+
+    const auto wait = findSite(stats, waitSite.function);
+    VERIFY_IS_NOT_NULL(wait);
+    VERIFY_IS_FALSE(wait->shared);
+    VERIFY_ARE_EQUAL(1u, wait->acquisitions);
+    VERIFY_IS_TRUE(wait->maxWait >= holdTime);
+    VERIFY_IS_TRUE(wait->maxWait == wait->totalWait);
+
+    Log::Comment(L"The most contended call site is reported first.");
+    VERIFY_IS_TRUE(stats.front().function == waitSite.function);
+}
+
+void TerminalLockTests::SharedConsoleLockAllowsConcurrentReaders()
+{
+    Terminal term;
+    DummyRenderTarget emptyRT;
+    term.Create({ 80, 32 }, 0, emptyRT);
+    term.EnableLockDiagnostics(true);
+
+    constexpr LockCallSite paintSite{ "PaintSite", 10 };
+    constexpr LockCallSite uiaSite{ "UiaSite", 20 };
+    constexpr LockCallSite selectSite{ "SelectSite", 30 };
+
+    // This is what the renderer and UIA use. A second reader must not have to
+    // wait for the first one. If it does, we give up after a while and release
+    // our lock, so that the reader can finish and the test fails instead of hanging.
+    term.LockConsoleShared(paintSite);
+    std::atomic<bool> acquired{ false };
+    std::thread reader{ [&]() {
+        term.LockConsoleShared(uiaSite);
+        acquired.store(true);
+        term.UnlockConsoleShared();
+    } };
+
+    const auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (!acquired.load() && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::yield();
+    }
+    const auto acquiredConcurrently = acquired.load();
+
+    term.UnlockConsoleShared();
+    reader.join();
+    VERIFY_IS_TRUE(acquiredConcurrently);
+
+    term.LockConsole(selectSite);
+    term.UnlockConsole();
+
+    Log::Comment(L"Each acquisition is attributed to the call site that was passed in.");
+    const auto stats = term.GetLockDiagnostics();
+    VERIFY_ARE_EQUAL(3u, stats.size());
+
+    for (const auto& site : { paintSite, uiaSite })
+    {
+        const auto shared = findSite(stats, site.function);
+        VERIFY_IS_NOT_NULL(shared);
+        VERIFY_ARE_EQUAL(site.line, shared->line);
+        VERIFY_IS_TRUE(shared->shared);
+        VERIFY_ARE_EQUAL(1u, shared->acquisitions);
+    }
+
+    const auto exclusive = findSite(stats, selectSite.function);
+    VERIFY_IS_NOT_NULL(exclusive);
+    VERIFY_IS_FALSE(exclusive->shared);
+    VERIFY_ARE_EQUAL(1u, exclusive->acquisitions);
+}
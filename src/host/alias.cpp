@@ -4,6 +4,7 @@
 #include "precomp.h"
 
 #include "alias.h"
+#include "caseInsensitiveMap.h"
 
 #include "_output.h"
 #include "output.h"
@@ -24,33 +25,8 @@
 
 using Microsoft::Console::Interactivity::ServiceLocator;
 
-struct case_insensitive_hash
-{
-    std::size_t operator()(const std::wstring& key) const
-    {
-        std::wstring lower(key);
-        std::transform(lower.begin(), lower.end(), lower.begin(), ::towlower);
-        std::hash<std::wstring> hash;
-        return hash(lower);
-    }
-};
-
-struct case_insensitive_equality
-{
-    bool operator()(const std::wstring& lhs, const std::wstring& rhs) const
-    {
-        return 0 == _wcsicmp(lhs.data(), rhs.data());
-    }
-};
-
-std::unordered_map<std::wstring,
-                   std::unordered_map<std::wstring,
-                                      std::wstring,
-                                      case_insensitive_hash,
-                                      case_insensitive_equality>,
-                   case_insensitive_hash,
-                   case_insensitive_equality>
-    g_aliasData;
+// Maps exe names to their aliases and those to their targets.
+CaseInsensitiveMap<CaseInsensitiveMap<std::wstring>> g_aliasData;
 
 // Routine Description:
 // - Adds a command line alias to the global set.
@@ -98,26 +74,19 @@ std::unordered_map<std::wstring,
 
     try
     {
-        std::wstring exeNameString(exeName);
-        std::wstring sourceString(source);
-        std::wstring targetString(target);
-
-        std::transform(exeNameString.begin(), exeNameString.end(), exeNameString.begin(), towlower);
-        std::transform(sourceString.begin(), sourceString.end(), sourceString.begin(), towlower);
-
-        if (targetString.size() == 0)
+        if (target.size() == 0)
         {
             // Only try to dig in and erase if the exeName exists.
-            auto exeData = g_aliasData.find(exeNameString);
-            if (exeData != g_aliasData.end())
+            const auto exeData = g_aliasData.find(exeName);
+            if (exeData)
             {
-                g_aliasData[exeNameString].erase(sourceString);
+                exeData->erase(source);
             }
         }
         else
         {
-            // Map will auto-create each level as necessary
-            g_aliasData[exeNameString][sourceString] = targetString;
+            // Map will auto-create each level as necessary (and lowercase the names)
+            g_aliasData[exeName][source] = target;
         }
     }
     CATCH_RETURN();
@@ -152,17 +121,13 @@ std::unordered_map<std::wstring,
         til::at(*target, 0) = UNICODE_NULL;
     }
 
-    std::wstring exeNameString(exeName);
-    std::wstring sourceString(source);
-
     // For compatibility, return ERROR_GEN_FAILURE for any result where the alias can't be found.
-    // We use .find for the iterators then dereference to search without creating entries.
-    const auto exeIter = g_aliasData.find(exeNameString);
-    RETURN_HR_IF(HRESULT_FROM_WIN32(ERROR_GEN_FAILURE), exeIter == g_aliasData.end());
-    const auto exeData = exeIter->second;
-    const auto sourceIter = exeData.find(sourceString);
-    RETURN_HR_IF(HRESULT_FROM_WIN32(ERROR_GEN_FAILURE), sourceIter == exeData.end());
-    const auto targetString = sourceIter->second;
+    // We use .find to search without creating entries.
+    const auto exeData = g_aliasData.find(exeName);
+    RETURN_HR_IF(HRESULT_FROM_WIN32(ERROR_GEN_FAILURE), !exeData);
+    const auto sourceData = exeData->find(source);
+    RETURN_HR_IF(HRESULT_FROM_WIN32(ERROR_GEN_FAILURE), !sourceData);
+    const auto& targetString = *sourceData;
     RETURN_HR_IF(HRESULT_FROM_WIN32(ERROR_GEN_FAILURE), targetString.size() == 0);
 
     // TargetLength is a byte count, convert to characters.
@@ -318,8 +283,6 @@ static std::wstring aliasesSeparator(L"=");
 
     try
     {
-        const std::wstring exeNameString(exeName);
-
         size_t cchNeeded = 0;
 
         // Each of the aliases will be made up of the source, a separator, the target, then a null character.
@@ -333,21 +296,22 @@ static std::wstring aliasesSeparator(L"=");
         }
 
         // Find without creating.
-        auto exeIter = g_aliasData.find(exeNameString);
-        if (exeIter != g_aliasData.end())
+        const auto list = g_aliasData.find(exeName);
+        if (list)
         {
-            auto list = exeIter->second;
-            for (auto& pair : list)
+            for (const auto& pair : *list)
             {
+                const auto& target = pair.second->value;
+
                 // Alias stores lengths in bytes.
                 size_t cchSource = pair.first.size();
-                size_t cchTarget = pair.second.size();
+                size_t cchTarget = target.size();
 
                 // If we're counting how much multibyte space will be needed, trial convert the source and target strings before we add.
                 if (!countInUnicode)
                 {
                     cchSource = GetALengthFromW(codepage, pair.first);
-                    cchTarget = GetALengthFromW(codepage, pair.second);
+                    cchTarget = GetALengthFromW(codepage, target);
                 }
 
                 // Accumulate all sizes to the final string count.
@@ -421,10 +385,10 @@ static std::wstring aliasesSeparator(L"=");
 void Alias::s_ClearCmdExeAliases()
 {
     // find without creating.
-    auto exeIter = g_aliasData.find(L"cmd.exe");
-    if (exeIter != g_aliasData.end())
+    const auto exeData = g_aliasData.find(L"cmd.exe");
+    if (exeData)
     {
-        exeIter->second.clear();
+        exeData->clear();
     }
 }
 
@@ -454,8 +418,6 @@ void Alias::s_ClearCmdExeAliases()
         til::at(*aliasBuffer, 0) = UNICODE_NULL;
     }
 
-    std::wstring exeNameString(exeName);
-
     LPWSTR AliasesBufferPtrW = aliasBuffer.has_value() ? aliasBuffer->data() : nullptr;
     size_t cchTotalLength = 0; // accumulate the characters we need/have copied as we walk the list
 
@@ -464,15 +426,16 @@ void Alias::s_ClearCmdExeAliases()
     size_t const cchNull = 1;
 
     // Find without creating.
-    auto exeIter = g_aliasData.find(exeNameString);
-    if (exeIter != g_aliasData.end())
+    const auto list = g_aliasData.find(exeName);
+    if (list)
     {
-        auto list = exeIter->second;
-        for (auto& pair : list)
+        for (const auto& pair : *list)
         {
+            const auto& target = pair.second->value;
+
             // Alias stores lengths in bytes.
             size_t const cchSource = pair.first.size();
-            size_t const cchTarget = pair.second.size();
+            size_t const cchTarget = target.size();
 
             // Add up how many characters we will need for the full alias data.
             size_t cchNeeded = 0;
@@ -502,7 +465,7 @@ void Alias::s_ClearCmdExeAliases()
                 RETURN_IF_FAILED(SizeTSub(cchAliasBufferRemaining, aliasesSeparator.size(), &cchAliasBufferRemaining));
                 AliasesBufferPtrW += aliasesSeparator.size();
 
-                RETURN_IF_FAILED(StringCchCopyNW(AliasesBufferPtrW, cchAliasBufferRemaining, pair.second.data(), cchTarget));
+                RETURN_IF_FAILED(StringCchCopyNW(AliasesBufferPtrW, cchAliasBufferRemaining, target.data(), cchTarget));
                 RETURN_IF_FAILED(SizeTSub(cchAliasBufferRemaining, cchTarget, &cchAliasBufferRemaining));
                 AliasesBufferPtrW += cchTarget;
 
@@ -1145,54 +1108,53 @@ std::wstring Alias::s_MatchAndCopyAlias(const std::wstring& sourceText,
                                         const std::wstring& exeName,
                                         size_t& lineCount)
 {
-    // Copy source text into a local for manipulation.
-    std::wstring sourceCopy(sourceText);
-
-    // Trim trailing \r\n off of sourceCopy if it has one.
-    s_TrimTrailingCrLf(sourceCopy);
-
-    // Trim leading spaces off of sourceCopy if it has any.
-    s_TrimLeadingSpaces(sourceCopy);
-
     // Check if we have an EXE in the list that matches the request first.
-    auto exeIter = g_aliasData.find(exeName);
-    if (exeIter == g_aliasData.end())
+    const auto exeList = g_aliasData.find(exeName);
+    if (!exeList)
     {
         // We found no data for this exe. Give back an empty string.
         return std::wstring();
     }
 
-    auto exeList = exeIter->second;
-    if (exeList.size() == 0)
+    if (exeList->size() == 0)
     {
         // If there's no match, give back an empty string.
         return std::wstring();
     }
 
-    // Tokenize the text by spaces
-    const auto tokens = s_Tokenize(sourceCopy);
-
-    // If there are no tokens, return an empty string
-    if (tokens.size() == 0)
-    {
-        return std::wstring();
-    }
+    // Most lines don't start with an alias, so find the first word of the line
+    // (trimmed just like below) and look it up before copying and tokenizing it.
+    std::wstring_view line{ sourceText };
+    line = line.substr(0, line.find_last_of(UNICODE_CARRIAGERETURN));
+    const auto firstNonSpace = std::find_if(line.begin(), line.end(), [](wchar_t ch) { return !std::iswspace(ch); });
+    line.remove_prefix(gsl::narrow_cast<size_t>(firstNonSpace - line.begin()));
 
     // Find alias. If there isn't one, return an empty string
-    const auto alias = tokens.front();
-    const auto aliasIter = exeList.find(alias);
-    if (aliasIter == exeList.end())
+    const auto aliasData = exeList->find(line.substr(0, line.find(L' ')));
+    if (!aliasData)
     {
         // We found no alias pair with this name. Give back an empty string.
         return std::wstring();
     }
 
-    const auto target = aliasIter->second;
+    const auto& target = *aliasData;
     if (target.size() == 0)
     {
         return std::wstring();
     }
 
+    // Copy source text into a local for manipulation.
+    std::wstring sourceCopy(sourceText);
+
+    // Trim trailing \r\n off of sourceCopy if it has one.
+    s_TrimTrailingCrLf(sourceCopy);
+
+    // Trim leading spaces off of sourceCopy if it has any.
+    s_TrimLeadingSpaces(sourceCopy);
+
+    // Tokenize the text by spaces
+    const auto tokens = s_Tokenize(sourceCopy);
+
     // Get the string of all parameters as a shorthand for $* later.
     const auto allParams = s_GetArgString(sourceCopy);
 
@@ -0,0 +1,124 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- caseInsensitiveMap.h
+
+Abstract:
+- A hash map with case-insensitive names as its keys. It holds the command aliases.
+- The names are lowercased once, when they're added. Lookups hash and compare the
+  given std::wstring_view in place, so that looking up the first word of every line
+  that's read doesn't have to copy it into a lowercase std::wstring first.
+--*/
+
+#pragma once
+
+template<typename T>
+class CaseInsensitiveMap
+{
+    struct Entry
+    {
+        std::wstring name;
+        T value;
+    };
+
+    struct Hash
+    {
+        size_t operator()(const std::wstring_view name) const noexcept
+        {
+            // FNV-1a over the lowercase characters.
+            auto hash = static_cast<size_t>(14695981039346656037ull);
+            for (const auto ch : name)
+            {
+                hash ^= s_Fold(ch);
+                hash *= static_cast<size_t>(1099511628211ull);
+            }
+            return hash;
+        }
+    };
+
+    struct Equality
+    {
+        bool operator()(const std::wstring_view lhs, const std::wstring_view rhs) const noexcept
+        {
+            return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), [](const wchar_t a, const wchar_t b) {
+                return s_Fold(a) == s_Fold(b);
+            });
+        }
+    };
+
+    // The keys point at the name in their Entry. The entries are
+    // allocated on their own, so that they don't move on a rehash.
+    using Map = std::unordered_map<std::wstring_view, std::unique_ptr<Entry>, Hash, Equality>;
+
+public:
+    using const_iterator = typename Map::const_iterator;
+
+    static wchar_t s_Fold(const wchar_t ch) noexcept
+    {
+        return ch < 0x80 ? til::tolower_ascii(ch) : gsl::narrow_cast<wchar_t>(::towlower(ch));
+    }
+
+    T* find(const std::wstring_view name) noexcept
+    {
+        const auto it = _map.find(name);
+        return it != _map.end() ? &it->second->value : nullptr;
+    }
+
+    const T* find(const std::wstring_view name) const noexcept
+    {
+        const auto it = _map.find(name);
+        return it != _map.end() ? &it->second->value : nullptr;
+    }
+
+    // Returns the value for the given name and adds an empty one if there's none yet.
+    T& operator[](const std::wstring_view name)
+    {
+        if (const auto value = find(name))
+        {
+            return *value;
+        }
+
+        auto entry = std::make_unique<Entry>();
+        entry->name.resize(name.size());
+        std::transform(name.begin(), name.end(), entry->name.begin(), s_Fold);
+
+        const std::wstring_view key{ entry->name };
+        return _map.emplace(key, std::move(entry)).first->second->value;
+    }
+
+    bool erase(const std::wstring_view name)
+    {
+        return _map.erase(name) != 0;
+    }
+
+    void clear() noexcept
+    {
+        _map.clear();
+    }
+
+    bool empty() const noexcept
+    {
+        return _map.empty();
+    }
+
+    size_t size() const noexcept
+    {
+        return _map.size();
+    }
+
+    // Iterates over pairs of the lowercase name and the Entry with the value.
+    const_iterator begin() const noexcept
+    {
+        return _map.begin();
+    }
+
+    const_iterator end() const noexcept
+    {
+        return _map.end();
+    }
+
+private:
+    Map _map;
+};
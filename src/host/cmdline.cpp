@@ -248,7 +248,6 @@ void RedrawCommandLine(COOKED_READ_DATA& cookedReadData)
         cookedReadData.OriginalCursorPosition() = cookedReadData.ScreenInfo().GetTextBuffer().GetCursor().GetPosition();
 
         SHORT ScrollY = 0;
-#pragma prefast(suppress : 28931, "Status is not unused. It's used in debug assertions.")
         NTSTATUS Status = WriteCharsLegacy(cookedReadData.ScreenInfo(),
                                            cookedReadData.BufferStartPtr(),
                                            cookedReadData.BufferStartPtr(),
@@ -258,7 +257,13 @@ void RedrawCommandLine(COOKED_READ_DATA& cookedReadData)
                                            cookedReadData.OriginalCursorPosition().X,
                                            WC_DESTRUCTIVE_BACKSPACE | WC_KEEP_CURSOR_VISIBLE | WC_PRINTABLE_CONTROL_CHARS,
                                            &ScrollY);
-        FAIL_FAST_IF_NTSTATUS_FAILED(Status);
+        // This also echoes pastes into the middle of the line. Like ProcessInput,
+        // a failure to echo them is logged and doesn't take down the console.
+        if (!NT_SUCCESS(Status))
+        {
+            RIPMSG1(RIP_WARNING, "WriteCharsLegacy failed 0x%x", Status);
+            return;
+        }
 
         cookedReadData.OriginalCursorPosition().Y += ScrollY;
 
@@ -274,7 +279,7 @@ void RedrawCommandLine(COOKED_READ_DATA& cookedReadData)
             CursorPosition.X++;
         }
         Status = AdjustCursorPosition(cookedReadData.ScreenInfo(), CursorPosition, TRUE, nullptr);
-        FAIL_FAST_IF_NTSTATUS_FAILED(Status);
+        LOG_IF_NTSTATUS_FAILED(Status);
     }
 }
 
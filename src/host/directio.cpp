@@ -444,7 +444,7 @@ void EventsToUnicode(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
 }
 
 // Routine Description:
-// - Writes events to the input buffer already formed into IInputEvents (private call)
+// - Writes events to the input buffer already formed into INPUT_RECORDs (private call)
 // Arguments:
 // - context - the input buffer to write to
 // - events - the events to written
@@ -454,11 +454,18 @@ void EventsToUnicode(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
 // Return Value:
 // - HRESULT indicating success or failure
 [[nodiscard]] HRESULT DoSrvPrivateWriteConsoleInputW(_Inout_ InputBuffer* const pInputBuffer,
-                                                     _Inout_ std::deque<std::unique_ptr<IInputEvent>>& events,
+                                                     const gsl::span<const INPUT_RECORD> events,
                                                      _Out_ size_t& eventsWritten,
                                                      const bool append) noexcept
 {
-    return _WriteConsoleInputWImplHelper(*pInputBuffer, events, eventsWritten, append);
+    eventsWritten = 0;
+
+    try
+    {
+        eventsWritten = append ? pInputBuffer->Write(events) : pInputBuffer->Prepend(events);
+        return S_OK;
+    }
+    CATCH_RETURN();
 }
 
 // Routine Description:
@@ -527,9 +534,9 @@ void EventsToUnicode(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
 
     try
     {
-        auto events = IInputEvent::Create(buffer);
-
-        return _WriteConsoleInputWImplHelper(context, events, written, append);
+        // The records are stored as they are, without wrapping each of them into an IInputEvent.
+        written = append ? context.Write(buffer) : context.Prepend(buffer);
+        return S_OK;
     }
     CATCH_RETURN();
 }
@@ -786,7 +793,6 @@ void EventsToUnicode(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
 {
     try
     {
-        const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
         const auto& storageBuffer = context.GetActiveBuffer();
         const auto storageSize = storageBuffer.GetBufferSize().Dimensions();
 
@@ -822,44 +828,16 @@ void EventsToUnicode(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
         // The final "request rectangle" or the area inside the buffer we want to read, is the clipped dimensions.
         const auto clippedRequestRectangle = Viewport::FromExclusive(clip);
 
-        // We will start reading the buffer at the point of the top left corner (origin) of the (potentially adjusted) request
-        const auto sourcePoint = clippedRequestRectangle.Origin();
-
-        // Get an iterator to the beginning of the return buffer
-        // We might have to seek this forward or skip around if we clipped the request.
-        auto targetIter = targetBuffer.begin();
-        COORD targetPos = { 0 };
-        const auto targetLimit = Viewport::FromDimensions(targetPoint, clippedRequestRectangle.Dimensions());
-
-        // Get an iterator to the beginning of the request inside the screen buffer
-        // This should walk exactly along every cell of the clipped request.
-        auto sourceIter = storageBuffer.GetCellDataAt(sourcePoint, clippedRequestRectangle);
-
-        // Walk through every cell of the target, advancing the buffer.
-        // Validate that we always still have a valid iterator to the backing store,
-        // that we always are writing inside the user's buffer (before the end)
-        // and we're always targeting the user's buffer inside its original bounds.
-        while (sourceIter && targetIter < targetBuffer.end())
+        // Read the clipped request a row span at a time, straight into the user's buffer.
+        // Its rows are as wide as the original request, so the clipped columns are skipped over.
+        if (clippedRequestRectangle.Width() > 0 && clippedRequestRectangle.Height() > 0)
         {
-            // If the point we're trying to write is inside the limited buffer write zone...
-            if (targetLimit.IsInBounds(targetPos))
-            {
-                // Copy the data into position...
-                *targetIter = gci.AsCharInfo(*sourceIter);
-                // ... and advance the read iterator.
-                sourceIter++;
-            }
-
-            // Always advance the write iterator, we might have skipped it due to clipping.
-            targetIter++;
+            size_t targetOffset;
+            RETURN_IF_FAILED(SizeTMult(targetPoint.Y, targetSize.X, &targetOffset));
+            RETURN_IF_FAILED(SizeTAdd(targetOffset, targetPoint.X, &targetOffset));
+            RETURN_HR_IF(E_INVALIDARG, targetOffset > targetBuffer.size());
 
-            // Increment the target
-            targetPos.X++;
-            if (targetPos.X >= targetSize.X)
-            {
-                targetPos.X = 0;
-                targetPos.Y++;
-            }
+            storageBuffer.GetTextBuffer().ReadCharInfos(clippedRequestRectangle, targetBuffer.subspan(targetOffset), gsl::narrow_cast<size_t>(targetSize.X));
         }
 
         // Reply with the region we read out of the backing buffer (potentially clipped)
@@ -985,34 +963,15 @@ void EventsToUnicode(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
 
         const auto writeRectangle = Viewport::FromInclusive(writeRegion);
 
-        auto target = writeRectangle.Origin();
+        // The rows of the user's buffer are as wide as the original request. Skip the rows and columns
+        // that were clipped away and write the rest a row span at a time, without copying it first.
+        size_t sourceOffset;
+        RETURN_IF_FAILED(SizeTMult(sourceRect.Top, requestRectangle.Width(), &sourceOffset));
+        RETURN_IF_FAILED(SizeTAdd(sourceOffset, sourceRect.Left, &sourceOffset));
+        RETURN_HR_IF(E_INVALIDARG, sourceOffset > buffer.size());
 
-        // For every row in the request, create a view into the clamped portion of just the one line to write.
-        // This allows us to restrict the width of the call without allocating/copying any memory by just making
-        // a smaller view over the existing big blob of data from the original call.
-        for (; target.Y < writeRectangle.BottomExclusive(); target.Y++)
-        {
-            // We find the offset into the original buffer by the dimensions of the original request rectangle.
-            ptrdiff_t rowOffset = 0;
-            RETURN_IF_FAILED(PtrdiffTSub(target.Y, requestRectangle.Top(), &rowOffset));
-            RETURN_IF_FAILED(PtrdiffTMult(rowOffset, requestRectangle.Width(), &rowOffset));
-
-            ptrdiff_t colOffset = 0;
-            RETURN_IF_FAILED(PtrdiffTSub(target.X, requestRectangle.Left(), &colOffset));
-
-            ptrdiff_t totalOffset = 0;
-            RETURN_IF_FAILED(PtrdiffTAdd(rowOffset, colOffset, &totalOffset));
-
-            // Now we make a subspan starting from that offset for as much of the original request as would fit
-            const auto subspan = buffer.subspan(totalOffset, writeRectangle.Width());
-
-            // Convert to a CHAR_INFO view to fit into the iterator
-            const auto charInfos = gsl::span<const CHAR_INFO>(subspan.data(), subspan.size());
-
-            // Make the iterator and write to the target position.
-            OutputCellIterator it(charInfos);
-            storageBuffer.Write(it, target);
-        }
+        const gsl::span<const CHAR_INFO> charInfos{ buffer.subspan(sourceOffset) };
+        storageBuffer.GetTextBuffer().WriteCharInfos(charInfos, gsl::narrow_cast<size_t>(requestRectangle.Width()), writeRectangle);
 
         // Since we've managed to write part of the request, return the clamped part that we actually used.
         writtenRectangle = writeRectangle;
@@ -2206,14 +2206,24 @@ void DoSrvPrivateMoveToBottom(SCREEN_INFORMATION& screenInfo)
             fillAttrs.SetStandardErase();
         }
 
-        const auto fillData = OutputCellIterator{ fillChar, fillAttrs, fillLength };
-        screenInfo.Write(fillData, startPosition, false);
+        // The region starts at the given position and continues at the left edge
+        // of the following rows. Every row span of it is filled in bulk.
+        auto& textBuffer = screenInfo.GetTextBuffer();
+        const auto bufferSize = screenInfo.GetBufferSize();
+        auto spanStart = startPosition;
+        auto remaining = fillLength;
+        while (remaining > 0 && spanStart.Y < bufferSize.BottomExclusive())
+        {
+            const auto spanLength = std::min<size_t>(remaining, bufferSize.RightExclusive() - spanStart.X);
+            textBuffer.FillRectangle(Viewport::FromDimensions(spanStart, gsl::narrow_cast<SHORT>(spanLength), 1), fillChar, fillAttrs);
+            remaining -= spanLength;
+            spanStart = { 0, gsl::narrow_cast<SHORT>(spanStart.Y + 1) };
+        }
 
         // Notify accessibility
         if (screenInfo.HasAccessibilityEventing())
         {
             auto endPosition = startPosition;
-            const auto bufferSize = screenInfo.GetBufferSize();
             bufferSize.MoveInBounds(fillLength - 1, endPosition);
             screenInfo.NotifyAccessibilityEventing(startPosition.X, startPosition.Y, endPosition.X, endPosition.Y);
         }
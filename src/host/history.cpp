@@ -77,6 +77,16 @@ static bool CaseInsensitiveEquality(wchar_t a, wchar_t b)
     return ::towlower(a) == ::towlower(b);
 }
 
+// Two commands are CaseInsensitiveEquality() equal if their FoldCase() versions are.
+static std::wstring FoldCase(const std::wstring_view command)
+{
+    std::wstring folded{ command };
+    std::transform(folded.begin(), folded.end(), folded.begin(), [](const wchar_t ch) {
+        return gsl::narrow_cast<wchar_t>(::towlower(ch));
+    });
+    return folded;
+}
+
 bool CommandHistory::IsAppNameMatch(const std::wstring_view other) const
 {
     return std::equal(_appName.cbegin(), _appName.cend(), other.cbegin(), other.cend(), CaseInsensitiveEquality);
@@ -124,7 +134,7 @@ void CommandHistory::_Reset()
             // find free record.  if all records are used, free the lru one.
             if ((SHORT)_commands.size() == _maxCommands)
             {
-                _commands.erase(_commands.cbegin());
+                _Erase(0);
                 // move LastDisplayed back one in order to stay synced with the
                 // command it referred to before erasing the lru one
                 --LastDisplayed;
@@ -133,11 +143,16 @@ void CommandHistory::_Reset()
             // add newCommand to array
             if (!reuse.empty())
             {
-                _commands.emplace_back(reuse);
+                _Append(std::move(reuse));
             }
             else
             {
-                _commands.emplace_back(newCommand);
+                _Append(std::wstring{ newCommand });
+            }
+
+            if (_store)
+            {
+                _store->Append(newCommand);
             }
 
             if (LastDisplayed == -1 ||
@@ -248,9 +263,14 @@ std::wstring_view CommandHistory::GetLastCommand() const
 
 void CommandHistory::Empty()
 {
-    _commands.clear();
+    _ClearCommands();
     LastDisplayed = -1;
     WI_SetFlag(Flags, CLE_RESET);
+
+    if (_store)
+    {
+        _store->Rewrite({});
+    }
 }
 
 bool CommandHistory::AtFirstCommand() const
@@ -282,14 +302,11 @@ void CommandHistory::Realloc(const size_t commands)
         return;
     }
 
-    const auto oldCommands = _commands;
-    const auto newNumberOfCommands = gsl::narrow<SHORT>(std::min(_commands.size(), commands));
+    const auto newNumberOfCommands = std::min(_commands.size(), commands);
 
-    _commands.clear();
-    for (SHORT i = 0; i < newNumberOfCommands; i++)
-    {
-        _commands.emplace_back(oldCommands[i]);
-    }
+    _commands.resize(newNumberOfCommands);
+    _sequences.resize(newNumberOfCommands);
+    _RebuildIndex();
 
     WI_SetFlag(Flags, CLE_RESET);
     LastDisplayed = gsl::narrow<SHORT>(_commands.size()) - 1;
@@ -391,7 +408,9 @@ CommandHistory* CommandHistory::s_Allocate(const std::wstring_view appName, cons
     {
         if (!SameApp)
         {
-            BestCandidate->_commands.clear();
+            BestCandidate->_ClearCommands();
+            BestCandidate->_store.reset();
+            BestCandidate->_loaded = false;
             BestCandidate->LastDisplayed = -1;
             BestCandidate->_appName = appName;
         }
@@ -474,7 +493,7 @@ std::wstring CommandHistory::Remove(const SHORT iDel)
 
         if (iDel < iLast)
         {
-            _commands.erase(_commands.cbegin() + iDel);
+            _Erase(iDel);
             if ((iDisp > iDel) && (iDisp <= iLast))
             {
                 _Dec(iDisp);
@@ -483,7 +502,7 @@ std::wstring CommandHistory::Remove(const SHORT iDel)
         }
         else if (iFirst <= iDel)
         {
-            _commands.erase(_commands.cbegin() + iDel);
+            _Erase(iDel);
             if ((iDisp >= iFirst) && (iDisp < iDel))
             {
                 _Inc(iDisp);
@@ -501,6 +520,8 @@ std::wstring CommandHistory::Remove(const SHORT iDel)
 
 // Routine Description:
 // - this routine finds the most recent command that starts with the letters already in the current command.  it returns the array index (no mod needed).
+// - It still finds what walking backwards from startingIndex (and wrapping around)
+//   would find, but it's answered by the _index instead of comparing every command.
 [[nodiscard]] bool CommandHistory::FindMatchingCommand(const std::wstring_view givenCommand,
                                                        const SHORT startingIndex,
                                                        SHORT& indexFound,
@@ -529,22 +550,13 @@ std::wstring CommandHistory::Remove(const SHORT iDel)
 
     try
     {
-        for (size_t i = 0; i < _commands.size(); i++)
+        const auto found = _FindNewest(FoldCase(givenCommand),
+                                       WI_IsFlagSet(options, MatchOptions::ExactMatch),
+                                       _sequences.at(indexFound));
+        if (found.has_value())
         {
-            const auto& storedCommand = _commands.at(indexFound);
-            if ((WI_IsFlagClear(options, MatchOptions::ExactMatch) && (givenCommand.size() <= storedCommand.size())) || (givenCommand.size() == storedCommand.size()))
-            {
-                if (std::equal(storedCommand.begin(),
-                               storedCommand.begin() + givenCommand.size(),
-                               givenCommand.begin(),
-                               givenCommand.end(),
-                               CaseInsensitiveEquality))
-                {
-                    return true;
-                }
-            }
-
-            _Prev(indexFound);
+            indexFound = gsl::narrow<SHORT>(found.value());
+            return true;
         }
     }
     CATCH_LOG();
@@ -552,6 +564,47 @@ std::wstring CommandHistory::Remove(const SHORT iDel)
     return false;
 }
 
+// Routine Description:
+// - Looks up the commands that start with (or are equal to) the given one in the _index.
+// Arguments:
+// - foldedCommand - the command to look for, in lowercase
+// - exactMatch - whether the commands have to be equal to foldedCommand instead of just starting with it
+// - newestSequence - the number of the newest command to consider first
+// Return Value:
+// - The index of the newest match that was added at or before newestSequence.
+//   If there's none, the search wraps around and it's the newest match overall,
+//   just like walking backwards through _commands would have found it.
+std::optional<size_t> CommandHistory::_FindNewest(const std::wstring& foldedCommand,
+                                                  const bool exactMatch,
+                                                  const uint64_t newestSequence) const
+{
+    std::optional<uint64_t> found;
+    std::optional<uint64_t> wrapped;
+
+    // All commands starting with foldedCommand are sorted right after it.
+    for (auto it = _index.lower_bound({ foldedCommand, 0 }); it != _index.end(); ++it)
+    {
+        const auto& [command, sequence] = *it;
+        if (command.compare(0, foldedCommand.size(), foldedCommand) != 0 ||
+            (exactMatch && command.size() != foldedCommand.size()))
+        {
+            break;
+        }
+
+        auto& candidate = sequence <= newestSequence ? found : wrapped;
+        candidate = std::max(candidate.value_or(0), sequence);
+    }
+
+    const auto sequence = found.has_value() ? found : wrapped;
+    if (!sequence.has_value())
+    {
+        return std::nullopt;
+    }
+
+    const auto position = std::lower_bound(_sequences.cbegin(), _sequences.cend(), sequence.value());
+    return gsl::narrow_cast<size_t>(position - _sequences.cbegin());
+}
+
 #ifdef UNIT_TESTING
 void CommandHistory::s_ClearHistoryListStorage()
 {
@@ -566,7 +619,132 @@ void CommandHistory::s_ClearHistoryListStorage()
 // - indexB - index of one history item to swap
 void CommandHistory::Swap(const short indexA, const short indexB)
 {
-    std::swap(_commands.at(indexA), _commands.at(indexB));
+    auto& commandA = _commands.at(indexA);
+    auto& commandB = _commands.at(indexB);
+    if (indexA == indexB)
+    {
+        return;
+    }
+
+    // The numbers stay where they are, so that they keep growing
+    // along _commands, and the commands trade them in the _index.
+    const auto sequenceA = _sequences.at(indexA);
+    const auto sequenceB = _sequences.at(indexB);
+    auto foldedA = FoldCase(commandA);
+    auto foldedB = FoldCase(commandB);
+    _index.erase({ foldedA, sequenceA });
+    _index.erase({ foldedB, sequenceB });
+    _index.emplace(std::move(foldedA), sequenceB);
+    _index.emplace(std::move(foldedB), sequenceA);
+
+    std::swap(commandA, commandB);
+}
+
+// Routine Description:
+// - Loads the persisted commands of the app, if the user opted into persisting them.
+//   This happens when the app reads its first line instead of when it attaches,
+//   so that apps that never read a line don't cost a trip to the disk.
+// - The persisted commands go before the ones that were added in this session.
+void CommandHistory::EnsureLoaded() noexcept
+{
+    if (_loaded)
+    {
+        return;
+    }
+    _loaded = true;
+
+    try
+    {
+        const CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        if (!_store && gci.GetPersistHistory())
+        {
+            _store = HistoryStore::s_Open(_appName);
+        }
+
+        if (!_store || _maxCommands <= 0)
+        {
+            return;
+        }
+
+        std::optional<uint64_t> tornRecordOffset;
+        auto commands = _store->Load(&tornRecordOffset);
+        const auto persisted = commands.size();
+
+        // Commands appended after a record that was cut off would never be loaded again.
+        if (tornRecordOffset)
+        {
+            _store->Truncate(*tornRecordOffset);
+        }
+        commands.insert(commands.end(), std::make_move_iterator(_commands.begin()), std::make_move_iterator(_commands.end()));
+        _ClearCommands();
+
+        for (auto& command : commands)
+        {
+            if (command.empty())
+            {
+                continue;
+            }
+
+            if (gci.GetHistoryNoDup())
+            {
+                const auto duplicate = _FindNewest(FoldCase(command), true, _nextSequence);
+                if (duplicate.has_value())
+                {
+                    _Erase(duplicate.value());
+                }
+            }
+
+            if (_commands.size() == gsl::narrow_cast<size_t>(_maxCommands))
+            {
+                _Erase(0);
+            }
+
+            _Append(std::move(command));
+        }
+
+        // The file only grows while commands are appended to it,
+        // so drop the ones that aged out once it got large enough.
+        if (persisted > 2 * gsl::narrow_cast<size_t>(_maxCommands))
+        {
+            _store->Rewrite(_commands);
+        }
+
+        _Reset();
+    }
+    CATCH_LOG();
+}
+
+void CommandHistory::_Append(std::wstring command)
+{
+    const auto sequence = _nextSequence++;
+    _index.emplace(FoldCase(command), sequence);
+    _sequences.emplace_back(sequence);
+    _commands.emplace_back(std::move(command));
+}
+
+std::wstring CommandHistory::_Erase(const size_t index)
+{
+    _index.erase({ FoldCase(_commands.at(index)), _sequences.at(index) });
+    auto command = std::move(_commands.at(index));
+    _commands.erase(_commands.cbegin() + index);
+    _sequences.erase(_sequences.cbegin() + index);
+    return command;
+}
+
+void CommandHistory::_ClearCommands() noexcept
+{
+    _commands.clear();
+    _sequences.clear();
+    _index.clear();
+}
+
+void CommandHistory::_RebuildIndex()
+{
+    _index.clear();
+    for (size_t i = 0; i < _commands.size(); ++i)
+    {
+        _index.emplace(FoldCase(_commands[i]), _sequences[i]);
+    }
 }
 
 // Routine Description:
@@ -12,6 +12,8 @@ Abstract:
 
 #pragma once
 
+#include "historyStore.h"
+
 class CommandHistory
 {
 public:
@@ -72,9 +74,17 @@ public:
 
     void Swap(const short indexA, const short indexB);
 
+    void EnsureLoaded() noexcept;
+
 private:
     void _Reset();
 
+    void _Append(std::wstring command);
+    std::wstring _Erase(const size_t index);
+    void _ClearCommands() noexcept;
+    void _RebuildIndex();
+    std::optional<size_t> _FindNewest(const std::wstring& foldedCommand, const bool exactMatch, const uint64_t newestSequence) const;
+
     // _Next and _Prev go to the next and prev command
     // _Inc  and _Dec go to the next and prev slots
     // Don't get the two confused - it matters when the cmd history is not full!
@@ -86,6 +96,18 @@ private:
     std::vector<std::wstring> _commands;
     SHORT _maxCommands;
 
+    // _sequences[i] is the number _commands[i] was added with. They only ever grow,
+    // which allows mapping a number from the _index back to an index into _commands.
+    // The _index holds the lowercase version of every command with its number,
+    // sorted, so that the commands starting with a prefix are next to each other.
+    std::vector<uint64_t> _sequences;
+    std::set<std::pair<std::wstring, uint64_t>> _index;
+    uint64_t _nextSequence = 0;
+
+    // The persisted commands are loaded when the app reads its first line.
+    std::shared_ptr<HistoryStore> _store;
+    bool _loaded = false;
+
     std::wstring _appName;
     HANDLE _processHandle;
 
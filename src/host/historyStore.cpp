@@ -0,0 +1,249 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "historyStore.h"
+
+#pragma hdrstop
+
+// Routine Description:
+// - Opens the history file of the given app. The files live in
+//   %LOCALAPPDATA%\Microsoft\Console\History and are named after the app.
+// Arguments:
+// - appName - the name of the executable the history belongs to
+// Return Value:
+// - The store, or nullptr if the app name can't be used as a file name
+//   or there's no local app data folder (like for some service accounts).
+std::shared_ptr<HistoryStore> HistoryStore::s_Open(const std::wstring_view appName)
+{
+    if (appName.empty() || appName.find_first_of(L"\\/:*?\"<>|") != std::wstring_view::npos)
+    {
+        return nullptr;
+    }
+
+    const auto localAppData = wil::TryGetEnvironmentVariableW(L"LOCALAPPDATA");
+    if (!localAppData)
+    {
+        return nullptr;
+    }
+
+    std::wstring directory{ localAppData.get() };
+    directory.append(L"\\Microsoft\\Console\\History");
+    wil::CreateDirectoryDeep(directory.c_str());
+
+    // App names are matched case-insensitively, so cmd.exe and CMD.EXE have to share a file.
+    std::wstring fileName{ appName };
+    std::transform(fileName.begin(), fileName.end(), fileName.begin(), [](const wchar_t ch) {
+        return gsl::narrow_cast<wchar_t>(::towlower(ch));
+    });
+
+    return std::make_shared<HistoryStore>(directory + L'\\' + fileName + L".history");
+}
+
+HistoryStore::HistoryStore(std::wstring path) :
+    _path{ std::move(path) },
+    _truncate{ false },
+    _work{ CreateThreadpoolWork(s_WriteCallback, this, nullptr) }
+{
+    THROW_LAST_ERROR_IF(!_work);
+}
+
+HistoryStore::~HistoryStore()
+{
+    // Don't lose the commands that haven't been written yet.
+    Flush();
+}
+
+const std::wstring& HistoryStore::GetPath() const noexcept
+{
+    return _path;
+}
+
+// Routine Description:
+// - Reads the commands stored in the file, oldest first.
+// - Commands that were appended or rewritten before are written first.
+// Arguments:
+// - tornRecordOffset - optional. Receives the offset of the record that was cut off,
+//   if there's one. Everything from there on can't be loaded and should be truncated.
+// Return Value:
+// - The stored commands. Empty if there's no file yet.
+std::vector<std::wstring> HistoryStore::Load(std::optional<uint64_t>* const tornRecordOffset)
+{
+    Flush();
+
+    std::vector<std::wstring> commands;
+    if (tornRecordOffset)
+    {
+        tornRecordOffset->reset();
+    }
+
+    wil::unique_hfile file{ CreateFileW(_path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr) };
+    if (!file)
+    {
+        const auto error = GetLastError();
+        THROW_WIN32_IF(error, error != ERROR_FILE_NOT_FOUND && error != ERROR_PATH_NOT_FOUND);
+        return commands;
+    }
+
+    LARGE_INTEGER fileSize{};
+    THROW_IF_WIN32_BOOL_FALSE(GetFileSizeEx(file.get(), &fileSize));
+
+    std::vector<BYTE> contents(gsl::narrow<DWORD>(fileSize.QuadPart));
+    DWORD read = 0;
+    if (!contents.empty())
+    {
+        THROW_IF_WIN32_BOOL_FALSE(ReadFile(file.get(), contents.data(), gsl::narrow<DWORD>(contents.size()), &read, nullptr));
+    }
+    contents.resize(read);
+
+    size_t offset = 0;
+    while (offset < contents.size())
+    {
+        uint32_t length = 0;
+        const auto remaining = contents.size() - offset;
+        if (remaining >= sizeof(length))
+        {
+            memcpy(&length, contents.data() + offset, sizeof(length));
+        }
+
+        const auto bytes = size_t{ length } * sizeof(wchar_t);
+        if (remaining < sizeof(length) || length > s_maxCommandLength || remaining - sizeof(length) < bytes)
+        {
+            if (tornRecordOffset)
+            {
+                *tornRecordOffset = offset;
+            }
+            break;
+        }
+
+        auto& command = commands.emplace_back(length, UNICODE_NULL);
+        memcpy(command.data(), contents.data() + offset + sizeof(length), bytes);
+        offset += sizeof(length) + bytes;
+    }
+
+    return commands;
+}
+
+// Routine Description:
+// - Cuts the file off at the given size. This is used to drop a record that was cut off,
+//   before any commands are appended after it, which Load() would never get to.
+// - Commands that were appended or rewritten before are written first.
+// Arguments:
+// - size - the size to truncate the file to. Does nothing if the file isn't larger.
+void HistoryStore::Truncate(const uint64_t size)
+{
+    Flush();
+
+    std::lock_guard writeLock{ _writeLock };
+
+    wil::unique_hfile file{ CreateFileW(_path.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr) };
+    THROW_LAST_ERROR_IF(!file);
+
+    LARGE_INTEGER fileSize{};
+    THROW_IF_WIN32_BOOL_FALSE(GetFileSizeEx(file.get(), &fileSize));
+    if (gsl::narrow<uint64_t>(fileSize.QuadPart) <= size)
+    {
+        return;
+    }
+
+    LARGE_INTEGER position{};
+    position.QuadPart = gsl::narrow<LONGLONG>(size);
+    THROW_IF_WIN32_BOOL_FALSE(SetFilePointerEx(file.get(), position, nullptr, FILE_BEGIN));
+    THROW_IF_WIN32_BOOL_FALSE(SetEndOfFile(file.get()));
+}
+
+// Routine Description:
+// - Queues a command to be appended to the file.
+// Arguments:
+// - command - the command to store
+void HistoryStore::Append(const std::wstring_view command)
+{
+    {
+        std::lock_guard lock{ _lock };
+        _pending.emplace_back(command);
+    }
+
+    SubmitThreadpoolWork(_work.get());
+}
+
+// Routine Description:
+// - Queues replacing the contents of the file with the given commands.
+//   This is used to empty the history and to drop the commands that aged out of it.
+// Arguments:
+// - commands - the commands to store, oldest first
+void HistoryStore::Rewrite(std::vector<std::wstring> commands)
+{
+    {
+        std::lock_guard lock{ _lock };
+        _pending = std::move(commands);
+        _truncate = true;
+    }
+
+    SubmitThreadpoolWork(_work.get());
+}
+
+// Routine Description:
+// - Waits until all queued commands have been written.
+void HistoryStore::Flush() noexcept
+{
+    WaitForThreadpoolWorkCallbacks(_work.get(), FALSE);
+}
+
+void CALLBACK HistoryStore::s_WriteCallback(PTP_CALLBACK_INSTANCE /*instance*/, PVOID context, PTP_WORK /*work*/) noexcept
+{
+    try
+    {
+        static_cast<HistoryStore*>(context)->_WritePending();
+    }
+    CATCH_LOG();
+}
+
+// Routine Description:
+// - Writes everything that was queued since the last call with a single WriteFile().
+// - Every Append()/Rewrite() submits the work, so there may be nothing left to do
+//   when an earlier callback already picked up the commands of a later submission.
+void HistoryStore::_WritePending()
+{
+    std::lock_guard writeLock{ _writeLock };
+
+    std::vector<std::wstring> pending;
+    bool truncate = false;
+    {
+        std::lock_guard lock{ _lock };
+        pending.swap(_pending);
+        truncate = std::exchange(_truncate, false);
+    }
+
+    if (pending.empty() && !truncate)
+    {
+        return;
+    }
+
+    std::vector<BYTE> records;
+    for (const auto& command : pending)
+    {
+        const auto length = gsl::narrow<uint32_t>(command.size());
+        const auto bytes = reinterpret_cast<const BYTE*>(command.data());
+        records.insert(records.end(), reinterpret_cast<const BYTE*>(&length), reinterpret_cast<const BYTE*>(&length + 1));
+        records.insert(records.end(), bytes, bytes + command.size() * sizeof(wchar_t));
+    }
+
+    // Without FILE_WRITE_DATA every write goes to the end of the file, even
+    // if another console appended to the same file since we opened it.
+    wil::unique_hfile file{ CreateFileW(_path.c_str(),
+                                        truncate ? GENERIC_WRITE : FILE_APPEND_DATA,
+                                        FILE_SHARE_READ | FILE_SHARE_WRITE,
+                                        nullptr,
+                                        truncate ? CREATE_ALWAYS : OPEN_ALWAYS,
+                                        FILE_ATTRIBUTE_NORMAL,
+                                        nullptr) };
+    THROW_LAST_ERROR_IF(!file);
+
+    if (!records.empty())
+    {
+        DWORD written = 0;
+        THROW_IF_WIN32_BOOL_FALSE(WriteFile(file.get(), records.data(), gsl::narrow<DWORD>(records.size()), &written, nullptr));
+        THROW_HR_IF(E_UNEXPECTED, written != records.size());
+    }
+}
@@ -0,0 +1,58 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- historyStore.h
+
+Abstract:
+- Keeps the command history of an app in a file, so that it survives the console.
+- The file is a sequence of records, each made of the length of a command
+  (in characters, as a uint32_t) followed by its UTF-16 text. New commands are
+  appended to it on the threadpool, so that the reads never wait for the disk.
+- A record that was cut off (because a console went away while writing it)
+  ends the history. Everything before it is still loaded, and Load() reports
+  where the record starts, so that the file can be truncated before anything
+  is appended after it.
+--*/
+
+#pragma once
+
+class HistoryStore final
+{
+public:
+    static std::shared_ptr<HistoryStore> s_Open(const std::wstring_view appName);
+
+    HistoryStore(std::wstring path);
+    ~HistoryStore();
+
+    HistoryStore(const HistoryStore&) = delete;
+    HistoryStore& operator=(const HistoryStore&) = delete;
+
+    const std::wstring& GetPath() const noexcept;
+
+    std::vector<std::wstring> Load(std::optional<uint64_t>* const tornRecordOffset = nullptr);
+    void Truncate(const uint64_t size);
+    void Append(const std::wstring_view command);
+    void Rewrite(std::vector<std::wstring> commands);
+    void Flush() noexcept;
+
+private:
+    static void CALLBACK s_WriteCallback(PTP_CALLBACK_INSTANCE instance, PVOID context, PTP_WORK work) noexcept;
+    void _WritePending();
+
+    // Commands longer than this can't come out of a cooked read,
+    // so a record that claims to be longer means that the file is corrupt.
+    static constexpr uint32_t s_maxCommandLength = 0x8000;
+
+    std::wstring _path;
+
+    // _lock protects the writes that haven't been picked up by the threadpool yet.
+    // _writeLock is held while they're written, so that they reach the file in order.
+    std::mutex _lock;
+    std::mutex _writeLock;
+    std::vector<std::wstring> _pending;
+    bool _truncate;
+
+    wil::unique_threadpool_work _work;
+};
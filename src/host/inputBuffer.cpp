@@ -214,10 +214,9 @@ void InputBuffer::Flush()
 // - The console lock must be held when calling this routine.
 void InputBuffer::FlushAllButKeys()
 {
-    auto newEnd = std::remove_if(_storage.begin(), _storage.end(), [](const std::unique_ptr<IInputEvent>& event) {
-        return event->EventType() != InputEventType::KeyEvent;
+    _storage.remove_if([](const INPUT_RECORD& record) noexcept {
+        return record.EventType != KEY_EVENT;
     });
-    _storage.erase(newEnd, _storage.end());
 }
 
 void InputBuffer::SetTerminalConnection(_In_ ITerminalOutputConnection* const pTtyConnection)
@@ -263,36 +262,67 @@ void InputBuffer::PassThroughWin32MouseRequest(bool enable)
                                          const bool WaitForData,
                                          const bool Unicode,
                                          const bool Stream)
+{
+    try
+    {
+        std::vector<INPUT_RECORD> records;
+        const auto Status = Read(records, AmountToRead, Peek, WaitForData, Unicode, Stream);
+        for (const auto& record : records)
+        {
+            OutEvents.push_back(IInputEvent::Create(record));
+        }
+        return Status;
+    }
+    catch (...)
+    {
+        return NTSTATUS_FROM_HRESULT(wil::ResultFromCaughtException());
+    }
+}
+
+// Routine Description:
+// - This routine reads from the input buffer without wrapping the records into IInputEvents.
+// - It can convert returned data to through the currently set Input CP, it can optionally return a wait condition
+//   if there isn't enough data in the buffer, and it can be set to not remove records as it reads them out.
+// Note:
+// - The console lock must be held when calling this routine.
+// Arguments:
+// - outRecords - vector the read records are appended to
+// - amountToRead - the amount of records to try to read
+// - peek - If true, copy records to outRecords but don't remove them from the input buffer.
+// - waitForData - if true, wait until an event is input (if there aren't enough to fill client buffer). if false, return immediately
+// - unicode - true if the data in key events should be treated as unicode. false if they should be converted by the current input CP.
+// - stream - true if read should unpack KeyEvents that have a >1 repeat count. amountToRead must be 1 if stream is true.
+// Return Value:
+// - STATUS_SUCCESS if records were read into the client buffer and everything is OK.
+// - CONSOLE_STATUS_WAIT if there weren't enough records to satisfy the request (and waits are allowed)
+// - otherwise a suitable memory/math/string error in NTSTATUS form.
+[[nodiscard]] NTSTATUS InputBuffer::Read(_Out_ std::vector<INPUT_RECORD>& outRecords,
+                                         const size_t amountToRead,
+                                         const bool peek,
+                                         const bool waitForData,
+                                         const bool unicode,
+                                         const bool stream)
 {
     try
     {
         if (_storage.empty())
         {
-            if (!WaitForData)
+            if (!waitForData)
             {
                 return STATUS_SUCCESS;
             }
             return CONSOLE_STATUS_WAIT;
         }
 
-        // read from buffer
-        std::deque<std::unique_ptr<IInputEvent>> events;
         size_t eventsRead;
         bool resetWaitEvent;
-        _ReadBuffer(events,
-                    AmountToRead,
+        _ReadBuffer(outRecords,
+                    amountToRead,
                     eventsRead,
-                    Peek,
+                    peek,
                     resetWaitEvent,
-                    Unicode,
-                    Stream);
-
-        // copy events to outEvents
-        while (!events.empty())
-        {
-            OutEvents.push_back(std::move(events.front()));
-            events.pop_front();
-        }
+                    unicode,
+                    stream);
 
         if (resetWaitEvent)
         {
@@ -354,7 +384,7 @@ void InputBuffer::PassThroughWin32MouseRequest(bool enable)
 // Routine Description:
 // - This routine reads from a buffer. It does the buffer manipulation.
 // Arguments:
-// - outEvents - where read events are placed
+// - outRecords - where read records are appended
 // - readCount - amount of events to read
 // - eventsRead - where to store number of events read
 // - peek - if true , don't remove data from buffer, just copy it.
@@ -365,7 +395,7 @@ void InputBuffer::PassThroughWin32MouseRequest(bool enable)
 // - <none>
 // Note:
 // - The console lock must be held when calling this routine.
-void InputBuffer::_ReadBuffer(_Out_ std::deque<std::unique_ptr<IInputEvent>>& outEvents,
+void InputBuffer::_ReadBuffer(_Out_ std::vector<INPUT_RECORD>& outRecords,
                               const size_t readCount,
                               _Out_ size_t& eventsRead,
                               const bool peek,
@@ -379,47 +409,57 @@ void InputBuffer::_ReadBuffer(_Out_ std::deque<std::unique_ptr<IInputEvent>>& ou
 
     resetWaitEvent = false;
 
-    std::deque<std::unique_ptr<IInputEvent>> readEvents;
-    // we need another var to keep track of how many we've read
-    // because dbcs records count for two when we aren't doing a
-    // unicode read but the eventsRead count should return the number
-    // of events actually put into outRecords.
-    size_t virtualReadCount = 0;
+    const auto initialSize = outRecords.size();
+
+    // the number of records consumed from the front of the storage
+    size_t consumed = 0;
 
-    while (!_storage.empty() && virtualReadCount < readCount)
+    if (unicode && !streamRead)
+    {
+        // Every record counts as one, so the records can be copied out in bulk.
+        consumed = std::min(readCount, _storage.size());
+        outRecords.resize(initialSize + consumed);
+        _storage.copy_to({ outRecords.data() + initialSize, consumed });
+    }
+    else
     {
-        bool performNormalRead = true;
-        // for stream reads we need to split any key events that have been coalesced
-        if (streamRead)
+        // we need another var to keep track of how many we've read
+        // because dbcs records count for two when we aren't doing a
+        // unicode read but the eventsRead count should return the number
+        // of events actually put into outRecords.
+        size_t virtualReadCount = 0;
+
+        while (consumed < _storage.size() && virtualReadCount < readCount)
         {
-            if (_storage.front()->EventType() == InputEventType::KeyEvent)
+            auto& record = _storage[consumed];
+
+            // for stream reads we need to split any key events that have been coalesced
+            if (streamRead &&
+                record.EventType == KEY_EVENT &&
+                record.Event.KeyEvent.wRepeatCount > 1)
             {
-                KeyEvent* const pKeyEvent = static_cast<KeyEvent* const>(_storage.front().get());
-                if (pKeyEvent->GetRepeatCount() > 1)
+                auto& streamRecord = outRecords.emplace_back(record);
+                streamRecord.Event.KeyEvent.wRepeatCount = 1;
+
+                // The rest of the repeats stay in the buffer. When peeking,
+                // the stored record is left as it is instead.
+                if (!peek)
                 {
-                    // split the key event
-                    std::unique_ptr<KeyEvent> streamKeyEvent = std::make_unique<KeyEvent>(*pKeyEvent);
-                    streamKeyEvent->SetRepeatCount(1);
-                    readEvents.push_back(std::move(streamKeyEvent));
-                    pKeyEvent->SetRepeatCount(pKeyEvent->GetRepeatCount() - 1);
-                    performNormalRead = false;
+                    record.Event.KeyEvent.wRepeatCount--;
                 }
             }
-        }
-
-        if (performNormalRead)
-        {
-            readEvents.push_back(std::move(_storage.front()));
-            _storage.pop_front();
-        }
+            else
+            {
+                outRecords.push_back(record);
+                ++consumed;
+            }
 
-        ++virtualReadCount;
-        if (!unicode)
-        {
-            if (readEvents.back()->EventType() == InputEventType::KeyEvent)
+            ++virtualReadCount;
+            if (!unicode)
             {
-                const KeyEvent* const pKeyEvent = static_cast<const KeyEvent* const>(readEvents.back().get());
-                if (IsGlyphFullWidth(pKeyEvent->GetCharData()))
+                const auto& lastRecord = outRecords.back();
+                if (lastRecord.EventType == KEY_EVENT &&
+                    IsGlyphFullWidth(lastRecord.Event.KeyEvent.uChar.UnicodeChar))
                 {
                     ++virtualReadCount;
                 }
@@ -428,44 +468,12 @@ void InputBuffer::_ReadBuffer(_Out_ std::deque<std::unique_ptr<IInputEvent>>& ou
     }
 
     // the amount of events that were actually read
-    eventsRead = readEvents.size();
-
-    // copy the events back if we were supposed to peek
-    if (peek)
-    {
-        if (streamRead)
-        {
-            // we need to check and see if the event was split from a coalesced key event
-            // or if it was unrelated to the current front event in storage
-            if (!readEvents.empty() &&
-                !_storage.empty() &&
-                readEvents.back()->EventType() == InputEventType::KeyEvent &&
-                _storage.front()->EventType() == InputEventType::KeyEvent &&
-                _CanCoalesce(static_cast<const KeyEvent&>(*readEvents.back()),
-                             static_cast<const KeyEvent&>(*_storage.front())))
-            {
-                KeyEvent& keyEvent = static_cast<KeyEvent&>(*_storage.front());
-                keyEvent.SetRepeatCount(keyEvent.GetRepeatCount() + 1);
-            }
-            else
-            {
-                _storage.push_front(IInputEvent::Create(readEvents.back()->ToInputRecord()));
-            }
-        }
-        else
-        {
-            for (auto it = readEvents.crbegin(); it != readEvents.crend(); ++it)
-            {
-                _storage.push_front(IInputEvent::Create((*it)->ToInputRecord()));
-            }
-        }
-    }
+    eventsRead = outRecords.size() - initialSize;
 
-    // move events read to proper deque
-    while (!readEvents.empty())
+    // peeking leaves the records in the buffer
+    if (!peek)
     {
-        outEvents.push_back(std::move(readEvents.front()));
-        readEvents.pop_front();
+        _storage.pop_front(consumed);
     }
 
     // signal if we emptied the buffer
@@ -479,54 +487,74 @@ void InputBuffer::_ReadBuffer(_Out_ std::deque<std::unique_ptr<IInputEvent>>& ou
 // -  Writes events to the beginning of the input buffer.
 // Arguments:
 // - inEvents - events to write to buffer.
-// - eventsWritten - The number of events written to the buffer on exit.
 // Return Value:
-// S_OK if successful.
+// - The number of events that were written to input buffer.
 // Note:
 // - The console lock must be held when calling this routine.
 size_t InputBuffer::Prepend(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents)
+{
+    try
+    {
+        const auto records = IInputEvent::ToInputRecords(inEvents);
+        inEvents.clear();
+        return Prepend(records);
+    }
+    catch (...)
+    {
+        LOG_HR(wil::ResultFromCaughtException());
+        return 0;
+    }
+}
+
+// Routine Description:
+// -  Writes records to the beginning of the input buffer.
+// Arguments:
+// - inRecords - records to write to buffer.
+// Return Value:
+// - The number of events that were written to input buffer.
+// Note:
+// - The console lock must be held when calling this routine.
+size_t InputBuffer::Prepend(const gsl::span<const INPUT_RECORD> inRecords)
 {
     try
     {
         _vtInputShouldSuppress = true;
         auto resetVtInputSuppress = wil::scope_exit([&]() { _vtInputShouldSuppress = false; });
-        _HandleConsoleSuspensionEvents(inEvents);
-        if (inEvents.empty())
+        const auto records = _HandleConsoleSuspensionEvents(inRecords);
+        if (records.empty())
         {
             return STATUS_SUCCESS;
         }
-        // read all of the records out of the buffer, then write the
-        // prepend ones, then write the original set. We need to do it
-        // this way to handle any coalescing that might occur.
 
-        // get all of the existing records, "emptying" the buffer
-        std::deque<std::unique_ptr<IInputEvent>> existingStorage;
-        existingStorage.swap(_storage);
+        const bool initiallyEmptyQueue = _storage.empty();
+        size_t prependEventsWritten;
 
-        // We will need this variable to pass to _WriteBuffer so it can attempt to determine wait status.
-        // However, because we swapped the storage out from under it with an empty deque, it will always
-        // return true after the first one (as it is filling the newly emptied backing deque.)
-        // Then after the second one, because we've inserted some input, it will always say false.
-        bool unusedWaitStatus = false;
+        if (IsInVirtualTerminalInputMode())
+        {
+            // The VT input module appends the sequences it generates to the
+            // storage, so the existing records are moved out of the way first
+            // and appended again after the prepended ones have been written.
+            InputRecordQueue existingStorage;
+            std::swap(existingStorage, _storage);
 
-        // write the prepend records
-        size_t prependEventsWritten;
-        _WriteBuffer(inEvents, prependEventsWritten, unusedWaitStatus);
-        FAIL_FAST_IF(!(unusedWaitStatus));
+            bool unusedWaitStatus = false;
+            _WriteBuffer(records, prependEventsWritten, unusedWaitStatus);
 
-        // write all previously existing records
-        size_t existingEventsWritten;
-        _WriteBuffer(existingStorage, existingEventsWritten, unusedWaitStatus);
-        FAIL_FAST_IF(!(!unusedWaitStatus));
+            for (size_t i = 0; i < existingStorage.size(); ++i)
+            {
+                _storage.push_back(existingStorage[i]);
+            }
+        }
+        else
+        {
+            // Prepended records are never coalesced with the existing ones.
+            _storage.push_front(records);
+            prependEventsWritten = records.size();
+        }
 
         // We need to set the wait event if there were 0 events in the
         // input queue when we started.
-        // Because we did interesting manipulation of the wait queue
-        // in order to prepend, we can't trust what _WriteBuffer said
-        // and instead need to set the event if the original backing
-        // buffer (the one we swapped out at the top) was empty
-        // when this whole thing started.
-        if (existingStorage.empty())
+        if (initiallyEmptyQueue && !_storage.empty())
         {
             ServiceLocator::LocateGlobals().hInputEvent.SetEvent();
         }
@@ -556,9 +584,9 @@ size_t InputBuffer::Write(_Inout_ std::unique_ptr<IInputEvent> inEvent)
 {
     try
     {
-        std::deque<std::unique_ptr<IInputEvent>> inEvents;
-        inEvents.push_back(std::move(inEvent));
-        return Write(inEvents);
+        const auto record = inEvent->ToInputRecord();
+        inEvent.reset();
+        return Write(gsl::span<const INPUT_RECORD>{ &record, 1 });
     }
     catch (...)
     {
@@ -577,13 +605,37 @@ size_t InputBuffer::Write(_Inout_ std::unique_ptr<IInputEvent> inEvent)
 // Note:
 // - The console lock must be held when calling this routine.
 size_t InputBuffer::Write(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents)
+{
+    try
+    {
+        const auto records = IInputEvent::ToInputRecords(inEvents);
+        inEvents.clear();
+        return Write(records);
+    }
+    catch (...)
+    {
+        LOG_HR(wil::ResultFromCaughtException());
+        return 0;
+    }
+}
+
+// Routine Description:
+// - Writes records to the input buffer. Wakes up any readers that are
+// waiting for additional input events.
+// Arguments:
+// - inRecords - input records to store in the buffer.
+// Return Value:
+// - The number of events that were written to input buffer.
+// Note:
+// - The console lock must be held when calling this routine.
+size_t InputBuffer::Write(const gsl::span<const INPUT_RECORD> inRecords)
 {
     try
     {
         _vtInputShouldSuppress = true;
         auto resetVtInputSuppress = wil::scope_exit([&]() { _vtInputShouldSuppress = false; });
-        _HandleConsoleSuspensionEvents(inEvents);
-        if (inEvents.empty())
+        const auto records = _HandleConsoleSuspensionEvents(inRecords);
+        if (records.empty())
         {
             return 0;
         }
@@ -591,7 +643,7 @@ size_t InputBuffer::Write(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEv
         // Write to buffer.
         size_t EventsWritten;
         bool SetWaitEvent;
-        _WriteBuffer(inEvents, EventsWritten, SetWaitEvent);
+        _WriteBuffer(records, EventsWritten, SetWaitEvent);
 
         if (SetWaitEvent)
         {
@@ -610,9 +662,9 @@ size_t InputBuffer::Write(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEv
 }
 
 // Routine Description:
-// - Coalesces input events and transfers them to storage queue.
+// - Coalesces input records and transfers them to storage queue.
 // Arguments:
-// - inRecords - The events to store.
+// - inRecords - The records to store.
 // - eventsWritten - The number of events written since this function
 // was called.
 // - setWaitEvent - on exit, true if buffer became non-empty.
@@ -621,77 +673,59 @@ size_t InputBuffer::Write(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEv
 // Note:
 // - The console lock must be held when calling this routine.
 // - will throw on failure
-void InputBuffer::_WriteBuffer(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
+void InputBuffer::_WriteBuffer(const gsl::span<const INPUT_RECORD> inRecords,
                                _Out_ size_t& eventsWritten,
                                _Out_ bool& setWaitEvent)
 {
     eventsWritten = 0;
     setWaitEvent = false;
     const bool initiallyEmptyQueue = _storage.empty();
-    const size_t initialInEventsSize = inEvents.size();
     const bool vtInputMode = IsInVirtualTerminalInputMode();
 
-    while (!inEvents.empty())
+    // we only check for possible coalescing when storing one
+    // record at a time because this is the original behavior of
+    // the input buffer. Changing this behavior may break stuff
+    // that was depending on it.
+    const bool mayCoalesce = inRecords.size() == 1;
+
+    if (!vtInputMode && !mayCoalesce)
     {
-        // Pop the next event.
-        // If we're in vt mode, try and handle it with the vt input module.
-        // If it was handled, do nothing else for it.
-        // If there was one event passed in, try coalescing it with the previous event currently in the buffer.
-        // If it's not coalesced, append it to the buffer.
-        std::unique_ptr<IInputEvent> inEvent = std::move(inEvents.front());
-        inEvents.pop_front();
-        if (vtInputMode)
+        // Nothing needs to be looked at individually, so store them all at once.
+        _storage.push_back(inRecords);
+        eventsWritten = inRecords.size();
+    }
+    else
+    {
+        for (const auto& inRecord : inRecords)
         {
-            const bool handled = _termInput.HandleKey(inEvent.get());
-            if (handled)
+            // If we're in vt mode, try and handle it with the vt input module.
+            // If it was handled, do nothing else for it.
+            if (vtInputMode && inRecord.EventType == KEY_EVENT)
             {
-                eventsWritten++;
-                continue;
+                const KeyEvent keyEvent{ inRecord.Event.KeyEvent };
+                if (_termInput.HandleKey(&keyEvent))
+                {
+                    eventsWritten++;
+                    continue;
+                }
             }
-        }
-
-        // we only check for possible coalescing when storing one
-        // record at a time because this is the original behavior of
-        // the input buffer. Changing this behavior may break stuff
-        // that was depending on it.
-        if (initialInEventsSize == 1 && !_storage.empty())
-        {
-            // coalescing requires a deque of events, so push it back onto the front.
-            inEvents.push_front(std::move(inEvent));
 
-            bool coalesced = false;
             // this looks kinda weird but we don't want to coalesce a
             // mouse event and then try to coalesce a key event right after.
-            //
-            // we also pass the whole deque to the coalescing methods
-            // even though they only want one event because it should
-            // be their responsibility to maintain the correct state
-            // of the deque if they process any records in it.
-            if (_CoalesceMouseMovedEvents(inEvents))
-            {
-                coalesced = true;
-            }
-            else if (_CoalesceRepeatedKeyPressEvents(inEvents))
-            {
-                coalesced = true;
-            }
-            if (coalesced)
+            if (mayCoalesce &&
+                !_storage.empty() &&
+                (_CoalesceMouseMovedEvents(inRecord) || _CoalesceRepeatedKeyPressEvents(inRecord)))
             {
                 eventsWritten = 1;
                 return;
             }
-            else
-            {
-                // We didn't coalesce the event. pull it from the queue again,
-                //  to keep the state consistent with the start of this block.
-                inEvent = std::move(inEvents.front());
-                inEvents.pop_front();
-            }
+
+            // At this point, the event was neither coalesced, nor processed by VT.
+            _storage.push_back(inRecord);
+            ++eventsWritten;
         }
-        // At this point, the event was neither coalesced, nor processed by VT.
-        _storage.push_back(std::move(inEvent));
-        ++eventsWritten;
     }
+
     if (initiallyEmptyQueue && !_storage.empty())
     {
         setWaitEvent = true;
@@ -699,44 +733,30 @@ void InputBuffer::_WriteBuffer(_Inout_ std::deque<std::unique_ptr<IInputEvent>>&
 }
 
 // Routine Description:
-// - Checks if the last saved event and the first event of inRecords are
-// both MOUSE_MOVED events. If they are, the last saved event is
-// updated with the new mouse position and the first event of inRecords is
-// dropped.
+// - Checks if the last saved event and the incoming record are both
+// MOUSE_MOVED events. If they are, the last saved event is updated
+// with the new mouse position.
 // Arguments:
-// - inRecords - The incoming records to process.
+// - inRecord - The incoming record to process.
 // Return Value:
 // true if events were coalesced, false if they were not.
 // Note:
-// - The size of inRecords must be 1.
+// - The storage must not be empty.
 // - Coalescing here means updating a record that already exists in
 // the buffer with updated values from an incoming event, instead of
 // storing the incoming event (which would make the original one
 // redundant/out of date with the most current state).
-bool InputBuffer::_CoalesceMouseMovedEvents(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents)
+bool InputBuffer::_CoalesceMouseMovedEvents(const INPUT_RECORD& inRecord) noexcept
 {
-    FAIL_FAST_IF(!(inEvents.size() == 1));
-    FAIL_FAST_IF(_storage.empty());
-    const IInputEvent* const pFirstInEvent = inEvents.front().get();
-    const IInputEvent* const pLastStoredEvent = _storage.back().get();
-    if (pFirstInEvent->EventType() == InputEventType::MouseEvent &&
-        pLastStoredEvent->EventType() == InputEventType::MouseEvent)
+    auto& lastRecord = _storage.back();
+    if (inRecord.EventType == MOUSE_EVENT &&
+        lastRecord.EventType == MOUSE_EVENT &&
+        inRecord.Event.MouseEvent.dwEventFlags == MOUSE_MOVED &&
+        lastRecord.Event.MouseEvent.dwEventFlags == MOUSE_MOVED)
     {
-        const MouseEvent* const pInMouseEvent = static_cast<const MouseEvent* const>(pFirstInEvent);
-        const MouseEvent* const pLastMouseEvent = static_cast<const MouseEvent* const>(pLastStoredEvent);
-
-        if (pInMouseEvent->IsMouseMoveEvent() &&
-            pLastMouseEvent->IsMouseMoveEvent())
-        {
-            // update mouse moved position
-            MouseEvent* const pMouseEvent = static_cast<MouseEvent* const>(_storage.back().release());
-            pMouseEvent->SetPosition(pInMouseEvent->GetPosition());
-            std::unique_ptr<IInputEvent> tempPtr(pMouseEvent);
-            tempPtr.swap(_storage.back());
-
-            inEvents.pop_front();
-            return true;
-        }
+        // update mouse moved position
+        lastRecord.Event.MouseEvent.dwMousePosition = inRecord.Event.MouseEvent.dwMousePosition;
+        return true;
     }
     return false;
 }
@@ -767,44 +787,35 @@ bool InputBuffer::_CanCoalesce(const KeyEvent& a, const KeyEvent& b) const noexc
 }
 
 // Routine Description::
-// - If the last input event saved and the first input event in inRecords
-// are both a keypress down event for the same key, update the repeat
-// count of the saved event and drop the first from inRecords.
+// - If the last input event saved and the incoming record are both a
+// keypress down event for the same key, update the repeat count of
+// the saved event.
 // Arguments:
-// - inRecords - The incoming records to process.
+// - inRecord - The incoming record to process.
 // Return Value:
 // true if events were coalesced, false if they were not.
 // Note:
-// - The size of inRecords must be 1.
+// - The storage must not be empty.
 // - Coalescing here means updating a record that already exists in
 // the buffer with updated values from an incoming event, instead of
 // storing the incoming event (which would make the original one
 // redundant/out of date with the most current state).
-bool InputBuffer::_CoalesceRepeatedKeyPressEvents(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents)
-{
-    FAIL_FAST_IF(!(inEvents.size() == 1));
-    FAIL_FAST_IF(_storage.empty());
-    const IInputEvent* const pFirstInEvent = inEvents.front().get();
-    const IInputEvent* const pLastStoredEvent = _storage.back().get();
-    if (pFirstInEvent->EventType() == InputEventType::KeyEvent &&
-        pLastStoredEvent->EventType() == InputEventType::KeyEvent)
-    {
-        const KeyEvent* const pInKeyEvent = static_cast<const KeyEvent* const>(pFirstInEvent);
-        const KeyEvent* const pLastKeyEvent = static_cast<const KeyEvent* const>(pLastStoredEvent);
-
-        if (pInKeyEvent->IsKeyDown() &&
-            pLastKeyEvent->IsKeyDown() &&
-            !IsGlyphFullWidth(pInKeyEvent->GetCharData()) &&
-            _CanCoalesce(*pInKeyEvent, *pLastKeyEvent))
+bool InputBuffer::_CoalesceRepeatedKeyPressEvents(const INPUT_RECORD& inRecord) noexcept
+{
+    auto& lastRecord = _storage.back();
+    if (inRecord.EventType == KEY_EVENT &&
+        lastRecord.EventType == KEY_EVENT)
+    {
+        const KeyEvent inKeyEvent{ inRecord.Event.KeyEvent };
+        const KeyEvent lastKeyEvent{ lastRecord.Event.KeyEvent };
+
+        if (inKeyEvent.IsKeyDown() &&
+            lastKeyEvent.IsKeyDown() &&
+            !IsGlyphFullWidth(inKeyEvent.GetCharData()) &&
+            _CanCoalesce(inKeyEvent, lastKeyEvent))
         {
             // increment repeat count
-            KeyEvent* const pKeyEvent = static_cast<KeyEvent* const>(_storage.back().release());
-            WORD repeatCount = pKeyEvent->GetRepeatCount() + pInKeyEvent->GetRepeatCount();
-            pKeyEvent->SetRepeatCount(repeatCount);
-            std::unique_ptr<IInputEvent> tempPtr(pKeyEvent);
-            tempPtr.swap(_storage.back());
-
-            inEvents.pop_front();
+            lastRecord.Event.KeyEvent.wRepeatCount += inKeyEvent.GetRepeatCount();
             return true;
         }
     }
@@ -814,42 +825,52 @@ bool InputBuffer::_CoalesceRepeatedKeyPressEvents(_Inout_ std::deque<std::unique
 // Routine Description:
 // - Handles records that suspend/resume the console.
 // Arguments:
-// - records - records to check for pause/unpause events
+// - inRecords - records to check for pause/unpause events
 // Return Value:
-// - None
+// - The records that remain to be written. This is either inRecords itself
+//   or, if any records were consumed, a filtered copy owned by the input buffer.
 // Note:
 // - The console lock must be held when calling this routine.
 // - will throw exception on error
-void InputBuffer::_HandleConsoleSuspensionEvents(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents)
+gsl::span<const INPUT_RECORD> InputBuffer::_HandleConsoleSuspensionEvents(const gsl::span<const INPUT_RECORD> inRecords)
 {
     CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
 
-    std::deque<std::unique_ptr<IInputEvent>> outEvents;
-    while (!inEvents.empty())
+    // The filtered copy is only made once the first record is consumed,
+    // so that the common case of writing plain input doesn't copy anything.
+    bool filtering = false;
+    for (size_t i = 0; i < inRecords.size(); ++i)
     {
-        std::unique_ptr<IInputEvent> currEvent = std::move(inEvents.front());
-        inEvents.pop_front();
-        if (currEvent->EventType() == InputEventType::KeyEvent)
+        const auto& record = til::at(inRecords, i);
+        bool consumed = false;
+        if (record.EventType == KEY_EVENT && record.Event.KeyEvent.bKeyDown)
         {
-            const KeyEvent* const pKeyEvent = static_cast<const KeyEvent* const>(currEvent.get());
-            if (pKeyEvent->IsKeyDown())
+            const KeyEvent keyEvent{ record.Event.KeyEvent };
+            if (WI_IsFlagSet(gci.Flags, CONSOLE_SUSPENDED) &&
+                !IsSystemKey(keyEvent.GetVirtualKeyCode()))
             {
-                if (WI_IsFlagSet(gci.Flags, CONSOLE_SUSPENDED) &&
-                    !IsSystemKey(pKeyEvent->GetVirtualKeyCode()))
-                {
-                    UnblockWriteConsole(CONSOLE_OUTPUT_SUSPENDED);
-                    continue;
-                }
-                else if (WI_IsFlagSet(InputMode, ENABLE_LINE_INPUT) && pKeyEvent->IsPauseKey())
-                {
-                    WI_SetFlag(gci.Flags, CONSOLE_SUSPENDED);
-                    continue;
-                }
+                UnblockWriteConsole(CONSOLE_OUTPUT_SUSPENDED);
+                consumed = true;
+            }
+            else if (WI_IsFlagSet(InputMode, ENABLE_LINE_INPUT) && keyEvent.IsPauseKey())
+            {
+                WI_SetFlag(gci.Flags, CONSOLE_SUSPENDED);
+                consumed = true;
             }
         }
-        outEvents.push_back(std::move(currEvent));
+
+        if (consumed && !filtering)
+        {
+            filtering = true;
+            _filteredRecords.assign(inRecords.begin(), inRecords.begin() + i);
+        }
+        else if (!consumed && filtering)
+        {
+            _filteredRecords.push_back(record);
+        }
     }
-    inEvents.swap(outEvents);
+
+    return filtering ? gsl::span<const INPUT_RECORD>{ _filteredRecords } : inRecords;
 }
 
 // Routine Description:
@@ -870,17 +891,12 @@ bool InputBuffer::IsInVirtualTerminalInputMode() const
 // - inEvents - Series of input records to insert into the buffer
 // Return Value:
 // - <none>
-void InputBuffer::_HandleTerminalInputCallback(std::deque<std::unique_ptr<IInputEvent>>& inEvents)
+void InputBuffer::_HandleTerminalInputCallback(const gsl::span<const INPUT_RECORD> inEvents)
 {
     try
     {
         // add all input events to the storage queue
-        while (!inEvents.empty())
-        {
-            std::unique_ptr<IInputEvent> inEvent = std::move(inEvents.front());
-            inEvents.pop_front();
-            _storage.push_back(std::move(inEvent));
-        }
+        _storage.push_back(inEvents);
 
         if (!_vtInputShouldSuppress)
         {
@@ -125,6 +125,24 @@ bool ConhostInternalGetSet::SetConsoleScreenBufferInfoEx(const CONSOLE_SCREEN_BU
     return SUCCEEDED(ServiceLocator::LocateGlobals().api.SetConsoleScreenBufferInfoExImpl(_io.GetActiveOutputBuffer(), screenBufferInfo));
 }
 
+// Method Description:
+// - Retrieves the cursor position, viewport and size of the active screen buffer.
+//   This is the same information GetConsoleScreenBufferInfoEx returns in its
+//   dwCursorPosition, srWindow and dwSize members, but without the cost of
+//   copying the color table and measuring the window.
+// Arguments:
+// - state - Receives the cursor position, the exclusive viewport and the buffer size.
+// Return Value:
+// - true if successful. false otherwise.
+bool ConhostInternalGetSet::PrivateGetScreenBufferState(VirtualTerminal::ScreenBufferState& state) const
+{
+    const auto& screenInfo = _io.GetActiveOutputBuffer().GetActiveBuffer();
+    state.cursorPosition = screenInfo.GetTextBuffer().GetCursor().GetPosition();
+    state.viewport = screenInfo.GetViewport().ToExclusive();
+    state.bufferSize = screenInfo.GetBufferSize().Dimensions();
+    return true;
+}
+
 // Routine Description:
 // - Connects the SetConsoleCursorPosition API call directly into our Driver Message servicing call inside Conhost.exe
 // Arguments:
@@ -213,7 +231,7 @@ SHORT ConhostInternalGetSet::PrivateGetLineWidth(const size_t row) const
 // - eventsWritten - on output, the number of events written
 // Return Value:
 // - true if successful (see DoSrvWriteConsoleInput). false otherwise.
-bool ConhostInternalGetSet::PrivateWriteConsoleInputW(std::deque<std::unique_ptr<IInputEvent>>& events,
+bool ConhostInternalGetSet::PrivateWriteConsoleInputW(const gsl::span<const INPUT_RECORD> events,
                                                       size_t& eventsWritten)
 {
     eventsWritten = 0;
@@ -787,6 +805,26 @@ bool ConhostInternalGetSet::PrivateScrollRegion(const SMALL_RECT scrollRect,
                                               standardFillAttrs));
 }
 
+// Routine Description:
+// - Erases everything but the given viewport rows from the active buffer
+//   and moves those rows to the top of the buffer. The erased rows are
+//   filled with the default attributes.
+// Arguments:
+// - viewportTop - The first row of the viewport.
+// - viewportHeight - The number of rows to keep.
+// Return value:
+// - true if successful. false otherwise.
+bool ConhostInternalGetSet::PrivateClearScrollback(const SHORT viewportTop, const SHORT viewportHeight)
+{
+    auto& textBuffer = _io.GetActiveOutputBuffer().GetTextBuffer();
+    textBuffer.ClearScrollback(viewportTop, viewportHeight, TextAttribute{});
+
+    // The buffer clears the rows lazily without notifying
+    // the renderer, so we have to repaint everything.
+    textBuffer.GetRenderTarget().TriggerRedrawAll();
+    return true;
+}
+
 // Routine Description:
 // - Checks if the InputBuffer is willing to accept VT Input directly
 //   PrivateIsVtInputEnabled is an internal-only "API" call that the vt commands can execute,
@@ -56,6 +56,7 @@ public:
 
     bool GetConsoleScreenBufferInfoEx(CONSOLE_SCREEN_BUFFER_INFOEX& screenBufferInfo) const override;
     bool SetConsoleScreenBufferInfoEx(const CONSOLE_SCREEN_BUFFER_INFOEX& screenBufferInfo) override;
+    bool PrivateGetScreenBufferState(Microsoft::Console::VirtualTerminal::ScreenBufferState& state) const override;
 
     bool SetConsoleCursorPosition(const COORD position) override;
 
@@ -66,7 +67,7 @@ public:
     bool PrivateResetLineRenditionRange(const size_t startRow, const size_t endRow) override;
     SHORT PrivateGetLineWidth(const size_t row) const override;
 
-    bool PrivateWriteConsoleInputW(std::deque<std::unique_ptr<IInputEvent>>& events,
+    bool PrivateWriteConsoleInputW(const gsl::span<const INPUT_RECORD> events,
                                    size_t& eventsWritten) override;
 
     bool SetConsoleWindowInfo(bool const absolute,
@@ -142,6 +143,8 @@ public:
                              const COORD destinationOrigin,
                              const bool standardFillAttrs) noexcept override;
 
+    bool PrivateClearScrollback(const SHORT viewportTop, const SHORT viewportHeight) override;
+
     bool PrivateIsVtInputEnabled() const override;
 
     bool PrivateAddHyperlink(const std::wstring_view uri, const std::wstring_view params) const override;
@@ -18,6 +18,14 @@
 
 using Microsoft::Console::Interactivity::ServiceLocator;
 
+// Routine Description:
+// - Returns true for characters that ProcessInput simply stores in the edit line,
+//   as opposed to control characters, backspaces and the like.
+static constexpr bool _isPrintableChar(const wchar_t wch) noexcept
+{
+    return wch >= L' ' && wch != EXTKEY_ERASE_PREV_WORD && wch != UNICODE_BACKSPACE2;
+}
+
 // Routine Description:
 // - Constructs cooked read data class to hold context across key presses while a user is modifying their 'input line'.
 // Arguments:
@@ -841,17 +849,26 @@ size_t COOKED_READ_DATA::Write(const std::wstring_view wstr)
         size_t NumSpaces = 0;
         SHORT ScrollY = 0;
 
-        FAIL_FAST_IF_NTSTATUS_FAILED(WriteCharsLegacy(ScreenInfo(),
-                                                      _backupLimit,
-                                                      _bufPtr,
-                                                      _bufPtr,
-                                                      &bytesInserted,
-                                                      &NumSpaces,
-                                                      OriginalCursorPosition().X,
-                                                      WC_DESTRUCTIVE_BACKSPACE | WC_KEEP_CURSOR_VISIBLE | WC_PRINTABLE_CONTROL_CHARS,
-                                                      &ScrollY));
-        OriginalCursorPosition().Y += ScrollY;
-        VisibleCharCount() += NumSpaces;
+        // Like ProcessInput, a failure to echo the text doesn't fail the read.
+        // The text is in the buffer either way, so the client still receives it.
+        const auto status = WriteCharsLegacy(ScreenInfo(),
+                                             _backupLimit,
+                                             _bufPtr,
+                                             _bufPtr,
+                                             &bytesInserted,
+                                             &NumSpaces,
+                                             OriginalCursorPosition().X,
+                                             WC_DESTRUCTIVE_BACKSPACE | WC_KEEP_CURSOR_VISIBLE | WC_PRINTABLE_CONTROL_CHARS,
+                                             &ScrollY);
+        if (NT_SUCCESS(status))
+        {
+            OriginalCursorPosition().Y += ScrollY;
+            VisibleCharCount() += NumSpaces;
+        }
+        else
+        {
+            RIPMSG1(RIP_WARNING, "WriteCharsLegacy failed 0x%x", status);
+        }
     }
     _bufPtr += charsInserted;
 
@@ -980,6 +997,29 @@ void COOKED_READ_DATA::SavePendingInput(const size_t index, const bool multiline
         }
         else
         {
+            // A paste arrives as a long run of printable characters. Inserting all of
+            // the ones that are already waiting at once shifts the rest of the line and
+            // redraws it once per run, instead of once per character.
+            if (_isPrintableChar(wch))
+            {
+                try
+                {
+                    std::wstring run(1, wch);
+                    _readPrintableRun(run);
+                    if (run.size() > 1)
+                    {
+                        _insertPrintableRun(run);
+                        continue;
+                    }
+                }
+                catch (...)
+                {
+                    Status = NTSTATUS_FROM_HRESULT(wil::ResultFromCaughtException());
+                    _bytesRead = 0;
+                    break;
+                }
+            }
+
             if (ProcessInput(wch, keyState, Status))
             {
                 CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
@@ -991,6 +1031,120 @@ void COOKED_READ_DATA::SavePendingInput(const size_t index, const bool multiline
     return Status;
 }
 
+// Routine Description:
+// - Appends the printable characters that are already waiting in the input buffer to the
+//   given run. Stops at the first event that has to go through ProcessInput on its own,
+//   like ENTER or a command line editing key, and never waits for more input.
+// - Key up events in between are skipped, just like GetChar does.
+// Arguments:
+// - run - the run to append the characters to
+// Return Value:
+// - <none>
+void COOKED_READ_DATA::_readPrintableRun(std::wstring& run)
+{
+    // There's no point in reading more than the edit line can hold.
+    const size_t capacity = _bufferSize / sizeof(wchar_t);
+    std::vector<INPUT_RECORD> records;
+
+    while (run.size() < capacity)
+    {
+        records.clear();
+        if (!NT_SUCCESS(_pInputBuffer->Read(records, 1, true, false, true, true)) || records.empty())
+        {
+            break;
+        }
+
+        const auto& record = records.front();
+        if (record.EventType != KEY_EVENT)
+        {
+            break;
+        }
+
+        const KeyEvent keyEvent{ record.Event.KeyEvent };
+        if (!keyEvent.IsKeyDown())
+        {
+            // Releasing ALT can complete an ALT+Numpad sequence, which GetChar has to handle.
+            if (keyEvent.GetVirtualKeyCode() == VK_MENU)
+            {
+                break;
+            }
+
+            records.clear();
+            LOG_IF_NTSTATUS_FAILED(_pInputBuffer->Read(records, 1, false, false, true, true));
+            continue;
+        }
+
+        if (!_isPrintableChar(keyEvent.GetCharData()) ||
+            keyEvent.IsCommandLineEditingKey() ||
+            keyEvent.GetVirtualKeyCode() == VK_ESCAPE)
+        {
+            break;
+        }
+
+        wchar_t wch = UNICODE_NULL;
+        if (!NT_SUCCESS(GetChar(_pInputBuffer, &wch, false, nullptr, nullptr, nullptr)))
+        {
+            break;
+        }
+        run.push_back(wch);
+    }
+}
+
+// Routine Description:
+// - Inserts a run of printable characters at the current position, with the same result
+//   as if ProcessInput had been called for each of them. The rest of the line is only
+//   shifted once, and it's only redrawn once (or twice, if the run overwrites the end of
+//   the line and then continues past it).
+// Arguments:
+// - run - the characters to insert
+// Return Value:
+// - <none>
+void COOKED_READ_DATA::_insertPrintableRun(std::wstring_view run)
+{
+    // ProcessInput stops accepting characters two short of the end of the buffer.
+    const size_t limit = _bufferSize / sizeof(wchar_t) - 2;
+
+    while (!run.empty())
+    {
+        const size_t length = _bytesRead / sizeof(wchar_t);
+        if (length >= limit)
+        {
+            return;
+        }
+
+        if (AtEol())
+        {
+            Write(run.substr(0, limit - length));
+            return;
+        }
+
+        size_t count;
+        if (_insertMode)
+        {
+            count = std::min(run.size(), limit - length);
+            memmove(_bufPtr + count,
+                    _bufPtr,
+                    _bytesRead - (_currentPosition * sizeof(WCHAR)));
+            _bytesRead += count * sizeof(WCHAR);
+        }
+        else
+        {
+            count = std::min(run.size(), length - _currentPosition);
+        }
+
+        std::copy_n(run.data(), count, _bufPtr);
+        _bufPtr += count;
+        _currentPosition += count;
+        run = run.substr(count);
+
+        if (_echoInput)
+        {
+            DeleteCommandLine(*this, FALSE);
+            RedrawCommandLine(*this);
+        }
+    }
+}
+
 // Routine Description:
 // - handles any tasks that need to be completed after the read input loop finishes
 // Arguments:
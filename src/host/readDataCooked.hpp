@@ -159,4 +159,7 @@ private:
     [[nodiscard]] NTSTATUS _readCharInputLoop(const bool isUnicode, size_t& numBytes) noexcept;
 
     [[nodiscard]] NTSTATUS _handlePostCharInputLoop(const bool isUnicode, size_t& numBytes, ULONG& controlKeyState) noexcept;
+
+    void _readPrintableRun(std::wstring& run);
+    void _insertPrintableRun(std::wstring_view run);
 };
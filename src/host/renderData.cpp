@@ -87,7 +87,9 @@ std::vector<Viewport> RenderData::GetSelectionRects() noexcept
 //      operation.
 //   Callers should make sure to also call RenderData::UnlockConsole once
 //      they're done with any querying they need to do.
-void RenderData::LockConsole() noexcept
+// Arguments:
+// - site - unused. The console lock doesn't gather diagnostics.
+void RenderData::LockConsole(const LockCallSite& /*site*/) noexcept
 {
     ::LockConsole();
 }
@@ -99,6 +101,20 @@ void RenderData::UnlockConsole() noexcept
     ::UnlockConsole();
 }
 
+// Method Description:
+// - The console lock has no shared mode, so readers take it exclusively.
+void RenderData::LockConsoleShared(const LockCallSite& /*site*/) noexcept
+{
+    ::LockConsole();
+}
+
+// Method Description:
+// - Unlocks the console after a call to RenderData::LockConsoleShared.
+void RenderData::UnlockConsoleShared() noexcept
+{
+    ::UnlockConsole();
+}
+
 #pragma endregion
 
 #pragma region IRenderData
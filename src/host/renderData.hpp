@@ -31,8 +31,10 @@ public:
 
     std::vector<Microsoft::Console::Types::Viewport> GetSelectionRects() noexcept override;
 
-    void LockConsole() noexcept override;
+    void LockConsole(const Microsoft::Console::Types::LockCallSite& site = Microsoft::Console::Types::LockCallSite::Current()) noexcept override;
     void UnlockConsole() noexcept override;
+    void LockConsoleShared(const Microsoft::Console::Types::LockCallSite& site = Microsoft::Console::Types::LockCallSite::Current()) noexcept override;
+    void UnlockConsoleShared() noexcept override;
 #pragma endregion
 
 #pragma region IRenderData
@@ -51,6 +51,7 @@ SCREEN_INFORMATION::SCREEN_INFORMATION(
     _viewport(Viewport::Empty()),
     _psiAlternateBuffer{ nullptr },
     _psiMainBuffer{ nullptr },
+    _psiRecycledAltBuffer{ nullptr },
     _rcAltSavedClientNew{ 0 },
     _rcAltSavedClientOld{ 0 },
     _fAltWindowChanged{ false },
@@ -206,6 +207,20 @@ void SCREEN_INFORMATION::s_InsertScreenBuffer(_In_ SCREEN_INFORMATION* const pSc
 // Note:
 // - The console lock must be held when calling this routine.
 void SCREEN_INFORMATION::s_RemoveScreenBuffer(_In_ SCREEN_INFORMATION* const pScreenInfo)
+{
+    s_UnlinkScreenBuffer(pScreenInfo);
+    delete pScreenInfo;
+}
+
+// Routine Description:
+// - This routine removes the screen buffer pointer from the console's list of screen buffers,
+//   without freeing it. If it was the active buffer, another buffer is made active.
+// Arguments:
+// - ScreenInfo - Pointer to screen information structure.
+// Return Value:
+// Note:
+// - The console lock must be held when calling this routine.
+void SCREEN_INFORMATION::s_UnlinkScreenBuffer(_In_ SCREEN_INFORMATION* const pScreenInfo)
 {
     CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
     if (pScreenInfo == gci.ScreenBuffers)
@@ -243,8 +258,6 @@ void SCREEN_INFORMATION::s_RemoveScreenBuffer(_In_ SCREEN_INFORMATION* const pSc
             gci.pCurrentScreenBuffer = nullptr;
         }
     }
-
-    delete pScreenInfo;
 }
 
 #pragma endregion
@@ -285,6 +298,9 @@ void SCREEN_INFORMATION::_FreeOutputStateMachine()
             s_RemoveScreenBuffer(_psiAlternateBuffer);
         }
 
+        // The recycled alt buffer shares our state machine, so it has to go first.
+        _psiRecycledAltBuffer.reset();
+
         _stateMachine.reset();
     }
 }
@@ -1878,6 +1894,10 @@ const SCREEN_INFORMATION& SCREEN_INFORMATION::GetMainBuffer() const
 // - Instantiates a new buffer to be used as an alternate buffer. This buffer
 //     does not have a driver handle associated with it and shares a state
 //     machine with the main buffer it belongs to.
+// - If the alternate buffer of the previous alt screen session is still around
+//     and has the right size, it's reset and reused instead. Applications like
+//     less or htop switch to the alt buffer all the time and there's no need to
+//     allocate an entire screen buffer for each of those switches.
 // TODO: MSFT:19817348 Don't create alt screenbuffer's via an out SCREEN_INFORMATION**
 // Parameters:
 // - ppsiNewScreenBuffer - a pointer to receive the newly created buffer.
@@ -1895,6 +1915,31 @@ const SCREEN_INFORMATION& SCREEN_INFORMATION::GetMainBuffer() const
     auto initAttributes = GetAttributes();
     initAttributes.SetStandardErase();
 
+    auto& recycled = GetMainBuffer()._psiRecycledAltBuffer;
+    if (recycled && recycled->_CanRecycleAsAltBuffer(WindowSize, existingFont))
+    {
+        try
+        {
+            recycled->_RecycleAsAltBuffer(initAttributes, GetPopupAttributes());
+        }
+        catch (...)
+        {
+            recycled.reset();
+            return NTSTATUS_FROM_HRESULT(wil::ResultFromCaughtException());
+        }
+
+        // Update the alt buffer's cursor style to match our own.
+        auto& myCursor = GetTextBuffer().GetCursor();
+        recycled->GetTextBuffer().GetCursor().SetStyle(myCursor.GetSize(), myCursor.GetColor(), myCursor.GetType());
+
+        *ppsiNewScreenBuffer = recycled.release();
+        s_InsertScreenBuffer(*ppsiNewScreenBuffer);
+        return STATUS_SUCCESS;
+    }
+
+    // The recycled buffer doesn't fit (anymore). Don't hold onto it.
+    recycled.reset();
+
     NTSTATUS Status = SCREEN_INFORMATION::CreateInstance(WindowSize,
                                                          existingFont,
                                                          WindowSize,
@@ -1921,6 +1966,62 @@ const SCREEN_INFORMATION& SCREEN_INFORMATION::GetMainBuffer() const
     return Status;
 }
 
+// Routine Description:
+// - Checks whether this (previously used) alternate buffer can be reused
+//     for a new alt screen session, instead of allocating a new buffer.
+// Parameters:
+// - windowSize - the size the new alternate buffer needs to have.
+// - font - the font the new alternate buffer needs to use.
+// Return value:
+// - true if the buffer has the given size and font.
+bool SCREEN_INFORMATION::_CanRecycleAsAltBuffer(const COORD windowSize, const FontInfo& font) const
+{
+    return GetBufferSize().Dimensions() == windowSize &&
+           _viewport.Dimensions() == windowSize &&
+           _currentFont == font;
+}
+
+// Routine Description:
+// - Resets a previously used alternate buffer in place, leaving it in the same
+//     state _CreateAltBuffer would have created a brand new one in.
+// Parameters:
+// - attributes - the attributes to clear the buffer with.
+// - popupAttributes - the popup attributes of the main buffer.
+// Return value:
+// - <none>
+void SCREEN_INFORMATION::_RecycleAsAltBuffer(const TextAttribute& attributes, const TextAttribute& popupAttributes)
+{
+    const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+
+    OutputMode = ENABLE_PROCESSED_OUTPUT | ENABLE_WRAP_AT_EOL_OUTPUT;
+    if (gci.GetVirtTermLevel() != 0)
+    {
+        OutputMode |= ENABLE_VIRTUAL_TERMINAL_PROCESSING;
+    }
+
+    ResizingWindow = 0;
+    WheelDelta = 0;
+    HWheelDelta = 0;
+    WriteConsoleDbcsLeadByte[0] = 0;
+    WriteConsoleDbcsLeadByte[1] = 0;
+    FillOutDbcsLeadChar = 0;
+    ScrollScale = 1ul;
+
+    _scrollMargins = Viewport::FromCoord({ 0 });
+    _rcAltSavedClientNew = { 0 };
+    _rcAltSavedClientOld = { 0 };
+    _fAltWindowChanged = false;
+    _PopupAttributes = popupAttributes;
+    _ignoreLegacyEquivalentVTAttributes = false;
+
+    _textBuffer->Reinitialize(attributes);
+    _textBuffer->GetCursor().SetColor(gci.GetCursorColor());
+    _textBuffer->GetCursor().SetType(gci.GetCursorType());
+
+    _viewport = Viewport::FromDimensions({ 0, 0 }, _viewport.Dimensions());
+    UpdateBottom();
+}
+
 // Routine Description:
 // - Creates an "alternate" screen buffer for this buffer. In virtual terminals, there exists both a "main"
 //     screen buffer and an alternate. ASBSET creates a new alternate, and switches to it. If there is an already
@@ -1995,8 +2096,10 @@ void SCREEN_INFORMATION::UseMainScreenBuffer()
 
         SCREEN_INFORMATION* psiAlt = psiMain->_psiAlternateBuffer;
         psiMain->_psiAlternateBuffer = nullptr;
-        s_RemoveScreenBuffer(psiAlt); // this will also delete the alt buffer
-        // deleting the alt buffer will give the GetSet back to its main
+        // Instead of deleting the alt buffer, hold onto it so that the
+        // next UseAlternateScreenBuffer() can reset and reuse it.
+        s_UnlinkScreenBuffer(psiAlt);
+        psiMain->_psiRecycledAltBuffer.reset(psiAlt);
 
         // Tell the VT MouseInput handler that we're in the main buffer now
         gci.GetActiveInputBuffer()->GetTerminalInput().UseMainScreenBuffer();
@@ -271,6 +271,9 @@ private:
     void _FreeOutputStateMachine();
 
     [[nodiscard]] NTSTATUS _CreateAltBuffer(_Out_ SCREEN_INFORMATION** const ppsiNewScreenBuffer);
+    bool _CanRecycleAsAltBuffer(const COORD windowSize, const FontInfo& font) const;
+    void _RecycleAsAltBuffer(const TextAttribute& attributes, const TextAttribute& popupAttributes);
+    static void s_UnlinkScreenBuffer(_In_ SCREEN_INFORMATION* const pScreenInfo);
 
     bool _IsAltBuffer() const;
     bool _IsInPtyMode() const;
@@ -286,6 +289,9 @@ private:
 
     SCREEN_INFORMATION* _psiAlternateBuffer; // The VT "Alternate" screen buffer.
     SCREEN_INFORMATION* _psiMainBuffer; // A pointer to the main buffer, if this is the alternate buffer.
+    // The alternate buffer of the previous alt screen session. It's no longer part of the
+    // console's list of buffers, but kept around so that it can be reset and reused.
+    std::unique_ptr<SCREEN_INFORMATION> _psiRecycledAltBuffer;
 
     RECT _rcAltSavedClientNew;
     RECT _rcAltSavedClientOld;
@@ -59,7 +59,8 @@ Settings::Settings() :
     _DefaultForeground(INVALID_COLOR),
     _DefaultBackground(INVALID_COLOR),
     _fUseDx(false),
-    _fCopyColor(false)
+    _fCopyColor(false),
+    _fPersistHistory(false)
 {
     _dwScreenBufferSize.X = 80;
     _dwScreenBufferSize.Y = 25;
@@ -835,3 +836,13 @@ bool Settings::GetCopyColor() const noexcept
 {
     return _fCopyColor;
 }
+
+// Routine Description:
+// - Determines whether the command history of each app is written to disk
+//   and restored when the app reads its first line in a later session.
+// Return Value:
+// - True if the command history should be persisted.
+bool Settings::GetPersistHistory() const noexcept
+{
+    return _fPersistHistory;
+}
@@ -184,6 +184,7 @@ public:
 
     bool GetUseDx() const noexcept;
     bool GetCopyColor() const noexcept;
+    bool GetPersistHistory() const noexcept;
 
 private:
     DWORD _dwHotKey;
@@ -228,6 +229,7 @@ private:
     bool _fScreenReversed;
     bool _fUseDx;
     bool _fCopyColor;
+    bool _fPersistHistory;
 
     std::array<COLORREF, XTERM_COLOR_TABLE_SIZE> _colorTable;
 
@@ -472,6 +472,10 @@ size_t RetrieveNumberOfSpaces(_In_ SHORT sOriginalCursorPositionX,
 
     SCREEN_INFORMATION& screenInfo = gci.GetActiveOutputBuffer();
     CommandHistory* const pCommandHistory = CommandHistory::s_Find(processData);
+    if (pCommandHistory)
+    {
+        pCommandHistory->EnsureLoaded();
+    }
 
     try
     {
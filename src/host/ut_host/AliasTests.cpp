@@ -371,6 +371,28 @@ class AliasTests
         VERIFY_ARE_EQUAL(dwLinesExpected, dwLines, L"Line count be updated to 1.");
     }
 
+    TEST_METHOD(TestMatchAndCopyIgnoresCase)
+    {
+        std::wstring exe(L"Exe.exe");
+        std::wstring source(L"SoUrCe");
+        std::wstring target(L"someTarget $1");
+        Alias::s_TestAddAlias(exe, source, target);
+
+        Log::Comment(L"Both the exe name and the alias should be matched case-insensitively.");
+        size_t lineCount = 0;
+        auto result = Alias::s_MatchAndCopyAlias(L"  SOURCE Arg\r\n", L"EXE.EXE", lineCount);
+        VERIFY_ARE_EQUAL(String(L"someTarget Arg\r\n"), String(result.c_str()));
+        VERIFY_ARE_EQUAL(1u, lineCount);
+
+        Log::Comment(L"An alias that's only the prefix of the first word doesn't match.");
+        result = Alias::s_MatchAndCopyAlias(L"sourcefile", L"exe.exe", lineCount);
+        VERIFY_IS_TRUE(result.empty());
+
+        Log::Comment(L"Neither does one that's used as an argument.");
+        result = Alias::s_MatchAndCopyAlias(L"dir source", L"exe.exe", lineCount);
+        VERIFY_IS_TRUE(result.empty());
+    }
+
     TEST_METHOD(TrimTrailing)
     {
         BEGIN_TEST_METHOD_PROPERTIES()
@@ -874,4 +874,120 @@ class ApiRoutinesTests
 
         ValidateComplexScreen(si, background, fill, scrollRect, Viewport::FromInclusive(scroll), destination, clipViewport);
     }
+
+    TEST_METHOD(ApiWriteConsoleOutputWClipped)
+    {
+        CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        SCREEN_INFORMATION& si = gci.GetActiveOutputBuffer();
+
+        VERIFY_SUCCEEDED(si.GetTextBuffer().ResizeTraditional({ 5, 5 }), L"Make the buffer small so this doesn't take forever.");
+
+        CHAR_INFO background;
+        background.Char.UnicodeChar = L'Z';
+        background.Attributes = FOREGROUND_GREEN;
+
+        // A 4x4 request where every cell is different, so that we can tell where each one ended up.
+        std::vector<CHAR_INFO> source(16);
+        for (size_t i = 0; i < source.size(); ++i)
+        {
+            source.at(i).Char.UnicodeChar = gsl::narrow_cast<wchar_t>(L'a' + i);
+            source.at(i).Attributes = gsl::narrow_cast<WORD>(i % 2 ? FOREGROUND_RED : BACKGROUND_BLUE);
+        }
+
+        const auto verifyWrite = [&](const Viewport& request, const Viewport& expectedWritten) {
+            si.GetActiveBuffer().ClearTextData(); // Clean out screen
+            si.GetActiveBuffer().Write(OutputCellIterator(background), { 0, 0 }); // Fill entire screen with green Zs.
+
+            auto written = Viewport::Empty();
+            VERIFY_SUCCEEDED(_pApiRoutines->WriteConsoleOutputWImpl(si, source, request, written));
+            VERIFY_ARE_EQUAL(expectedWritten.ToInclusive(), written.ToInclusive());
+
+            // Cells inside of the written rectangle come from the same position of the request,
+            // in rows that are as wide as the request. Everything else must be untouched.
+            auto it = si.GetActiveBuffer().GetCellDataAt({ 0, 0 });
+            while (it)
+            {
+                if (expectedWritten.IsInBounds(it._pos))
+                {
+                    const auto index = gsl::narrow_cast<size_t>((it._pos.Y - request.Top()) * request.Width() + (it._pos.X - request.Left()));
+                    VERIFY_ARE_EQUAL(source.at(index), gci.AsCharInfo(*it));
+                }
+                else
+                {
+                    VERIFY_ARE_EQUAL(background, gci.AsCharInfo(*it));
+                }
+                it++;
+            }
+        };
+
+        Log::Comment(L"Write a request that sticks out of the top left corner of the buffer.");
+        verifyWrite(Viewport::FromDimensions({ -1, -1 }, { 4, 4 }), Viewport::FromInclusive({ 0, 0, 2, 2 }));
+
+        Log::Comment(L"Write a request that sticks out of the bottom right corner of the buffer.");
+        verifyWrite(Viewport::FromDimensions({ 3, 3 }, { 4, 4 }), Viewport::FromInclusive({ 3, 3, 4, 4 }));
+
+        Log::Comment(L"Write a request that fits into the buffer.");
+        verifyWrite(Viewport::FromDimensions({ 1, 0 }, { 4, 4 }), Viewport::FromDimensions({ 1, 0 }, { 4, 4 }));
+    }
+
+    TEST_METHOD(ApiReadConsoleOutputWClipped)
+    {
+        CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        SCREEN_INFORMATION& si = gci.GetActiveOutputBuffer();
+
+        VERIFY_SUCCEEDED(si.GetTextBuffer().ResizeTraditional({ 5, 5 }), L"Make the buffer small so this doesn't take forever.");
+
+        // Give every cell of the buffer a different character and alternating colors.
+        si.GetActiveBuffer().ClearTextData(); // Clean out screen
+        for (SHORT y = 0; y < 5; ++y)
+        {
+            for (SHORT x = 0; x < 5; ++x)
+            {
+                CHAR_INFO cell;
+                cell.Char.UnicodeChar = gsl::narrow_cast<wchar_t>(L'A' + y * 5 + x);
+                cell.Attributes = gsl::narrow_cast<WORD>(x % 2 ? FOREGROUND_RED : BACKGROUND_BLUE);
+                si.GetActiveBuffer().Write(OutputCellIterator(cell, 1), { x, y });
+            }
+        }
+
+        CHAR_INFO untouched;
+        untouched.Char.UnicodeChar = L'#';
+        untouched.Attributes = 0;
+
+        const auto verifyRead = [&](const Viewport& request, const Viewport& expectedRead) {
+            std::vector<CHAR_INFO> target(gsl::narrow_cast<size_t>(request.Width()) * request.Height(), untouched);
+
+            auto read = Viewport::Empty();
+            VERIFY_SUCCEEDED(_pApiRoutines->ReadConsoleOutputWImpl(si, target, request, read));
+            VERIFY_ARE_EQUAL(expectedRead.ToInclusive(), read.ToInclusive());
+
+            // The cells that were read land at the same position of the request, in rows
+            // that are as wide as the request. The clipped parts of the target are skipped over.
+            for (SHORT y = 0; y < request.Height(); ++y)
+            {
+                for (SHORT x = 0; x < request.Width(); ++x)
+                {
+                    const COORD position{ gsl::narrow_cast<SHORT>(request.Left() + x), gsl::narrow_cast<SHORT>(request.Top() + y) };
+                    const auto& cell = target.at(gsl::narrow_cast<size_t>(y * request.Width() + x));
+                    if (expectedRead.IsInBounds(position))
+                    {
+                        VERIFY_ARE_EQUAL(gci.AsCharInfo(*si.GetActiveBuffer().GetCellDataAt(position)), cell);
+                    }
+                    else
+                    {
+                        VERIFY_ARE_EQUAL(untouched, cell);
+                    }
+                }
+            }
+        };
+
+        Log::Comment(L"Read a request that sticks out of the left and bottom of the buffer.");
+        verifyRead(Viewport::FromDimensions({ -1, 3 }, { 7, 4 }), Viewport::FromInclusive({ 0, 3, 4, 4 }));
+
+        Log::Comment(L"Read a request that sticks out of the top right corner of the buffer.");
+        verifyRead(Viewport::FromDimensions({ 2, -2 }, { 4, 4 }), Viewport::FromInclusive({ 2, 0, 4, 1 }));
+
+        Log::Comment(L"Read a request that fits into the buffer.");
+        verifyRead(Viewport::FromDimensions({ 1, 1 }, { 3, 3 }), Viewport::FromDimensions({ 1, 1 }, { 3, 3 }));
+    }
 };
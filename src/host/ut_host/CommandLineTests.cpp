@@ -100,6 +100,25 @@ class CommandLineTests
         cookedReadData._bufPtr = cookedReadData._backupLimit + column;
     }
 
+    // Pastes the given text into the input buffer as a key down and a key up event per character.
+    void WritePaste(const std::wstring_view text)
+    {
+        std::vector<INPUT_RECORD> records;
+        for (const auto wch : text)
+        {
+            for (const auto keyDown : { TRUE, FALSE })
+            {
+                INPUT_RECORD record{};
+                record.EventType = KEY_EVENT;
+                record.Event.KeyEvent.bKeyDown = keyDown;
+                record.Event.KeyEvent.wRepeatCount = 1;
+                record.Event.KeyEvent.uChar.UnicodeChar = wch;
+                records.push_back(record);
+            }
+        }
+        ServiceLocator::LocateGlobals().getConsoleInformation().pInputBuffer->Write(records);
+    }
+
     TEST_METHOD(CanCycleCommandHistory)
     {
         auto buffer = std::make_unique<wchar_t[]>(PROMPT_SIZE);
@@ -534,4 +553,39 @@ class CommandLineTests
             }
         }
     }
+
+    TEST_METHOD(CanInsertPasteAtOnce)
+    {
+        auto buffer = std::make_unique<wchar_t[]>(PROMPT_SIZE);
+        VERIFY_IS_NOT_NULL(buffer.get());
+
+        auto& cookedReadData = ServiceLocator::LocateGlobals().getConsoleInformation().CookedReadData();
+        InitCookedReadData(cookedReadData, nullptr, buffer.get(), PROMPT_SIZE);
+        SetPrompt(cookedReadData, L"dir C:\\");
+        MoveCursor(cookedReadData, 4);
+
+        size_t numBytes = 0;
+        ULONG controlKeyState = 0;
+
+        Log::Comment(L"In insert mode a paste in the middle of the line is inserted in front of the cursor.");
+        cookedReadData.SetInsertMode(true);
+        WritePaste(L"/s /b ");
+        VERIFY_ARE_EQUAL(static_cast<HRESULT>(CONSOLE_STATUS_WAIT), cookedReadData.Read(true, numBytes, controlKeyState));
+        VerifyPromptText(cookedReadData, L"dir /s /b C:\\");
+        VERIFY_ARE_EQUAL(10u, cookedReadData.InsertionPoint());
+
+        Log::Comment(L"In overwrite mode it replaces the rest of the line and continues past its end.");
+        cookedReadData.SetInsertMode(false);
+        WritePaste(L"D:\\temp");
+        VERIFY_ARE_EQUAL(static_cast<HRESULT>(CONSOLE_STATUS_WAIT), cookedReadData.Read(true, numBytes, controlKeyState));
+        VerifyPromptText(cookedReadData, L"dir /s /b D:\\temp");
+        VERIFY_ARE_EQUAL(17u, cookedReadData.InsertionPoint());
+
+        Log::Comment(L"A paste that doesn't fit is cut off where typing would stop accepting characters.");
+        cookedReadData.SetInsertMode(true);
+        WritePaste(std::wstring(PROMPT_SIZE, L'x'));
+        VERIFY_ARE_EQUAL(static_cast<HRESULT>(CONSOLE_STATUS_WAIT), cookedReadData.Read(true, numBytes, controlKeyState));
+        VerifyPromptText(cookedReadData, L"dir /s /b D:\\temp" + std::wstring(PROMPT_SIZE - 2 - 17, L'x'));
+        VERIFY_ARE_EQUAL(0u, ServiceLocator::LocateGlobals().getConsoleInformation().pInputBuffer->GetNumberOfReadyEvents());
+    }
 };
@@ -242,6 +242,231 @@ class HistoryTests
         VERIFY_ARE_EQUAL(2ul, history->GetNumberOfCommands());
     }
 
+    TEST_METHOD(FindMatchingCommand)
+    {
+        auto history = CommandHistory::s_Allocate(_manyApps[0], _MakeHandle(0));
+        VERIFY_IS_NOT_NULL(history);
+        for (const auto command : { L"dir", L"cd ..", L"DIR /w", L"echo", L"dir /p" })
+        {
+            VERIFY_SUCCEEDED(history->Add(command, false));
+        }
+
+        const auto justLooking = CommandHistory::MatchOptions::JustLooking;
+        const auto exactMatch = CommandHistory::MatchOptions::ExactMatch | justLooking;
+        SHORT index = 0;
+
+        Log::Comment(L"The search starts before the given index and ignores the case.");
+        VERIFY_IS_TRUE(history->FindMatchingCommand(L"di", 4, index, justLooking));
+        VERIFY_ARE_EQUAL(2, index);
+        VERIFY_IS_TRUE(history->FindMatchingCommand(L"di", 2, index, justLooking));
+        VERIFY_ARE_EQUAL(0, index);
+
+        Log::Comment(L"It wraps around to the newest command.");
+        VERIFY_IS_TRUE(history->FindMatchingCommand(L"di", 0, index, justLooking));
+        VERIFY_ARE_EQUAL(4, index);
+
+        Log::Comment(L"An exact match skips the commands that only start with the given one.");
+        VERIFY_IS_TRUE(history->FindMatchingCommand(L"DIR", 4, index, exactMatch));
+        VERIFY_ARE_EQUAL(0, index);
+        VERIFY_IS_FALSE(history->FindMatchingCommand(L"di", 4, index, exactMatch));
+        VERIFY_IS_FALSE(history->FindMatchingCommand(L"ping", 4, index, justLooking));
+
+        Log::Comment(L"Swapping and removing commands keeps the lookups in sync.");
+        history->Swap(0, 1);
+        VERIFY_IS_TRUE(history->FindMatchingCommand(L"dir", 4, index, exactMatch));
+        VERIFY_ARE_EQUAL(1, index);
+        VERIFY_ARE_EQUAL(String(L"dir"), String(history->Remove(1).c_str()));
+        VERIFY_IS_FALSE(history->FindMatchingCommand(L"dir", 3, index, exactMatch));
+        VERIFY_IS_TRUE(history->FindMatchingCommand(L"dir", 3, index, justLooking));
+        VERIFY_ARE_EQUAL(1, index);
+        VERIFY_IS_TRUE(history->FindMatchingCommand(L"c", 3, index, justLooking));
+        VERIFY_ARE_EQUAL(0, index);
+    }
+
+    TEST_METHOD(PersistedCommandsAreLoadedAndAppended)
+    {
+        const auto path = (std::filesystem::temp_directory_path() / L"HistoryTests.history").wstring();
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        auto cleanup = wil::scope_exit([&]() { std::filesystem::remove(path, ec); });
+
+        auto store = std::make_shared<HistoryStore>(path);
+        store->Append(L"dir");
+        store->Append(L"cd ..");
+
+        auto history = CommandHistory::s_Allocate(_manyApps[0], _MakeHandle(0));
+        VERIFY_IS_NOT_NULL(history);
+        VERIFY_SUCCEEDED(history->Add(L"echo", false));
+
+        history->_store = store;
+        history->EnsureLoaded();
+
+        Log::Comment(L"The persisted commands go before the ones of this session.");
+        VERIFY_ARE_EQUAL(3ul, history->GetNumberOfCommands());
+        VERIFY_ARE_EQUAL(String(L"dir"), String(history->GetNth(0).data()));
+        VERIFY_ARE_EQUAL(String(L"cd .."), String(history->GetNth(1).data()));
+        VERIFY_ARE_EQUAL(String(L"echo"), String(history->GetNth(2).data()));
+
+        SHORT index = 0;
+        VERIFY_IS_TRUE(history->FindMatchingCommand(L"CD", 2, index, CommandHistory::MatchOptions::JustLooking));
+        VERIFY_ARE_EQUAL(1, index);
+
+        Log::Comment(L"New commands are appended to the file.");
+        VERIFY_SUCCEEDED(history->Add(L"ping", false));
+        const std::vector<std::wstring> expected{ L"dir", L"cd ..", L"ping" };
+        VERIFY_IS_TRUE(expected == store->Load());
+
+        Log::Comment(L"Emptying the history empties the file.");
+        history->Empty();
+        VERIFY_IS_TRUE(store->Load().empty());
+    }
+
+    TEST_METHOD(HistoryStoreStopsAtTruncatedRecord)
+    {
+        const auto path = (std::filesystem::temp_directory_path() / L"HistoryTests.history").wstring();
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        auto cleanup = wil::scope_exit([&]() { std::filesystem::remove(path, ec); });
+
+        HistoryStore store{ path };
+        store.Append(L"dir");
+        store.Append(L"cd ..");
+        store.Flush();
+
+        Log::Comment(L"Append a record that claims 10 characters but only has 3.");
+        {
+            std::ofstream file{ path, std::ios::binary | std::ios::app };
+            const uint32_t length = 10;
+            file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+            file.write(reinterpret_cast<const char*>(L"abc"), 3 * sizeof(wchar_t));
+        }
+
+        const std::vector<std::wstring> expected{ L"dir", L"cd .." };
+        std::optional<uint64_t> tornRecordOffset;
+        VERIFY_IS_TRUE(expected == store.Load(&tornRecordOffset));
+        VERIFY_IS_TRUE(tornRecordOffset.has_value());
+        VERIFY_ARE_EQUAL(2 * sizeof(uint32_t) + 8 * sizeof(wchar_t), gsl::narrow_cast<size_t>(*tornRecordOffset));
+
+        Log::Comment(L"Truncating the torn record allows commands to be appended after the valid ones.");
+        store.Truncate(*tornRecordOffset);
+        store.Append(L"ping");
+        store.Flush();
+
+        const std::vector<std::wstring> appended{ L"dir", L"cd ..", L"ping" };
+        VERIFY_IS_TRUE(appended == store.Load(&tornRecordOffset));
+        VERIFY_IS_FALSE(tornRecordOffset.has_value());
+    }
+
+    TEST_METHOD(LoadingHistoryTruncatesTornRecord)
+    {
+        const auto path = (std::filesystem::temp_directory_path() / L"HistoryTests.history").wstring();
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        auto cleanup = wil::scope_exit([&]() { std::filesystem::remove(path, ec); });
+
+        auto store = std::make_shared<HistoryStore>(path);
+        store->Append(L"dir");
+        store->Flush();
+
+        Log::Comment(L"Append half of a record's length.");
+        {
+            std::ofstream file{ path, std::ios::binary | std::ios::app };
+            const uint16_t half = 5;
+            file.write(reinterpret_cast<const char*>(&half), sizeof(half));
+        }
+
+        auto history = CommandHistory::s_Allocate(_manyApps[0], _MakeHandle(0));
+        VERIFY_IS_NOT_NULL(history);
+        history->_store = store;
+        history->EnsureLoaded();
+        VERIFY_ARE_EQUAL(1ul, history->GetNumberOfCommands());
+
+        Log::Comment(L"A command added afterwards survives the next load.");
+        VERIFY_SUCCEEDED(history->Add(L"ping", false));
+        const std::vector<std::wstring> expected{ L"dir", L"ping" };
+        VERIFY_IS_TRUE(expected == store->Load());
+    }
+
+    TEST_METHOD(FullHistoryPerformance)
+    {
+        // This is the benchmark for the lookups into a full history: It fills one to its maximum
+        // size and logs how long F8-style searches and duplicate-suppressing adds take.
+        auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        const auto bufferSize = gci.GetHistoryBufferSize();
+        gci.SetHistoryBufferSize(SHRT_MAX);
+        auto restore = wil::scope_exit([&]() { gci.SetHistoryBufferSize(bufferSize); });
+
+        auto history = CommandHistory::s_Allocate(_manyApps[0], _MakeHandle(0));
+        VERIFY_IS_NOT_NULL(history);
+
+        const auto makeCommand = [this](const size_t i) {
+            return _manyHistoryItems.at(i % _manyHistoryItems.size()) + L' ' + std::to_wstring(i * 7919 % 100000);
+        };
+
+        const auto measure = [](const wchar_t* name, const size_t count, auto&& func) {
+            const auto start = std::chrono::steady_clock::now();
+            func();
+            const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+            Log::Comment(NoThrowString().Format(L"%s: %.0f ns per call", name, elapsed.count() / count));
+        };
+
+        auto hr = S_OK;
+        measure(L"Add to a growing history", SHRT_MAX, [&]() {
+            for (size_t i = 0; i < SHRT_MAX && SUCCEEDED(hr); ++i)
+            {
+                hr = history->Add(makeCommand(i), true);
+            }
+        });
+        VERIFY_SUCCEEDED(hr);
+        VERIFY_ARE_EQUAL(gsl::narrow_cast<size_t>(SHRT_MAX), history->GetNumberOfCommands());
+
+        // What F8 searches for: Prefixes of older commands, exact commands and commands that aren't there.
+        std::vector<std::pair<std::wstring, CommandHistory::MatchOptions>> queries;
+        for (size_t i = 0; i < 256; ++i)
+        {
+            auto command = makeCommand(i * 127);
+            switch (i % 3)
+            {
+            case 0:
+                command.resize(command.size() - 2);
+                queries.emplace_back(std::move(command), CommandHistory::MatchOptions::JustLooking);
+                break;
+            case 1:
+                queries.emplace_back(std::move(command), CommandHistory::MatchOptions::ExactMatch | CommandHistory::MatchOptions::JustLooking);
+                break;
+            default:
+                queries.emplace_back(command + L" --missing", CommandHistory::MatchOptions::JustLooking);
+                break;
+            }
+        }
+
+        const auto newest = gsl::narrow<SHORT>(history->GetNumberOfCommands() - 1);
+        size_t found = 0;
+        measure(L"FindMatchingCommand in a full history", queries.size(), [&]() {
+            for (const auto& [command, options] : queries)
+            {
+                SHORT index = 0;
+                if (history->FindMatchingCommand(command, newest, index, options))
+                {
+                    ++found;
+                }
+            }
+        });
+        VERIFY_ARE_EQUAL(queries.size() - queries.size() / 3, found);
+
+        // Every other command was added before and is moved to the end of the
+        // history, the others push the oldest command out of the full history.
+        static constexpr size_t addCount = 1024;
+        measure(L"Add to a full history", addCount, [&]() {
+            for (size_t i = SHRT_MAX; i < SHRT_MAX + addCount && SUCCEEDED(hr); ++i)
+            {
+                hr = history->Add(makeCommand(i % 2 ? i : i / 2), true);
+            }
+        });
+        VERIFY_SUCCEEDED(hr);
+        VERIFY_ARE_EQUAL(gsl::narrow_cast<size_t>(SHRT_MAX), history->GetNumberOfCommands());
+    }
+
 private:
     const std::array<std::wstring, 5> _manyApps = {
         L"foo.exe",
@@ -193,6 +193,7 @@ class ScreenBufferTests
     TEST_METHOD(SnapCursorWithTerminalScrolling);
 
     TEST_METHOD(ClearAlternateBuffer);
+    TEST_METHOD(RecycledAlternateBufferIsReset);
 
     TEST_METHOD(TestExtendedTextAttributes);
     TEST_METHOD(TestExtendedTextAttributesWithColors);
@@ -4983,6 +4984,57 @@ void ScreenBufferTests::ClearAlternateBuffer()
     VerifyText(siMain.GetTextBuffer());
 }
 
+void ScreenBufferTests::RecycledAlternateBufferIsReset()
+{
+    CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+    gci.LockConsole(); // Lock must be taken to manipulate buffer.
+    auto unlock = wil::scope_exit([&] { gci.UnlockConsole(); });
+
+    auto& siMain = gci.GetActiveOutputBuffer();
+    auto& stateMachine = siMain.GetStateMachine();
+    WI_SetFlag(siMain.OutputMode, ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+
+    Log::Comment(L"Enter the alt buffer and dirty it.");
+    VERIFY_SUCCEEDED(siMain.UseAlternateScreenBuffer());
+    auto* const firstAlt = siMain._psiAlternateBuffer;
+    VERIFY_IS_NOT_NULL(firstAlt);
+    WI_SetFlag(firstAlt->OutputMode, ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+
+    stateMachine.ProcessString(L"\x1b[2;5r\x1b[31mfoo\x1b]8;;https://example.com\x1b\\bar\x1b]8;;\x1b\\\x1b[?25l");
+    VERIFY_IS_TRUE(firstAlt->AreMarginsSet());
+    VERIFY_IS_FALSE(firstAlt->GetTextBuffer().GetCursor().IsVisible());
+
+    Log::Comment(L"Leaving the alt buffer should hold onto it.");
+    firstAlt->UseMainScreenBuffer();
+    VERIFY_IS_NULL(siMain._psiAlternateBuffer);
+    VERIFY_ARE_EQUAL(firstAlt, siMain._psiRecycledAltBuffer.get());
+    VERIFY_ARE_EQUAL(&siMain, &gci.GetActiveOutputBuffer());
+
+    Log::Comment(L"Entering it again should reuse the same buffer, but in a pristine state.");
+    VERIFY_SUCCEEDED(siMain.UseAlternateScreenBuffer());
+    auto* const secondAlt = siMain._psiAlternateBuffer;
+    auto useMain = wil::scope_exit([&] { secondAlt->UseMainScreenBuffer(); });
+
+    VERIFY_ARE_EQUAL(firstAlt, secondAlt);
+    VERIFY_IS_NULL(siMain._psiRecycledAltBuffer.get());
+    VERIFY_ARE_EQUAL(secondAlt, &gci.GetActiveOutputBuffer().GetActiveBuffer());
+
+    const auto& textBuffer = secondAlt->GetTextBuffer();
+    const auto& cursor = textBuffer.GetCursor();
+    VERIFY_ARE_EQUAL(COORD({ 0, 0 }), cursor.GetPosition());
+    VERIFY_IS_TRUE(cursor.IsVisible());
+    VERIFY_IS_FALSE(secondAlt->AreMarginsSet());
+    VERIFY_ARE_EQUAL(0, secondAlt->GetViewport().Top());
+    VERIFY_ARE_EQUAL(siMain.GetViewport().Dimensions(), secondAlt->GetBufferSize().Dimensions());
+
+    auto expectedAttributes = siMain.GetAttributes();
+    expectedAttributes.SetStandardErase();
+    VERIFY_ARE_EQUAL(expectedAttributes, textBuffer.GetCurrentAttributes());
+    VERIFY_ARE_EQUAL(L"\x20", textBuffer.GetCellDataAt({ 0, 0 })->Chars());
+    VERIFY_ARE_EQUAL(expectedAttributes, textBuffer.GetCellDataAt({ 0, 0 })->TextAttr());
+    VERIFY_IS_FALSE(textBuffer.GetRowByOffset(0).GetCharRow().ContainsText());
+}
+
 void ScreenBufferTests::TestExtendedTextAttributes()
 {
     // This is a test for microsoft/terminal#2554. Refer to that issue for more
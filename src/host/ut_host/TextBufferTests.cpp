@@ -91,6 +91,8 @@ class TextBufferTests
 
     TEST_METHOD(TestBoundaryMeasuresFloatingString);
 
+    TEST_METHOD(TestBoundaryMeasuresAfterClearAndReset);
+
     TEST_METHOD(TestCopyProperties);
 
     TEST_METHOD(TestInsertCharacter);
@@ -156,6 +158,12 @@ class TextBufferTests
 
     TEST_METHOD(HyperlinkTrim);
     TEST_METHOD(NoHyperlinkTrim);
+
+    TEST_METHOD(ClearScrollback);
+
+    TEST_METHOD(CopyRectangle);
+    TEST_METHOD(FillRectangle);
+    TEST_METHOD(ReadWriteCharInfos);
 };
 
 void TextBufferTests::TestBufferCreate()
@@ -349,6 +357,45 @@ void TextBufferTests::TestBoundaryMeasuresFloatingString()
     DoBoundaryTest(pwszOffsets, 14, csBufferWidth, 5, 9);
 }
 
+void TextBufferTests::TestBoundaryMeasuresAfterClearAndReset()
+{
+    TextBuffer& textBuffer = GetTbi();
+    ROW& row = textBuffer._GetFirstRow();
+    CharRow& charRow = row.GetCharRow();
+
+    Log::Comment(L"A freshly reset row has no text.");
+    row.Reset(TextAttribute{});
+    VERIFY_IS_FALSE(charRow.ContainsText());
+    VERIFY_ARE_EQUAL(0u, charRow.MeasureRight());
+    VERIFY_ARE_EQUAL(charRow.size(), charRow.MeasureLeft());
+
+    Log::Comment(L"Writing a glyph extends the right edge.");
+    const auto x = L'X';
+    charRow.GlyphAt(10) = { &x, 1 };
+    charRow.GlyphAt(3) = { &x, 1 };
+    VERIFY_IS_TRUE(charRow.ContainsText());
+    VERIFY_ARE_EQUAL(3u, charRow.MeasureLeft());
+    VERIFY_ARE_EQUAL(11u, charRow.MeasureRight());
+
+    Log::Comment(L"Clearing the rightmost glyph moves the right edge back.");
+    row.ClearColumn(10);
+    VERIFY_ARE_EQUAL(4u, charRow.MeasureRight());
+    charRow.ClearGlyph(3);
+    VERIFY_IS_FALSE(charRow.ContainsText());
+    VERIFY_ARE_EQUAL(0u, charRow.MeasureRight());
+    VERIFY_ARE_EQUAL(charRow.size(), charRow.MeasureLeft());
+
+    Log::Comment(L"Writing through WriteCells is tracked as well.");
+    row.WriteCells(OutputCellIterator{ L"abc" }, 20);
+    VERIFY_ARE_EQUAL(20u, charRow.MeasureLeft());
+    VERIFY_ARE_EQUAL(23u, charRow.MeasureRight());
+
+    Log::Comment(L"Resetting the row forgets about all text.");
+    row.Reset(TextAttribute{});
+    VERIFY_IS_FALSE(charRow.ContainsText());
+    VERIFY_ARE_EQUAL(0u, charRow.MeasureRight());
+}
+
 void TextBufferTests::TestCopyProperties()
 {
     TextBuffer& otherTbi = GetTbi();
@@ -2660,3 +2707,248 @@ void TextBufferTests::NoHyperlinkTrim()
     VERIFY_ARE_EQUAL(_buffer->GetHyperlinkUriFromId(id), url);
     VERIFY_ARE_EQUAL(_buffer->_hyperlinkCustomIdMap[finalCustomId], id);
 }
+
+// This tests that clearing the scrollback keeps the viewport, releases the
+// glyphs and hyperlinks of the erased rows and resets those rows lazily.
+void TextBufferTests::ClearScrollback()
+{
+    const COORD bufferSize{ 80, 10 };
+    const UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+
+    std::vector<std::wstring> lines;
+    for (auto i = 0; i < bufferSize.Y; ++i)
+    {
+        lines.emplace_back(fmt::format(L"row {}", i));
+    }
+    WriteLinesToBuffer(lines, *_buffer);
+
+    // Put a hyperlink into the scrollback and another one into the viewport.
+    const auto scrollbackId = _buffer->GetHyperlinkId(L"scrollback.url", L"");
+    _buffer->AddHyperlinkToMap(L"scrollback.url", scrollbackId);
+    const auto viewportId = _buffer->GetHyperlinkId(L"viewport.url", L"");
+    _buffer->AddHyperlinkToMap(L"viewport.url", viewportId);
+
+    TextAttribute linkAttr{ 0x7f };
+    linkAttr.SetHyperlinkId(scrollbackId);
+    _buffer->GetRowByOffset(1).GetAttrRow().SetAttrToEnd(70, linkAttr);
+    linkAttr.SetHyperlinkId(viewportId);
+    _buffer->GetRowByOffset(6).GetAttrRow().SetAttrToEnd(70, linkAttr);
+
+    // Do the same for glyphs that are kept in the unicode storage.
+    auto& unicodeStorage = _buffer->GetUnicodeStorage();
+    unicodeStorage.StoreGlyph({ 75, _buffer->GetRowByOffset(2).GetId() }, { L'\xD83D', L'\xDE00' });
+    unicodeStorage.StoreGlyph({ 75, _buffer->GetRowByOffset(7).GetId() }, { L'\xD83D', L'\xDE01' });
+
+    const auto staleRowId = _buffer->GetRowByOffset(1).GetId();
+
+    // Keep the 3 rows starting at row 5.
+    const TextAttribute fillAttr{ 0x1e };
+    _buffer->ClearScrollback(5, 3, fillAttr);
+
+    Log::Comment(L"The viewport rows should be at the top of the buffer now.");
+    for (SHORT i = 0; i < 3; ++i)
+    {
+        const auto rowText = std::as_const(*_buffer).GetRowByOffset(i).GetText();
+        VERIFY_ARE_EQUAL(lines[i + 5], rowText.substr(0, lines[i + 5].size()));
+    }
+
+    Log::Comment(L"All other rows should read as blank, without having been reset yet.");
+    for (SHORT i = 3; i < bufferSize.Y; ++i)
+    {
+        const auto& row = std::as_const(*_buffer).GetRowByOffset(i);
+        VERIFY_ARE_EQUAL(std::wstring(bufferSize.X, L' '), row.GetText());
+        VERIFY_ARE_EQUAL(fillAttr, row.GetAttrRow().GetAttrByColumn(0));
+    }
+    VERIFY_ARE_EQUAL(lines[1], _buffer->_storage.at(staleRowId).GetText().substr(0, lines[1].size()));
+
+    Log::Comment(L"Only the glyphs and hyperlinks referenced by the viewport should be left.");
+    VERIFY_ARE_EQUAL(1u, unicodeStorage._map.size());
+    VERIFY_ARE_EQUAL(_buffer->_hyperlinkMap.find(scrollbackId), _buffer->_hyperlinkMap.end());
+    VERIFY_ARE_EQUAL(_buffer->GetHyperlinkUriFromId(viewportId), L"viewport.url");
+
+    Log::Comment(L"Asking for a mutable row should reset it. The former row 1 is at offset 6 now.");
+    auto& row = _buffer->GetRowByOffset(6);
+    VERIFY_ARE_EQUAL(staleRowId, row.GetId());
+    VERIFY_ARE_EQUAL(std::wstring(bufferSize.X, L' '), _buffer->_storage.at(staleRowId).GetText());
+    VERIFY_ARE_EQUAL(fillAttr, row.GetAttrRow().GetAttrByColumn(0));
+
+    Log::Comment(L"Resizing should reset all remaining rows.");
+    VERIFY_SUCCEEDED(_buffer->ResizeTraditional({ 60, 12 }));
+    VERIFY_IS_FALSE(_buffer->_blankRow.has_value());
+    for (SHORT i = 3; i < 10; ++i)
+    {
+        VERIFY_ARE_EQUAL(std::wstring(60, L' '), _buffer->GetRowByOffset(i).GetText());
+    }
+}
+
+void TextBufferTests::CopyRectangle()
+{
+    const COORD bufferSize{ 10, 6 };
+    const UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+
+    WriteLinesToBuffer({ L"0123456789", L"abcdefghij", L"ABCDEFGHIJ", L"klmnopqrst" }, *_buffer);
+
+    const TextAttribute red{ 0x4 };
+    _buffer->GetRowByOffset(1).GetAttrRow().Replace(1, 3, red);
+
+    // This is the fire emoji: 🔥
+    // It doesn't fit into a single cell and has to be kept in the unicode storage.
+    const auto fire = L"\xD83D\xDD25";
+    _buffer->GetRowByOffset(2).GetCharRow().GlyphAt(3) = fire;
+
+    Log::Comment(L"Move a block down and to the right, so that it overlaps itself.");
+    _buffer->CopyRectangle(Viewport::FromDimensions({ 1, 0 }, { 4, 3 }), { 3, 1 });
+
+    VERIFY_ARE_EQUAL(std::wstring{ L"0123456789" }, _buffer->GetRowByOffset(0).GetText());
+    VERIFY_ARE_EQUAL(std::wstring{ L"abc1234hij" }, _buffer->GetRowByOffset(1).GetText());
+    VERIFY_ARE_EQUAL(std::wstring{ L"ABCbcdeHIJ" }, _buffer->GetRowByOffset(2).GetText());
+    VERIFY_ARE_EQUAL(std::wstring{ L"klmBC" } + fire + L"Erst", _buffer->GetRowByOffset(3).GetText());
+
+    Log::Comment(L"The glyph should have moved along with its cell.");
+    VERIFY_ARE_EQUAL(1u, _buffer->GetUnicodeStorage()._map.size());
+    const auto fireText = *_buffer->GetTextDataAt({ 5, 3 });
+    VERIFY_ARE_EQUAL(String(fire), String(fireText.data(), gsl::narrow<int>(fireText.size())));
+
+    Log::Comment(L"And so should the attributes.");
+    const auto& attrRow = _buffer->GetRowByOffset(2).GetAttrRow();
+    VERIFY_ARE_EQUAL(attr, attrRow.GetAttrByColumn(2));
+    VERIFY_ARE_EQUAL(red, attrRow.GetAttrByColumn(3));
+    VERIFY_ARE_EQUAL(red, attrRow.GetAttrByColumn(4));
+    VERIFY_ARE_EQUAL(attr, attrRow.GetAttrByColumn(5));
+
+    Log::Comment(L"Spans within the same row should be moved like memmove in either direction.");
+    _buffer->CopyRectangle(Viewport::FromDimensions({ 2, 0 }, { 8, 1 }), { 0, 0 });
+    VERIFY_ARE_EQUAL(std::wstring{ L"2345678989" }, _buffer->GetRowByOffset(0).GetText());
+    _buffer->CopyRectangle(Viewport::FromDimensions({ 0, 0 }, { 8, 1 }), { 2, 0 });
+    VERIFY_ARE_EQUAL(std::wstring{ L"2323456789" }, _buffer->GetRowByOffset(0).GetText());
+
+    Log::Comment(L"Moving a block up should copy the top rows first.");
+    _buffer->CopyRectangle(Viewport::FromDimensions({ 0, 1 }, { 3, 3 }), { 0, 0 });
+    VERIFY_ARE_EQUAL(std::wstring{ L"abc3456789" }, _buffer->GetRowByOffset(0).GetText());
+    VERIFY_ARE_EQUAL(std::wstring{ L"ABC1234hij" }, _buffer->GetRowByOffset(1).GetText());
+    VERIFY_ARE_EQUAL(std::wstring{ L"klmbcdeHIJ" }, _buffer->GetRowByOffset(2).GetText());
+
+    Log::Comment(L"A target outside of the buffer should be rejected.");
+    VERIFY_THROWS(_buffer->CopyRectangle(Viewport::FromDimensions({ 0, 0 }, { 4, 1 }), { 8, 0 }), wil::ResultException);
+}
+
+void TextBufferTests::FillRectangle()
+{
+    const COORD bufferSize{ 10, 4 };
+    const UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+
+    WriteLinesToBuffer({ L"0123456789", L"abcdefghij", L"ABCDEFGHIJ" }, *_buffer);
+    _buffer->GetRowByOffset(1).GetCharRow().GlyphAt(3) = L"\xD83D\xDD25";
+    _buffer->GetRowByOffset(2).SetWrapForced(true);
+
+    Log::Comment(L"Fill a rectangle in the middle of the buffer.");
+    const TextAttribute red{ 0x4 };
+    _buffer->FillRectangle(Viewport::FromDimensions({ 2, 0 }, { 4, 2 }), L'x', red);
+
+    VERIFY_ARE_EQUAL(std::wstring{ L"01xxxx6789" }, _buffer->GetRowByOffset(0).GetText());
+    VERIFY_ARE_EQUAL(std::wstring{ L"abxxxxghij" }, _buffer->GetRowByOffset(1).GetText());
+    VERIFY_ARE_EQUAL(std::wstring{ L"ABCDEFGHIJ" }, _buffer->GetRowByOffset(2).GetText());
+    for (SHORT y = 0; y < 2; ++y)
+    {
+        const auto& attrRow = _buffer->GetRowByOffset(y).GetAttrRow();
+        VERIFY_ARE_EQUAL(attr, attrRow.GetAttrByColumn(1));
+        VERIFY_ARE_EQUAL(red, attrRow.GetAttrByColumn(2));
+        VERIFY_ARE_EQUAL(red, attrRow.GetAttrByColumn(5));
+        VERIFY_ARE_EQUAL(attr, attrRow.GetAttrByColumn(6));
+    }
+
+    Log::Comment(L"The overwritten glyph should be gone from the unicode storage.");
+    VERIFY_IS_TRUE(_buffer->GetUnicodeStorage()._map.empty());
+
+    Log::Comment(L"Erasing up to the right edge should unwrap the row.");
+    _buffer->FillRectangle(Viewport::FromDimensions({ 5, 2 }, { 5, 1 }), L' ', attr);
+    VERIFY_ARE_EQUAL(std::wstring{ L"ABCDE     " }, _buffer->GetRowByOffset(2).GetText());
+    VERIFY_ARE_EQUAL(5u, _buffer->GetRowByOffset(2).GetCharRow().MeasureRight());
+    VERIFY_IS_FALSE(_buffer->GetRowByOffset(2).WasWrapForced());
+
+    Log::Comment(L"A rectangle outside of the buffer should be rejected.");
+    VERIFY_THROWS(_buffer->FillRectangle(Viewport::FromDimensions({ 8, 0 }, { 4, 1 }), L' ', attr), wil::ResultException);
+}
+
+void TextBufferTests::ReadWriteCharInfos()
+{
+    const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+    const COORD bufferSize{ 10, 3 };
+    const UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+
+    WriteLinesToBuffer({ L"0123456789", L"abcdefghij", L"ABCDEFGHIJ" }, *_buffer);
+    _buffer->GetRowByOffset(1).GetCharRow().GlyphAt(4) = L"\xD83D\xDD25";
+
+    // Two rows of 4 cells with a wide glyph in the second one. The source rows are 5 cells wide
+    // and the last cell of each row must be skipped, just like the clipped columns of a WriteConsoleOutput.
+    const std::vector<CHAR_INFO> source{
+        { L'w', 0x04 }, { L'x', 0x04 }, { L'y', 0x1e }, { L'z', 0x1e }, { L'-', 0x00 },
+        { L'q', 0x1e }, { L'\x3042', 0x04 | COMMON_LVB_LEADING_BYTE }, { L'\x3042', 0x04 | COMMON_LVB_TRAILING_BYTE }, { L'r', 0x04 }, { L'-', 0x00 },
+    };
+
+    Log::Comment(L"Write a rectangle in the middle of the buffer.");
+    _buffer->WriteCharInfos(source, 5, Viewport::FromDimensions({ 3, 0 }, { 4, 2 }));
+
+    VERIFY_ARE_EQUAL(std::wstring{ L"012wxyz789" }, _buffer->GetRowByOffset(0).GetText());
+    VERIFY_ARE_EQUAL(std::wstring{ L"abcq\x3042rhij" }, _buffer->GetRowByOffset(1).GetText());
+    VERIFY_IS_TRUE(_buffer->GetRowByOffset(1).GetCharRow().DbcsAttrAt(4).IsLeading());
+    VERIFY_IS_TRUE(_buffer->GetRowByOffset(1).GetCharRow().DbcsAttrAt(5).IsTrailing());
+    VERIFY_ARE_EQUAL(attr, _buffer->GetRowByOffset(0).GetAttrRow().GetAttrByColumn(2));
+    VERIFY_ARE_EQUAL(TextAttribute{ 0x04 }, _buffer->GetRowByOffset(0).GetAttrRow().GetAttrByColumn(3));
+    VERIFY_ARE_EQUAL(TextAttribute{ 0x1e }, _buffer->GetRowByOffset(0).GetAttrRow().GetAttrByColumn(6));
+    VERIFY_ARE_EQUAL(attr, _buffer->GetRowByOffset(0).GetAttrRow().GetAttrByColumn(7));
+    VERIFY_IS_FALSE(_buffer->GetRowByOffset(0).WasWrapForced());
+
+    Log::Comment(L"The overwritten glyph should be gone from the unicode storage.");
+    VERIFY_IS_TRUE(_buffer->GetUnicodeStorage()._map.empty());
+
+    Log::Comment(L"Reading the rectangle back should return the cells that were written.");
+    std::vector<CHAR_INFO> target(10);
+    _buffer->ReadCharInfos(Viewport::FromDimensions({ 3, 0 }, { 4, 2 }), target, 5);
+    for (size_t i = 0; i < source.size(); ++i)
+    {
+        if (i % 5 != 4)
+        {
+            VERIFY_ARE_EQUAL(source.at(i), target.at(i));
+        }
+    }
+
+    Log::Comment(L"Every cell should read like it does through the cell iterator.");
+    _buffer->GetRowByOffset(2).GetCharRow().GlyphAt(1) = L"\xD83D\xDD25";
+    std::vector<CHAR_INFO> screen(30);
+    _buffer->ReadCharInfos(_buffer->GetSize(), screen, 10);
+    auto it = _buffer->GetCellDataAt({ 0, 0 });
+    for (const auto& cell : screen)
+    {
+        VERIFY_ARE_EQUAL(gci.AsCharInfo(*it), cell);
+        ++it;
+    }
+    VERIFY_ARE_EQUAL(UNICODE_REPLACEMENT, screen.at(21).Char.UnicodeChar);
+
+    Log::Comment(L"Halves of wide glyphs at the edges of the row should be replaced by spaces.");
+    const std::vector<CHAR_INFO> edges{
+        { L'\x3042', 0x04 | COMMON_LVB_TRAILING_BYTE }, { L'e', 0x04 }, { L'\x3042', 0x04 | COMMON_LVB_LEADING_BYTE }
+    };
+    _buffer->WriteCharInfos({ edges.data(), 1 }, 1, Viewport::FromDimensions({ 0, 2 }, { 1, 1 }));
+    _buffer->WriteCharInfos({ edges.data() + 1, 2 }, 2, Viewport::FromDimensions({ 8, 2 }, { 2, 1 }));
+    VERIFY_ARE_EQUAL(std::wstring{ L" \xD83D\xDD25" L"CDEFGHe " }, _buffer->GetRowByOffset(2).GetText());
+    VERIFY_IS_TRUE(_buffer->GetRowByOffset(2).GetCharRow().DbcsAttrAt(0).IsSingle());
+    VERIFY_IS_TRUE(_buffer->GetRowByOffset(2).GetCharRow().DbcsAttrAt(9).IsSingle());
+    VERIFY_IS_TRUE(_buffer->GetRowByOffset(2).WasDoubleBytePadded());
+
+    Log::Comment(L"Like Write(), writing up to the right edge should wrap the row.");
+    VERIFY_IS_TRUE(_buffer->GetRowByOffset(2).WasWrapForced());
+
+    Log::Comment(L"A rectangle outside of the buffer or a source that's too small should be rejected.");
+    VERIFY_THROWS(_buffer->WriteCharInfos(source, 5, Viewport::FromDimensions({ 8, 0 }, { 4, 1 })), wil::ResultException);
+    VERIFY_THROWS(_buffer->WriteCharInfos(source, 5, Viewport::FromDimensions({ 0, 0 }, { 4, 3 })), wil::ResultException);
+    VERIFY_THROWS(_buffer->ReadCharInfos(Viewport::FromDimensions({ 0, 0 }, { 6, 2 }), target, 5), wil::ResultException);
+}
@@ -282,7 +282,7 @@ public:
         return std::vector<Microsoft::Console::Types::Viewport>{};
     }
 
-    void LockConsole() noexcept override
+    void LockConsole(const Microsoft::Console::Types::LockCallSite& /*site*/) noexcept override
     {
     }
 
@@ -290,6 +290,14 @@ public:
     {
     }
 
+    void LockConsoleShared(const Microsoft::Console::Types::LockCallSite& /*site*/) noexcept override
+    {
+    }
+
+    void UnlockConsoleShared() noexcept override
+    {
+    }
+
     const TextAttribute GetDefaultBrushColors() noexcept override
     {
         return TextAttribute{};
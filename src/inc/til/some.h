@@ -158,6 +158,16 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
             return _array[_used - 1];
         }
 
+        constexpr reference front() noexcept
+        {
+            return _array[0];
+        }
+
+        constexpr reference back() noexcept
+        {
+            return _array[_used - 1];
+        }
+
         constexpr const T* data() const noexcept
         {
             return _array.data();
@@ -35,6 +35,13 @@ namespace til
             }
         }
 
+        bool try_lock() noexcept
+        {
+            // Only draw a ticket if it would be served right away.
+            auto ticket = _now_serving.load(std::memory_order_relaxed);
+            return _next_ticket.compare_exchange_strong(ticket, ticket + 1, std::memory_order_acquire, std::memory_order_relaxed);
+        }
+
         void unlock() noexcept
         {
             _now_serving.fetch_add(1, std::memory_order_release);
@@ -53,4 +60,112 @@ namespace til
         std::atomic<uint32_t> _next_ticket{ 0 };
         std::atomic<uint32_t> _now_serving{ 0 };
     };
+
+    // shared_ticket_lock is a reader/writer lock built on top of ticket_lock.
+    //
+    // Writers are serialized fairly among themselves using a ticket_lock and are
+    // preferred over readers: As soon as a writer has drawn its ticket, it flags
+    // the lock as "write pending", which prevents any new readers from entering.
+    // The writer then waits for the existing readers to drain. This ensures that
+    // a steady stream of readers (UIA, selection, hover, ...) can't starve the
+    // writer (usually the thread processing output from the connection).
+    //
+    // The same caveats as for ticket_lock apply: It's not recursive, and
+    // lock()/unlock() and lock_shared()/unlock_shared() must be balanced.
+    // It satisfies the standard SharedMutex requirements and can thus be
+    // used with std::unique_lock and std::shared_lock.
+    struct shared_ticket_lock
+    {
+        void lock() noexcept
+        {
+            _writers.lock();
+
+            // Block any new readers and wait for the current ones to leave.
+            auto state = _state.fetch_or(write_pending, std::memory_order_acquire) | write_pending;
+            while (state != write_pending)
+            {
+                til::atomic_wait(_state, state);
+                state = _state.load(std::memory_order_acquire);
+            }
+        }
+
+        bool try_lock() noexcept
+        {
+            if (!_writers.try_lock())
+            {
+                return false;
+            }
+
+            auto state = 0u;
+            if (!_state.compare_exchange_strong(state, write_pending, std::memory_order_acquire, std::memory_order_relaxed))
+            {
+                _writers.unlock();
+                return false;
+            }
+
+            return true;
+        }
+
+        void unlock() noexcept
+        {
+            _state.store(0, std::memory_order_release);
+            til::atomic_notify_all(_state);
+            _writers.unlock();
+        }
+
+        void lock_shared() noexcept
+        {
+            auto state = _state.load(std::memory_order_relaxed);
+
+            for (;;)
+            {
+                if (state & write_pending)
+                {
+                    til::atomic_wait(_state, state);
+                    state = _state.load(std::memory_order_relaxed);
+                    continue;
+                }
+
+                if (_state.compare_exchange_weak(state, state + 1, std::memory_order_acquire, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+        }
+
+        bool try_lock_shared() noexcept
+        {
+            auto state = _state.load(std::memory_order_relaxed);
+
+            // Fails if a writer holds the lock or is waiting for it.
+            while (!(state & write_pending))
+            {
+                if (_state.compare_exchange_weak(state, state + 1, std::memory_order_acquire, std::memory_order_relaxed))
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        void unlock_shared() noexcept
+        {
+            const auto state = _state.fetch_sub(1, std::memory_order_release) - 1;
+
+            // Only a writer can be waiting on us: Wake it up once the last reader left.
+            if (state == write_pending)
+            {
+                til::atomic_notify_all(_state);
+            }
+        }
+
+    private:
+        static constexpr uint32_t write_pending = 0x80000000;
+
+        ticket_lock _writers;
+        // The lower 31 bits contain the number of active readers.
+        // The highest bit is set while a writer is waiting for or holding the lock.
+        std::atomic<uint32_t> _state{ 0 };
+    };
 }
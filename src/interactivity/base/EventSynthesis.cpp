@@ -44,73 +44,25 @@ static CodepointWidth GetQuickCharWidthLegacyForNumpadEventSynthesis(const wchar
     return CodepointWidth::Invalid;
 }
 
-std::deque<std::unique_ptr<KeyEvent>> Microsoft::Console::Interactivity::CharToKeyEvents(const wchar_t wch,
-                                                                                         const unsigned int codepage)
-{
-    const short invalidKey = -1;
-    short keyState = VkKeyScanW(wch);
-
-    if (keyState == invalidKey)
-    {
-        if constexpr (Feature_UseNumpadEventsForClipboardInput::IsEnabled())
-        {
-            // Determine DBCS character because these character does not know by VkKeyScan.
-            // GetStringTypeW(CT_CTYPE3) & C3_ALPHA can determine all linguistic characters. However, this is
-            // not include symbolic character for DBCS.
-            WORD CharType = 0;
-            GetStringTypeW(CT_CTYPE3, &wch, 1, &CharType);
-
-            if (!(WI_IsFlagSet(CharType, C3_ALPHA) || GetQuickCharWidthLegacyForNumpadEventSynthesis(wch) == CodepointWidth::Wide))
-            {
-                // It wasn't alphanumeric or determined to be wide by the old algorithm
-                // if VkKeyScanW fails (char is not in kbd layout), we must
-                // emulate the key being input through the numpad
-                return SynthesizeNumpadEvents(wch, codepage);
-            }
-        }
-        keyState = 0; // SynthesizeKeyboardEvents would rather get 0 than -1
-    }
-
-    return SynthesizeKeyboardEvents(wch, keyState);
-}
-
 // Routine Description:
-// - converts a wchar_t into a series of KeyEvents as if it was typed
-// using the keyboard
-// Arguments:
-// - wch - the wchar_t to convert
-// Return Value:
-// - deque of KeyEvents that represent the wchar_t being typed
-// Note:
-// - will throw exception on error
-std::deque<std::unique_ptr<KeyEvent>> Microsoft::Console::Interactivity::SynthesizeKeyboardEvents(const wchar_t wch, const short keyState)
+// - Appends the key records for typing wch using the keyboard to records.
+static void _SynthesizeKeyboardRecords(const wchar_t wch, const short keyState, Microsoft::Console::Interactivity::InputRecordBuffer& records)
 {
     const byte modifierState = HIBYTE(keyState);
 
     bool altGrSet = false;
     bool shiftSet = false;
-    std::deque<std::unique_ptr<KeyEvent>> keyEvents;
 
     // add modifier key event if necessary
     if (WI_AreAllFlagsSet(modifierState, VkKeyScanModState::CtrlAndAltPressed))
     {
         altGrSet = true;
-        keyEvents.push_back(std::make_unique<KeyEvent>(true,
-                                                       1ui16,
-                                                       static_cast<WORD>(VK_MENU),
-                                                       altScanCode,
-                                                       UNICODE_NULL,
-                                                       (ENHANCED_KEY | LEFT_CTRL_PRESSED | RIGHT_ALT_PRESSED)));
+        records.push_back(KeyEvent{ true, 1ui16, static_cast<WORD>(VK_MENU), altScanCode, UNICODE_NULL, (ENHANCED_KEY | LEFT_CTRL_PRESSED | RIGHT_ALT_PRESSED) }.ToInputRecord());
     }
     else if (WI_IsFlagSet(modifierState, VkKeyScanModState::ShiftPressed))
     {
         shiftSet = true;
-        keyEvents.push_back(std::make_unique<KeyEvent>(true,
-                                                       1ui16,
-                                                       static_cast<WORD>(VK_SHIFT),
-                                                       leftShiftScanCode,
-                                                       UNICODE_NULL,
-                                                       SHIFT_PRESSED));
+        records.push_back(KeyEvent{ true, 1ui16, static_cast<WORD>(VK_SHIFT), leftShiftScanCode, UNICODE_NULL, SHIFT_PRESSED }.ToInputRecord());
     }
 
     const auto vk = LOBYTE(keyState);
@@ -132,54 +84,27 @@ std::deque<std::unique_ptr<KeyEvent>> Microsoft::Console::Interactivity::Synthes
     }
 
     // add key event down and up
-    keyEvents.push_back(std::make_unique<KeyEvent>(keyEvent));
+    records.push_back(keyEvent.ToInputRecord());
     keyEvent.SetKeyDown(false);
-    keyEvents.push_back(std::make_unique<KeyEvent>(keyEvent));
+    records.push_back(keyEvent.ToInputRecord());
 
     // add modifier key up event
     if (altGrSet)
     {
-        keyEvents.push_back(std::make_unique<KeyEvent>(false,
-                                                       1ui16,
-                                                       static_cast<WORD>(VK_MENU),
-                                                       altScanCode,
-                                                       UNICODE_NULL,
-                                                       ENHANCED_KEY));
+        records.push_back(KeyEvent{ false, 1ui16, static_cast<WORD>(VK_MENU), altScanCode, UNICODE_NULL, ENHANCED_KEY }.ToInputRecord());
     }
     else if (shiftSet)
     {
-        keyEvents.push_back(std::make_unique<KeyEvent>(false,
-                                                       1ui16,
-                                                       static_cast<WORD>(VK_SHIFT),
-                                                       leftShiftScanCode,
-                                                       UNICODE_NULL,
-                                                       0));
+        records.push_back(KeyEvent{ false, 1ui16, static_cast<WORD>(VK_SHIFT), leftShiftScanCode, UNICODE_NULL, 0 }.ToInputRecord());
     }
-
-    return keyEvents;
 }
 
 // Routine Description:
-// - converts a wchar_t into a series of KeyEvents as if it was typed
-// using Alt + numpad
-// Arguments:
-// - wch - the wchar_t to convert
-// Return Value:
-// - deque of KeyEvents that represent the wchar_t being typed using
-// alt + numpad
-// Note:
-// - will throw exception on error
-std::deque<std::unique_ptr<KeyEvent>> Microsoft::Console::Interactivity::SynthesizeNumpadEvents(const wchar_t wch, const unsigned int codepage)
+// - Appends the key records for typing wch using Alt + numpad to records.
+static void _SynthesizeNumpadRecords(const wchar_t wch, const unsigned int codepage, Microsoft::Console::Interactivity::InputRecordBuffer& records)
 {
-    std::deque<std::unique_ptr<KeyEvent>> keyEvents;
-
     //alt keydown
-    keyEvents.push_back(std::make_unique<KeyEvent>(true,
-                                                   1ui16,
-                                                   static_cast<WORD>(VK_MENU),
-                                                   altScanCode,
-                                                   UNICODE_NULL,
-                                                   LEFT_ALT_PRESSED));
+    records.push_back(KeyEvent{ true, 1ui16, static_cast<WORD>(VK_MENU), altScanCode, UNICODE_NULL, LEFT_ALT_PRESSED }.ToInputRecord());
 
     const int radix = 10;
     std::wstring wstr{ wch };
@@ -207,27 +132,105 @@ std::deque<std::unique_ptr<KeyEvent>> Microsoft::Console::Interactivity::Synthes
             const WORD virtualKey = ch - '0' + VK_NUMPAD0;
             const WORD virtualScanCode = gsl::narrow<WORD>(MapVirtualKeyW(virtualKey, MAPVK_VK_TO_VSC));
 
-            keyEvents.push_back(std::make_unique<KeyEvent>(true,
-                                                           1ui16,
-                                                           virtualKey,
-                                                           virtualScanCode,
-                                                           UNICODE_NULL,
-                                                           LEFT_ALT_PRESSED));
-            keyEvents.push_back(std::make_unique<KeyEvent>(false,
-                                                           1ui16,
-                                                           virtualKey,
-                                                           virtualScanCode,
-                                                           UNICODE_NULL,
-                                                           LEFT_ALT_PRESSED));
+            records.push_back(KeyEvent{ true, 1ui16, virtualKey, virtualScanCode, UNICODE_NULL, LEFT_ALT_PRESSED }.ToInputRecord());
+            records.push_back(KeyEvent{ false, 1ui16, virtualKey, virtualScanCode, UNICODE_NULL, LEFT_ALT_PRESSED }.ToInputRecord());
         }
     }
 
     // alt keyup
-    keyEvents.push_back(std::make_unique<KeyEvent>(false,
-                                                   1ui16,
-                                                   static_cast<WORD>(VK_MENU),
-                                                   altScanCode,
-                                                   wch,
-                                                   0));
+    records.push_back(KeyEvent{ false, 1ui16, static_cast<WORD>(VK_MENU), altScanCode, wch, 0 }.ToInputRecord());
+}
+
+// Routine Description:
+// - Wraps the given records in KeyEvents, for the callers that still work with IInputEvents.
+static std::deque<std::unique_ptr<KeyEvent>> _ToKeyEvents(const Microsoft::Console::Interactivity::InputRecordBuffer& records)
+{
+    std::deque<std::unique_ptr<KeyEvent>> keyEvents;
+    for (const auto& record : records)
+    {
+        keyEvents.push_back(std::make_unique<KeyEvent>(record.Event.KeyEvent));
+    }
     return keyEvents;
 }
+
+std::deque<std::unique_ptr<KeyEvent>> Microsoft::Console::Interactivity::CharToKeyEvents(const wchar_t wch,
+                                                                                         const unsigned int codepage)
+{
+    boost::container::small_vector<INPUT_RECORD, 8> records;
+    CharToKeyRecords(wch, codepage, records);
+    return _ToKeyEvents(records);
+}
+
+// Routine Description:
+// - converts a wchar_t into a series of key records as if it was typed,
+//   either using the keyboard or, if the character isn't on it, Alt + numpad.
+// Arguments:
+// - wch - the wchar_t to convert
+// - codepage - the codepage used to determine the Alt + numpad sequence
+// - records - the buffer the key records are appended to
+// Note:
+// - will throw exception on error
+void Microsoft::Console::Interactivity::CharToKeyRecords(const wchar_t wch,
+                                                         const unsigned int codepage,
+                                                         InputRecordBuffer& records)
+{
+    const short invalidKey = -1;
+    short keyState = VkKeyScanW(wch);
+
+    if (keyState == invalidKey)
+    {
+        if constexpr (Feature_UseNumpadEventsForClipboardInput::IsEnabled())
+        {
+            // Determine DBCS character because these character does not know by VkKeyScan.
+            // GetStringTypeW(CT_CTYPE3) & C3_ALPHA can determine all linguistic characters. However, this is
+            // not include symbolic character for DBCS.
+            WORD CharType = 0;
+            GetStringTypeW(CT_CTYPE3, &wch, 1, &CharType);
+
+            if (!(WI_IsFlagSet(CharType, C3_ALPHA) || GetQuickCharWidthLegacyForNumpadEventSynthesis(wch) == CodepointWidth::Wide))
+            {
+                // It wasn't alphanumeric or determined to be wide by the old algorithm
+                // if VkKeyScanW fails (char is not in kbd layout), we must
+                // emulate the key being input through the numpad
+                _SynthesizeNumpadRecords(wch, codepage, records);
+                return;
+            }
+        }
+        keyState = 0; // _SynthesizeKeyboardRecords would rather get 0 than -1
+    }
+
+    _SynthesizeKeyboardRecords(wch, keyState, records);
+}
+
+// Routine Description:
+// - converts a wchar_t into a series of KeyEvents as if it was typed
+// using the keyboard
+// Arguments:
+// - wch - the wchar_t to convert
+// Return Value:
+// - deque of KeyEvents that represent the wchar_t being typed
+// Note:
+// - will throw exception on error
+std::deque<std::unique_ptr<KeyEvent>> Microsoft::Console::Interactivity::SynthesizeKeyboardEvents(const wchar_t wch, const short keyState)
+{
+    boost::container::small_vector<INPUT_RECORD, 8> records;
+    _SynthesizeKeyboardRecords(wch, keyState, records);
+    return _ToKeyEvents(records);
+}
+
+// Routine Description:
+// - converts a wchar_t into a series of KeyEvents as if it was typed
+// using Alt + numpad
+// Arguments:
+// - wch - the wchar_t to convert
+// Return Value:
+// - deque of KeyEvents that represent the wchar_t being typed using
+// alt + numpad
+// Note:
+// - will throw exception on error
+std::deque<std::unique_ptr<KeyEvent>> Microsoft::Console::Interactivity::SynthesizeNumpadEvents(const wchar_t wch, const unsigned int codepage)
+{
+    boost::container::small_vector<INPUT_RECORD, 8> records;
+    _SynthesizeNumpadRecords(wch, codepage, records);
+    return _ToKeyEvents(records);
+}
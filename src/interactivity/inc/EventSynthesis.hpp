@@ -20,8 +20,13 @@ Author:
 
 namespace Microsoft::Console::Interactivity
 {
+    // Any small_vector<INPUT_RECORD, N>, so that callers can pick how many records they keep on the stack.
+    using InputRecordBuffer = boost::container::small_vector_base<INPUT_RECORD>;
+
     std::deque<std::unique_ptr<KeyEvent>> CharToKeyEvents(const wchar_t wch, const unsigned int codepage);
 
+    void CharToKeyRecords(const wchar_t wch, const unsigned int codepage, InputRecordBuffer& records);
+
     std::deque<std::unique_ptr<KeyEvent>> SynthesizeKeyboardEvents(const wchar_t wch,
                                                                    const short keyState);
 
@@ -33,7 +33,10 @@ void BlinkingState::SetBlinkingAllowed(const bool blinkingAllowed) noexcept
 // - <none>
 void BlinkingState::RecordBlinkingUsage(const TextAttribute& attr) noexcept
 {
-    _blinkingIsInUse = _blinkingIsInUse || attr.IsBlinking();
+    if (attr.IsBlinking())
+    {
+        _blinkingIsInUse.store(true, std::memory_order_relaxed);
+    }
 }
 
 // Method Description:
@@ -69,11 +72,11 @@ try
         _blinkingShouldBeFaint = _blinkingCycle >= 2;
         // Every two cycles (when the state changes), we need to trigger a
         // redraw, but only if there are actually blinking attributes in use.
-        if (_blinkingIsInUse && _blinkingCycle % 2 == 0)
+        if (_blinkingIsInUse.load(std::memory_order_relaxed) && _blinkingCycle % 2 == 0)
         {
             // We reset the _blinkingIsInUse flag before redrawing, so we can
             // get a fresh assessment of the current blinking attribute usage.
-            _blinkingIsInUse = false;
+            _blinkingIsInUse.store(false, std::memory_order_relaxed);
             renderTarget.TriggerRedrawAll();
         }
     }
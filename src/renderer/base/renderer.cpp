@@ -111,9 +111,10 @@ try
 {
     FAIL_FAST_IF_NULL(pEngine); // This is a programming error. Fail fast.
 
-    _pData->LockConsole();
+    // Painting only reads the render data, which allows UIA queries to run concurrently.
+    _pData->LockConsoleShared();
     auto unlock = wil::scope_exit([&]() {
-        _pData->UnlockConsole();
+        _pData->UnlockConsoleShared();
     });
 
     // Last chance check if anything scrolled without an explicit invalidate notification since the last frame.
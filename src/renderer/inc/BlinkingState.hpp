@@ -31,7 +31,8 @@ namespace Microsoft::Console::Render
     private:
         bool _blinkingAllowed = true;
         size_t _blinkingCycle = 0;
-        bool _blinkingIsInUse = false;
+        // Recorded by the renderer and UIA, which may query attribute colors concurrently.
+        std::atomic<bool> _blinkingIsInUse{ false };
         bool _blinkingShouldBeFaint = false;
     };
 }
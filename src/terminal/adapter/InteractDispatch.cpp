@@ -27,10 +27,10 @@ InteractDispatch::InteractDispatch(std::unique_ptr<ConGetSet> pConApi) :
 //      interrupt in the client, but instead write a Ctrl+C to the input buffer
 //      to be read by the client.
 // Arguments:
-// - inputEvents: a collection of IInputEvents
+// - inputEvents: a span of input records
 // Return Value:
 // True if handled successfully. False otherwise.
-bool InteractDispatch::WriteInput(std::deque<std::unique_ptr<IInputEvent>>& inputEvents)
+bool InteractDispatch::WriteInput(const gsl::span<const INPUT_RECORD> inputEvents)
 {
     size_t written = 0;
     return _pConApi->PrivateWriteConsoleInputW(inputEvents, written);
@@ -52,7 +52,8 @@ bool InteractDispatch::WriteCtrlKey(const KeyEvent& event)
 
 // Method Description:
 // - Writes a string of input to the host. The string is converted to keystrokes
-//      that will faithfully represent the input by CharToKeyEvents.
+//      that will faithfully represent the input by CharToKeyRecords.
+//   The records are written in a single call, so that readers are woken up once.
 // Arguments:
 // - string : a string to write to the console.
 // Return Value:
@@ -68,18 +69,17 @@ bool InteractDispatch::WriteString(const std::wstring_view string)
     bool success = _pConApi->GetConsoleOutputCP(codepage);
     if (success)
     {
-        std::deque<std::unique_ptr<IInputEvent>> keyEvents;
+        // Most characters are a key down and up record, so short strings
+        // are built on the stack and longer ones spill onto the heap.
+        boost::container::small_vector<INPUT_RECORD, 128> keyEvents;
+        keyEvents.reserve(string.size() * 2);
 
         for (const auto& wch : string)
         {
-            std::deque<std::unique_ptr<KeyEvent>> convertedEvents = Microsoft::Console::Interactivity::CharToKeyEvents(wch, codepage);
-
-            std::move(convertedEvents.begin(),
-                      convertedEvents.end(),
-                      std::back_inserter(keyEvents));
+            Microsoft::Console::Interactivity::CharToKeyRecords(wch, codepage, keyEvents);
         }
 
-        success = WriteInput(keyEvents);
+        success = WriteInput({ keyEvents.data(), keyEvents.size() });
     }
     return success;
 }
@@ -157,9 +157,12 @@ namespace Microsoft::Console::VirtualTerminal
         };
 
         bool _CursorMovePosition(const Offset rowOffset, const Offset colOffset, const bool clampInMargins) const;
-        bool _EraseSingleLineHelper(const CONSOLE_SCREEN_BUFFER_INFOEX& csbiex,
+        bool _EraseSingleLineHelper(const ScreenBufferState& bufferState,
                                     const DispatchTypes::EraseType eraseType,
                                     const size_t lineId) const;
+        bool _EraseFullLinesHelper(const ScreenBufferState& bufferState,
+                                   const SHORT startLine,
+                                   const SHORT endLine) const;
         bool _EraseScrollback();
         bool _EraseAll();
         bool _InsertDeleteHelper(const size_t count, const bool isInsert) const;
@@ -187,6 +190,7 @@ namespace Microsoft::Console::VirtualTerminal
         std::unique_ptr<ConGetSet> _pConApi;
         std::unique_ptr<AdaptDefaults> _pDefaults;
         TerminalOutput _termOutput;
+        std::wstring _translatedString;
         std::optional<unsigned int> _initialCodePage;
 
         // We have two instances of the saved cursor state, because we need
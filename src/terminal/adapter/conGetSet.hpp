@@ -25,12 +25,24 @@ Author(s):
 
 namespace Microsoft::Console::VirtualTerminal
 {
+    // The part of CONSOLE_SCREEN_BUFFER_INFOEX that most VT operations need.
+    // Unlike the full structure it doesn't require the color table or the
+    // window metrics to be gathered, so it's cheap enough to be queried for
+    // every cursor movement. Like srWindow, the viewport is exclusive.
+    struct ScreenBufferState
+    {
+        COORD cursorPosition{};
+        SMALL_RECT viewport{};
+        COORD bufferSize{};
+    };
+
     class ConGetSet
     {
     public:
         virtual ~ConGetSet() = default;
         virtual bool GetConsoleScreenBufferInfoEx(CONSOLE_SCREEN_BUFFER_INFOEX& screenBufferInfo) const = 0;
         virtual bool SetConsoleScreenBufferInfoEx(const CONSOLE_SCREEN_BUFFER_INFOEX& screenBufferInfo) = 0;
+        virtual bool PrivateGetScreenBufferState(ScreenBufferState& state) const = 0;
         virtual bool SetConsoleCursorPosition(const COORD position) = 0;
 
         virtual bool PrivateIsVtInputEnabled() const = 0;
@@ -42,7 +54,7 @@ namespace Microsoft::Console::VirtualTerminal
         virtual bool PrivateResetLineRenditionRange(const size_t startRow, const size_t endRow) = 0;
         virtual SHORT PrivateGetLineWidth(const size_t row) const = 0;
 
-        virtual bool PrivateWriteConsoleInputW(std::deque<std::unique_ptr<IInputEvent>>& events,
+        virtual bool PrivateWriteConsoleInputW(const gsl::span<const INPUT_RECORD> events,
                                                size_t& eventsWritten) = 0;
         virtual bool SetConsoleWindowInfo(const bool absolute,
                                           const SMALL_RECT& window) = 0;
@@ -104,6 +116,7 @@ namespace Microsoft::Console::VirtualTerminal
                                          const std::optional<SMALL_RECT> clipRect,
                                          const COORD destinationOrigin,
                                          const bool standardFillAttrs) = 0;
+        virtual bool PrivateClearScrollback(const SHORT viewportTop, const SHORT viewportHeight) = 0;
 
         virtual bool PrivateAddHyperlink(const std::wstring_view uri, const std::wstring_view params) const = 0;
         virtual bool PrivateEndHyperlink() const = 0;
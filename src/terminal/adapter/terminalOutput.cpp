@@ -15,6 +15,7 @@ TerminalOutput::TerminalOutput() noexcept
     _gsetTranslationTables.at(1) = Ascii;
     _gsetTranslationTables.at(2) = Latin1;
     _gsetTranslationTables.at(3) = Latin1;
+    _UpdateCombinedTable();
 }
 
 bool TerminalOutput::Designate94Charset(size_t gsetNumber, const VTID charset)
@@ -116,6 +117,7 @@ bool TerminalOutput::LockingShift(const size_t gsetNumber)
     {
         _glTranslationTable = {};
     }
+    _UpdateCombinedTable();
     return true;
 }
 
@@ -129,6 +131,7 @@ bool TerminalOutput::LockingShiftRight(const size_t gsetNumber)
     {
         _grTranslationTable = {};
     }
+    _UpdateCombinedTable();
     return true;
 }
 
@@ -172,20 +175,55 @@ wchar_t TerminalOutput::TranslateKey(const wchar_t wch) const noexcept
         }
         _ssTranslationTable = {};
     }
-    else
+    else if (wch < _combinedTranslationTable.size())
     {
-        if (wch - 0x20u < _glTranslationTable.size())
-        {
-            wchFound = _glTranslationTable.at(wch - 0x20u);
-        }
-        else if (wch - 0xA0u < _grTranslationTable.size())
-        {
-            wchFound = _grTranslationTable.at(wch - 0xA0u);
-        }
+        wchFound = til::at(_combinedTranslationTable, wch);
     }
     return wchFound;
 }
 
+// Routine Description:
+// - Translates a string of characters with the active character sets.
+// - A pending single shift only applies to the first character, like it does
+//   with TranslateKey. Everything else is a lookup in the combined GL/GR table.
+// Arguments:
+// - string - the characters to translate
+// - translated - receives the translated characters. Its capacity is reused,
+//   so passing the same string every time avoids any allocations.
+// Return Value:
+// - <none>
+void TerminalOutput::TranslateString(const std::wstring_view string, std::wstring& translated) const
+{
+    translated.resize(string.size());
+
+    auto source = string.begin();
+    auto target = translated.begin();
+    if (!_ssTranslationTable.empty() && source != string.end())
+    {
+        *target++ = TranslateKey(*source++);
+    }
+
+    // A branchless lookup per character, which the compiler is free to unroll.
+    const auto& table = _combinedTranslationTable;
+    std::transform(source, string.end(), target, [&](const wchar_t wch) noexcept {
+        return wch < table.size() ? til::at(table, wch) : wch;
+    });
+}
+
+// Routine Description:
+// - Merges the active GL and GR translation tables into the combined table.
+//   This only happens when a character set is designated or shifted.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void TerminalOutput::_UpdateCombinedTable() noexcept
+{
+    std::iota(_combinedTranslationTable.begin(), _combinedTranslationTable.end(), L'\0');
+    std::copy(_glTranslationTable.begin(), _glTranslationTable.end(), _combinedTranslationTable.begin() + 0x20);
+    std::copy(_grTranslationTable.begin(), _grTranslationTable.end(), _combinedTranslationTable.begin() + 0xA0);
+}
+
 bool TerminalOutput::_SetTranslationTable(const size_t gsetNumber, const std::wstring_view translationTable)
 {
     _gsetTranslationTables.at(gsetNumber) = translationTable;
@@ -26,6 +26,7 @@ namespace Microsoft::Console::VirtualTerminal
         TerminalOutput() noexcept;
 
         wchar_t TranslateKey(const wchar_t wch) const noexcept;
+        void TranslateString(const std::wstring_view string, std::wstring& translated) const;
         bool Designate94Charset(const size_t gsetNumber, const VTID charset);
         bool Designate96Charset(const size_t gsetNumber, const VTID charset);
         bool LockingShift(const size_t gsetNumber);
@@ -36,6 +37,7 @@ namespace Microsoft::Console::VirtualTerminal
 
     private:
         bool _SetTranslationTable(const size_t gsetNumber, const std::wstring_view translationTable);
+        void _UpdateCombinedTable() noexcept;
 
         std::array<std::wstring_view, 4> _gsetTranslationTables;
         size_t _glSetNumber = 0;
@@ -44,5 +46,9 @@ namespace Microsoft::Console::VirtualTerminal
         std::wstring_view _grTranslationTable;
         mutable std::wstring_view _ssTranslationTable;
         boolean _grTranslationEnabled = false;
+
+        // The GL and GR tables merged into a single lookup for the first 256 code points.
+        // Everything outside of the two tables maps to itself.
+        std::array<wchar_t, 256> _combinedTranslationTable{};
     };
 }
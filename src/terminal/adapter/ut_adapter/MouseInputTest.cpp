@@ -85,7 +85,7 @@ class MouseInputTest
 public:
     TEST_CLASS(MouseInputTest);
 
-    static void s_MouseInputTestCallback(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& events)
+    static void s_MouseInputTestCallback(const gsl::span<const INPUT_RECORD> events)
     {
         Log::Comment(L"MouseInput successfully generated a sequence for the input, and sent it.");
 
@@ -99,7 +99,7 @@ public:
             for (size_t i = 0; i < events.size(); ++i)
             {
                 KeyEvent expectedKeyEvent(TRUE, 1, 0, 0, s_pwszInputExpected[i], 0);
-                KeyEvent testKeyEvent = *static_cast<const KeyEvent* const>(events[i].get());
+                KeyEvent testKeyEvent{ events[i].Event.KeyEvent };
                 VERIFY_ARE_EQUAL(expectedKeyEvent, testKeyEvent, NoThrowString().Format(L"Chars='%c','%c'", s_pwszInputExpected[i], testKeyEvent.GetCharData()));
             }
         }
@@ -651,4 +651,92 @@ public:
         mouseInput->EnableAlternateScroll(true);
         VERIFY_IS_FALSE(mouseInput->HandleMouse({ 0, 0 }, WM_MOUSEWHEEL, noModifierKeys, WHEEL_DELTA, {}));
     }
+    // Routine Description:
+    // - Drags the mouse from the first to the last of the given cells with the left
+    //      button pressed. The UI reports motion at pixel granularity, so every cell
+    //      is visited a couple of times before the mouse moves on to the next one.
+    static void s_SyntheticDrag(TerminalInput& mouseInput, const short cells, const short modifierKeyState)
+    {
+        constexpr int samplesPerCell = 4;
+        const TerminalInput::MouseButtonState leftButtonDown{ true, false, false };
+
+        mouseInput.HandleMouse({ 0, 0 }, WM_LBUTTONDOWN, modifierKeyState, 0, {});
+        for (short x = 0; x < cells; x++)
+        {
+            for (int i = 0; i < samplesPerCell; i++)
+            {
+                mouseInput.HandleMouse({ x, 0 }, WM_MOUSEMOVE, modifierKeyState, 0, leftButtonDown);
+            }
+        }
+    }
+
+    TEST_METHOD(MotionCoalescingTests)
+    {
+        std::vector<std::wstring> reports;
+        TerminalInput mouseInput{ [&](const gsl::span<const INPUT_RECORD> events) {
+            std::wstring report;
+            for (const auto& event : events)
+            {
+                report.push_back(event.Event.KeyEvent.uChar.UnicodeChar);
+            }
+            reports.emplace_back(std::move(report));
+        } };
+        mouseInput.EnableAnyEventTracking(true);
+        mouseInput.SetSGRExtendedMode(true);
+
+        constexpr short cells = 20;
+        const short noModifierKeys = 0;
+        const short shift = SHIFT_PRESSED;
+        const TerminalInput::MouseButtonState leftButtonDown{ true, false, false };
+
+        Log::Comment(L"Without coalescing, every cell of the drag is reported once.");
+        s_SyntheticDrag(mouseInput, cells, noModifierKeys);
+        mouseInput.HandleMouse({ cells - 1, 0 }, WM_LBUTTONUP, noModifierKeys, 0, {});
+        Log::Comment(NoThrowString().Format(L"%zu reports were sent", reports.size()));
+        VERIFY_ARE_EQUAL(static_cast<size_t>(cells + 2), reports.size());
+        VERIFY_IS_FALSE(mouseInput.HasPendingMouseMotion());
+
+        Log::Comment(L"With coalescing, only the first motion is reported right away.");
+        reports.clear();
+        mouseInput.SetMouseMotionCoalescing(std::chrono::hours{ 1 });
+        mouseInput.EnableAnyEventTracking(true);
+        s_SyntheticDrag(mouseInput, cells, noModifierKeys);
+        VERIFY_ARE_EQUAL(2u, reports.size());
+        VERIFY_ARE_EQUAL(L"\x1b[<0;1;1M", reports.at(0));
+        VERIFY_ARE_EQUAL(L"\x1b[<32;1;1M", reports.at(1));
+        VERIFY_IS_TRUE(mouseInput.HasPendingMouseMotion());
+
+        Log::Comment(L"Releasing the button reports the latest position first.");
+        mouseInput.HandleMouse({ cells - 1, 0 }, WM_LBUTTONUP, noModifierKeys, 0, {});
+        Log::Comment(NoThrowString().Format(L"%zu reports were sent", reports.size()));
+        VERIFY_ARE_EQUAL(4u, reports.size());
+        VERIFY_ARE_EQUAL(L"\x1b[<32;20;1M", reports.at(2));
+        VERIFY_ARE_EQUAL(L"\x1b[<0;20;1m", reports.at(3));
+        VERIFY_IS_FALSE(mouseInput.HasPendingMouseMotion());
+
+        Log::Comment(L"Changing the modifiers flushes the pending motion and is reported right away.");
+        reports.clear();
+        mouseInput.EnableAnyEventTracking(true);
+        s_SyntheticDrag(mouseInput, cells, noModifierKeys);
+        mouseInput.HandleMouse({ cells, 0 }, WM_MOUSEMOVE, shift, 0, leftButtonDown);
+        VERIFY_ARE_EQUAL(4u, reports.size());
+        VERIFY_ARE_EQUAL(L"\x1b[<32;20;1M", reports.at(2));
+        VERIFY_ARE_EQUAL(L"\x1b[<36;21;1M", reports.at(3));
+        VERIFY_IS_FALSE(mouseInput.HasPendingMouseMotion());
+
+        Log::Comment(L"The caller flushes the latest position once the interval elapsed.");
+        mouseInput.HandleMouse({ cells + 1, 0 }, WM_MOUSEMOVE, shift, 0, leftButtonDown);
+        mouseInput.HandleMouse({ cells + 2, 0 }, WM_MOUSEMOVE, shift, 0, leftButtonDown);
+        VERIFY_ARE_EQUAL(4u, reports.size());
+        VERIFY_IS_TRUE(mouseInput.FlushPendingMouseMotion());
+        VERIFY_ARE_EQUAL(5u, reports.size());
+        VERIFY_ARE_EQUAL(L"\x1b[<36;23;1M", reports.at(4));
+        VERIFY_IS_FALSE(mouseInput.FlushPendingMouseMotion());
+
+        Log::Comment(L"Changing the tracking mode drops the pending motion.");
+        mouseInput.HandleMouse({ cells + 3, 0 }, WM_MOUSEMOVE, shift, 0, leftButtonDown);
+        mouseInput.EnableAnyEventTracking(true);
+        VERIFY_IS_FALSE(mouseInput.HasPendingMouseMotion());
+        VERIFY_ARE_EQUAL(5u, reports.size());
+    }
 };
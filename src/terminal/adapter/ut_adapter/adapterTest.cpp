@@ -72,6 +72,19 @@ public:
 
         return _getConsoleScreenBufferInfoExResult;
     }
+    bool PrivateGetScreenBufferState(ScreenBufferState& state) const override
+    {
+        Log::Comment(L"PrivateGetScreenBufferState MOCK returning data...");
+
+        if (_privateGetScreenBufferStateResult)
+        {
+            state.bufferSize = _bufferSize;
+            state.viewport = _viewport;
+            state.cursorPosition = _cursorPos;
+        }
+
+        return _privateGetScreenBufferStateResult;
+    }
     bool SetConsoleScreenBufferInfoEx(const CONSOLE_SCREEN_BUFFER_INFOEX& sbiex) override
     {
         Log::Comment(L"SetConsoleScreenBufferInfoEx MOCK returning data...");
@@ -244,13 +257,15 @@ public:
         return _bufferSize.X;
     }
 
-    bool PrivateWriteConsoleInputW(std::deque<std::unique_ptr<IInputEvent>>& events,
+    bool PrivateWriteConsoleInputW(const gsl::span<const INPUT_RECORD> records,
                                    size_t& eventsWritten) override
     {
         Log::Comment(L"PrivateWriteConsoleInputW MOCK called...");
 
         if (_privateWriteConsoleInputWResult)
         {
+            auto events = IInputEvent::Create(records);
+
             // move all the input events we were given into local storage so we can test against them
             Log::Comment(NoThrowString().Format(L"Moving %zu input events into local storage...", events.size()));
 
@@ -567,6 +582,13 @@ public:
         return TRUE;
     }
 
+    bool PrivateClearScrollback(const SHORT /*viewportTop*/, const SHORT /*viewportHeight*/) noexcept override
+    {
+        Log::Comment(L"PrivateClearScrollback MOCK called...");
+
+        return TRUE;
+    }
+
     void PrepData()
     {
         PrepData(CursorDirection::UP); // if called like this, the cursor direction doesn't matter.
@@ -598,6 +620,7 @@ public:
         // APIs succeed by default
         _setConsoleCursorPositionResult = TRUE;
         _getConsoleScreenBufferInfoExResult = TRUE;
+        _privateGetScreenBufferStateResult = TRUE;
         _privateGetTextAttributesResult = TRUE;
         _privateSetTextAttributesResult = TRUE;
         _privateWriteConsoleInputWResult = TRUE;
@@ -756,6 +779,7 @@ public:
     bool _expectedShowCursor = false;
 
     bool _getConsoleScreenBufferInfoExResult = false;
+    bool _privateGetScreenBufferStateResult = false;
     bool _setConsoleCursorPositionResult = false;
     bool _privateGetTextAttributesResult = false;
     bool _privateSetTextAttributesResult = false;
@@ -1015,10 +1039,10 @@ public:
         VERIFY_IS_FALSE((_pDispatch.get()->*(moveFunc))(0));
         VERIFY_ARE_EQUAL(_testGetSet->_expectedCursorPos, _testGetSet->_cursorPos);
 
-        // GetConsoleScreenBufferInfo throws failure. Parameters are otherwise normal.
-        Log::Comment(L"Test 5: When GetConsoleScreenBufferInfo throws a failure, call fails and cursor doesn't move.");
+        // PrivateGetScreenBufferState throws failure. Parameters are otherwise normal.
+        Log::Comment(L"Test 5: When PrivateGetScreenBufferState throws a failure, call fails and cursor doesn't move.");
         _testGetSet->PrepData(CursorX::LEFT, CursorY::TOP);
-        _testGetSet->_getConsoleScreenBufferInfoExResult = FALSE;
+        _testGetSet->_privateGetScreenBufferStateResult = FALSE;
         VERIFY_IS_FALSE((_pDispatch.get()->*(moveFunc))(0));
         VERIFY_ARE_EQUAL(_testGetSet->_expectedCursorPos, _testGetSet->_cursorPos);
     }
@@ -1062,7 +1086,7 @@ public:
         Log::Comment(L"Test 4: GetConsoleInfo API returns false. No move, return false.");
         _testGetSet->PrepData(CursorX::LEFT, CursorY::TOP);
 
-        _testGetSet->_getConsoleScreenBufferInfoExResult = FALSE;
+        _testGetSet->_privateGetScreenBufferStateResult = FALSE;
 
         VERIFY_IS_FALSE(_pDispatch.get()->CursorPosition(1, 1));
 
@@ -1149,7 +1173,7 @@ public:
         Log::Comment(L"Test 4: GetConsoleInfo API returns false. No move, return false.");
         _testGetSet->PrepData(CursorX::LEFT, CursorY::TOP);
 
-        _testGetSet->_getConsoleScreenBufferInfoExResult = FALSE;
+        _testGetSet->_privateGetScreenBufferStateResult = FALSE;
 
         sVal = 1;
 
@@ -2057,7 +2081,7 @@ public:
         _testGetSet->_bufferSize = { 100, 600 };
         _testGetSet->_viewport.Right = 8;
         _testGetSet->_viewport.Bottom = 8;
-        _testGetSet->_getConsoleScreenBufferInfoExResult = TRUE;
+        _testGetSet->_privateGetScreenBufferStateResult = TRUE;
         SHORT sScreenHeight = _testGetSet->_viewport.Bottom - _testGetSet->_viewport.Top;
 
         Log::Comment(L"Test 1: Verify having both values is valid.");
@@ -2353,6 +2377,60 @@ public:
         VERIFY_IS_FALSE(_pDispatch.get()->SetColorTableEntry(15, testColor));
     }
 
+    TEST_METHOD(TranslateStringMatchesTranslateKey)
+    {
+        // Every code point that a character set could affect, plus a few that none can.
+        std::wstring string;
+        for (wchar_t wch = 0; wch < 0x120; wch++)
+        {
+            string.push_back(wch);
+        }
+        string.append(L"\x2500\xffff");
+
+        TerminalOutput termOutput;
+        const auto verifyTranslation = [&]() {
+            // TranslateKey consumes a single shift, so the expectation is built on a copy.
+            auto expectedOutput = termOutput;
+            std::wstring expected;
+            for (const auto wch : string)
+            {
+                expected.push_back(expectedOutput.TranslateKey(wch));
+            }
+
+            std::wstring translated;
+            termOutput.TranslateString(string, translated);
+            VERIFY_ARE_EQUAL(expected, translated);
+        };
+
+        Log::Comment(L"No translation at all.");
+        verifyTranslation();
+
+        Log::Comment(L"DEC Special Graphics in GL.");
+        VERIFY_IS_TRUE(termOutput.Designate94Charset(0, VTID("0")));
+        verifyTranslation();
+
+        Log::Comment(L"British NRCS shifted into GL.");
+        VERIFY_IS_TRUE(termOutput.Designate94Charset(1, VTID("A")));
+        VERIFY_IS_TRUE(termOutput.LockingShift(1));
+        verifyTranslation();
+
+        Log::Comment(L"ISO Latin-2 in GR.");
+        termOutput.EnableGrTranslation(true);
+        VERIFY_IS_TRUE(termOutput.Designate96Charset(2, VTID("B")));
+        verifyTranslation();
+
+        Log::Comment(L"A single shift should only affect the first character.");
+        VERIFY_IS_TRUE(termOutput.Designate94Charset(3, VTID("<")));
+        VERIFY_IS_TRUE(termOutput.SingleShift(3));
+        string.insert(0, 1, L'\xa8');
+        verifyTranslation();
+
+        std::wstring translated;
+        VERIFY_IS_TRUE(termOutput.SingleShift(3));
+        termOutput.TranslateString(L"\xa8\xa8", translated);
+        VERIFY_ARE_EQUAL(std::wstring{ L"\x00a4\xa8" }, translated);
+    }
+
 private:
     TestGetSet* _testGetSet; // non-ownership pointer
     std::unique_ptr<AdaptDispatch> _pDispatch;
@@ -38,14 +38,15 @@ class Microsoft::Console::VirtualTerminal::InputTest
 public:
     TEST_CLASS(InputTest);
 
-    static void s_TerminalInputTestCallback(_In_ std::deque<std::unique_ptr<IInputEvent>>& inEvents);
-    static void s_TerminalInputTestNullCallback(_In_ std::deque<std::unique_ptr<IInputEvent>>& inEvents);
+    static void s_TerminalInputTestCallback(const gsl::span<const INPUT_RECORD> records);
+    static void s_TerminalInputTestNullCallback(const gsl::span<const INPUT_RECORD> records);
 
     TEST_METHOD(TerminalInputTests);
     TEST_METHOD(TerminalInputModifierKeyTests);
     TEST_METHOD(TerminalInputNullKeyTests);
     TEST_METHOD(DifferentModifiersTest);
     TEST_METHOD(CtrlNumTest);
+    TEST_METHOD(Win32InputModeTest);
 
     wchar_t GetModifierChar(const bool fShift, const bool fAlt, const bool fCtrl)
     {
@@ -78,10 +79,8 @@ public:
     }
 };
 
-void InputTest::s_TerminalInputTestCallback(_In_ std::deque<std::unique_ptr<IInputEvent>>& inEvents)
+void InputTest::s_TerminalInputTestCallback(const gsl::span<const INPUT_RECORD> records)
 {
-    auto records = IInputEvent::ToInputRecords(inEvents);
-
     if (VERIFY_ARE_EQUAL(s_expectedInput.size(), records.size(), L"Verify expected and actual input array lengths matched."))
     {
         Log::Comment(L"We are expecting always key events and always key down. All other properties should not be written by simulated keys.");
@@ -100,10 +99,8 @@ void InputTest::s_TerminalInputTestCallback(_In_ std::deque<std::unique_ptr<IInp
     }
 }
 
-void InputTest::s_TerminalInputTestNullCallback(_In_ std::deque<std::unique_ptr<IInputEvent>>& inEvents)
+void InputTest::s_TerminalInputTestNullCallback(const gsl::span<const INPUT_RECORD> records)
 {
-    auto records = IInputEvent::ToInputRecords(inEvents);
-
     if (records.size() == 1)
     {
         Log::Comment(L"We are expecting a null input event.");
@@ -739,3 +736,19 @@ void InputTest::CtrlNumTest()
     s_expectedInput = L"9";
     TestKey(pInput, uiKeystate, vkey);
 }
+
+void InputTest::Win32InputModeTest()
+{
+    Log::Comment(L"Starting test...");
+
+    TerminalInput* const pInput = new TerminalInput(s_TerminalInputTestCallback);
+    pInput->ChangeWin32InputMode(true);
+
+    Log::Comment(L"Every key should be sent as a single win32-input-mode sequence.");
+
+    s_expectedInput = L"\x1b[65;0;97;1;0;1_";
+    TestKey(pInput, 0, 'A', L'a');
+
+    s_expectedInput = L"\x1b[46;0;0;1;264;1_";
+    TestKey(pInput, LEFT_CTRL_PRESSED | ENHANCED_KEY, VK_DELETE);
+}
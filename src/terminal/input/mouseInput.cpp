@@ -346,9 +346,12 @@ bool TerminalInput::HandleMouse(const COORD position,
             const bool isHover = _isHoverMsg(button);
             const bool isButton = _isButtonMsg(button);
 
+            // The UI reports motion at pixel granularity, but we only report it
+            //      once per cell (and whenever the modifiers change).
             const bool sameCoord = (position.X == _mouseInputState.lastPos.X) &&
                                    (position.Y == _mouseInputState.lastPos.Y) &&
-                                   (_mouseInputState.lastButton == button);
+                                   (_mouseInputState.lastButton == button) &&
+                                   (_mouseInputState.lastModifierKeyState == modifierKeyState);
 
             // If we have a WM_MOUSEMOVE, we need to know if any of the mouse
             //      buttons are actually pressed. If they are,
@@ -369,53 +372,33 @@ bool TerminalInput::HandleMouse(const COORD position,
 
             if (success)
             {
-                std::wstring sequence;
-                switch (_mouseInputState.extendedMode)
+                if (isHover && _ShouldCoalesceMotion(realButton, modifierKeyState))
                 {
-                case ExtendedMode::None:
-                    sequence = _GenerateDefaultSequence(position,
-                                                        realButton,
-                                                        isHover,
-                                                        modifierKeyState,
-                                                        delta);
-                    break;
-                case ExtendedMode::Utf8:
-                    sequence = _GenerateUtf8Sequence(position,
-                                                     realButton,
-                                                     isHover,
-                                                     modifierKeyState,
-                                                     delta);
-                    break;
-                case ExtendedMode::Sgr:
-                    // For SGR encoding, if no physical buttons were pressed,
-                    // then we want to handle hovers with WM_MOUSEMOVE.
-                    // However, if we're dragging (WM_MOUSEMOVE with a button pressed),
-                    //      then use that pressed button instead.
-                    sequence = _GenerateSGRSequence(position,
-                                                    physicalButtonPressed ? realButton : button,
-                                                    _isButtonDown(realButton), // Use realButton here, to properly get the up/down state
-                                                    isHover,
-                                                    modifierKeyState,
-                                                    delta);
-                    break;
-                case ExtendedMode::Urxvt:
-                default:
-                    success = false;
-                    break;
+                    // Hold the report back. If more motion follows within the
+                    //      interval, it'll simply replace this one.
+                    _mouseInputState.pendingMotion = PendingMotion{ position, modifierKeyState, state };
                 }
-
-                success = !sequence.empty();
-
-                if (success)
+                else
                 {
-                    _SendInputSequence(sequence);
-                    success = true;
+                    // A held back report in the same button/modifier state is superseded
+                    //      by this motion. Anything else has to be reported first, so
+                    //      that the client sees the events in the order they happened.
+                    const auto& pending = _mouseInputState.pendingMotion;
+                    if (pending && (!isHover || s_GetPressedButton(pending->state) != realButton || pending->modifierKeyState != modifierKeyState))
+                    {
+                        FlushPendingMouseMotion();
+                    }
+                    _mouseInputState.pendingMotion.reset();
+
+                    success = _SendMouseSequence(position, button, modifierKeyState, delta, state);
                 }
+
                 if (_mouseInputState.trackingMode == TrackingMode::ButtonEvent || _mouseInputState.trackingMode == TrackingMode::AnyEvent)
                 {
                     _mouseInputState.lastPos.X = position.X;
                     _mouseInputState.lastPos.Y = position.Y;
                     _mouseInputState.lastButton = button;
+                    _mouseInputState.lastModifierKeyState = modifierKeyState;
                 }
             }
         }
@@ -423,6 +406,129 @@ bool TerminalInput::HandleMouse(const COORD position,
     return success;
 }
 
+// Routine Description:
+// - Returns true if there's a motion report that's being held back, and the
+//      caller should call FlushPendingMouseMotion once the coalescing interval elapsed.
+// Parameters:
+// - <none>
+// Return value:
+// - true if there's a pending motion report.
+bool TerminalInput::HasPendingMouseMotion() const noexcept
+{
+    return _mouseInputState.pendingMotion.has_value();
+}
+
+// Routine Description:
+// - Sends the motion report that's being held back, if there is one.
+// Parameters:
+// - <none>
+// Return value:
+// - true if a report was sent.
+bool TerminalInput::FlushPendingMouseMotion()
+{
+    if (const auto pending = std::exchange(_mouseInputState.pendingMotion, std::nullopt))
+    {
+        return _SendMouseSequence(pending->position, WM_MOUSEMOVE, pending->modifierKeyState, 0, pending->state);
+    }
+    return false;
+}
+
+// Routine Description:
+// - Returns true if a motion in the given button/modifier state should be held
+//      back, because it follows the last reported motion within the coalescing
+//      interval and doesn't change the state the client has last seen.
+// Parameters:
+// - realButton - the button that's pressed during the motion, or WM_LBUTTONUP if there's none.
+// - modifierKeyState - the modifier keys pressed during the motion
+// Return value:
+// - true if the motion report should be held back.
+bool TerminalInput::_ShouldCoalesceMotion(const unsigned int realButton, const short modifierKeyState) const noexcept
+{
+    const auto& last = _mouseInputState.lastMotion;
+    return _mouseInputState.motionCoalescingInterval.count() > 0 &&
+           last &&
+           last->button == realButton &&
+           last->modifierKeyState == modifierKeyState &&
+           std::chrono::steady_clock::now() - last->time < _mouseInputState.motionCoalescingInterval;
+}
+
+// Routine Description:
+// - Encodes the given mouse event according to the selected ExtendedMode and sends it.
+// Parameters:
+// - position - The windows coordinates (top,left = 0,0) of the mouse event
+// - button - the message to decode.
+// - modifierKeyState - the modifier keys pressed with this button
+// - delta - the amount that the scroll wheel changed (should be 0 unless button is a WM_MOUSE*WHEEL)
+// - state - the state of the mouse buttons at this moment
+// Return value:
+// - true if we were able to encode and send the event.
+bool TerminalInput::_SendMouseSequence(const COORD position,
+                                       const unsigned int button,
+                                       const short modifierKeyState,
+                                       const short delta,
+                                       const MouseButtonState state)
+{
+    // isHover is only true for WM_MOUSEMOVE events
+    const bool isHover = _isHoverMsg(button);
+
+    // If we have a WM_MOUSEMOVE, we need to know if any of the mouse
+    //      buttons are actually pressed. If they are,
+    //      _GetPressedButton will return the first pressed mouse button.
+    // If it returns WM_LBUTTONUP, then we can assume that the mouse
+    //      moved without a button being pressed.
+    const unsigned int realButton = isHover ? s_GetPressedButton(state) : button;
+    const bool physicalButtonPressed = realButton != WM_LBUTTONUP;
+
+    SequenceBuffer sequence;
+    switch (_mouseInputState.extendedMode)
+    {
+    case ExtendedMode::None:
+        _GenerateDefaultSequence(position,
+                                 realButton,
+                                 isHover,
+                                 modifierKeyState,
+                                 delta,
+                                 sequence);
+        break;
+    case ExtendedMode::Utf8:
+        _GenerateUtf8Sequence(position,
+                              realButton,
+                              isHover,
+                              modifierKeyState,
+                              delta,
+                              sequence);
+        break;
+    case ExtendedMode::Sgr:
+        // For SGR encoding, if no physical buttons were pressed,
+        // then we want to handle hovers with WM_MOUSEMOVE.
+        // However, if we're dragging (WM_MOUSEMOVE with a button pressed),
+        //      then use that pressed button instead.
+        _GenerateSGRSequence(position,
+                             physicalButtonPressed ? realButton : button,
+                             _isButtonDown(realButton), // Use realButton here, to properly get the up/down state
+                             isHover,
+                             modifierKeyState,
+                             delta,
+                             sequence);
+        break;
+    case ExtendedMode::Urxvt:
+    default:
+        break;
+    }
+
+    if (sequence.size() == 0)
+    {
+        return false;
+    }
+
+    _SendInputSequence({ sequence.data(), sequence.size() });
+    if (isHover)
+    {
+        _mouseInputState.lastMotion = SentMotion{ std::chrono::steady_clock::now(), realButton, modifierKeyState };
+    }
+    return true;
+}
+
 // Routine Description:
 // - Generates a sequence encoding the mouse event according to the default scheme.
 //     see http://invisible-island.net/xterm/ctlseqs/ctlseqs.html#h2-Mouse-Tracking
@@ -432,13 +538,15 @@ bool TerminalInput::HandleMouse(const COORD position,
 // - isHover - true if the sequence is generated in response to a mouse hover
 // - modifierKeyState - the modifier keys pressed with this button
 // - delta - the amount that the scroll wheel changed (should be 0 unless button is a WM_MOUSE*WHEEL)
+// - sequence - the buffer to append the generated sequence to. Nothing is appended if we couldn't generate one.
 // Return value:
-// - The generated sequence. Will be empty if we couldn't generate.
-std::wstring TerminalInput::_GenerateDefaultSequence(const COORD position,
-                                                     const unsigned int button,
-                                                     const bool isHover,
-                                                     const short modifierKeyState,
-                                                     const short delta)
+// - <none>
+void TerminalInput::_GenerateDefaultSequence(const COORD position,
+                                             const unsigned int button,
+                                             const bool isHover,
+                                             const short modifierKeyState,
+                                             const short delta,
+                                             SequenceBuffer& sequence)
 {
     // In the default, non-extended encoding scheme, coordinates above 94 shouldn't be supported,
     //   because (95+32+1)=128, which is not an ASCII character.
@@ -450,14 +558,10 @@ std::wstring TerminalInput::_GenerateDefaultSequence(const COORD position,
         const short encodedX = _encodeDefaultCoordinate(vtCoords.X);
         const short encodedY = _encodeDefaultCoordinate(vtCoords.Y);
 
-        std::wstring format{ L"\x1b[Mbxy" };
-        format.at(3) = ' ' + gsl::narrow_cast<short>(_windowsButtonToXEncoding(button, isHover, modifierKeyState, delta));
-        format.at(4) = encodedX;
-        format.at(5) = encodedY;
-        return format;
+        const auto encodedButton = ' ' + gsl::narrow_cast<short>(_windowsButtonToXEncoding(button, isHover, modifierKeyState, delta));
+        const std::array<wchar_t, 6> format{ L'\x1b', L'[', L'M', gsl::narrow_cast<wchar_t>(encodedButton), gsl::narrow_cast<wchar_t>(encodedX), gsl::narrow_cast<wchar_t>(encodedY) };
+        sequence.append(format.data(), format.data() + format.size());
     }
-
-    return {};
 }
 
 // Routine Description:
@@ -469,13 +573,15 @@ std::wstring TerminalInput::_GenerateDefaultSequence(const COORD position,
 // - isHover - true if the sequence is generated in response to a mouse hover
 // - modifierKeyState - the modifier keys pressed with this button
 // - delta - the amount that the scroll wheel changed (should be 0 unless button is a WM_MOUSE*WHEEL)
+// - sequence - the buffer to append the generated sequence to. Nothing is appended if we couldn't generate one.
 // Return value:
-// - The generated sequence. Will be empty if we couldn't generate.
-std::wstring TerminalInput::_GenerateUtf8Sequence(const COORD position,
-                                                  const unsigned int button,
-                                                  const bool isHover,
-                                                  const short modifierKeyState,
-                                                  const short delta)
+// - <none>
+void TerminalInput::_GenerateUtf8Sequence(const COORD position,
+                                          const unsigned int button,
+                                          const bool isHover,
+                                          const short modifierKeyState,
+                                          const short delta,
+                                          SequenceBuffer& sequence)
 {
     // So we have some complications here.
     // The windows input stream is typically encoded as UTF16.
@@ -496,15 +602,11 @@ std::wstring TerminalInput::_GenerateUtf8Sequence(const COORD position,
         const COORD vtCoords = _winToVTCoord(position);
         const short encodedX = _encodeDefaultCoordinate(vtCoords.X);
         const short encodedY = _encodeDefaultCoordinate(vtCoords.Y);
-        std::wstring format{ L"\x1b[Mbxy" };
         // The short cast is safe because we know s_WindowsButtonToXEncoding  never returns more than xff
-        format.at(3) = ' ' + gsl::narrow_cast<short>(_windowsButtonToXEncoding(button, isHover, modifierKeyState, delta));
-        format.at(4) = encodedX;
-        format.at(5) = encodedY;
-        return format;
+        const auto encodedButton = ' ' + gsl::narrow_cast<short>(_windowsButtonToXEncoding(button, isHover, modifierKeyState, delta));
+        const std::array<wchar_t, 6> format{ L'\x1b', L'[', L'M', gsl::narrow_cast<wchar_t>(encodedButton), gsl::narrow_cast<wchar_t>(encodedX), gsl::narrow_cast<wchar_t>(encodedY) };
+        sequence.append(format.data(), format.data() + format.size());
     }
-
-    return {};
 }
 
 // Routine Description:
@@ -517,25 +619,23 @@ std::wstring TerminalInput::_GenerateUtf8Sequence(const COORD position,
 // - isHover - true if the sequence is generated in response to a mouse hover
 // - modifierKeyState - the modifier keys pressed with this button
 // - delta - the amount that the scroll wheel changed (should be 0 unless button is a WM_MOUSE*WHEEL)
-// - ppwchSequence - On success, where to put the pointer to the generated sequence
-// - pcchLength - On success, where to put the length of the generated sequence
+// - sequence - the buffer to append the generated sequence to.
 // Return value:
-// - true if we were able to successfully generate a sequence.
-// On success, caller is responsible for delete[]ing *ppwchSequence.
-std::wstring TerminalInput::_GenerateSGRSequence(const COORD position,
-                                                 const unsigned int button,
-                                                 const bool isDown,
-                                                 const bool isHover,
-                                                 const short modifierKeyState,
-                                                 const short delta)
+// - <none>
+void TerminalInput::_GenerateSGRSequence(const COORD position,
+                                         const unsigned int button,
+                                         const bool isDown,
+                                         const bool isHover,
+                                         const short modifierKeyState,
+                                         const short delta,
+                                         SequenceBuffer& sequence)
 {
     // Format for SGR events is:
     // "\x1b[<%d;%d;%d;%c", xButton, x+1, y+1, fButtonDown? 'M' : 'm'
     const int xbutton = _windowsButtonToSGREncoding(button, isHover, modifierKeyState, delta);
 
-    auto format = wil::str_printf<std::wstring>(L"\x1b[<%d;%d;%d%c", xbutton, position.X + 1, position.Y + 1, isDown ? L'M' : L'm');
-
-    return format;
+    fmt::format_to(std::back_inserter(sequence), FMT_COMPILE(L"\x1b[<{};{};{}"), xbutton, position.X + 1, position.Y + 1);
+    sequence.push_back(isDown ? L'M' : L'm');
 }
 
 // Routine Description:
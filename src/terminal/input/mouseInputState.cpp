@@ -45,8 +45,7 @@ void TerminalInput::SetSGRExtendedMode(const bool enable) noexcept
 void TerminalInput::EnableDefaultTracking(const bool enable) noexcept
 {
     _mouseInputState.trackingMode = enable ? TrackingMode::Default : TrackingMode::None;
-    _mouseInputState.lastPos = { -1, -1 }; // Clear out the last saved mouse position & button.
-    _mouseInputState.lastButton = 0;
+    _ResetMouseTrackingState();
 }
 
 // Routine Description:
@@ -61,8 +60,7 @@ void TerminalInput::EnableDefaultTracking(const bool enable) noexcept
 void TerminalInput::EnableButtonEventTracking(const bool enable) noexcept
 {
     _mouseInputState.trackingMode = enable ? TrackingMode::ButtonEvent : TrackingMode::None;
-    _mouseInputState.lastPos = { -1, -1 }; // Clear out the last saved mouse position & button.
-    _mouseInputState.lastButton = 0;
+    _ResetMouseTrackingState();
 }
 
 // Routine Description:
@@ -77,8 +75,25 @@ void TerminalInput::EnableButtonEventTracking(const bool enable) noexcept
 void TerminalInput::EnableAnyEventTracking(const bool enable) noexcept
 {
     _mouseInputState.trackingMode = enable ? TrackingMode::AnyEvent : TrackingMode::None;
-    _mouseInputState.lastPos = { -1, -1 }; // Clear out the last saved mouse position & button.
-    _mouseInputState.lastButton = 0;
+    _ResetMouseTrackingState();
+}
+
+// Routine Description:
+// - Sets how long motion reports are held back after a motion was reported, so
+//      that a burst of them (e.g. while the user is sweeping across the window in
+//      AnyEvent mode) is reported as a single event at its latest position.
+//   Motion that changes the pressed buttons or modifiers, and every other mouse
+//      event, still flushes the held back report and is sent right away.
+//   The caller is responsible for calling FlushPendingMouseMotion once the
+//      interval has elapsed, if HasPendingMouseMotion returns true.
+// Parameters:
+// - interval - the coalescing interval. 0 disables coalescing.
+// Return value:
+// <none>
+void TerminalInput::SetMouseMotionCoalescing(const std::chrono::milliseconds interval) noexcept
+{
+    _mouseInputState.motionCoalescingInterval = std::max(interval, std::chrono::milliseconds::zero());
+    _mouseInputState.pendingMotion.reset();
 }
 
 // Routine Description:
@@ -113,3 +128,19 @@ void TerminalInput::UseMainScreenBuffer() noexcept
 {
     _mouseInputState.inAlternateBuffer = false;
 }
+
+// Routine Description:
+// - Clears out the last saved mouse position, button and modifiers, as well as
+//      any motion report that's still held back, whenever the tracking mode changes.
+// Parameters:
+// <none>
+// Return value:
+// <none>
+void TerminalInput::_ResetMouseTrackingState() noexcept
+{
+    _mouseInputState.lastPos = { -1, -1 };
+    _mouseInputState.lastButton = 0;
+    _mouseInputState.lastModifierKeyState = 0;
+    _mouseInputState.pendingMotion.reset();
+    _mouseInputState.lastMotion.reset();
+}
@@ -19,7 +19,7 @@
 
 using namespace Microsoft::Console::VirtualTerminal;
 
-TerminalInput::TerminalInput(_In_ std::function<void(std::deque<std::unique_ptr<IInputEvent>>&)> pfn) :
+TerminalInput::TerminalInput(_In_ std::function<void(const gsl::span<const INPUT_RECORD>)> pfn) :
     _leadingSurrogate{}
 {
     _pfnWriteEvents = pfn;
@@ -359,6 +359,19 @@ static std::optional<const TermKeyMap> _searchKeyMapping(const KeyEvent& keyEven
 
 typedef std::function<void(const std::wstring_view)> InputSender;
 
+// The modifiable sequences are edited in a small buffer on the stack.
+static constexpr size_t s_maxModifiableSequenceLength = 8;
+static_assert([]() {
+    for (const auto& map : s_modifierKeyMapping)
+    {
+        if (map.sequence.size() > s_maxModifiableSequenceLength)
+        {
+            return false;
+        }
+    }
+    return true;
+}());
+
 // Routine Description:
 // - Searches the s_modifierKeyMapping for a entry corresponding to this key event.
 //      Changes the second to last byte to correspond to the currently pressed modifier keys
@@ -379,12 +392,13 @@ static bool _searchWithModifier(const KeyEvent& keyEvent, InputSender sender)
         const auto& v = match.value();
         if (!v.sequence.empty())
         {
-            std::wstring modified{ v.sequence }; // Make a copy so we can modify it.
+            std::array<wchar_t, s_maxModifiableSequenceLength> modified{}; // Make a copy so we can modify it.
+            std::copy(v.sequence.begin(), v.sequence.end(), modified.begin());
             const bool shift = keyEvent.IsShiftPressed();
             const bool alt = keyEvent.IsAltPressed();
             const bool ctrl = keyEvent.IsCtrlPressed();
-            modified.at(modified.size() - 2) = L'1' + (shift ? 1 : 0) + (alt ? 2 : 0) + (ctrl ? 4 : 0);
-            sender(modified);
+            til::at(modified, v.sequence.size() - 2) = L'1' + (shift ? 1 : 0) + (alt ? 2 : 0) + (ctrl ? 4 : 0);
+            sender({ modified.data(), v.sequence.size() });
             success = true;
         }
     }
@@ -532,8 +546,9 @@ bool TerminalInput::HandleKey(const IInputEvent* const pInEvent)
     // Only do this if win32-input-mode support isn't manually disabled.
     if (_win32InputMode && !_forceDisableWin32InputMode)
     {
-        const auto seq = _GenerateWin32KeySequence(keyEvent);
-        _SendInputSequence(seq);
+        SequenceBuffer sequence;
+        _GenerateWin32KeySequence(keyEvent, sequence);
+        _SendInputSequence({ sequence.data(), sequence.size() });
         return true;
     }
 
@@ -713,10 +728,8 @@ void TerminalInput::_SendEscapedInputSequence(const wchar_t wch) const
 {
     try
     {
-        std::deque<std::unique_ptr<IInputEvent>> inputEvents;
-        inputEvents.push_back(std::make_unique<KeyEvent>(true, 1ui16, 0ui16, 0ui16, L'\x1b', 0));
-        inputEvents.push_back(std::make_unique<KeyEvent>(true, 1ui16, 0ui16, 0ui16, wch, 0));
-        _pfnWriteEvents(inputEvents);
+        const std::array<INPUT_RECORD, 2> records{ _MakeKeyRecord(L'\x1b'), _MakeKeyRecord(wch) };
+        _pfnWriteEvents(records);
     }
     catch (...)
     {
@@ -728,14 +741,14 @@ void TerminalInput::_SendNullInputSequence(const DWORD controlKeyState) const
 {
     try
     {
-        std::deque<std::unique_ptr<IInputEvent>> inputEvents;
-        inputEvents.push_back(std::make_unique<KeyEvent>(true,
-                                                         1ui16,
-                                                         LOBYTE(VkKeyScanW(0)),
-                                                         0ui16,
-                                                         L'\x0',
-                                                         controlKeyState));
-        _pfnWriteEvents(inputEvents);
+        const KeyEvent keyEvent{ true,
+                                 1ui16,
+                                 LOBYTE(VkKeyScanW(0)),
+                                 0ui16,
+                                 L'\x0',
+                                 controlKeyState };
+        const auto record = keyEvent.ToInputRecord();
+        _pfnWriteEvents({ &record, 1 });
     }
     catch (...)
     {
@@ -749,12 +762,12 @@ void TerminalInput::_SendInputSequence(const std::wstring_view sequence) const n
     {
         try
         {
-            std::deque<std::unique_ptr<IInputEvent>> inputEvents;
-            for (const auto& wch : sequence)
-            {
-                inputEvents.push_back(std::make_unique<KeyEvent>(true, 1ui16, 0ui16, 0ui16, wch, 0));
-            }
-            _pfnWriteEvents(inputEvents);
+            // Every key and mouse sequence fits onto the stack, only longer strings
+            // (like pastes) spill onto the heap. The whole sequence is written in a
+            // single call, so that readers are woken up once and never see a part of it.
+            boost::container::small_vector<INPUT_RECORD, 64> records(sequence.size());
+            std::transform(sequence.begin(), sequence.end(), records.begin(), _MakeKeyRecord);
+            _pfnWriteEvents({ records.data(), records.size() });
         }
         catch (...)
         {
@@ -763,13 +776,30 @@ void TerminalInput::_SendInputSequence(const std::wstring_view sequence) const n
     }
 }
 
+// Routine Description:
+// - Creates the key down record that's sent for a single character of a sequence.
+// Arguments:
+// - wch - the character to send
+// Return Value:
+// - the key down record
+INPUT_RECORD TerminalInput::_MakeKeyRecord(const wchar_t wch) noexcept
+{
+    INPUT_RECORD record{};
+    record.EventType = KEY_EVENT;
+    record.Event.KeyEvent.bKeyDown = TRUE;
+    record.Event.KeyEvent.wRepeatCount = 1;
+    record.Event.KeyEvent.uChar.UnicodeChar = wch;
+    return record;
+}
+
 // Method Description:
 // - Synthesize a win32-input-mode sequence for the given keyevent.
 // Arguments:
 // - key: the KeyEvent to serialize.
+// - sequence: the buffer to append the formatted sequence to.
 // Return Value:
-// - the formatted string representation of this key
-std::wstring TerminalInput::_GenerateWin32KeySequence(const KeyEvent& key)
+// - <none>
+void TerminalInput::_GenerateWin32KeySequence(const KeyEvent& key, SequenceBuffer& sequence)
 {
     // Sequences are formatted as follows:
     //
@@ -782,11 +812,12 @@ std::wstring TerminalInput::_GenerateWin32KeySequence(const KeyEvent& key)
     //      Kd: the value of bKeyDown - either a '0' or '1'. If omitted, defaults to '0'.
     //      Cs: the value of dwControlKeyState - any number. If omitted, defaults to '0'.
     //      Rc: the value of wRepeatCount - any number. If omitted, defaults to '1'.
-    return fmt::format(FMT_COMPILE(L"\x1b[{};{};{};{};{};{}_"),
-                       key.GetVirtualKeyCode(),
-                       key.GetVirtualScanCode(),
-                       static_cast<int>(key.GetCharData()),
-                       key.IsKeyDown() ? 1 : 0,
-                       key.GetActiveModifierKeys(),
-                       key.GetRepeatCount());
+    fmt::format_to(std::back_inserter(sequence),
+                   FMT_COMPILE(L"\x1b[{};{};{};{};{};{}_"),
+                   key.GetVirtualKeyCode(),
+                   key.GetVirtualScanCode(),
+                   static_cast<int>(key.GetCharData()),
+                   key.IsKeyDown() ? 1 : 0,
+                   key.GetActiveModifierKeys(),
+                   key.GetRepeatCount());
 }
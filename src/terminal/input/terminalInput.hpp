@@ -13,6 +13,7 @@ Author(s):
 - Michael Niksa (MiNiksa) 30-Oct-2015
 --*/
 
+#include <chrono>
 #include <functional>
 #include "../../types/inc/IInputEvent.hpp"
 #pragma once
@@ -22,7 +23,7 @@ namespace Microsoft::Console::VirtualTerminal
     class TerminalInput final
     {
     public:
-        TerminalInput(_In_ std::function<void(std::deque<std::unique_ptr<IInputEvent>>&)> pfn);
+        TerminalInput(_In_ std::function<void(const gsl::span<const INPUT_RECORD>)> pfn);
 
         TerminalInput() = delete;
         TerminalInput(const TerminalInput& old) = default;
@@ -58,6 +59,10 @@ namespace Microsoft::Console::VirtualTerminal
                          const MouseButtonState state);
 
         bool IsTrackingMouseInput() const noexcept;
+
+        void SetMouseMotionCoalescing(const std::chrono::milliseconds interval) noexcept;
+        bool HasPendingMouseMotion() const noexcept;
+        bool FlushPendingMouseMotion();
 #pragma endregion
 
 #pragma region MouseInputState Management
@@ -75,7 +80,11 @@ namespace Microsoft::Console::VirtualTerminal
 #pragma endregion
 
     private:
-        std::function<void(std::deque<std::unique_ptr<IInputEvent>>&)> _pfnWriteEvents;
+        std::function<void(const gsl::span<const INPUT_RECORD>)> _pfnWriteEvents;
+
+        // Sequences are encoded into a buffer on the caller's stack. It's large
+        // enough for any key or mouse sequence, so encoding doesn't allocate.
+        using SequenceBuffer = fmt::basic_memory_buffer<wchar_t, 64>;
 
         // storage location for the leading surrogate of a utf-16 surrogate pair
         std::optional<wchar_t> _leadingSurrogate;
@@ -90,7 +99,8 @@ namespace Microsoft::Console::VirtualTerminal
         void _SendNullInputSequence(const DWORD dwControlKeyState) const;
         void _SendInputSequence(const std::wstring_view sequence) const noexcept;
         void _SendEscapedInputSequence(const wchar_t wch) const;
-        static std::wstring _GenerateWin32KeySequence(const KeyEvent& key);
+        static INPUT_RECORD _MakeKeyRecord(const wchar_t wch) noexcept;
+        static void _GenerateWin32KeySequence(const KeyEvent& key, SequenceBuffer& sequence);
 
 #pragma region MouseInputState Management
         // These methods are defined in mouseInputState.cpp
@@ -110,6 +120,23 @@ namespace Microsoft::Console::VirtualTerminal
             AnyEvent
         };
 
+        // A motion report that was held back, because it arrived within the
+        // coalescing interval of the previous one. Only the latest one is kept.
+        struct PendingMotion
+        {
+            COORD position;
+            short modifierKeyState;
+            MouseButtonState state;
+        };
+
+        // The time and the button/modifier state of the last motion we reported.
+        struct SentMotion
+        {
+            std::chrono::steady_clock::time_point time;
+            unsigned int button;
+            short modifierKeyState;
+        };
+
         struct MouseInputState
         {
             ExtendedMode extendedMode{ ExtendedMode::None };
@@ -118,29 +145,45 @@ namespace Microsoft::Console::VirtualTerminal
             bool inAlternateBuffer{ false };
             COORD lastPos{ -1, -1 };
             unsigned int lastButton{ 0 };
+            short lastModifierKeyState{ 0 };
             int accumulatedDelta{ 0 };
+            std::chrono::milliseconds motionCoalescingInterval{ 0 };
+            std::optional<PendingMotion> pendingMotion;
+            std::optional<SentMotion> lastMotion;
         };
 
+        void _ResetMouseTrackingState() noexcept;
+
         MouseInputState _mouseInputState;
 #pragma endregion
 
 #pragma region MouseInput
-        static std::wstring _GenerateDefaultSequence(const COORD position,
-                                                     const unsigned int button,
-                                                     const bool isHover,
-                                                     const short modifierKeyState,
-                                                     const short delta);
-        static std::wstring _GenerateUtf8Sequence(const COORD position,
-                                                  const unsigned int button,
-                                                  const bool isHover,
-                                                  const short modifierKeyState,
-                                                  const short delta);
-        static std::wstring _GenerateSGRSequence(const COORD position,
-                                                 const unsigned int button,
-                                                 const bool isDown,
-                                                 const bool isHover,
-                                                 const short modifierKeyState,
-                                                 const short delta);
+        static void _GenerateDefaultSequence(const COORD position,
+                                             const unsigned int button,
+                                             const bool isHover,
+                                             const short modifierKeyState,
+                                             const short delta,
+                                             SequenceBuffer& sequence);
+        static void _GenerateUtf8Sequence(const COORD position,
+                                          const unsigned int button,
+                                          const bool isHover,
+                                          const short modifierKeyState,
+                                          const short delta,
+                                          SequenceBuffer& sequence);
+        static void _GenerateSGRSequence(const COORD position,
+                                         const unsigned int button,
+                                         const bool isDown,
+                                         const bool isHover,
+                                         const short modifierKeyState,
+                                         const short delta,
+                                         SequenceBuffer& sequence);
+
+        bool _SendMouseSequence(const COORD position,
+                                const unsigned int button,
+                                const short modifierKeyState,
+                                const short delta,
+                                const MouseButtonState state);
+        bool _ShouldCoalesceMotion(const unsigned int realButton, const short modifierKeyState) const noexcept;
 
         bool _ShouldSendAlternateScroll(const unsigned int button, const short delta) const noexcept;
         bool _SendAlternateScroll(const short delta) const noexcept;
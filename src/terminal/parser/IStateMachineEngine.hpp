@@ -44,6 +44,8 @@ namespace Microsoft::Console::VirtualTerminal
 
         virtual bool ActionIgnore() = 0;
 
+        virtual bool ActionEndOfString() = 0;
+
         virtual bool ActionOscDispatch(const wchar_t wch,
                                        const size_t parameter,
                                        const std::wstring_view string) = 0;
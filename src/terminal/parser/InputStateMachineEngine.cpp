@@ -278,12 +278,14 @@ bool InputStateMachineEngine::ActionPassThroughString(const std::wstring_view st
         {
             try
             {
-                std::deque<std::unique_ptr<IInputEvent>> inputEvents;
-                for (const auto& wch : string)
-                {
-                    inputEvents.push_back(std::make_unique<KeyEvent>(true, 1ui16, 0ui16, 0ui16, wch, 0));
-                }
-                return _pDispatch->WriteInput(inputEvents);
+                // Short strings are built on the stack, rather than allocating an event
+                // for every character. The string is written in a single call, so that
+                // readers are woken up once and never see a part of it.
+                boost::container::small_vector<INPUT_RECORD, 64> records(string.size());
+                std::transform(string.begin(), string.end(), records.begin(), [](const wchar_t wch) noexcept {
+                    return KeyEvent{ true, 1ui16, 0ui16, 0ui16, wch, 0 }.ToInputRecord();
+                });
+                return _pDispatch->WriteInput({ records.data(), records.size() });
             }
             catch (...)
             {
@@ -519,6 +521,19 @@ bool InputStateMachineEngine::ActionIgnore() noexcept
     return true;
 }
 
+// Method Description:
+// - Triggers the EndOfString action to indicate that the state machine has
+//      processed all of the characters of the current string.
+// Arguments:
+// - <none>
+// Return Value:
+// - true iff we successfully dispatched the sequence.
+bool InputStateMachineEngine::ActionEndOfString() noexcept
+{
+    // Input is dispatched as soon as it's parsed, so there's nothing to do.
+    return true;
+}
+
 // Method Description:
 // - Triggers the OscDispatch action to indicate that the listener should handle a control sequence.
 //   These sequences perform various API-type commands that can include many parameters.
@@ -552,10 +567,8 @@ bool InputStateMachineEngine::ActionOscDispatch(const wchar_t /*wch*/,
 void InputStateMachineEngine::_GenerateWrappedSequence(const wchar_t wch,
                                                        const short vkey,
                                                        const DWORD modifierState,
-                                                       std::vector<INPUT_RECORD>& input)
+                                                       KeySequence& input)
 {
-    input.reserve(input.size() + 8);
-
     // TODO: Reuse the clipboard functions for generating input for characters
     //       that aren't on the current keyboard.
     // MSFT:13994942
@@ -662,10 +675,8 @@ void InputStateMachineEngine::_GenerateWrappedSequence(const wchar_t wch,
 void InputStateMachineEngine::_GetSingleKeypress(const wchar_t wch,
                                                  const short vkey,
                                                  const DWORD modifierState,
-                                                 std::vector<INPUT_RECORD>& input)
+                                                 KeySequence& input)
 {
-    input.reserve(input.size() + 2);
-
     INPUT_RECORD rec;
 
     rec.EventType = KEY_EVENT;
@@ -694,12 +705,9 @@ void InputStateMachineEngine::_GetSingleKeypress(const wchar_t wch,
 // - true iff we successfully wrote the keypress to the input callback.
 bool InputStateMachineEngine::_WriteSingleKey(const wchar_t wch, const short vkey, const DWORD modifierState)
 {
-    // At most 8 records - 2 for each of shift,ctrl,alt up and down, and 2 for the actual key up and down.
-    std::vector<INPUT_RECORD> input;
+    KeySequence input;
     _GenerateWrappedSequence(wch, vkey, modifierState, input);
-    std::deque<std::unique_ptr<IInputEvent>> inputEvents = IInputEvent::Create(gsl::make_span(input));
-
-    return _pDispatch->WriteInput(inputEvents);
+    return _pDispatch->WriteInput({ input.data(), input.size() });
 }
 
 // Method Description:
@@ -735,10 +743,9 @@ bool InputStateMachineEngine::_WriteMouseEvent(const til::point uiPos, const DWO
     rgInput.Event.MouseEvent.dwControlKeyState = controlKeyState;
     rgInput.Event.MouseEvent.dwEventFlags = eventFlags;
 
-    // pack and write input record
+    // write input record
     // 1 record - the modifiers don't get their own events
-    std::deque<std::unique_ptr<IInputEvent>> inputEvents = IInputEvent::Create(gsl::make_span(&rgInput, 1));
-    return _pDispatch->WriteInput(inputEvents);
+    return _pDispatch->WriteInput({ &rgInput, 1 });
 }
 
 // Method Description:
@@ -152,6 +152,8 @@ namespace Microsoft::Console::VirtualTerminal
 
         bool ActionIgnore() noexcept override;
 
+        bool ActionEndOfString() noexcept override;
+
         bool ActionOscDispatch(const wchar_t wch,
                                const size_t parameter,
                                const std::wstring_view string) noexcept override;
@@ -191,6 +193,9 @@ namespace Microsoft::Console::VirtualTerminal
         bool _GetCursorKeysVkey(const VTID id, short& vkey) const;
         bool _GetSs3KeysVkey(const wchar_t wch, short& vkey) const;
 
+        // At most 8 records - 2 for each of shift,ctrl,alt up and down, and 2 for the actual key up and down.
+        using KeySequence = til::some<INPUT_RECORD, 8>;
+
         bool _WriteSingleKey(const short vkey, const DWORD modifierState);
         bool _WriteSingleKey(const wchar_t wch, const short vkey, const DWORD modifierState);
 
@@ -199,12 +204,12 @@ namespace Microsoft::Console::VirtualTerminal
         void _GenerateWrappedSequence(const wchar_t wch,
                                       const short vkey,
                                       const DWORD modifierState,
-                                      std::vector<INPUT_RECORD>& input);
+                                      KeySequence& input);
 
         void _GetSingleKeypress(const wchar_t wch,
                                 const short vkey,
                                 const DWORD modifierState,
-                                std::vector<INPUT_RECORD>& input);
+                                KeySequence& input);
 
         bool _GetWindowManipulationType(const gsl::span<const size_t> parameters,
                                         unsigned int& function) const noexcept;
@@ -21,7 +21,8 @@ OutputStateMachineEngine::OutputStateMachineEngine(std::unique_ptr<ITermDispatch
     _dispatch(std::move(pDispatch)),
     _pfnFlushToTerminal(nullptr),
     _pTtyConnection(nullptr),
-    _lastPrintedChar(AsciiChars::NUL)
+    _lastPrintedChar(AsciiChars::NUL),
+    _batchingEnabled(false)
 {
     THROW_HR_IF_NULL(E_INVALIDARG, _dispatch.get());
 }
@@ -45,6 +46,8 @@ ITermDispatch& OutputStateMachineEngine::Dispatch() noexcept
 // - true iff we successfully dispatched the sequence.
 bool OutputStateMachineEngine::ActionExecute(const wchar_t wch)
 {
+    FlushCommandBatch();
+
     switch (wch)
     {
     case AsciiChars::NUL:
@@ -122,7 +125,17 @@ bool OutputStateMachineEngine::ActionPrint(const wchar_t wch)
         _lastPrintedChar = wch;
     }
 
-    _dispatch->Print(wch); // call print
+    // A DEL is only printed if it's translated to something else. That's
+    // left to the dispatch, which is why it's never added to a batched run.
+    if (_IsBatching() && wch != AsciiChars::DEL)
+    {
+        _BatchPrintString({ &wch, 1 });
+    }
+    else
+    {
+        FlushCommandBatch();
+        _dispatch->Print(wch); // call print
+    }
 
     return true;
 }
@@ -148,7 +161,14 @@ bool OutputStateMachineEngine::ActionPrintString(const std::wstring_view string)
         _lastPrintedChar = wch;
     }
 
-    _dispatch->PrintString(string); // call print
+    if (_IsBatching())
+    {
+        _BatchPrintString(string);
+    }
+    else
+    {
+        _dispatch->PrintString(string); // call print
+    }
 
     return true;
 }
@@ -167,6 +187,8 @@ bool OutputStateMachineEngine::ActionPrintString(const std::wstring_view string)
 // - true iff we successfully dispatched the sequence.
 bool OutputStateMachineEngine::ActionPassThroughString(const std::wstring_view string)
 {
+    FlushCommandBatch();
+
     bool success = true;
     if (_pTtyConnection != nullptr)
     {
@@ -189,6 +211,8 @@ bool OutputStateMachineEngine::ActionPassThroughString(const std::wstring_view s
 // - true iff we successfully dispatched the sequence.
 bool OutputStateMachineEngine::ActionEscDispatch(const VTID id)
 {
+    FlushCommandBatch();
+
     bool success = false;
 
     switch (id)
@@ -352,6 +376,8 @@ bool OutputStateMachineEngine::ActionEscDispatch(const VTID id)
 // - true iff we successfully dispatched the sequence.
 bool OutputStateMachineEngine::ActionVt52EscDispatch(const VTID id, const VTParameters parameters)
 {
+    FlushCommandBatch();
+
     bool success = false;
 
     switch (id)
@@ -425,6 +451,14 @@ bool OutputStateMachineEngine::ActionVt52EscDispatch(const VTID id, const VTPara
 // - true iff we successfully dispatched the sequence.
 bool OutputStateMachineEngine::ActionCsiDispatch(const VTID id, const VTParameters parameters)
 {
+    if (_IsBatching() && _BatchCsiDispatch(id, parameters))
+    {
+        _ClearLastChar();
+        return true;
+    }
+
+    FlushCommandBatch();
+
     bool success = false;
 
     switch (id)
@@ -588,11 +622,19 @@ bool OutputStateMachineEngine::ActionCsiDispatch(const VTID id, const VTParamete
         // implementation would effectively be the same, calling only
         // functions that are already part of the interface.
         // Print the last graphical character a number of times.
+        // The character is printed in chunks from a small buffer on the stack,
+        // rather than allocating a string as long as the repeat count.
         if (_lastPrintedChar != AsciiChars::NUL)
         {
-            const size_t repeatCount = parameters.at(0);
-            std::wstring wstr(repeatCount, _lastPrintedChar);
-            _dispatch->PrintString(wstr);
+            std::array<wchar_t, 256> chunk;
+            size_t remaining = parameters.at(0);
+            std::fill_n(chunk.begin(), std::min(remaining, chunk.size()), _lastPrintedChar);
+            while (remaining > 0)
+            {
+                const auto count = std::min(remaining, chunk.size());
+                _dispatch->PrintString({ chunk.data(), count });
+                remaining -= count;
+            }
         }
         success = true;
         TermTelemetry::Instance().Log(TermTelemetry::Codes::REP);
@@ -680,6 +722,20 @@ bool OutputStateMachineEngine::ActionIgnore() noexcept
     return true;
 }
 
+// Routine Description:
+// - Triggers the EndOfString action to indicate that the state machine has
+//      processed all of the characters of the current string. Any commands
+//      that were batched up while doing so are applied now.
+// Arguments:
+// - <none>
+// Return Value:
+// - true iff we successfully dispatched the sequence.
+bool OutputStateMachineEngine::ActionEndOfString()
+{
+    FlushCommandBatch();
+    return true;
+}
+
 // Routine Description:
 // - Triggers the OscDispatch action to indicate that the listener should handle a control sequence.
 //   These sequences perform various API-type commands that can include many parameters.
@@ -693,6 +749,8 @@ bool OutputStateMachineEngine::ActionOscDispatch(const wchar_t /*wch*/,
                                                  const size_t parameter,
                                                  const std::wstring_view string)
 {
+    FlushCommandBatch();
+
     bool success = false;
 
     switch (parameter)
@@ -701,9 +759,8 @@ bool OutputStateMachineEngine::ActionOscDispatch(const wchar_t /*wch*/,
     case OscActionCodes::SetWindowIcon:
     case OscActionCodes::SetWindowTitle:
     {
-        std::wstring title;
-        success = _GetOscTitle(string, title);
-        success = success && _dispatch->SetWindowTitle(title);
+        success = _GetOscTitle(string);
+        success = success && _dispatch->SetWindowTitle(string);
         TermTelemetry::Instance().Log(TermTelemetry::Codes::OSCWT);
         break;
     }
@@ -790,8 +847,8 @@ bool OutputStateMachineEngine::ActionOscDispatch(const wchar_t /*wch*/,
     }
     case OscActionCodes::Hyperlink:
     {
-        std::wstring params;
-        std::wstring uri;
+        std::wstring_view params;
+        std::wstring_view uri;
         success = _ParseHyperlink(string, params, uri);
         if (uri.empty())
         {
@@ -843,17 +900,15 @@ bool OutputStateMachineEngine::ActionSs3Dispatch(const wchar_t /*wch*/, const VT
 }
 
 // Routine Description:
-// - Null terminates, then returns, the string that we've collected as part of the OSC string.
+// - Checks whether the string that we've collected as part of the OSC string
+//   can be used as a title. The string itself is passed on to the dispatch
+//   as is, without copying it.
 // Arguments:
 // - string - Osc String input
-// - title - Where to place the Osc String to use as a title.
 // Return Value:
 // - True if there was a title to output. (a title with length=0 is still valid)
-bool OutputStateMachineEngine::_GetOscTitle(const std::wstring_view string,
-                                            std::wstring& title) const
+bool OutputStateMachineEngine::_GetOscTitle(const std::wstring_view string) const noexcept
 {
-    title = string;
-
     return !string.empty();
 }
 
@@ -968,16 +1023,16 @@ CATCH_LOG_RETURN_FALSE()
 //          ";"
 // Arguments:
 // - string - the string containing the parameters and URI
-// - params - where to store the parameters
-// - uri - where to store the uri
+// - params - receives the id parameter, as a view into string
+// - uri - receives the uri, as a view into string
 // Return Value:
 // - True if a URI was successfully parsed or if we are meant to close a hyperlink
 bool OutputStateMachineEngine::_ParseHyperlink(const std::wstring_view string,
-                                               std::wstring& params,
-                                               std::wstring& uri) const
+                                               std::wstring_view& params,
+                                               std::wstring_view& uri) const
 {
-    params.clear();
-    uri.clear();
+    params = {};
+    uri = {};
 
     if (string == L";")
     {
@@ -988,15 +1043,17 @@ bool OutputStateMachineEngine::_ParseHyperlink(const std::wstring_view string,
     if (midPos != std::wstring::npos)
     {
         uri = string.substr(midPos + 1);
-        const auto paramStr = string.substr(0, midPos);
-        const auto paramParts = Utils::SplitString(paramStr, ':');
-        for (const auto& part : paramParts)
+        auto paramStr = string.substr(0, midPos);
+        while (!paramStr.empty())
         {
+            const auto partLength = std::min(paramStr.find(L':'), paramStr.size());
+            const auto part = paramStr.substr(0, partLength);
             const auto idPos = part.find(hyperlinkIDParameter);
             if (idPos != std::wstring::npos)
             {
                 params = part.substr(idPos + hyperlinkIDParameter.size());
             }
+            paramStr = paramStr.substr(std::min(partLength + 1, paramStr.size()));
         }
         return true;
     }
@@ -1068,6 +1125,201 @@ void OutputStateMachineEngine::SetTerminalConnection(ITerminalOutputConnection*
     this->_pfnFlushToTerminal = pfnFlushToTerminal;
 }
 
+// Routine Description:
+// - Enables or disables command batching. While batching, printed text, cursor
+//      positioning (CUP/HVP) and graphics renditions (SGR) aren't dispatched
+//      right away, but recorded into a command buffer that's applied once the
+//      state machine reaches the end of the string, or before any other command
+//      is dispatched. While recording, adjacent prints are merged into a single
+//      PrintString and commands that are overwritten before anything depends
+//      on them are dropped. For a TUI that redraws with lots of CUP+SGR+text
+//      triples this saves a good share of the calls into the dispatch.
+// - Batching is suspended while a terminal connection is attached, because
+//      whether a sequence needs to be passed through is only known once it
+//      has been dispatched.
+// Arguments:
+// - enabled - true to record commands into the command buffer.
+// Return Value:
+// - <none>
+void OutputStateMachineEngine::SetCommandBatching(const bool enabled)
+{
+    if (!enabled)
+    {
+        FlushCommandBatch();
+    }
+    _batchingEnabled = enabled;
+}
+
+// Routine Description:
+// - Applies the commands that were recorded in the command buffer, in order.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void OutputStateMachineEngine::FlushCommandBatch()
+{
+    if (_batchedCommands.empty())
+    {
+        return;
+    }
+
+    // The buffers are emptied even if a dispatch throws, so
+    // that the commands before it aren't applied a second time.
+    auto clearBuffers = wil::scope_exit([&]() noexcept {
+        _batchedCommands.clear();
+        _batchedText.clear();
+        _batchedParameters.clear();
+    });
+
+    for (const auto& command : _batchedCommands)
+    {
+        switch (command.type)
+        {
+        case BatchedCommandType::PrintString:
+            _dispatch->PrintString({ _batchedText.data() + command.offset, command.length });
+            break;
+        case BatchedCommandType::CursorPosition:
+            _dispatch->CursorPosition(til::at(_batchedParameters, command.offset),
+                                      til::at(_batchedParameters, command.offset + 1));
+            break;
+        case BatchedCommandType::SetGraphicsRendition:
+            _dispatch->SetGraphicsRendition({ _batchedParameters.data() + command.offset, command.length });
+            break;
+        default:
+            // This command was superseded by a later one.
+            break;
+        }
+    }
+}
+
+// Routine Description:
+// - Checks whether commands are currently recorded into the command buffer.
+// Arguments:
+// - <none>
+// Return Value:
+// - true if batching is enabled and there's no terminal connection.
+bool OutputStateMachineEngine::_IsBatching() const noexcept
+{
+    return _batchingEnabled && _pfnFlushToTerminal == nullptr;
+}
+
+// Routine Description:
+// - Records the control sequences that can be batched into the command buffer.
+// Arguments:
+// - id - Identifier of the control sequence to dispatch.
+// - parameters - set of numeric parameters collected while parsing the sequence.
+// Return Value:
+// - true if the sequence was recorded, false if it needs to be dispatched now.
+bool OutputStateMachineEngine::_BatchCsiDispatch(const VTID id, const VTParameters parameters)
+{
+    switch (id)
+    {
+    case CsiActionCodes::CUP_CursorPosition:
+    case CsiActionCodes::HVP_HorizontalVerticalPosition:
+        _BatchCursorPosition(parameters.at(0), parameters.at(1));
+        TermTelemetry::Instance().Log(TermTelemetry::Codes::CUP);
+        return true;
+    case CsiActionCodes::SGR_SetGraphicsRendition:
+        _BatchGraphicsRendition(parameters);
+        TermTelemetry::Instance().Log(TermTelemetry::Codes::SGR);
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Routine Description:
+// - Records printed text into the command buffer. If the previous command
+//      printed text as well, nothing could have changed the attributes or the
+//      cursor position in between and the text is appended to it instead.
+// Arguments:
+// - string - string to print.
+// Return Value:
+// - <none>
+void OutputStateMachineEngine::_BatchPrintString(const std::wstring_view string)
+{
+    // Only printing appends to _batchedText, so the text of
+    // the previous print ends right where this one begins.
+    if (!_batchedCommands.empty() && _batchedCommands.back().type == BatchedCommandType::PrintString)
+    {
+        _batchedCommands.back().length += string.size();
+    }
+    else
+    {
+        _batchedCommands.push_back({ BatchedCommandType::PrintString, _batchedText.size(), string.size() });
+    }
+    _batchedText.append(string);
+}
+
+// Routine Description:
+// - Records a CUP into the command buffer. A previous CUP that nothing
+//      depended upon is overwritten by this one and dropped. SGRs don't
+//      depend on the cursor position, so they're skipped over to find it.
+// Arguments:
+// - line - the line to move to.
+// - column - the column to move to.
+// Return Value:
+// - <none>
+void OutputStateMachineEngine::_BatchCursorPosition(const VTParameter line, const VTParameter column)
+{
+    for (auto it = _batchedCommands.rbegin(); it != _batchedCommands.rend(); ++it)
+    {
+        if (it->type == BatchedCommandType::CursorPosition)
+        {
+            it->type = BatchedCommandType::Superseded;
+            break;
+        }
+        if (it->type == BatchedCommandType::PrintString)
+        {
+            break;
+        }
+    }
+
+    _batchedCommands.push_back({ BatchedCommandType::CursorPosition, _batchedParameters.size(), 2 });
+    _batchedParameters.push_back(line);
+    _batchedParameters.push_back(column);
+}
+
+// Routine Description:
+// - Records an SGR into the command buffer. If it starts with a reset, it
+//      overwrites everything the previous SGRs did, unless some text was
+//      printed with those attributes in the meantime, so they're dropped.
+// Arguments:
+// - options - the graphics options to apply.
+// Return Value:
+// - <none>
+void OutputStateMachineEngine::_BatchGraphicsRendition(const VTParameters options)
+{
+    if (static_cast<DispatchTypes::GraphicsOptions>(options.at(0)) == DispatchTypes::GraphicsOptions::Off)
+    {
+        for (auto it = _batchedCommands.rbegin(); it != _batchedCommands.rend(); ++it)
+        {
+            if (it->type == BatchedCommandType::SetGraphicsRendition)
+            {
+                it->type = BatchedCommandType::Superseded;
+
+                // Anything before a previous reset was already dropped when it was recorded.
+                if (static_cast<DispatchTypes::GraphicsOptions>(til::at(_batchedParameters, it->offset)) == DispatchTypes::GraphicsOptions::Off)
+                {
+                    break;
+                }
+            }
+            else if (it->type == BatchedCommandType::PrintString)
+            {
+                break;
+            }
+        }
+    }
+
+    // An empty parameter list is stored as a single default parameter,
+    // which is what VTParameters reports for it anyway.
+    _batchedCommands.push_back({ BatchedCommandType::SetGraphicsRendition, _batchedParameters.size(), options.size() });
+    for (size_t i = 0; i < options.size(); ++i)
+    {
+        _batchedParameters.push_back(options.at(i));
+    }
+}
+
 // Routine Description:
 // - Parse OscSetClipboard parameters with the format `Pc;Pd`. Currently the first parameter `Pc` is
 // ignored. The second parameter `Pd` should be a valid base64 string or character `?`.
@@ -45,6 +45,8 @@ namespace Microsoft::Console::VirtualTerminal
 
         bool ActionIgnore() noexcept override;
 
+        bool ActionEndOfString() override;
+
         bool ActionOscDispatch(const wchar_t wch,
                                const size_t parameter,
                                const std::wstring_view string) override;
@@ -59,6 +61,9 @@ namespace Microsoft::Console::VirtualTerminal
         void SetTerminalConnection(Microsoft::Console::ITerminalOutputConnection* const pTtyConnection,
                                    std::function<bool()> pfnFlushToTerminal);
 
+        void SetCommandBatching(const bool enabled);
+        void FlushCommandBatch();
+
         const ITermDispatch& Dispatch() const noexcept;
         ITermDispatch& Dispatch() noexcept;
 
@@ -68,6 +73,29 @@ namespace Microsoft::Console::VirtualTerminal
         std::function<bool()> _pfnFlushToTerminal;
         wchar_t _lastPrintedChar;
 
+        // The command buffer used in batching mode. The printed text and the
+        // parameters are stored out-of-line, so that the buffers can be reused
+        // from one string to the next and a command is just an index into them.
+        enum class BatchedCommandType : uint8_t
+        {
+            Superseded,
+            PrintString,
+            CursorPosition,
+            SetGraphicsRendition
+        };
+
+        struct BatchedCommand
+        {
+            BatchedCommandType type;
+            size_t offset;
+            size_t length;
+        };
+
+        bool _batchingEnabled;
+        std::vector<BatchedCommand> _batchedCommands;
+        std::wstring _batchedText;
+        std::vector<VTParameter> _batchedParameters;
+
         enum EscActionCodes : uint64_t
         {
             DECSC_CursorSave = VTID("7"),
@@ -181,8 +209,13 @@ namespace Microsoft::Console::VirtualTerminal
             ResetCursorColor = 112
         };
 
-        bool _GetOscTitle(const std::wstring_view string,
-                          std::wstring& title) const;
+        bool _IsBatching() const noexcept;
+        bool _BatchCsiDispatch(const VTID id, const VTParameters parameters);
+        void _BatchPrintString(const std::wstring_view string);
+        void _BatchCursorPosition(const VTParameter line, const VTParameter column);
+        void _BatchGraphicsRendition(const VTParameters options);
+
+        bool _GetOscTitle(const std::wstring_view string) const noexcept;
 
         bool _GetOscSetColorTable(const std::wstring_view string,
                                   std::vector<size_t>& tableIndexes,
@@ -197,8 +230,8 @@ namespace Microsoft::Console::VirtualTerminal
 
         static constexpr std::wstring_view hyperlinkIDParameter{ L"id=" };
         bool _ParseHyperlink(const std::wstring_view string,
-                             std::wstring& params,
-                             std::wstring& uri) const;
+                             std::wstring_view& params,
+                             std::wstring_view& uri) const;
 
         void _ClearLastChar() noexcept;
     };
@@ -0,0 +1,193 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "instrumentation.hpp"
+
+using namespace Microsoft::Console::VirtualTerminal;
+
+// Routine Description:
+// - Adds a dispatched sequence to the totals.
+// Arguments:
+// - kind - the kind of sequence (or control character) that was dispatched
+// - id - the VTID of the sequence, the control character itself, or the OSC number
+// - time - the time the engine took to handle it
+// Return Value:
+// - <none>
+void ParserInstrumentation::RecordSequence(const SequenceKind kind, const uint64_t id, const Clock::duration time)
+{
+    auto& totals = _sequences[{ kind, id }];
+    totals.count++;
+    totals.time += time;
+}
+
+// Routine Description:
+// - Adds a run of printable characters to the totals.
+// Arguments:
+// - length - the number of characters in the run
+// - time - the time the engine took to print it
+// Return Value:
+// - <none>
+void ParserInstrumentation::RecordPrintRun(const size_t length, const Clock::duration time) noexcept
+{
+    _print.runs++;
+    _print.characters += length;
+    _print.longestRun = std::max(_print.longestRun, length);
+    _print.time += time;
+
+    // The bucket is the position of the highest set bit, so that every bucket
+    // is twice as wide as the previous one. Very long runs share the last one.
+    size_t bucket = 0;
+    for (auto remaining = length; remaining > 1 && bucket < _print.histogram.size() - 1; remaining >>= 1)
+    {
+        bucket++;
+    }
+    til::at(_print.histogram, bucket)++;
+}
+
+// Routine Description:
+// - Discards everything that has been recorded so far.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void ParserInstrumentation::Reset() noexcept
+{
+    _sequences.clear();
+    _print = {};
+}
+
+// Routine Description:
+// - Returns the totals for every sequence that has been dispatched,
+//   ordered by the time spent on them, the most expensive first.
+// Arguments:
+// - <none>
+// Return Value:
+// - the totals per sequence
+std::vector<ParserInstrumentation::SequenceStats> ParserInstrumentation::GetSequenceStats() const
+{
+    std::vector<SequenceStats> stats;
+    stats.reserve(_sequences.size());
+    for (const auto& [key, totals] : _sequences)
+    {
+        stats.push_back({ key.kind, key.id, totals.count, totals.time });
+    }
+    std::sort(stats.begin(), stats.end(), [](const auto& a, const auto& b) {
+        return a.time > b.time;
+    });
+    return stats;
+}
+
+// Routine Description:
+// - Returns the totals for the runs of printable characters.
+// Arguments:
+// - <none>
+// Return Value:
+// - the print run totals
+const ParserInstrumentation::PrintStats& ParserInstrumentation::GetPrintStats() const noexcept
+{
+    return _print;
+}
+
+// Routine Description:
+// - Formats a sequence in a human readable way, like "CSI ?h" or "C0 0x0D".
+// Arguments:
+// - kind - the kind of sequence
+// - id - the VTID of the sequence, the control character itself, or the OSC number
+// Return Value:
+// - the formatted sequence
+std::wstring ParserInstrumentation::FormatSequence(const SequenceKind kind, const uint64_t id)
+{
+    // A VTID holds the private parameter prefix, the intermediates and the final
+    // character, one per byte, starting with the least significant one.
+    const auto chars = [](const VTID vtid) {
+        std::wstring string;
+        for (size_t i = 0; i < sizeof(uint64_t) && vtid[i]; i++)
+        {
+            string.push_back(vtid[i]);
+        }
+        return string;
+    };
+
+    switch (kind)
+    {
+    case SequenceKind::Execute:
+        return fmt::format(L"C0 0x{:02X}", id);
+    case SequenceKind::Escape:
+        return L"ESC " + chars(id);
+    case SequenceKind::Vt52Escape:
+        return L"VT52 ESC " + chars(id);
+    case SequenceKind::Csi:
+        return L"CSI " + chars(id);
+    case SequenceKind::Osc:
+        return fmt::format(L"OSC {}", id);
+    case SequenceKind::Ss3:
+        return fmt::format(L"SS3 {}", static_cast<wchar_t>(id));
+    case SequenceKind::Dcs:
+        return L"DCS " + chars(id);
+    default:
+        return fmt::format(L"? {}", id);
+    }
+}
+
+// Routine Description:
+// - Formats everything that has been recorded as a table, one sequence per line.
+// Arguments:
+// - <none>
+// Return Value:
+// - the formatted totals
+std::wstring ParserInstrumentation::Format() const
+{
+    using std::chrono::duration_cast;
+    using std::chrono::nanoseconds;
+
+    std::wstring text;
+    auto out = std::back_inserter(text);
+
+    fmt::format_to(out, L"{:<16}{:>12}{:>16}{:>16}\n", L"Sequence", L"Count", L"Total (ns)", L"Average (ns)");
+    for (const auto& stats : GetSequenceStats())
+    {
+        const auto total = duration_cast<nanoseconds>(stats.time).count();
+        fmt::format_to(out, L"{:<16}{:>12}{:>16}{:>16}\n", FormatSequence(stats.kind, stats.id), stats.count, total, total / std::max<int64_t>(stats.count, 1));
+    }
+
+    const auto printTotal = duration_cast<nanoseconds>(_print.time).count();
+    fmt::format_to(out, L"\nPrint runs: {} runs, {} characters, longest {}, {} ns\n", _print.runs, _print.characters, _print.longestRun, printTotal);
+    for (size_t i = 0; i < _print.histogram.size(); i++)
+    {
+        const auto count = til::at(_print.histogram, i);
+        if (count)
+        {
+            const size_t lowest = size_t{ 1 } << i;
+            if (i + 1 < _print.histogram.size())
+            {
+                fmt::format_to(out, L"  {:>5}-{:<5}{:>12}\n", lowest, lowest * 2 - 1, count);
+            }
+            else
+            {
+                fmt::format_to(out, L"  {:>5}+     {:>12}\n", lowest, count);
+            }
+        }
+    }
+
+    return text;
+}
+
+// Routine Description:
+// - Writes the formatted totals into a UTF-8 text file.
+// Arguments:
+// - path - the file to write. It's replaced if it already exists.
+// Return Value:
+// - <none>
+void ParserInstrumentation::DumpToFile(const std::wstring& path) const
+{
+    std::string utf8;
+    THROW_IF_FAILED(til::u16u8(Format(), utf8));
+
+    wil::unique_hfile file{ CreateFileW(path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr) };
+    THROW_LAST_ERROR_IF(!file);
+
+    DWORD written = 0;
+    THROW_IF_WIN32_BOOL_FALSE(WriteFile(file.get(), utf8.data(), gsl::narrow<DWORD>(utf8.size()), &written, nullptr));
+    THROW_HR_IF(E_UNEXPECTED, written != utf8.size());
+}
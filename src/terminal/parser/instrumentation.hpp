@@ -0,0 +1,99 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+/*
+Module Name:
+- instrumentation.hpp
+
+Abstract:
+- Aggregates how often the state machine dispatches each kind of sequence and
+  how much time the engine spends handling it, as well as the print runs.
+- Sequences are told apart by their final character, intermediates and private
+  parameter prefix (the VTID), so CSI ?h and CSI h have separate counts.
+- This is opt-in via StateMachine::EnableInstrumentation. While it's disabled,
+  the only cost is a null check per dispatch.
+*/
+
+#pragma once
+
+#include "../adapter/DispatchTypes.hpp"
+#include <chrono>
+
+namespace Microsoft::Console::VirtualTerminal
+{
+    class ParserInstrumentation final
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        enum class SequenceKind : uint8_t
+        {
+            Execute,
+            Escape,
+            Vt52Escape,
+            Csi,
+            Osc,
+            Ss3,
+            Dcs
+        };
+
+        struct SequenceStats
+        {
+            SequenceKind kind;
+            uint64_t id;
+            size_t count;
+            Clock::duration time;
+        };
+
+        struct PrintStats
+        {
+            size_t runs;
+            size_t characters;
+            size_t longestRun;
+            Clock::duration time;
+            // The number of runs with a length of 1, 2-3, 4-7, 8-15, ... characters.
+            std::array<size_t, 12> histogram;
+        };
+
+        void RecordSequence(const SequenceKind kind, const uint64_t id, const Clock::duration time);
+        void RecordPrintRun(const size_t length, const Clock::duration time) noexcept;
+        void Reset() noexcept;
+
+        std::vector<SequenceStats> GetSequenceStats() const;
+        const PrintStats& GetPrintStats() const noexcept;
+
+        std::wstring Format() const;
+        void DumpToFile(const std::wstring& path) const;
+
+        static std::wstring FormatSequence(const SequenceKind kind, const uint64_t id);
+
+    private:
+        struct Key
+        {
+            SequenceKind kind;
+            uint64_t id;
+
+            bool operator==(const Key& other) const noexcept
+            {
+                return kind == other.kind && id == other.id;
+            }
+        };
+
+        struct KeyHash
+        {
+            size_t operator()(const Key& key) const noexcept
+            {
+                return std::hash<uint64_t>{}(key.id * 8 + static_cast<uint64_t>(key.kind));
+            }
+        };
+
+        struct Totals
+        {
+            size_t count = 0;
+            Clock::duration time{};
+        };
+
+        std::unordered_map<Key, Totals, KeyHash> _sequences;
+        PrintStats _print{};
+    };
+}
@@ -7,6 +7,12 @@
 
 #include "ascii.hpp"
 
+#if defined(_M_IX86) || defined(_M_AMD64)
+#include <immintrin.h>
+#elif defined(_M_ARM64)
+#include <arm64_neon.h>
+#endif
+
 using namespace Microsoft::Console::VirtualTerminal;
 
 //Takes ownership of the pEngine.
@@ -18,8 +24,10 @@ StateMachine::StateMachine(std::unique_ptr<IStateMachineEngine> engine) :
     _parameters{},
     _parameterLimitReached(false),
     _oscString{},
-    _cachedSequence{ std::nullopt },
-    _processingIndividually(false)
+    _cachedSequence{},
+    _processingIndividually(false),
+    _utf8Partials{},
+    _utf8PartialsLength(0)
 {
     _ActionClear();
 }
@@ -39,6 +47,36 @@ IStateMachineEngine& StateMachine::Engine() noexcept
     return *_engine;
 }
 
+// Routine Description:
+// - Starts or stops collecting per-sequence counts and timings.
+//   Enabling it again after it was disabled starts over with empty totals.
+// Arguments:
+// - enabled - true to collect the statistics, false to discard them.
+// Return Value:
+// - <none>
+void StateMachine::EnableInstrumentation(const bool enabled)
+{
+    if (!enabled)
+    {
+        _instrumentation.reset();
+    }
+    else if (!_instrumentation)
+    {
+        _instrumentation = std::make_unique<ParserInstrumentation>();
+    }
+}
+
+// Routine Description:
+// - Returns the statistics that were collected since instrumentation was enabled.
+// Arguments:
+// - <none>
+// Return Value:
+// - The statistics, or nullptr if instrumentation is disabled.
+const ParserInstrumentation* StateMachine::GetInstrumentation() const noexcept
+{
+    return _instrumentation.get();
+}
+
 // Routine Description:
 // - Determines if a character is a valid number character, 0-9.
 // Arguments:
@@ -188,30 +226,6 @@ static constexpr bool _isCsiInvalid(const wchar_t wch) noexcept
     return wch == L':'; // 0x3A
 }
 
-// Routine Description:
-// - Determines if a character is an invalid intermediate.
-// Arguments:
-// - wch - Character to check.
-// Return Value:
-// - True if it is. False if it isn't.
-static constexpr bool _isIntermediateInvalid(const wchar_t wch) noexcept
-{
-    // 0x30 - 0x3F
-    return _isNumericParamValue(wch) || _isCsiInvalid(wch) || _isParameterDelimiter(wch) || _isCsiPrivateMarker(wch);
-}
-
-// Routine Description:
-// - Determines if a character is an invalid parameter.
-// Arguments:
-// - wch - Character to check.
-// Return Value:
-// - True if it is. False if it isn't.
-static constexpr bool _isParameterInvalid(const wchar_t wch) noexcept
-{
-    // 0x3A, 0x3C - 0x3F
-    return _isCsiInvalid(wch) || _isCsiPrivateMarker(wch);
-}
-
 // Routine Description:
 // - Determines if a character is a string terminator indicator.
 // Arguments:
@@ -262,32 +276,6 @@ static constexpr bool _isOscIndicator(const wchar_t wch) noexcept
     return wch == L']'; // 0x5D
 }
 
-// Routine Description:
-// - Determines if a character is a delimiter between two parameters in a "operating system control sequence"
-//   This occurs in the middle of a control sequence after escape and OscIndicator have been recognized,
-//   after the parameter indicating which OSC action to take.
-// Arguments:
-// - wch - Character to check.
-// Return Value:
-// - True if it is. False if it isn't.
-static constexpr bool _isOscDelimiter(const wchar_t wch) noexcept
-{
-    return wch == L';'; // 0x3B
-}
-
-// Routine Description:
-// - Determines if a character should be ignored in a operating system control sequence
-// Arguments:
-// - wch - Character to check.
-// Return Value:
-// - True if it is. False if it isn't.
-static constexpr bool _isOscInvalid(const wchar_t wch) noexcept
-{
-    return wch <= L'\x17' ||
-           wch == L'\x19' ||
-           (wch >= L'\x1c' && wch <= L'\x1f');
-}
-
 // Routine Description:
 // - Determines if a character is "operating system control string" termination indicator.
 //   This signals the end of an OSC string collection.
@@ -374,6 +362,300 @@ static constexpr bool _isActionableFromGround(const wchar_t wch) noexcept
 
 #pragma warning(pop)
 
+// Routine Description:
+// - Finds the next character that _isActionableFromGround(), starting at the given offset.
+//   This is the hot loop when printing bulk text, so it tests 8 (SSE2, NEON)
+//   or 16 (AVX2) characters at once where the target architecture allows it.
+//   The instruction set is chosen at build time: SSE2 and NEON are always available
+//   on the architectures we build for, while AVX2 is only used when compiling with /arch:AVX2.
+// - A wrapping subtraction moves the range of DEL and the C1 controls (0x7F-0x9F)
+//   down to 0x00-0x20, so that each character only needs two comparisons.
+//   SSE2 and AVX2 don't have unsigned 16-bit comparisons, so they use a saturating
+//   subtraction instead, which yields 0 for every character <= the subtrahend.
+// Arguments:
+// - string - The string to scan.
+// - offset - The index of the first character to test.
+// Return Value:
+// - The index of the first actionable character, or string.size() if there's none.
+#pragma warning(push)
+#pragma warning(disable : 26429 26481 26490) // The vectorized loops use raw pointers to the string's contents.
+static size_t _findActionableFromGround(const std::wstring_view string, size_t offset) noexcept
+{
+    const auto data = string.data();
+    const auto size = string.size();
+    static constexpr auto c1Range = static_cast<short>(L'\x9F' - AsciiChars::DEL);
+
+#if defined(__AVX2__)
+    {
+        const auto c0Max = _mm256_set1_epi16(AsciiChars::US);
+        const auto delMin = _mm256_set1_epi16(AsciiChars::DEL);
+        const auto delRange = _mm256_set1_epi16(c1Range);
+        const auto zero = _mm256_setzero_si256();
+
+        for (; offset + 16 <= size; offset += 16)
+        {
+            const auto wch = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + offset));
+            const auto isC0 = _mm256_cmpeq_epi16(_mm256_subs_epu16(wch, c0Max), zero);
+            const auto isDelOrC1 = _mm256_cmpeq_epi16(_mm256_subs_epu16(_mm256_sub_epi16(wch, delMin), delRange), zero);
+            const auto mask = static_cast<unsigned long>(_mm256_movemask_epi8(_mm256_or_si256(isC0, isDelOrC1)));
+            if (mask)
+            {
+                unsigned long index;
+                _BitScanForward(&index, mask);
+                return offset + index / sizeof(wchar_t);
+            }
+        }
+    }
+#endif
+
+#if defined(_M_IX86) || defined(_M_AMD64)
+    {
+        const auto c0Max = _mm_set1_epi16(AsciiChars::US);
+        const auto delMin = _mm_set1_epi16(AsciiChars::DEL);
+        const auto delRange = _mm_set1_epi16(c1Range);
+        const auto zero = _mm_setzero_si128();
+
+        for (; offset + 8 <= size; offset += 8)
+        {
+            const auto wch = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+            const auto isC0 = _mm_cmpeq_epi16(_mm_subs_epu16(wch, c0Max), zero);
+            const auto isDelOrC1 = _mm_cmpeq_epi16(_mm_subs_epu16(_mm_sub_epi16(wch, delMin), delRange), zero);
+            const auto mask = static_cast<unsigned long>(_mm_movemask_epi8(_mm_or_si128(isC0, isDelOrC1)));
+            if (mask)
+            {
+                unsigned long index;
+                _BitScanForward(&index, mask);
+                return offset + index / sizeof(wchar_t);
+            }
+        }
+    }
+#elif defined(_M_ARM64)
+    {
+        const auto c0Max = vdupq_n_u16(AsciiChars::US);
+        const auto delMin = vdupq_n_u16(AsciiChars::DEL);
+        const auto delRange = vdupq_n_u16(c1Range);
+
+        for (; offset + 8 <= size; offset += 8)
+        {
+            const auto wch = vld1q_u16(reinterpret_cast<const uint16_t*>(data + offset));
+            const auto isC0 = vcleq_u16(wch, c0Max);
+            const auto isDelOrC1 = vcleq_u16(vsubq_u16(wch, delMin), delRange);
+            // Narrowing the 16-bit lanes to 8 bits turns the result into a 64-bit mask with 8 bits per character.
+            const auto narrowed = vmovn_u16(vorrq_u16(isC0, isDelOrC1));
+            const auto mask = vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+            if (mask)
+            {
+                unsigned long index;
+                _BitScanForward64(&index, mask);
+                return offset + index / 8;
+            }
+        }
+    }
+#endif
+
+    for (; offset < size; ++offset)
+    {
+        if (_isActionableFromGround(til::at(string, offset)))
+        {
+            break;
+        }
+    }
+    return offset;
+}
+#pragma warning(pop)
+
+// Routine Description:
+// - The UTF-8 counterpart of _findActionableFromGround(). In UTF-8 the C0
+//   controls and DEL are single bytes, while the C1 controls are encoded as
+//   0xC2 followed by 0x80-0x9F. The vectorized loops look for all three lead
+//   bytes 16 at a time and the scalar loop then confirms that a 0xC2 actually
+//   starts a C1 control and isn't just the lead byte of a printable character.
+// Arguments:
+// - string - The UTF-8 string to scan.
+// - offset - The index of the first byte to test.
+// Return Value:
+// - The index of the first actionable byte, or string.size() if there's none.
+#pragma warning(push)
+#pragma warning(disable : 26429 26481 26490) // The vectorized loops use raw pointers to the string's contents.
+static size_t _findActionableFromGroundUtf8(const std::string_view string, size_t offset) noexcept
+{
+    const auto data = reinterpret_cast<const uint8_t*>(string.data());
+    const auto size = string.size();
+    static constexpr uint8_t c1LeadByte = 0xC2;
+
+    for (;;)
+    {
+#if defined(_M_IX86) || defined(_M_AMD64)
+        {
+            const auto c0Max = _mm_set1_epi8(static_cast<char>(AsciiChars::US));
+            const auto del = _mm_set1_epi8(static_cast<char>(AsciiChars::DEL));
+            const auto c1Lead = _mm_set1_epi8(static_cast<char>(c1LeadByte));
+            const auto zero = _mm_setzero_si128();
+
+            for (; offset + 16 <= size; offset += 16)
+            {
+                const auto ch = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+                const auto isC0 = _mm_cmpeq_epi8(_mm_subs_epu8(ch, c0Max), zero);
+                const auto isDelOrC1 = _mm_or_si128(_mm_cmpeq_epi8(ch, del), _mm_cmpeq_epi8(ch, c1Lead));
+                const auto mask = static_cast<unsigned long>(_mm_movemask_epi8(_mm_or_si128(isC0, isDelOrC1)));
+                if (mask)
+                {
+                    unsigned long index;
+                    _BitScanForward(&index, mask);
+                    offset += index;
+                    break;
+                }
+            }
+        }
+#elif defined(_M_ARM64)
+        {
+            const auto c0Max = vdupq_n_u8(static_cast<uint8_t>(AsciiChars::US));
+            const auto del = vdupq_n_u8(static_cast<uint8_t>(AsciiChars::DEL));
+            const auto c1Lead = vdupq_n_u8(c1LeadByte);
+
+            for (; offset + 16 <= size; offset += 16)
+            {
+                const auto ch = vld1q_u8(data + offset);
+                const auto matches = vorrq_u8(vcleq_u8(ch, c0Max), vorrq_u8(vceqq_u8(ch, del), vceqq_u8(ch, c1Lead)));
+                // Shifting and narrowing the 16-bit lanes by 4 turns the result into a 64-bit mask with 4 bits per byte.
+                const auto narrowed = vshrn_n_u16(vreinterpretq_u16_u8(matches), 4);
+                const auto mask = vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+                if (mask)
+                {
+                    unsigned long index;
+                    _BitScanForward64(&index, mask);
+                    offset += index / 4;
+                    break;
+                }
+            }
+        }
+#endif
+
+        for (; offset < size; ++offset)
+        {
+            const auto ch = data[offset];
+            if (ch <= AsciiChars::US || ch == AsciiChars::DEL || ch == c1LeadByte)
+            {
+                break;
+            }
+        }
+
+        if (offset >= size || data[offset] != c1LeadByte)
+        {
+            return offset;
+        }
+        if (offset + 1 < size && _isC1ControlCharacter(data[offset + 1]))
+        {
+            return offset;
+        }
+
+        // A printable character in the U+0080-U+00BF range. Keep looking after it.
+        ++offset;
+    }
+}
+#pragma warning(pop)
+
+// Routine Description:
+// - Determines the length of the UTF-8 sequence introduced by the given lead byte.
+// Arguments:
+// - ch - The first byte of the sequence.
+// Return Value:
+// - The expected length of the sequence. Stray continuation bytes and
+//   invalid lead bytes have a length of 1 (and decode as U+FFFD).
+static constexpr size_t _utf8SequenceLength(const uint8_t ch) noexcept
+{
+    if (ch >= 0xF0 && ch <= 0xF4)
+    {
+        return 4;
+    }
+    if (ch >= 0xE0 && ch <= 0xEF)
+    {
+        return 3;
+    }
+    if (ch >= 0xC2 && ch <= 0xDF)
+    {
+        return 2;
+    }
+    return 1;
+}
+
+// Routine Description:
+// - Determines if a byte is a UTF-8 continuation byte.
+// Arguments:
+// - ch - The byte to check.
+// Return Value:
+// - True if it is. False if it isn't.
+static constexpr bool _isUtf8ContinuationByte(const uint8_t ch) noexcept
+{
+    return (ch & 0xC0) == 0x80;
+}
+
+// Routine Description:
+// - Determines the length of the code point at the given offset. A sequence
+//   that's interrupted by a byte that isn't a continuation byte is cut short,
+//   so that the interrupting byte is processed on its own.
+// Arguments:
+// - string - The UTF-8 string.
+// - offset - The index of the code point's first byte.
+// Return Value:
+// - The number of bytes that make up the code point.
+static size_t _utf8CodePointLength(const std::string_view string, const size_t offset) noexcept
+{
+    const auto expected = std::min(_utf8SequenceLength(static_cast<uint8_t>(til::at(string, offset))), string.size() - offset);
+    size_t length = 1;
+    while (length < expected && _isUtf8ContinuationByte(static_cast<uint8_t>(til::at(string, offset + length))))
+    {
+        ++length;
+    }
+    return length;
+}
+
+// Routine Description:
+// - Determines the length of a code point at the end of the given string
+//   that's incomplete, because the rest of it hasn't been received yet.
+// Arguments:
+// - string - The UTF-8 string.
+// Return Value:
+// - The number of bytes of the incomplete code point, or 0 if the string ends with a complete one.
+static size_t _utf8TrailingPartialLength(const std::string_view string) noexcept
+{
+    const auto maxLength = std::min<size_t>(string.size(), 3);
+    for (size_t length = 1; length <= maxLength; ++length)
+    {
+        const auto ch = static_cast<uint8_t>(til::at(string, string.size() - length));
+        if (!_isUtf8ContinuationByte(ch))
+        {
+            return _utf8SequenceLength(ch) > length ? length : 0;
+        }
+    }
+    return 0;
+}
+
+// Routine Description:
+// - Converts the given UTF-8 string to UTF-16 and appends it to the output.
+// Arguments:
+// - string - The UTF-8 string to convert.
+// - out - The string to append the UTF-16 characters to.
+// Return Value:
+// - <none>
+static void _appendUtf16(const std::string_view string, std::wstring& out)
+{
+    if (string.empty())
+    {
+        return;
+    }
+
+    // UTF-16 never needs more code units than UTF-8.
+    const auto offset = out.size();
+    const auto capacity = gsl::narrow<int>(string.size());
+    out.resize(offset + string.size());
+
+    const auto length = MultiByteToWideChar(CP_UTF8, 0, string.data(), capacity, out.data() + offset, capacity);
+    THROW_LAST_ERROR_IF(length == 0);
+
+    out.resize(offset + length);
+}
+
 // Routine Description:
 // - Triggers the Execute action to indicate that the listener should immediately respond to a C0 control character.
 // Arguments:
@@ -383,7 +665,9 @@ static constexpr bool _isActionableFromGround(const wchar_t wch) noexcept
 void StateMachine::_ActionExecute(const wchar_t wch)
 {
     _trace.TraceOnExecute(wch);
+    const auto start = _StartMeasurement();
     const bool success = _engine->ActionExecute(wch);
+    _EndMeasurement(ParserInstrumentation::SequenceKind::Execute, wch, start);
 
     // Trace the result.
     _trace.DispatchSequenceTrace(success);
@@ -401,7 +685,9 @@ void StateMachine::_ActionExecuteFromEscape(const wchar_t wch)
 {
     _trace.TraceOnExecuteFromEscape(wch);
 
+    const auto start = _StartMeasurement();
     const bool success = _engine->ActionExecuteFromEscape(wch);
+    _EndMeasurement(ParserInstrumentation::SequenceKind::Execute, wch, start);
 
     // Trace the result.
     _trace.DispatchSequenceTrace(success);
@@ -417,7 +703,12 @@ void StateMachine::_ActionPrint(const wchar_t wch)
 {
     _trace.TraceOnAction(L"Print");
 
+    const auto start = _StartMeasurement();
     const bool success = _engine->ActionPrint(wch);
+    if (_instrumentation)
+    {
+        _instrumentation->RecordPrintRun(1, ParserInstrumentation::Clock::now() - start);
+    }
 
     // Trace the result.
     _trace.DispatchSequenceTrace(success);
@@ -434,7 +725,10 @@ void StateMachine::_ActionEscDispatch(const wchar_t wch)
 {
     _trace.TraceOnAction(L"EscDispatch");
 
-    const bool success = _engine->ActionEscDispatch(_identifier.Finalize(wch));
+    const auto id = _identifier.Finalize(wch);
+    const auto start = _StartMeasurement();
+    const bool success = _engine->ActionEscDispatch(id);
+    _EndMeasurement(ParserInstrumentation::SequenceKind::Escape, id, start);
 
     // Trace the result.
     _trace.DispatchSequenceTrace(success);
@@ -457,8 +751,10 @@ void StateMachine::_ActionVt52EscDispatch(const wchar_t wch)
 {
     _trace.TraceOnAction(L"Vt52EscDispatch");
 
-    const bool success = _engine->ActionVt52EscDispatch(_identifier.Finalize(wch),
-                                                        { _parameters.data(), _parameters.size() });
+    const auto id = _identifier.Finalize(wch);
+    const auto start = _StartMeasurement();
+    const bool success = _engine->ActionVt52EscDispatch(id, { _parameters.data(), _parameters.size() });
+    _EndMeasurement(ParserInstrumentation::SequenceKind::Vt52Escape, id, start);
 
     // Trace the result.
     _trace.DispatchSequenceTrace(success);
@@ -481,8 +777,10 @@ void StateMachine::_ActionCsiDispatch(const wchar_t wch)
 {
     _trace.TraceOnAction(L"CsiDispatch");
 
-    const bool success = _engine->ActionCsiDispatch(_identifier.Finalize(wch),
-                                                    { _parameters.data(), _parameters.size() });
+    const auto id = _identifier.Finalize(wch);
+    const auto start = _StartMeasurement();
+    const bool success = _engine->ActionCsiDispatch(id, { _parameters.data(), _parameters.size() });
+    _EndMeasurement(ParserInstrumentation::SequenceKind::Csi, id, start);
 
     // Trace the result.
     _trace.DispatchSequenceTrace(success);
@@ -573,7 +871,7 @@ void StateMachine::_ActionClear()
     _parameters.clear();
     _parameterLimitReached = false;
 
-    _oscString.clear();
+    _ClearRetainedString(_oscString);
     _oscParameter = 0;
 
     _dcsStringHandler = nullptr;
@@ -581,6 +879,26 @@ void StateMachine::_ActionClear()
     _engine->ActionClear();
 }
 
+// Routine Description:
+// - Empties one of the strings that are accumulated while parsing a sequence.
+//   The buffer is kept for the next sequence unless it grew unusually large,
+//   in which case it's released instead of holding on to it indefinitely.
+// Arguments:
+// - string - The string to clear.
+// Return Value:
+// - <none>
+void StateMachine::_ClearRetainedString(std::wstring& string) noexcept
+{
+    if (string.capacity() > s_maxRetainedStringCapacity)
+    {
+        string = std::wstring{};
+    }
+    else
+    {
+        string.clear();
+    }
+}
+
 // Routine Description:
 // - Triggers the Ignore action to indicate that the state machine should eat this character and say nothing.
 // Arguments:
@@ -648,7 +966,9 @@ void StateMachine::_ActionOscDispatch(const wchar_t wch)
 {
     _trace.TraceOnAction(L"OscDispatch");
 
+    const auto start = _StartMeasurement();
     const bool success = _engine->ActionOscDispatch(wch, _oscParameter, _oscString);
+    _EndMeasurement(ParserInstrumentation::SequenceKind::Osc, _oscParameter, start);
 
     // Trace the result.
     _trace.DispatchSequenceTrace(success);
@@ -671,7 +991,9 @@ void StateMachine::_ActionSs3Dispatch(const wchar_t wch)
 {
     _trace.TraceOnAction(L"Ss3Dispatch");
 
+    const auto start = _StartMeasurement();
     const bool success = _engine->ActionSs3Dispatch(wch, { _parameters.data(), _parameters.size() });
+    _EndMeasurement(ParserInstrumentation::SequenceKind::Ss3, wch, start);
 
     // Trace the result.
     _trace.DispatchSequenceTrace(success);
@@ -694,8 +1016,10 @@ void StateMachine::_ActionDcsDispatch(const wchar_t wch)
 {
     _trace.TraceOnAction(L"DcsDispatch");
 
-    _dcsStringHandler = _engine->ActionDcsDispatch(_identifier.Finalize(wch),
-                                                   { _parameters.data(), _parameters.size() });
+    const auto id = _identifier.Finalize(wch);
+    const auto start = _StartMeasurement();
+    _dcsStringHandler = _engine->ActionDcsDispatch(id, { _parameters.data(), _parameters.size() });
+    _EndMeasurement(ParserInstrumentation::SequenceKind::Dcs, id, start);
 
     // If the returned handler is null, the sequence is not supported.
     const bool success = _dcsStringHandler != nullptr;
@@ -716,6 +1040,24 @@ void StateMachine::_ActionDcsDispatch(const wchar_t wch)
     }
 }
 
+// Routine Description:
+// - Triggers the PrintString action to indicate that the listener should render a run of characters.
+// Arguments:
+// - string - Characters to dispatch.
+// Return Value:
+// - <none>
+void StateMachine::_ActionPrintString(const std::wstring_view string)
+{
+    const auto start = _StartMeasurement();
+    _engine->ActionPrintString(string);
+    if (_instrumentation)
+    {
+        _instrumentation->RecordPrintRun(string.size(), ParserInstrumentation::Clock::now() - start);
+    }
+
+    _trace.DispatchPrintRunTrace(string);
+}
+
 // Routine Description:
 // - Moves the state machine into the Ground state.
 //   This state is entered:
@@ -728,7 +1070,7 @@ void StateMachine::_ActionDcsDispatch(const wchar_t wch)
 void StateMachine::_EnterGround() noexcept
 {
     _state = VTStates::Ground;
-    _cachedSequence.reset(); // entering ground means we've completed the pending sequence
+    _ClearRetainedString(_cachedSequence); // entering ground means we've completed the pending sequence
     _trace.TraceStateChange(L"Ground");
 }
 
@@ -998,519 +1340,438 @@ void StateMachine::_EnterSosPmApcString() noexcept
     _trace.TraceStateChange(L"SosPmApcString");
 }
 
+// The character classes used to index into the transition tables below.
+// Every character that the state machine distinguishes in at least one state
+// has its own class. The indicators that follow an ESC (like '[' or ']') only
+// differ from the other final characters in the Escape state.
+enum class CharClass : uint8_t
+{
+    C0, // 0x00 - 0x17, 0x19, 0x1C - 0x1F except for BEL
+    Bel, // 0x07
+    Esc, // 0x1B, only reaches the table in the OscString state
+    Intermediate, // 0x20 - 0x2F
+    Digit, // 0x30 - 0x39
+    Colon, // 0x3A
+    Semicolon, // 0x3B
+    PrivateMarker, // 0x3C - 0x3F
+    CsiIndicator, // '['
+    OscIndicator, // ']'
+    Ss3Indicator, // 'O'
+    DcsIndicator, // 'P'
+    SosPmApcIndicator, // 'X', '^', '_'
+    Vt52CursorAddress, // 'Y'
+    StringTerminator, // '\'
+    Final, // all other characters in 0x40 - 0x7E
+    Delete, // 0x7F
+    Other // CAN, SUB and everything above 0x7F
+};
+
+#pragma warning(push)
+#pragma warning(disable : 26446 26482) // Indexing a constexpr array with a checked index is fine.
+
 // Routine Description:
-// - Processes a character event into an Action that occurs while in the Ground state.
-//   Events in this state will:
-//   1. Execute C0 control characters
-//   2. Print all other characters
+// - Determines the class of a character in the 0x00 - 0xFF range.
+//   This is only used to generate s_charClasses at compile time.
 // Arguments:
-// - wch - Character that triggered the event
+// - wch - Character to classify.
 // Return Value:
-// - <none>
-void StateMachine::_EventGround(const wchar_t wch)
+// - The character class.
+static constexpr CharClass _classifyByte(const wchar_t wch) noexcept
 {
-    _trace.TraceOnEvent(L"Ground");
-    if (_isC0Code(wch) || _isDelete(wch))
+    if (_isOscTerminator(wch))
     {
-        _ActionExecute(wch);
+        return CharClass::Bel;
     }
-    else
+    if (_isEscape(wch))
     {
-        _ActionPrint(wch);
+        return CharClass::Esc;
     }
-}
-
-// Routine Description:
-// - Processes a character event into an Action that occurs while in the Escape state.
-//   Events in this state will:
-//   1. Execute C0 control characters
-//   2. Ignore Delete characters
-//   3. Collect Intermediate characters
-//   4. Enter Control Sequence state
-//   5. Dispatch an Escape action.
-// Arguments:
-// - wch - Character that triggered the event
-// Return Value:
-// - <none>
-void StateMachine::_EventEscape(const wchar_t wch)
-{
-    _trace.TraceOnEvent(L"Escape");
     if (_isC0Code(wch))
     {
-        if (_engine->DispatchControlCharsFromEscape())
-        {
-            _ActionExecuteFromEscape(wch);
-            _EnterGround();
-        }
-        else
-        {
-            _ActionExecute(wch);
-        }
+        return CharClass::C0;
     }
-    else if (_isDelete(wch))
+    if (_isDelete(wch))
     {
-        _ActionIgnore();
+        return CharClass::Delete;
     }
-    else if (_isIntermediate(wch))
+    if (_isIntermediate(wch))
     {
-        if (_engine->DispatchIntermediatesFromEscape())
-        {
-            _ActionEscDispatch(wch);
-            _EnterGround();
-        }
-        else
-        {
-            _ActionCollect(wch);
-            _EnterEscapeIntermediate();
-        }
+        return CharClass::Intermediate;
     }
-    else if (_isInAnsiMode)
+    if (_isNumericParamValue(wch))
     {
-        if (_isCsiIndicator(wch))
-        {
-            _EnterCsiEntry();
-        }
-        else if (_isOscIndicator(wch))
-        {
-            _EnterOscParam();
-        }
-        else if (_isSs3Indicator(wch) && _engine->ParseControlSequenceAfterSs3())
-        {
-            _EnterSs3Entry();
-        }
-        else if (_isDcsIndicator(wch))
-        {
-            _EnterDcsEntry();
-        }
-        else if (_isSosIndicator(wch) || _isPmIndicator(wch) || _isApcIndicator(wch))
-        {
-            _EnterSosPmApcString();
-        }
-        else
-        {
-            _ActionEscDispatch(wch);
-            _EnterGround();
-        }
+        return CharClass::Digit;
     }
-    else if (_isVt52CursorAddress(wch))
+    if (_isCsiInvalid(wch))
     {
-        _EnterVt52Param();
+        return CharClass::Colon;
     }
-    else
+    if (_isParameterDelimiter(wch))
     {
-        _ActionVt52EscDispatch(wch);
-        _EnterGround();
+        return CharClass::Semicolon;
     }
-}
-
-// Routine Description:
-// - Processes a character event into an Action that occurs while in the EscapeIntermediate state.
-//   Events in this state will:
-//   1. Execute C0 control characters
-//   2. Ignore Delete characters
-//   3. Collect Intermediate characters
-//   4. Dispatch an Escape action.
-// Arguments:
-// - wch - Character that triggered the event
-// Return Value:
-// - <none>
-void StateMachine::_EventEscapeIntermediate(const wchar_t wch)
-{
-    _trace.TraceOnEvent(L"EscapeIntermediate");
-    if (_isC0Code(wch))
-    {
-        _ActionExecute(wch);
-    }
-    else if (_isIntermediate(wch))
+    if (_isCsiPrivateMarker(wch))
     {
-        _ActionCollect(wch);
+        return CharClass::PrivateMarker;
     }
-    else if (_isDelete(wch))
+    if (_isCsiIndicator(wch))
     {
-        _ActionIgnore();
+        return CharClass::CsiIndicator;
     }
-    else if (_isInAnsiMode)
+    if (_isOscIndicator(wch))
     {
-        _ActionEscDispatch(wch);
-        _EnterGround();
-    }
-    else if (_isVt52CursorAddress(wch))
-    {
-        _EnterVt52Param();
-    }
-    else
-    {
-        _ActionVt52EscDispatch(wch);
-        _EnterGround();
+        return CharClass::OscIndicator;
     }
-}
-
-// Routine Description:
-// - Processes a character event into an Action that occurs while in the CsiEntry state.
-//   Events in this state will:
-//   1. Execute C0 control characters
-//   2. Ignore Delete characters
-//   3. Collect Intermediate characters
-//   4. Begin to ignore all remaining parameters when an invalid character is detected (CsiIgnore)
-//   5. Store parameter data
-//   6. Collect Control Sequence Private markers
-//   7. Dispatch a control sequence with parameters for action
-// Arguments:
-// - wch - Character that triggered the event
-// Return Value:
-// - <none>
-void StateMachine::_EventCsiEntry(const wchar_t wch)
-{
-    _trace.TraceOnEvent(L"CsiEntry");
-    if (_isC0Code(wch))
+    if (_isSs3Indicator(wch))
     {
-        _ActionExecute(wch);
+        return CharClass::Ss3Indicator;
     }
-    else if (_isDelete(wch))
+    if (_isDcsIndicator(wch))
     {
-        _ActionIgnore();
+        return CharClass::DcsIndicator;
     }
-    else if (_isIntermediate(wch))
+    if (_isSosIndicator(wch) || _isPmIndicator(wch) || _isApcIndicator(wch))
     {
-        _ActionCollect(wch);
-        _EnterCsiIntermediate();
+        return CharClass::SosPmApcIndicator;
     }
-    else if (_isCsiInvalid(wch))
+    if (_isVt52CursorAddress(wch))
     {
-        _EnterCsiIgnore();
+        return CharClass::Vt52CursorAddress;
     }
-    else if (_isNumericParamValue(wch) || _isParameterDelimiter(wch))
+    if (_isStringTerminatorIndicator(wch))
     {
-        _ActionParam(wch);
-        _EnterCsiParam();
+        return CharClass::StringTerminator;
     }
-    else if (_isCsiPrivateMarker(wch))
+    if (_isDcsPassThroughValid(wch))
     {
-        _ActionCollect(wch);
-        _EnterCsiParam();
-    }
-    else
-    {
-        _ActionCsiDispatch(wch);
-        _EnterGround();
+        return CharClass::Final;
     }
+    return CharClass::Other;
 }
 
-// Routine Description:
-// - Processes a character event into an Action that occurs while in the CsiIntermediate state.
-//   Events in this state will:
-//   1. Execute C0 control characters
-//   2. Ignore Delete characters
-//   3. Collect Intermediate characters
-//   4. Begin to ignore all remaining parameters when an invalid character is detected (CsiIgnore)
-//   5. Dispatch a control sequence with parameters for action
-// Arguments:
-// - wch - Character that triggered the event
-// Return Value:
-// - <none>
-void StateMachine::_EventCsiIntermediate(const wchar_t wch)
-{
-    _trace.TraceOnEvent(L"CsiIntermediate");
-    if (_isC0Code(wch))
-    {
-        _ActionExecute(wch);
-    }
-    else if (_isIntermediate(wch))
+static constexpr auto s_charClasses = []() noexcept {
+    std::array<CharClass, 256> classes{};
+    for (size_t i = 0; i < classes.size(); ++i)
     {
-        _ActionCollect(wch);
+        classes[i] = _classifyByte(static_cast<wchar_t>(i));
     }
-    else if (_isDelete(wch))
-    {
-        _ActionIgnore();
-    }
-    else if (_isIntermediateInvalid(wch))
-    {
-        _EnterCsiIgnore();
-    }
-    else
-    {
-        _ActionCsiDispatch(wch);
-        _EnterGround();
-    }
-}
+    return classes;
+}();
 
 // Routine Description:
-// - Processes a character event into an Action that occurs while in the CsiIgnore state.
-//   Events in this state will:
-//   1. Execute C0 control characters
-//   2. Ignore Delete characters
-//   3. Collect Intermediate characters
-//   4. Begin to ignore all remaining parameters when an invalid character is detected (CsiIgnore)
-//   5. Return to Ground
+// - Determines the class of a character with a single table lookup.
 // Arguments:
-// - wch - Character that triggered the event
+// - wch - Character to classify.
 // Return Value:
-// - <none>
-void StateMachine::_EventCsiIgnore(const wchar_t wch)
+// - The character class.
+static constexpr CharClass _classify(const wchar_t wch) noexcept
 {
-    _trace.TraceOnEvent(L"CsiIgnore");
-    if (_isC0Code(wch))
-    {
-        _ActionExecute(wch);
-    }
-    else if (_isDelete(wch))
-    {
-        _ActionIgnore();
-    }
-    else if (_isIntermediate(wch))
-    {
-        _ActionIgnore();
-    }
-    else if (_isIntermediateInvalid(wch))
-    {
-        _ActionIgnore();
-    }
-    else
-    {
-        _EnterGround();
-    }
+    return wch < s_charClasses.size() ? s_charClasses[wch] : CharClass::Other;
 }
 
 // Routine Description:
-// - Processes a character event into an Action that occurs while in the CsiParam state.
-//   Events in this state will:
-//   1. Execute C0 control characters
-//   2. Ignore Delete characters
-//   3. Collect Intermediate characters
-//   4. Begin to ignore all remaining parameters when an invalid character is detected (CsiIgnore)
-//   5. Store parameter data
-//   6. Dispatch a control sequence with parameters for action
+// - Generates the transition table of the state machine at compile time.
+//   Each entry holds the action to perform for a character class in a given
+//   state and the state to enter afterwards. An entry whose next state is the
+//   state it belongs to doesn't change the state (and won't call its _Enter method).
+//   The rules below are applied in order, later rules overriding earlier ones.
 // Arguments:
-// - wch - Character that triggered the event
+// - ansiMode - Whether to generate the table for the ANSI or the VT52 mode.
+//   The two only differ in the Escape and EscapeIntermediate states.
 // Return Value:
-// - <none>
-void StateMachine::_EventCsiParam(const wchar_t wch)
+// - The transition table, indexed by state and character class.
+constexpr StateMachine::VTTransitionTable StateMachine::_GenerateTransitions(const bool ansiMode) noexcept
 {
-    _trace.TraceOnEvent(L"CsiParam");
-    if (_isC0Code(wch))
-    {
-        _ActionExecute(wch);
-    }
-    else if (_isDelete(wch))
-    {
-        _ActionIgnore();
-    }
-    else if (_isNumericParamValue(wch) || _isParameterDelimiter(wch))
-    {
-        _ActionParam(wch);
-    }
-    else if (_isIntermediate(wch))
-    {
-        _ActionCollect(wch);
-        _EnterCsiIntermediate();
-    }
-    else if (_isParameterInvalid(wch))
-    {
-        _EnterCsiIgnore();
-    }
-    else
-    {
-        _ActionCsiDispatch(wch);
-        _EnterGround();
-    }
-}
+    static_assert(static_cast<size_t>(CharClass::Other) + 1 == s_charClassCount);
 
-// Routine Description:
-// - Processes a character event into an Action that occurs while in the OscParam state.
-//   Events in this state will:
-//   1. Collect numeric values into an Osc Param
-//   2. Move to the OscString state on a delimiter
-//   3. Ignore everything else.
-// Arguments:
-// - wch - Character that triggered the event
-// Return Value:
-// - <none>
-void StateMachine::_EventOscParam(const wchar_t wch) noexcept
-{
-    _trace.TraceOnEvent(L"OscParam");
-    if (_isOscTerminator(wch))
-    {
-        _EnterGround();
-    }
-    else if (_isNumericParamValue(wch))
-    {
-        _ActionOscParam(wch);
-    }
-    else if (_isOscDelimiter(wch))
-    {
-        _EnterOscString();
-    }
-    else
-    {
-        _ActionIgnore();
-    }
-}
+    using S = VTStates;
+    using A = VTActions;
+    using C = CharClass;
 
-// Routine Description:
-// - Processes a character event into a Action that occurs while in the OscParam state.
-//   Events in this state will:
-//   1. Trigger the OSC action associated with the param on an OscTerminator
-//   2. If we see a ESC, enter the OscTermination state. We'll wait for one
-//      more character before we dispatch the string.
-//   3. Ignore OscInvalid characters.
-//   4. Collect everything else into the OscString
-// Arguments:
-// - wch - Character that triggered the event
-// Return Value:
-// - <none>
-void StateMachine::_EventOscString(const wchar_t wch)
-{
-    _trace.TraceOnEvent(L"OscString");
-    if (_isOscTerminator(wch))
-    {
-        _ActionOscDispatch(wch);
-        _EnterGround();
-    }
-    else if (_isEscape(wch))
-    {
-        _EnterOscTermination();
-    }
-    else if (_isOscInvalid(wch))
-    {
-        _ActionIgnore();
-    }
-    else
-    {
-        // add this character to our OSC string
-        _ActionOscPut(wch);
-    }
-}
+    constexpr C controls[] = { C::C0, C::Bel, C::Esc };
+    constexpr C params[] = { C::Digit, C::Semicolon };
+    constexpr C invalidIntermediates[] = { C::Digit, C::Colon, C::Semicolon, C::PrivateMarker };
+    constexpr C invalidParams[] = { C::Colon, C::PrivateMarker };
 
-// Routine Description:
-// - Handle the two-character termination of a OSC sequence.
-//   Events in this state will:
-//   1. Trigger the OSC action associated with the param on an OscTerminator
-//   2. Otherwise treat this as a normal escape character event.
-// Arguments:
-// - wch - Character that triggered the event
-// Return Value:
-// - <none>
-void StateMachine::_EventOscTermination(const wchar_t wch)
-{
-    _trace.TraceOnEvent(L"OscTermination");
-    if (_isStringTerminatorIndicator(wch))
-    {
-        _ActionOscDispatch(wch);
-        _EnterGround();
-    }
-    else
-    {
-        _EnterEscape();
-        _EventEscape(wch);
-    }
-}
+    VTTransitionTable table{};
 
-// Routine Description:
-// - Processes a character event into an Action that occurs while in the Ss3Entry state.
-//   Events in this state will:
-//   1. Execute C0 control characters
-//   2. Ignore Delete characters
-//   3. Begin to ignore all remaining parameters when an invalid character is detected (CsiIgnore)
-//   4. Store parameter data
-//   5. Dispatch a control sequence with parameters for action
-//  SS3 sequences are structurally the same as CSI sequences, just with a
-//      different initiation. It's safe to reuse CSI's functions for
-//      determining if a character is a parameter, delimiter, or invalid.
-// Arguments:
-// - wch - Character that triggered the event
-// Return Value:
-// - <none>
-void StateMachine::_EventSs3Entry(const wchar_t wch)
-{
-    _trace.TraceOnEvent(L"Ss3Entry");
-    if (_isC0Code(wch))
-    {
-        _ActionExecute(wch);
-    }
-    else if (_isDelete(wch))
-    {
-        _ActionIgnore();
-    }
-    else if (_isCsiInvalid(wch))
-    {
-        // It's safe for us to go into the CSI ignore here, because both SS3 and
-        //      CSI sequences ignore characters the same way.
-        _EnterCsiIgnore();
-    }
-    else if (_isNumericParamValue(wch) || _isParameterDelimiter(wch))
-    {
-        _ActionParam(wch);
-        _EnterSs3Param();
+    const auto fill = [&](const S state, const A action, const S next) {
+        for (auto& transition : table[static_cast<size_t>(state)])
+        {
+            transition = { action, next };
+        }
+    };
+    const auto set = [&](const S state, const C cls, const A action, const S next) {
+        table[static_cast<size_t>(state)][static_cast<size_t>(cls)] = { action, next };
+    };
+    const auto setAll = [&](const S state, const auto& classes, const A action, const S next) {
+        for (const auto cls : classes)
+        {
+            set(state, cls, action, next);
+        }
+    };
+
+    // Ground: Execute C0 control characters and print everything else.
+    fill(S::Ground, A::Print, S::Ground);
+    setAll(S::Ground, controls, A::Execute, S::Ground);
+    set(S::Ground, C::Delete, A::Execute, S::Ground);
+
+    // Escape and EscapeIntermediate: Dispatch on a final character.
+    const auto escDispatch = ansiMode ? A::EscDispatch : A::Vt52EscDispatch;
+    fill(S::Escape, escDispatch, S::Ground);
+    setAll(S::Escape, controls, A::EscapeExecute, S::Escape);
+    set(S::Escape, C::Delete, A::Ignore, S::Escape);
+    set(S::Escape, C::Intermediate, A::EscapeCollect, S::Escape);
+    fill(S::EscapeIntermediate, escDispatch, S::Ground);
+    setAll(S::EscapeIntermediate, controls, A::Execute, S::EscapeIntermediate);
+    set(S::EscapeIntermediate, C::Delete, A::Ignore, S::EscapeIntermediate);
+    set(S::EscapeIntermediate, C::Intermediate, A::Collect, S::EscapeIntermediate);
+    if (ansiMode)
+    {
+        set(S::Escape, C::CsiIndicator, A::None, S::CsiEntry);
+        set(S::Escape, C::OscIndicator, A::None, S::OscParam);
+        set(S::Escape, C::Ss3Indicator, A::EscapeSs3, S::Escape);
+        set(S::Escape, C::DcsIndicator, A::None, S::DcsEntry);
+        set(S::Escape, C::SosPmApcIndicator, A::None, S::SosPmApcString);
     }
     else
     {
-        _ActionSs3Dispatch(wch);
-        _EnterGround();
-    }
-}
-
-// Routine Description:
-// - Processes a character event into an Action that occurs while in the CsiParam state.
-//   Events in this state will:
-//   1. Execute C0 control characters
-//   2. Ignore Delete characters
-//   3. Begin to ignore all remaining parameters when an invalid character is detected (CsiIgnore)
-//   4. Store parameter data
-//   5. Dispatch a control sequence with parameters for action
+        set(S::Escape, C::Vt52CursorAddress, A::None, S::Vt52Param);
+        set(S::EscapeIntermediate, C::Vt52CursorAddress, A::None, S::Vt52Param);
+    }
+
+    // CsiEntry, CsiParam and CsiIntermediate: Collect the parameters and intermediates
+    // and dispatch on a final character. Invalid characters move us into CsiIgnore.
+    fill(S::CsiEntry, A::CsiDispatch, S::Ground);
+    setAll(S::CsiEntry, controls, A::Execute, S::CsiEntry);
+    set(S::CsiEntry, C::Delete, A::Ignore, S::CsiEntry);
+    set(S::CsiEntry, C::Intermediate, A::Collect, S::CsiIntermediate);
+    set(S::CsiEntry, C::Colon, A::None, S::CsiIgnore);
+    setAll(S::CsiEntry, params, A::Param, S::CsiParam);
+    set(S::CsiEntry, C::PrivateMarker, A::Collect, S::CsiParam);
+
+    fill(S::CsiParam, A::CsiDispatch, S::Ground);
+    setAll(S::CsiParam, controls, A::Execute, S::CsiParam);
+    set(S::CsiParam, C::Delete, A::Ignore, S::CsiParam);
+    setAll(S::CsiParam, params, A::Param, S::CsiParam);
+    set(S::CsiParam, C::Intermediate, A::Collect, S::CsiIntermediate);
+    setAll(S::CsiParam, invalidParams, A::None, S::CsiIgnore);
+
+    fill(S::CsiIntermediate, A::CsiDispatch, S::Ground);
+    setAll(S::CsiIntermediate, controls, A::Execute, S::CsiIntermediate);
+    set(S::CsiIntermediate, C::Delete, A::Ignore, S::CsiIntermediate);
+    set(S::CsiIntermediate, C::Intermediate, A::Collect, S::CsiIntermediate);
+    setAll(S::CsiIntermediate, invalidIntermediates, A::None, S::CsiIgnore);
+
+    // CsiIgnore: Ignore everything up to the final character.
+    fill(S::CsiIgnore, A::None, S::Ground);
+    setAll(S::CsiIgnore, controls, A::Execute, S::CsiIgnore);
+    set(S::CsiIgnore, C::Delete, A::Ignore, S::CsiIgnore);
+    set(S::CsiIgnore, C::Intermediate, A::Ignore, S::CsiIgnore);
+    setAll(S::CsiIgnore, invalidIntermediates, A::Ignore, S::CsiIgnore);
+
+    // OscParam, OscString and OscTermination: Collect the parameter and the string
+    // and dispatch on a BEL or an ST. Any other ESC sequence aborts the OSC.
+    fill(S::OscParam, A::Ignore, S::OscParam);
+    set(S::OscParam, C::Bel, A::None, S::Ground);
+    set(S::OscParam, C::Digit, A::OscParam, S::OscParam);
+    set(S::OscParam, C::Semicolon, A::None, S::OscString);
+
+    fill(S::OscString, A::OscPut, S::OscString);
+    set(S::OscString, C::C0, A::Ignore, S::OscString);
+    set(S::OscString, C::Bel, A::OscDispatch, S::Ground);
+    set(S::OscString, C::Esc, A::None, S::OscTermination);
+
+    fill(S::OscTermination, A::EscapeEvent, S::OscTermination);
+    set(S::OscTermination, C::StringTerminator, A::OscDispatch, S::Ground);
+
+    // Ss3Entry and Ss3Param: Structurally the same as CSI sequences,
+    // but without intermediates or private markers.
+    fill(S::Ss3Entry, A::Ss3Dispatch, S::Ground);
+    setAll(S::Ss3Entry, controls, A::Execute, S::Ss3Entry);
+    set(S::Ss3Entry, C::Delete, A::Ignore, S::Ss3Entry);
+    set(S::Ss3Entry, C::Colon, A::None, S::CsiIgnore);
+    setAll(S::Ss3Entry, params, A::Param, S::Ss3Param);
+
+    fill(S::Ss3Param, A::Ss3Dispatch, S::Ground);
+    setAll(S::Ss3Param, controls, A::Execute, S::Ss3Param);
+    set(S::Ss3Param, C::Delete, A::Ignore, S::Ss3Param);
+    setAll(S::Ss3Param, params, A::Param, S::Ss3Param);
+    setAll(S::Ss3Param, invalidParams, A::None, S::CsiIgnore);
+
+    // Vt52Param: Store exactly two parameter characters.
+    fill(S::Vt52Param, A::Vt52Param, S::Vt52Param);
+    setAll(S::Vt52Param, controls, A::Execute, S::Vt52Param);
+    set(S::Vt52Param, C::Delete, A::Ignore, S::Vt52Param);
+
+    // DcsEntry, DcsParam and DcsIntermediate: Like their CSI counterparts,
+    // except that control characters are ignored and that the dispatch
+    // moves us into either DcsPassThrough or DcsIgnore.
+    fill(S::DcsEntry, A::DcsDispatch, S::DcsEntry);
+    setAll(S::DcsEntry, controls, A::Ignore, S::DcsEntry);
+    set(S::DcsEntry, C::Delete, A::Ignore, S::DcsEntry);
+    set(S::DcsEntry, C::Colon, A::None, S::DcsIgnore);
+    setAll(S::DcsEntry, params, A::Param, S::DcsParam);
+    set(S::DcsEntry, C::Intermediate, A::Collect, S::DcsIntermediate);
+
+    fill(S::DcsParam, A::DcsDispatch, S::DcsParam);
+    setAll(S::DcsParam, controls, A::Ignore, S::DcsParam);
+    set(S::DcsParam, C::Delete, A::Ignore, S::DcsParam);
+    setAll(S::DcsParam, params, A::Param, S::DcsParam);
+    set(S::DcsParam, C::Intermediate, A::Collect, S::DcsIntermediate);
+    setAll(S::DcsParam, invalidParams, A::None, S::DcsIgnore);
+
+    fill(S::DcsIntermediate, A::DcsDispatch, S::DcsIntermediate);
+    setAll(S::DcsIntermediate, controls, A::Ignore, S::DcsIntermediate);
+    set(S::DcsIntermediate, C::Delete, A::Ignore, S::DcsIntermediate);
+    set(S::DcsIntermediate, C::Intermediate, A::Collect, S::DcsIntermediate);
+    setAll(S::DcsIntermediate, invalidIntermediates, A::None, S::DcsIgnore);
+
+    // DcsPassThrough: Pass C0 and printable ASCII characters to the string handler.
+    // DcsIgnore and SosPmApcString: Ignore everything.
+    // All three are terminated outside of the table when an ESC, CAN or SUB is seen.
+    fill(S::DcsPassThrough, A::DcsPassThrough, S::DcsPassThrough);
+    set(S::DcsPassThrough, C::Esc, A::Ignore, S::DcsPassThrough);
+    set(S::DcsPassThrough, C::Delete, A::Ignore, S::DcsPassThrough);
+    set(S::DcsPassThrough, C::Other, A::Ignore, S::DcsPassThrough);
+
+    fill(S::DcsIgnore, A::Ignore, S::DcsIgnore);
+    fill(S::SosPmApcString, A::Ignore, S::SosPmApcString);
+
+    return table;
+}
+
+const StateMachine::VTTransitionTable StateMachine::s_ansiTransitions = _GenerateTransitions(true);
+const StateMachine::VTTransitionTable StateMachine::s_vt52Transitions = _GenerateTransitions(false);
+
+// Routine Description:
+// - Processes a character event in the current state. The character's class
+//   and the current state determine the action to perform and the state to
+//   enter afterwards with a single lookup into the transition table.
 // Arguments:
 // - wch - Character that triggered the event
 // Return Value:
 // - <none>
-void StateMachine::_EventSs3Param(const wchar_t wch)
+void StateMachine::_ProcessTransition(const wchar_t wch)
 {
-    _trace.TraceOnEvent(L"Ss3Param");
-    if (_isC0Code(wch))
-    {
-        _ActionExecute(wch);
-    }
-    else if (_isDelete(wch))
-    {
-        _ActionIgnore();
-    }
-    else if (_isNumericParamValue(wch) || _isParameterDelimiter(wch))
-    {
-        _ActionParam(wch);
-    }
-    else if (_isParameterInvalid(wch))
-    {
-        _EnterCsiIgnore();
-    }
-    else
+    static constexpr std::array<const wchar_t*, s_stateCount> stateNames{
+        L"Ground",
+        L"Escape",
+        L"EscapeIntermediate",
+        L"CsiEntry",
+        L"CsiIntermediate",
+        L"CsiIgnore",
+        L"CsiParam",
+        L"OscParam",
+        L"OscString",
+        L"OscTermination",
+        L"Ss3Entry",
+        L"Ss3Param",
+        L"Vt52Param",
+        L"DcsEntry",
+        L"DcsIgnore",
+        L"DcsIntermediate",
+        L"DcsParam",
+        L"DcsPassThrough",
+        L"SosPmApcString",
+    };
+
+    const auto state = _state;
+    const auto& transitions = _isInAnsiMode ? s_ansiTransitions : s_vt52Transitions;
+    const auto transition = transitions[static_cast<size_t>(state)][static_cast<size_t>(_classify(wch))];
+
+    _trace.TraceOnEvent(stateNames[static_cast<size_t>(state)]);
+    _PerformAction(transition.action, wch);
+
+    if (transition.next != state)
     {
-        _ActionSs3Dispatch(wch);
-        _EnterGround();
+        _EnterState(transition.next);
     }
 }
+#pragma warning(pop)
 
 // Routine Description:
-// - Processes a character event into an Action that occurs while in the Vt52Param state.
-//   Events in this state will:
-//   1. Execute C0 control characters
-//   2. Ignore Delete characters
-//   3. Store exactly two parameter characters
-//   4. Dispatch a control sequence with parameters for action (always Direct Cursor Address)
+// - Performs the action of a transition.
 // Arguments:
+// - action - The action to perform.
 // - wch - Character that triggered the event
 // Return Value:
 // - <none>
-void StateMachine::_EventVt52Param(const wchar_t wch)
-{
-    _trace.TraceOnEvent(L"Vt52Param");
-    if (_isC0Code(wch))
-    {
-        _ActionExecute(wch);
-    }
-    else if (_isDelete(wch))
-    {
-        _ActionIgnore();
-    }
-    else
-    {
+void StateMachine::_PerformAction(const VTActions action, const wchar_t wch)
+{
+    switch (action)
+    {
+    case VTActions::None:
+        return;
+    case VTActions::Ignore:
+        return _ActionIgnore();
+    case VTActions::Execute:
+        return _ActionExecute(wch);
+    case VTActions::Print:
+        return _ActionPrint(wch);
+    case VTActions::Collect:
+        return _ActionCollect(wch);
+    case VTActions::Param:
+        return _ActionParam(wch);
+    case VTActions::EscDispatch:
+        return _ActionEscDispatch(wch);
+    case VTActions::Vt52EscDispatch:
+        return _ActionVt52EscDispatch(wch);
+    case VTActions::CsiDispatch:
+        return _ActionCsiDispatch(wch);
+    case VTActions::Ss3Dispatch:
+        return _ActionSs3Dispatch(wch);
+    case VTActions::DcsDispatch:
+        return _ActionDcsDispatch(wch);
+    case VTActions::OscParam:
+        return _ActionOscParam(wch);
+    case VTActions::OscPut:
+        return _ActionOscPut(wch);
+    case VTActions::OscDispatch:
+        return _ActionOscDispatch(wch);
+    case VTActions::EscapeExecute:
+        // The input engine needs to know about control characters
+        // following an ESC, so that it can generate Ctrl+Alt+key keys.
+        if (_engine->DispatchControlCharsFromEscape())
+        {
+            _ActionExecuteFromEscape(wch);
+            _EnterGround();
+        }
+        else
+        {
+            _ActionExecute(wch);
+        }
+        return;
+    case VTActions::EscapeCollect:
+        // Likewise the input engine dispatches intermediates as Alt+key keys.
+        if (_engine->DispatchIntermediatesFromEscape())
+        {
+            _ActionEscDispatch(wch);
+            _EnterGround();
+        }
+        else
+        {
+            _ActionCollect(wch);
+            _EnterEscapeIntermediate();
+        }
+        return;
+    case VTActions::EscapeSs3:
+        if (_engine->ParseControlSequenceAfterSs3())
+        {
+            _EnterSs3Entry();
+        }
+        else
+        {
+            _ActionEscDispatch(wch);
+            _EnterGround();
+        }
+        return;
+    case VTActions::EscapeEvent:
+        // An ESC in an OSC string that isn't followed by a '\' is treated
+        // as the start of a regular escape sequence instead.
+        _EnterEscape();
+        return _ProcessTransition(wch);
+    case VTActions::Vt52Param:
         _parameters.push_back(wch);
         if (_parameters.size() == 2)
         {
@@ -1519,190 +1780,71 @@ void StateMachine::_EventVt52Param(const wchar_t wch)
             _ActionVt52EscDispatch(L'Y');
             _EnterGround();
         }
-    }
-}
-
-// Routine Description:
-// - Processes a character event into an Action that occurs while in the DcsEntry state.
-//   Events in this state will:
-//   1. Ignore C0 control characters
-//   2. Ignore Delete characters
-//   3. Begin to ignore all remaining characters when an invalid character is detected (DcsIgnore)
-//   4. Store parameter data
-//   5. Collect Intermediate characters
-//   6. Dispatch the Final character in preparation for parsing the data string
-//  DCS sequences are structurally almost the same as CSI sequences, just with an
-//      extra data string. It's safe to reuse CSI functions for
-//      determining if a character is a parameter, delimiter, or invalid.
-// Arguments:
-// - wch - Character that triggered the event
-// Return Value:
-// - <none>
-void StateMachine::_EventDcsEntry(const wchar_t wch)
-{
-    _trace.TraceOnEvent(L"DcsEntry");
-    if (_isC0Code(wch))
-    {
-        _ActionIgnore();
-    }
-    else if (_isDelete(wch))
-    {
-        _ActionIgnore();
-    }
-    else if (_isCsiInvalid(wch))
-    {
-        _EnterDcsIgnore();
-    }
-    else if (_isNumericParamValue(wch) || _isParameterDelimiter(wch))
-    {
-        _ActionParam(wch);
-        _EnterDcsParam();
-    }
-    else if (_isIntermediate(wch))
-    {
-        _ActionCollect(wch);
-        _EnterDcsIntermediate();
-    }
-    else
-    {
-        _ActionDcsDispatch(wch);
-    }
-}
-
-// Routine Description:
-// - Processes a character event into an Action that occurs while in the DcsIgnore state.
-//   In this state the entire DCS string is considered invalid and we will ignore everything.
-//   The termination state is handled outside when an ESC is seen.
-// Arguments:
-// - wch - Character that triggered the event
-// Return Value:
-// - <none>
-void StateMachine::_EventDcsIgnore() noexcept
-{
-    _trace.TraceOnEvent(L"DcsIgnore");
-    _ActionIgnore();
-}
-
-// Routine Description:
-// - Processes a character event into an Action that occurs while in the DcsIntermediate state.
-//   Events in this state will:
-//   1. Ignore C0 control characters
-//   2. Ignore Delete characters
-//   3. Collect intermediate data.
-//   4. Begin to ignore all remaining intermediates when an invalid character is detected (DcsIgnore)
-//   5. Dispatch the Final character in preparation for parsing the data string
-// Arguments:
-// - wch - Character that triggered the event
-// Return Value:
-// - <none>
-void StateMachine::_EventDcsIntermediate(const wchar_t wch)
-{
-    _trace.TraceOnEvent(L"DcsIntermediate");
-    if (_isC0Code(wch))
-    {
-        _ActionIgnore();
-    }
-    else if (_isDelete(wch))
-    {
-        _ActionIgnore();
-    }
-    else if (_isIntermediate(wch))
-    {
-        _ActionCollect(wch);
-    }
-    else if (_isIntermediateInvalid(wch))
-    {
-        _EnterDcsIgnore();
-    }
-    else
-    {
-        _ActionDcsDispatch(wch);
-    }
-}
-
-// Routine Description:
-// - Processes a character event into an Action that occurs while in the DcsParam state.
-//   Events in this state will:
-//   1. Ignore C0 control characters
-//   2. Ignore Delete characters
-//   3. Collect DCS parameter data
-//   4. Enter DcsIntermediate if we see an intermediate
-//   5. Begin to ignore all remaining parameters when an invalid character is detected (DcsIgnore)
-//   6. Dispatch the Final character in preparation for parsing the data string
-// Arguments:
-// - wch - Character that triggered the event
-// Return Value:
-// - <none>
-void StateMachine::_EventDcsParam(const wchar_t wch)
-{
-    _trace.TraceOnEvent(L"DcsParam");
-    if (_isC0Code(wch))
-    {
-        _ActionIgnore();
-    }
-    else if (_isDelete(wch))
-    {
-        _ActionIgnore();
-    }
-    if (_isNumericParamValue(wch) || _isParameterDelimiter(wch))
-    {
-        _ActionParam(wch);
-    }
-    else if (_isIntermediate(wch))
-    {
-        _ActionCollect(wch);
-        _EnterDcsIntermediate();
-    }
-    else if (_isParameterInvalid(wch))
-    {
-        _EnterDcsIgnore();
-    }
-    else
-    {
-        _ActionDcsDispatch(wch);
-    }
-}
-
-// Routine Description:
-// - Processes a character event into an Action that occurs while in the DcsPassThrough state.
-//   Events in this state will:
-//   1. Pass through if character is valid.
-//   2. Ignore everything else.
-//   The termination state is handled outside when an ESC is seen.
-// Arguments:
-// - wch - Character that triggered the event
-// Return Value:
-// - <none>
-void StateMachine::_EventDcsPassThrough(const wchar_t wch)
-{
-    _trace.TraceOnEvent(L"DcsPassThrough");
-    if (_isC0Code(wch) || _isDcsPassThroughValid(wch))
-    {
+        return;
+    case VTActions::DcsPassThrough:
         if (!_dcsStringHandler(wch))
         {
             _EnterDcsIgnore();
         }
-    }
-    else
-    {
-        _ActionIgnore();
+        return;
+    default:
+        return;
+    }
+}
+
+// Routine Description:
+// - Moves the state machine into the given state by calling its _Enter method.
+// Arguments:
+// - state - The state to enter.
+// Return Value:
+// - <none>
+void StateMachine::_EnterState(const VTStates state)
+{
+    switch (state)
+    {
+    case VTStates::Ground:
+        return _EnterGround();
+    case VTStates::Escape:
+        return _EnterEscape();
+    case VTStates::EscapeIntermediate:
+        return _EnterEscapeIntermediate();
+    case VTStates::CsiEntry:
+        return _EnterCsiEntry();
+    case VTStates::CsiIntermediate:
+        return _EnterCsiIntermediate();
+    case VTStates::CsiIgnore:
+        return _EnterCsiIgnore();
+    case VTStates::CsiParam:
+        return _EnterCsiParam();
+    case VTStates::OscParam:
+        return _EnterOscParam();
+    case VTStates::OscString:
+        return _EnterOscString();
+    case VTStates::OscTermination:
+        return _EnterOscTermination();
+    case VTStates::Ss3Entry:
+        return _EnterSs3Entry();
+    case VTStates::Ss3Param:
+        return _EnterSs3Param();
+    case VTStates::Vt52Param:
+        return _EnterVt52Param();
+    case VTStates::DcsEntry:
+        return _EnterDcsEntry();
+    case VTStates::DcsIgnore:
+        return _EnterDcsIgnore();
+    case VTStates::DcsIntermediate:
+        return _EnterDcsIntermediate();
+    case VTStates::DcsParam:
+        return _EnterDcsParam();
+    case VTStates::DcsPassThrough:
+        return _EnterDcsPassThrough();
+    case VTStates::SosPmApcString:
+        return _EnterSosPmApcString();
+    default:
+        return;
     }
 }
 
-// Routine Description:
-// - Handle SOS/PM/APC string.
-//   In this state the entire string is ignored.
-//   The termination state is handled outside when an ESC is seen.
-// Arguments:
-// - wch - Character that triggered the event
-// Return Value:
-// - <none>
-void StateMachine::_EventSosPmApcString(const wchar_t /*wch*/) noexcept
-{
-    _trace.TraceOnEvent(L"SosPmApcString");
-    _ActionIgnore();
-}
-
 // Routine Description:
 // - Entry to the state machine. Takes characters one by one and processes them according to the state machine rules.
 // Arguments:
@@ -1741,49 +1883,7 @@ void StateMachine::ProcessCharacter(const wchar_t wch)
     else
     {
         // Then pass to the current state as an event
-        switch (_state)
-        {
-        case VTStates::Ground:
-            return _EventGround(wch);
-        case VTStates::Escape:
-            return _EventEscape(wch);
-        case VTStates::EscapeIntermediate:
-            return _EventEscapeIntermediate(wch);
-        case VTStates::CsiEntry:
-            return _EventCsiEntry(wch);
-        case VTStates::CsiIntermediate:
-            return _EventCsiIntermediate(wch);
-        case VTStates::CsiIgnore:
-            return _EventCsiIgnore(wch);
-        case VTStates::CsiParam:
-            return _EventCsiParam(wch);
-        case VTStates::OscParam:
-            return _EventOscParam(wch);
-        case VTStates::OscString:
-            return _EventOscString(wch);
-        case VTStates::OscTermination:
-            return _EventOscTermination(wch);
-        case VTStates::Ss3Entry:
-            return _EventSs3Entry(wch);
-        case VTStates::Ss3Param:
-            return _EventSs3Param(wch);
-        case VTStates::Vt52Param:
-            return _EventVt52Param(wch);
-        case VTStates::DcsEntry:
-            return _EventDcsEntry(wch);
-        case VTStates::DcsIgnore:
-            return _EventDcsIgnore();
-        case VTStates::DcsIntermediate:
-            return _EventDcsIntermediate(wch);
-        case VTStates::DcsParam:
-            return _EventDcsParam(wch);
-        case VTStates::DcsPassThrough:
-            return _EventDcsPassThrough(wch);
-        case VTStates::SosPmApcString:
-            return _EventSosPmApcString(wch);
-        default:
-            return;
-        }
+        _ProcessTransition(wch);
     }
 }
 // Method Description:
@@ -1803,13 +1903,13 @@ bool StateMachine::FlushToTerminal()
 {
     bool success{ true };
 
-    if (success && _cachedSequence.has_value())
+    if (success && !_cachedSequence.empty())
     {
         // Flush the partial sequence to the terminal before we flush the rest of it.
         // We always want to clear the sequence, even if we failed, so we don't accumulate bad state
         // and dump it out elsewhere later.
-        success = _engine->ActionPassThroughString(*_cachedSequence);
-        _cachedSequence.reset();
+        success = _engine->ActionPassThroughString(_cachedSequence);
+        _ClearRetainedString(_cachedSequence);
     }
 
     if (success)
@@ -1829,6 +1929,8 @@ bool StateMachine::FlushToTerminal()
 //     and print as many as it can without encountering a character indicating
 //     a escape sequence, then feed characters into the state machine one at a
 //     time until we return to the ground state.
+// - Once the whole string was consumed, the engine is notified with
+//     ActionEndOfString, so that it can apply any work it deferred.
 // Arguments:
 // - string - Characters to operate upon
 // Return Value:
@@ -1863,27 +1965,21 @@ void StateMachine::ProcessString(const std::wstring_view string)
         }
         else
         {
-            if (_isActionableFromGround(til::at(string, current))) // If the current char is the start of an escape sequence, or should be executed in ground state...
+            // Skip over all printable characters at once. If we find the start of
+            // an escape sequence, or a character that should be executed in ground state...
+            current = _findActionableFromGround(string, current);
+            if (current < string.size())
             {
+                _runSize = current - start;
                 if (_runSize > 0)
                 {
-                    // Because the run above is composed INCLUDING current, we must
-                    // trim it off here since we just determined it's actionable
-                    // and only pass through everything before it.
-                    _runSize -= 1;
                     const auto allLeadingUpTo = _CurrentRun();
 
-                    _engine->ActionPrintString(allLeadingUpTo); // ... print all the chars leading up to it as part of the run...
-                    _trace.DispatchPrintRunTrace(allLeadingUpTo);
+                    _ActionPrintString(allLeadingUpTo); // ... print all the chars leading up to it as part of the run...
                 }
 
                 _processingIndividually = true; // begin processing future characters individually...
                 start = current;
-                continue;
-            }
-            else
-            {
-                ++current; // Otherwise, add this char to the current run to be printed.
             }
         }
     }
@@ -1906,87 +2002,241 @@ void StateMachine::ProcessString(const std::wstring_view string)
     if (!_processingIndividually && !run.empty())
     {
         // print the rest of the characters in the string
-        _engine->ActionPrintString(run);
-        _trace.DispatchPrintRunTrace(run);
+        _ActionPrintString(run);
     }
     else if (_processingIndividually)
     {
-        // One of the "weird things" in VT input is the case of something like
-        // <kbd>alt+[</kbd>. In VT, that's encoded as `\x1b[`. However, that's
-        // also the start of a CSI, and could be the start of a longer sequence,
-        // there's no way to know for sure. For an <kbd>alt+[</kbd> keypress,
-        // the parser originally would just sit in the `CsiEntry` state after
-        // processing it, which would pollute the following keypress (e.g.
-        // <kbd>alt+[</kbd>, <kbd>A</kbd> would be processed like `\x1b[A`,
-        // which is _wrong_).
-        //
-        // Fortunately, for VT input, each keystroke comes in as an individual
-        // write operation. So, if at the end of processing a string for the
-        // InputEngine, we find that we're not in the Ground state, that implies
-        // that we've processed some input, but not dispatched it yet. This
-        // block at the end of `ProcessString` will then re-process the
-        // undispatched string, but it will ensure that it dispatches on the
-        // last character of the string. For our previous `\x1b[` scenario, that
-        // means we'll make sure to call `_ActionEscDispatch('[')`., which will
-        // properly decode the string as <kbd>alt+[</kbd>.
-
-        if (_engine->FlushAtEndOfString())
+        _ProcessUnfinishedSequence(run);
+    }
+
+    _engine->ActionEndOfString();
+}
+
+// Routine Description:
+// - Called at the end of a Process*String call if it ended in the middle of a sequence.
+// Arguments:
+// - run - The characters of the unfinished sequence that were part of this call.
+// Return Value:
+// - <none>
+void StateMachine::_ProcessUnfinishedSequence(const std::wstring_view run)
+{
+    // One of the "weird things" in VT input is the case of something like
+    // <kbd>alt+[</kbd>. In VT, that's encoded as `\x1b[`. However, that's
+    // also the start of a CSI, and could be the start of a longer sequence,
+    // there's no way to know for sure. For an <kbd>alt+[</kbd> keypress,
+    // the parser originally would just sit in the `CsiEntry` state after
+    // processing it, which would pollute the following keypress (e.g.
+    // <kbd>alt+[</kbd>, <kbd>A</kbd> would be processed like `\x1b[A`,
+    // which is _wrong_).
+    //
+    // Fortunately, for VT input, each keystroke comes in as an individual
+    // write operation. So, if at the end of processing a string for the
+    // InputEngine, we find that we're not in the Ground state, that implies
+    // that we've processed some input, but not dispatched it yet. This
+    // block at the end of `ProcessString` will then re-process the
+    // undispatched string, but it will ensure that it dispatches on the
+    // last character of the string. For our previous `\x1b[` scenario, that
+    // means we'll make sure to call `_ActionEscDispatch('[')`., which will
+    // properly decode the string as <kbd>alt+[</kbd>.
+
+    if (_engine->FlushAtEndOfString())
+    {
+        // Reset our state, and put all but the last char in again.
+        ResetState();
+        // Chars to flush are [pwchSequenceStart, pwchCurr)
+        auto wchIter = run.cbegin();
+        while (wchIter < run.cend() - 1)
+        {
+            ProcessCharacter(*wchIter);
+            wchIter++;
+        }
+        // Manually execute the last char [pwchCurr]
+        switch (_state)
+        {
+        case VTStates::Ground:
+            _ActionExecute(*wchIter);
+            break;
+        case VTStates::Escape:
+        case VTStates::EscapeIntermediate:
+            _ActionEscDispatch(*wchIter);
+            break;
+        case VTStates::CsiEntry:
+        case VTStates::CsiIntermediate:
+        case VTStates::CsiIgnore:
+        case VTStates::CsiParam:
+            _ActionCsiDispatch(*wchIter);
+            break;
+        case VTStates::OscParam:
+        case VTStates::OscString:
+        case VTStates::OscTermination:
+            _ActionOscDispatch(*wchIter);
+            break;
+        case VTStates::Ss3Entry:
+        case VTStates::Ss3Param:
+            _ActionSs3Dispatch(*wchIter);
+            break;
+        }
+        // microsoft/terminal#2746: Make sure to return to the ground state
+        // after dispatching the characters
+        _EnterGround();
+    }
+    else
+    {
+        // If the engine doesn't require flushing at the end of the string, we
+        // want to cache the partial sequence in case we have to flush the whole
+        // thing to the terminal later.
+        _cachedSequence.append(run);
+    }
+}
+
+// Routine Description:
+// - The UTF-8 counterpart of ProcessString(std::wstring_view). Control sequences
+//   are recognized on the UTF-8 bytes directly and only the printable runs in
+//   between are converted to UTF-16, into a buffer that's reused between calls,
+//   right before they're passed to the engine. The few non-ASCII characters
+//   inside of sequences (like the ones in an OSC title) are decoded one by one.
+//   This saves the caller from converting and copying the entire string upfront.
+// - A code point that's split across two calls is held back until it's complete.
+//   Invalid UTF-8 is replaced with U+FFFD.
+// Arguments:
+// - string - UTF-8 characters to operate upon
+// Return Value:
+// - <none>
+void StateMachine::ProcessString(const std::string_view string)
+{
+    auto remaining = string;
+
+    _utf8Sequence.clear();
+
+    // Complete the code point that was split across the end of the last call, if any.
+    if (_utf8PartialsLength != 0)
+    {
+        const auto expected = _utf8SequenceLength(static_cast<uint8_t>(til::at(_utf8Partials, 0)));
+        while (_utf8PartialsLength < expected && !remaining.empty() && _isUtf8ContinuationByte(static_cast<uint8_t>(remaining.front())))
+        {
+            til::at(_utf8Partials, _utf8PartialsLength) = remaining.front();
+            ++_utf8PartialsLength;
+            remaining.remove_prefix(1);
+        }
+
+        // Keep waiting, unless the code point was interrupted by another character.
+        // The engine still needs to know that this string ended, just like
+        // it does after a string that ends in the middle of a sequence.
+        if (_utf8PartialsLength < expected && remaining.empty())
+        {
+            _engine->ActionEndOfString();
+            return;
+        }
+
+        const std::string_view partial{ _utf8Partials.data(), _utf8PartialsLength };
+        _utf8PartialsLength = 0;
+        _ProcessUtf8(partial);
+    }
+
+    // Hold back a code point that's split across the end of this call.
+    const auto partialLength = _utf8TrailingPartialLength(remaining);
+    remaining.copy(_utf8Partials.data(), partialLength, remaining.size() - partialLength);
+    _utf8PartialsLength = partialLength;
+    remaining.remove_suffix(partialLength);
+
+    _ProcessUtf8(remaining);
+
+    if (_processingIndividually && !_utf8Sequence.empty())
+    {
+        _ProcessUnfinishedSequence(_utf8Sequence);
+    }
+
+    _engine->ActionEndOfString();
+}
+
+// Routine Description:
+// - Processes a string of complete UTF-8 code points for ProcessString(std::string_view).
+//   Printable runs in the ground state are converted and printed in bulk, while
+//   everything else is decoded into _utf8Sequence and passed to ProcessCharacter().
+// Arguments:
+// - string - UTF-8 characters to operate upon
+// Return Value:
+// - <none>
+void StateMachine::_ProcessUtf8(const std::string_view string)
+{
+    size_t current = 0;
+
+    while (current < string.size())
+    {
+        if (_processingIndividually)
         {
-            // Reset our state, and put all but the last char in again.
-            ResetState();
-            // Chars to flush are [pwchSequenceStart, pwchCurr)
-            auto wchIter = run.cbegin();
-            while (wchIter < run.cend() - 1)
+            const auto sequenceStart = _utf8Sequence.size();
+            const auto ch = static_cast<uint8_t>(til::at(string, current));
+            if (ch < 0x80)
             {
-                ProcessCharacter(*wchIter);
-                wchIter++;
+                _utf8Sequence.push_back(ch);
+                ++current;
             }
-            // Manually execute the last char [pwchCurr]
-            switch (_state)
+            else
             {
-            case VTStates::Ground:
-                _ActionExecute(*wchIter);
-                break;
-            case VTStates::Escape:
-            case VTStates::EscapeIntermediate:
-                _ActionEscDispatch(*wchIter);
-                break;
-            case VTStates::CsiEntry:
-            case VTStates::CsiIntermediate:
-            case VTStates::CsiIgnore:
-            case VTStates::CsiParam:
-                _ActionCsiDispatch(*wchIter);
-                break;
-            case VTStates::OscParam:
-            case VTStates::OscString:
-            case VTStates::OscTermination:
-                _ActionOscDispatch(*wchIter);
-                break;
-            case VTStates::Ss3Entry:
-            case VTStates::Ss3Param:
-                _ActionSs3Dispatch(*wchIter);
-                break;
+                const auto length = _utf8CodePointLength(string, current);
+                _appendUtf16(string.substr(current, length), _utf8Sequence);
+                current += length;
+            }
+
+            for (auto i = sequenceStart; i < _utf8Sequence.size(); ++i)
+            {
+                // The run is the unfinished sequence up to and including the
+                // current character, in case FlushToTerminal() needs to pass it through.
+                _currentString = _utf8Sequence;
+                _runOffset = 0;
+                _runSize = i + 1;
+
+                ProcessCharacter(til::at(_utf8Sequence, i));
+
+                if (_state == VTStates::Ground)
+                {
+                    // The second half of a surrogate pair is printed, just like
+                    // it would be as the start of the next run of printable characters.
+                    const auto rest = std::wstring_view{ _utf8Sequence }.substr(i + 1);
+                    if (!rest.empty())
+                    {
+                        _ActionPrintString(rest);
+                    }
+                    _processingIndividually = false;
+                    _utf8Sequence.clear();
+                    break;
+                }
             }
-            // microsoft/terminal#2746: Make sure to return to the ground state
-            // after dispatching the characters
-            _EnterGround();
         }
         else
         {
-            // If the engine doesn't require flushing at the end of the string, we
-            // want to cache the partial sequence in case we have to flush the whole
-            // thing to the terminal later.
-            if (!_cachedSequence)
+            // Skip over all printable characters at once and print them...
+            const auto end = _findActionableFromGroundUtf8(string, current);
+            if (end > current)
             {
-                _cachedSequence.emplace(std::wstring{});
+                _PrintUtf8(string.substr(current, end - current));
             }
 
-            auto& cachedSequence = *_cachedSequence;
-            cachedSequence.append(run);
+            // ... up to the start of an escape sequence or a control character.
+            current = end;
+            if (current < string.size())
+            {
+                _processingIndividually = true;
+            }
         }
     }
 }
 
+// Routine Description:
+// - Converts a run of printable UTF-8 characters and prints it.
+// Arguments:
+// - string - UTF-8 characters to print
+// Return Value:
+// - <none>
+void StateMachine::_PrintUtf8(const std::string_view string)
+{
+    _utf16Buffer.clear();
+    _appendUtf16(string, _utf16Buffer);
+
+    _ActionPrintString(_utf16Buffer);
+}
+
 // Routine Description:
 // - Wherever the state machine is, whatever it's going, go back to ground.
 //     This is used by conhost to "jiggle the handle" - when VT support is
@@ -2023,3 +2273,30 @@ void StateMachine::_AccumulateTo(const wchar_t wch, size_t& value) noexcept
         value = MAX_PARAMETER_VALUE;
     }
 }
+
+// Routine Description:
+// - Reads the clock before a sequence is dispatched, if instrumentation is enabled.
+// Arguments:
+// - <none>
+// Return Value:
+// - The current time, or the epoch if instrumentation is disabled.
+ParserInstrumentation::Clock::time_point StateMachine::_StartMeasurement() const noexcept
+{
+    return _instrumentation ? ParserInstrumentation::Clock::now() : ParserInstrumentation::Clock::time_point{};
+}
+
+// Routine Description:
+// - Records a dispatched sequence and the time it took, if instrumentation is enabled.
+// Arguments:
+// - kind - The kind of sequence that was dispatched.
+// - id - The identifier of the sequence within its kind.
+// - start - The time returned by _StartMeasurement before it was dispatched.
+// Return Value:
+// - <none>
+void StateMachine::_EndMeasurement(const ParserInstrumentation::SequenceKind kind, const uint64_t id, const ParserInstrumentation::Clock::time_point start)
+{
+    if (_instrumentation)
+    {
+        _instrumentation->RecordSequence(kind, id, ParserInstrumentation::Clock::now() - start);
+    }
+}
@@ -8,6 +8,8 @@ Module Name:
 Abstract:
 - This declares the entire state machine for handling Virtual Terminal Sequences
 - The design is based from the specifications at http://vt100.net
+- The transitions between the states are looked up in tables that are generated
+  at compile time, indexed by the current state and the class of the character.
 - The actual implementation of actions decoded by the StateMachine should be
   implemented in an IStateMachineEngine.
 */
@@ -17,6 +19,7 @@ Abstract:
 #include "IStateMachineEngine.hpp"
 #include "telemetry.hpp"
 #include "tracing.hpp"
+#include "instrumentation.hpp"
 #include <memory>
 
 namespace Microsoft::Console::VirtualTerminal
@@ -46,6 +49,7 @@ namespace Microsoft::Console::VirtualTerminal
 
         void ProcessCharacter(const wchar_t wch);
         void ProcessString(const std::wstring_view string);
+        void ProcessString(const std::string_view string);
 
         void ResetState() noexcept;
 
@@ -54,6 +58,9 @@ namespace Microsoft::Console::VirtualTerminal
         const IStateMachineEngine& Engine() const noexcept;
         IStateMachineEngine& Engine() noexcept;
 
+        void EnableInstrumentation(const bool enabled);
+        const ParserInstrumentation* GetInstrumentation() const noexcept;
+
     private:
         void _ActionExecute(const wchar_t wch);
         void _ActionExecuteFromEscape(const wchar_t wch);
@@ -68,6 +75,7 @@ namespace Microsoft::Console::VirtualTerminal
         void _ActionOscDispatch(const wchar_t wch);
         void _ActionSs3Dispatch(const wchar_t wch);
         void _ActionDcsDispatch(const wchar_t wch);
+        void _ActionPrintString(const std::wstring_view string);
 
         void _ActionClear();
         void _ActionIgnore() noexcept;
@@ -93,29 +101,16 @@ namespace Microsoft::Console::VirtualTerminal
         void _EnterDcsPassThrough() noexcept;
         void _EnterSosPmApcString() noexcept;
 
-        void _EventGround(const wchar_t wch);
-        void _EventEscape(const wchar_t wch);
-        void _EventEscapeIntermediate(const wchar_t wch);
-        void _EventCsiEntry(const wchar_t wch);
-        void _EventCsiIntermediate(const wchar_t wch);
-        void _EventCsiIgnore(const wchar_t wch);
-        void _EventCsiParam(const wchar_t wch);
-        void _EventOscParam(const wchar_t wch) noexcept;
-        void _EventOscString(const wchar_t wch);
-        void _EventOscTermination(const wchar_t wch);
-        void _EventSs3Entry(const wchar_t wch);
-        void _EventSs3Param(const wchar_t wch);
-        void _EventVt52Param(const wchar_t wch);
-        void _EventDcsEntry(const wchar_t wch);
-        void _EventDcsIgnore() noexcept;
-        void _EventDcsIntermediate(const wchar_t wch);
-        void _EventDcsParam(const wchar_t wch);
-        void _EventDcsPassThrough(const wchar_t wch);
-        void _EventSosPmApcString(const wchar_t wch) noexcept;
+        void _ProcessUnfinishedSequence(const std::wstring_view run);
+        void _ProcessUtf8(const std::string_view string);
+        void _PrintUtf8(const std::string_view string);
 
         void _AccumulateTo(const wchar_t wch, size_t& value) noexcept;
 
-        enum class VTStates
+        ParserInstrumentation::Clock::time_point _StartMeasurement() const noexcept;
+        void _EndMeasurement(const ParserInstrumentation::SequenceKind kind, const uint64_t id, const ParserInstrumentation::Clock::time_point start);
+
+        enum class VTStates : uint8_t
         {
             Ground,
             Escape,
@@ -138,10 +133,59 @@ namespace Microsoft::Console::VirtualTerminal
             SosPmApcString
         };
 
+        // The actions a transition can perform before entering its next state.
+        // The Escape* actions cover the transitions of the Escape and OscTermination
+        // states that also depend on the engine, so that the table doesn't have to.
+        enum class VTActions : uint8_t
+        {
+            None,
+            Ignore,
+            Execute,
+            Print,
+            Collect,
+            Param,
+            EscDispatch,
+            Vt52EscDispatch,
+            CsiDispatch,
+            Ss3Dispatch,
+            DcsDispatch,
+            OscParam,
+            OscPut,
+            OscDispatch,
+            EscapeExecute,
+            EscapeCollect,
+            EscapeSs3,
+            EscapeEvent,
+            Vt52Param,
+            DcsPassThrough
+        };
+
+        struct VTTransition
+        {
+            VTActions action;
+            VTStates next;
+        };
+
+        static constexpr size_t s_stateCount = static_cast<size_t>(VTStates::SosPmApcString) + 1;
+        static constexpr size_t s_charClassCount = 18;
+        using VTTransitionTable = std::array<std::array<VTTransition, s_charClassCount>, s_stateCount>;
+
+        static constexpr VTTransitionTable _GenerateTransitions(const bool ansiMode) noexcept;
+        static const VTTransitionTable s_ansiTransitions;
+        static const VTTransitionTable s_vt52Transitions;
+
+        void _ProcessTransition(const wchar_t wch);
+        void _PerformAction(const VTActions action, const wchar_t wch);
+        void _EnterState(const VTStates state);
+
         Microsoft::Console::VirtualTerminal::ParserTracing _trace;
 
         std::unique_ptr<IStateMachineEngine> _engine;
 
+        // Only allocated while instrumentation is enabled, so that
+        // it costs nothing but a null check when it's not.
+        std::unique_ptr<ParserInstrumentation> _instrumentation;
+
         VTStates _state;
 
         bool _isInAnsiMode;
@@ -160,7 +204,7 @@ namespace Microsoft::Console::VirtualTerminal
         }
 
         VTIDBuilder _identifier;
-        std::vector<VTParameter> _parameters;
+        til::some<VTParameter, MAX_PARAMETER_COUNT> _parameters;
         bool _parameterLimitReached;
 
         std::wstring _oscString;
@@ -168,10 +212,24 @@ namespace Microsoft::Console::VirtualTerminal
 
         IStateMachineEngine::StringHandler _dcsStringHandler;
 
-        std::optional<std::wstring> _cachedSequence;
+        std::wstring _cachedSequence;
+
+        // _oscString and _cachedSequence keep their capacity between sequences,
+        // so that the steady state doesn't allocate. This is the most we hold
+        // on to after an exceptionally long sequence (like an OSC 52 payload).
+        static constexpr size_t s_maxRetainedStringCapacity = 4096;
+        static void _ClearRetainedString(std::wstring& string) noexcept;
 
         // This is tracked per state machine instance so that separate calls to Process*
         //   can start and finish a sequence.
         bool _processingIndividually;
+
+        // State of ProcessString(std::string_view): The UTF-16 conversion of the current
+        // printable run, the unfinished sequence decoded from UTF-8 and the first
+        // bytes of a code point that's split across two calls.
+        std::wstring _utf16Buffer;
+        std::wstring _utf8Sequence;
+        std::array<char, 4> _utf8Partials;
+        size_t _utf8PartialsLength;
     };
 }
@@ -0,0 +1,158 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include <wextestclass.h>
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "stateMachine.hpp"
+#include "OutputStateMachineEngine.hpp"
+
+using namespace Microsoft::Console::VirtualTerminal;
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+// Records the calls that make it to the dispatch, so that
+// the tests can verify what the command buffer applied.
+class RecordingDispatch final : public TermDispatch
+{
+public:
+    RecordingDispatch(std::wstring& log) :
+        _log{ log }
+    {
+    }
+
+    void Execute(const wchar_t /*wchControl*/) noexcept override
+    {
+    }
+
+    void Print(const wchar_t wchPrintable) noexcept override
+    {
+        _Record(L"Print(" + std::wstring(1, wchPrintable) + L")");
+    }
+
+    void PrintString(const std::wstring_view string) noexcept override
+    {
+        _Record(L"Print(" + std::wstring{ string } + L")");
+    }
+
+    bool CursorPosition(const size_t line, const size_t column) noexcept override
+    {
+        _Record(L"CUP(" + std::to_wstring(line) + L"," + std::to_wstring(column) + L")");
+        return true;
+    }
+
+    bool SetGraphicsRendition(const VTParameters options) noexcept override
+    {
+        std::wstring entry{ L"SGR(" };
+        for (size_t i = 0; i < options.size(); ++i)
+        {
+            entry += (i ? L"," : L"") + std::to_wstring(options.at(i).value_or(0));
+        }
+        _Record(entry + L")");
+        return true;
+    }
+
+    bool EraseInLine(const DispatchTypes::EraseType eraseType) noexcept override
+    {
+        _Record(L"EL(" + std::to_wstring(static_cast<size_t>(eraseType)) + L")");
+        return true;
+    }
+
+    bool CarriageReturn() noexcept override
+    {
+        _Record(L"CR");
+        return true;
+    }
+
+private:
+    void _Record(const std::wstring& entry)
+    {
+        if (!_log.empty())
+        {
+            _log += L' ';
+        }
+        _log += entry;
+    }
+
+    std::wstring& _log;
+};
+
+class CommandBatchingTest
+{
+    TEST_CLASS(CommandBatchingTest);
+
+    std::wstring _log;
+
+    std::unique_ptr<StateMachine> _CreateStateMachine(const bool batching)
+    {
+        _log.clear();
+        auto engine = std::make_unique<OutputStateMachineEngine>(std::make_unique<RecordingDispatch>(_log));
+        engine->SetCommandBatching(batching);
+        return std::make_unique<StateMachine>(std::move(engine));
+    }
+
+    TEST_METHOD(PrintsAreMerged)
+    {
+        // The malformed CSI is ignored, but it still splits the text into two print runs.
+        Log::Comment(L"Without batching, every run is printed separately.");
+        auto mach = _CreateStateMachine(false);
+        mach->ProcessString(L"ab\x1b[:mcd");
+        VERIFY_ARE_EQUAL(L"Print(ab) Print(cd)", _log);
+
+        Log::Comment(L"With batching, adjacent runs are printed at once.");
+        mach = _CreateStateMachine(true);
+        mach->ProcessString(L"ab\x1b[:mcd");
+        VERIFY_ARE_EQUAL(L"Print(abcd)", _log);
+    }
+
+    TEST_METHOD(OverwrittenCursorMovesAreDropped)
+    {
+        auto mach = _CreateStateMachine(true);
+        mach->ProcessString(L"\x1b[1;1H\x1b[31m\x1b[5;6Hx");
+        VERIFY_ARE_EQUAL(L"SGR(31) CUP(5,6) Print(x)", _log);
+
+        Log::Comment(L"A cursor move that text was printed at has to stay.");
+        mach = _CreateStateMachine(true);
+        mach->ProcessString(L"\x1b[1;1Hx\x1b[5;6Hy");
+        VERIFY_ARE_EQUAL(L"CUP(1,1) Print(x) CUP(5,6) Print(y)", _log);
+    }
+
+    TEST_METHOD(OverwrittenRenditionsAreDropped)
+    {
+        auto mach = _CreateStateMachine(true);
+        mach->ProcessString(L"\x1b[1m\x1b[31m\x1b[2;2H\x1b[0;32mx\x1b[4m\x1b[my");
+        VERIFY_ARE_EQUAL(L"CUP(2,2) SGR(0,32) Print(x) SGR(0) Print(y)", _log);
+
+        Log::Comment(L"Renditions that don't start with a reset are applied in order.");
+        mach = _CreateStateMachine(true);
+        mach->ProcessString(L"\x1b[1m\x1b[31mx");
+        VERIFY_ARE_EQUAL(L"SGR(1) SGR(31) Print(x)", _log);
+    }
+
+    TEST_METHOD(OtherCommandsApplyTheBatchFirst)
+    {
+        auto mach = _CreateStateMachine(true);
+        mach->ProcessString(L"\x1b[3;4Hab\x1b[K\rcd");
+        VERIFY_ARE_EQUAL(L"CUP(3,4) Print(ab) EL(0) CR Print(cd)", _log);
+    }
+
+    TEST_METHOD(BatchIsAppliedAtTheEndOfEveryString)
+    {
+        auto mach = _CreateStateMachine(true);
+        mach->ProcessString(L"\x1b[3;4Hab");
+        VERIFY_ARE_EQUAL(L"CUP(3,4) Print(ab)", _log);
+
+        Log::Comment(L"A sequence that's split between strings is applied when it's complete.");
+        mach->ProcessString(L"\x1b[5;");
+        VERIFY_ARE_EQUAL(L"CUP(3,4) Print(ab)", _log);
+        mach->ProcessString(L"6Hcd");
+        VERIFY_ARE_EQUAL(L"CUP(3,4) Print(ab) CUP(5,6) Print(cd)", _log);
+
+        Log::Comment(L"The same goes for the UTF-8 overload.");
+        mach->ProcessString(std::string_view{ "\x1b[1m\xe2\x82\xac" });
+        VERIFY_ARE_EQUAL(L"CUP(3,4) Print(ab) CUP(5,6) Print(cd) SGR(1) Print(\x20ac)", _log);
+    }
+};
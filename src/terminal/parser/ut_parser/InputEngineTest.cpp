@@ -282,6 +282,8 @@ class Microsoft::Console::VirtualTerminal::InputEngineTest
     TEST_METHOD(TestWin32InputParsing);
     TEST_METHOD(TestWin32InputOptionals);
 
+    TEST_METHOD(PassThroughStringIsWrittenAtOnce);
+
     friend class TestInteractDispatch;
 };
 
@@ -323,7 +325,7 @@ class Microsoft::Console::VirtualTerminal::TestInteractDispatch final : public I
 public:
     TestInteractDispatch(_In_ std::function<void(std::deque<std::unique_ptr<IInputEvent>>&)> pfn,
                          _In_ TestState* testState);
-    virtual bool WriteInput(_In_ std::deque<std::unique_ptr<IInputEvent>>& inputEvents) override;
+    virtual bool WriteInput(const gsl::span<const INPUT_RECORD> inputEvents) override;
 
     virtual bool WriteCtrlKey(const KeyEvent& event) override;
     virtual bool WindowManipulation(const DispatchTypes::WindowManipulationType function,
@@ -348,18 +350,18 @@ TestInteractDispatch::TestInteractDispatch(_In_ std::function<void(std::deque<st
 {
 }
 
-bool TestInteractDispatch::WriteInput(_In_ std::deque<std::unique_ptr<IInputEvent>>& inputEvents)
+bool TestInteractDispatch::WriteInput(const gsl::span<const INPUT_RECORD> inputEvents)
 {
-    _pfnWriteInputCallback(inputEvents);
+    auto events = IInputEvent::Create(inputEvents);
+    _pfnWriteInputCallback(events);
     return true;
 }
 
 bool TestInteractDispatch::WriteCtrlKey(const KeyEvent& event)
 {
     VERIFY_IS_TRUE(_testState->_expectSendCtrlC);
-    std::deque<std::unique_ptr<IInputEvent>> inputEvents;
-    inputEvents.push_back(std::make_unique<KeyEvent>(event));
-    return WriteInput(inputEvents);
+    const auto record = event.ToInputRecord();
+    return WriteInput({ &record, 1 });
 }
 
 bool TestInteractDispatch::WindowManipulation(const DispatchTypes::WindowManipulationType function,
@@ -387,7 +389,8 @@ bool TestInteractDispatch::WriteString(const std::wstring_view string)
                   std::back_inserter(keyEvents));
     }
 
-    return WriteInput(keyEvents);
+    _pfnWriteInputCallback(keyEvents);
+    return true;
 }
 
 bool TestInteractDispatch::MoveCursor(const size_t row, const size_t col)
@@ -1611,3 +1614,31 @@ void InputEngineTest::TestWin32InputOptionals()
         }
     }
 }
+
+void InputEngineTest::PassThroughStringIsWrittenAtOnce()
+{
+    size_t writes = 0;
+    std::wstring written;
+    auto pfn = [&](std::deque<std::unique_ptr<IInputEvent>>& events) {
+        writes++;
+        for (const auto& event : events)
+        {
+            VERIFY_IS_TRUE(event->EventType() == InputEventType::KeyEvent);
+            written += static_cast<const KeyEvent&>(*event).GetCharData();
+        }
+    };
+
+    auto dispatch = std::make_unique<TestInteractDispatch>(pfn, &testState);
+    InputStateMachineEngine engine{ std::move(dispatch) };
+
+    Log::Comment(L"A string that doesn't fit into the records kept on the stack must still arrive in a single write.");
+    std::wstring string;
+    for (auto i = 0; i < 200; ++i)
+    {
+        string += static_cast<wchar_t>(L'a' + i % 26);
+    }
+
+    VERIFY_IS_TRUE(engine.ActionPassThroughString(string));
+    VERIFY_ARE_EQUAL(1u, writes);
+    VERIFY_ARE_EQUAL(string, written);
+}
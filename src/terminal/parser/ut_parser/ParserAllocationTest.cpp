@@ -0,0 +1,89 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include <wextestclass.h>
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "stateMachine.hpp"
+#include "OutputStateMachineEngine.hpp"
+
+using namespace Microsoft::Console::VirtualTerminal;
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+// The global allocation functions are replaced for this test module, so that
+// the tests below can count the allocations made by the parser on their thread.
+static thread_local size_t s_allocationCount = 0;
+
+void* operator new(size_t size)
+{
+    ++s_allocationCount;
+    if (const auto ptr = malloc(size ? size : 1))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept
+{
+    free(ptr);
+}
+
+class NullDispatch final : public TermDispatch
+{
+public:
+    void Execute(const wchar_t /*wchControl*/) override
+    {
+    }
+
+    void Print(const wchar_t /*wchPrintable*/) override
+    {
+    }
+
+    void PrintString(const std::wstring_view /*string*/) override
+    {
+    }
+};
+
+class ParserAllocationTest
+{
+    TEST_CLASS(ParserAllocationTest);
+
+    TEST_METHOD(SteadyStateDoesNotAllocate)
+    {
+        StateMachine mach{ std::make_unique<OutputStateMachineEngine>(std::make_unique<NullDispatch>()) };
+
+        std::wstring corpus;
+        for (auto i = 0; i < 64; ++i)
+        {
+            corpus.append(L"\x1b[1;38;2;255;128;0;48;5;17mcolored\x1b[m text\r\n");
+            corpus.append(L"\x1b[12;40H\x1b[K\x1b[2J\x1b[?25l\x1b[?25h\x1b[3;1;4;5;7;8;9;21;22;23;24;25;27;28;29m");
+            corpus.append(L"\x1b]0;a window title\x07\x1b]2;another title\x1b\\");
+            corpus.append(L"\x1b]8;id=42;https://example.com\x1b\\link\x1b]8;;\x1b\\");
+            corpus.append(L"x\x1b[1000b\x1b(0lqk\x1b(B\x1b" L"7\x1b" L"8\x1bM\x1bP1$r\x1b\\");
+        }
+
+        // Feed the corpus in odd-sized pieces, so that sequences are split
+        // between calls and have to be cached in the state machine.
+        const auto feed = [&]() {
+            const std::wstring_view view{ corpus };
+            for (size_t offset = 0; offset < view.size(); offset += 97)
+            {
+                mach.ProcessString(view.substr(offset, 97));
+            }
+        };
+
+        Log::Comment(L"The first pass may allocate the buffers that are reused later.");
+        feed();
+
+        Log::Comment(L"Every pass after that shouldn't allocate anymore.");
+        s_allocationCount = 0;
+        feed();
+        feed();
+        VERIFY_ARE_EQUAL(0u, s_allocationCount);
+    }
+};
@@ -38,6 +38,7 @@ public:
         dcsId = 0;
         dcsParams.clear();
         dcsDataString.clear();
+        endOfStrings = 0;
     }
 
     bool ActionExecute(const wchar_t wch) override
@@ -68,6 +69,12 @@ public:
 
     bool ActionIgnore() override { return true; };
 
+    bool ActionEndOfString() override
+    {
+        endOfStrings++;
+        return true;
+    };
+
     bool ActionOscDispatch(const wchar_t /* wch */,
                            const size_t /* parameter */,
                            const std::wstring_view /* string */) override
@@ -134,6 +141,9 @@ public:
     // Executed string.
     std::wstring executed;
 
+    // The number of calls to ActionEndOfString.
+    size_t endOfStrings = 0;
+
     // These will only be populated if ActionDcsDispatch is called.
     uint64_t dcsId = 0;
     std::vector<size_t> dcsParams;
@@ -159,9 +169,16 @@ class Microsoft::Console::VirtualTerminal::StateMachineTest
     TEST_METHOD(PassThroughUnhandled);
     TEST_METHOD(RunStorageBeforeEscape);
     TEST_METHOD(BulkTextPrint);
+    TEST_METHOD(BulkTextPrintStopsAtControlCharacters);
     TEST_METHOD(PassThroughUnhandledSplitAcrossWrites);
 
     TEST_METHOD(DcsDataStringsReceivedByHandler);
+    TEST_METHOD(DcsParametersIgnoreControlCharacters);
+
+    TEST_METHOD(Utf8InputMatchesUtf16Input);
+    TEST_METHOD(Utf8InputReplacesInvalidSequences);
+
+    TEST_METHOD(InstrumentationCountsSequences);
 };
 
 void StateMachineTest::TwoStateMachinesDoNotInterfereWithEachother()
@@ -234,6 +251,57 @@ void StateMachineTest::BulkTextPrint()
     VERIFY_ARE_EQUAL(String(L"12345 Hello World"), String(engine.printed.c_str()));
 }
 
+void StateMachineTest::BulkTextPrintStopsAtControlCharacters()
+{
+    auto enginePtr{ std::make_unique<TestStateMachineEngine>() };
+    // this dance is required because StateMachine presumes to take ownership of its engine.
+    auto& engine{ *enginePtr.get() };
+    StateMachine machine{ std::move(enginePtr) };
+
+    // Printable characters right at the edges of the actionable ranges (and one that's
+    // negative if treated as a signed 16-bit integer), to validate the vectorized scanner.
+    static constexpr std::wstring_view printable{ L"a \x7e\xa0\x8000\xffff\xd83d\xde00" };
+
+    // The lengths cover strings shorter than, equal to and longer than
+    // a vector register, so that the scalar tail is tested as well.
+    for (size_t length = 1; length <= 40; ++length)
+    {
+        std::wstring text;
+        for (size_t i = 0; i < length; ++i)
+        {
+            text.push_back(til::at(printable, i % printable.size()));
+        }
+
+        for (size_t position = 0; position < length; ++position)
+        {
+            for (const auto control : { L'\0', L'\a', L'\x1f', L'\x7f' })
+            {
+                auto input = text;
+                input[position] = control;
+
+                engine.ResetTestState();
+                machine.ProcessString(input);
+
+                auto expected = text;
+                expected.erase(position, 1);
+                VERIFY_ARE_EQUAL(expected, engine.printed);
+                VERIFY_ARE_EQUAL(std::wstring(1, control), engine.executed);
+            }
+
+            // A C1 control isn't executed, but it has to interrupt the run nonetheless.
+            auto input = text;
+            input[position] = L'\x84';
+
+            engine.ResetTestState();
+            machine.ProcessString(input);
+
+            auto expected = text;
+            expected.erase(position, 1);
+            VERIFY_ARE_EQUAL(expected, engine.printed);
+        }
+    }
+}
+
 void StateMachineTest::PassThroughUnhandledSplitAcrossWrites()
 {
     auto enginePtr{ std::make_unique<TestStateMachineEngine>() };
@@ -342,3 +410,149 @@ void StateMachineTest::DcsDataStringsReceivedByHandler()
     // Verify the control characters were executed (if expected).
     VERIFY_ARE_EQUAL(expectedExecuted, engine.executed);
 }
+
+void StateMachineTest::DcsParametersIgnoreControlCharacters()
+{
+    auto enginePtr{ std::make_unique<TestStateMachineEngine>() };
+    // this dance is required because StateMachine presumes to take ownership of its engine.
+    auto& engine{ *enginePtr.get() };
+    StateMachine machine{ std::move(enginePtr) };
+
+    Log::Comment(L"C0 controls and DEL in the parameters of a DCS should neither dispatch nor be executed");
+    machine.ProcessString(L"\033P1;\a2\x7f;\r3|data string\033\\");
+
+    VERIFY_ARE_EQUAL(VTID("|"), engine.dcsId);
+    VERIFY_ARE_EQUAL(std::vector<size_t>({ 1, 2, 3 }), engine.dcsParams);
+    VERIFY_ARE_EQUAL(L"data string\033", engine.dcsDataString);
+    VERIFY_ARE_EQUAL(L"", engine.executed);
+}
+
+void StateMachineTest::Utf8InputMatchesUtf16Input()
+{
+    // Plain and colored text, a C1 CSI, an OSC and a DCS with non-ASCII characters
+    // in them, and characters with 2, 3 and 4 byte long UTF-8 encodings.
+    const std::string_view utf8{
+        "plain \xe2\x82\xac text \x1b[12;34mcolored \xf0\x9f\x98\x80\r\n"
+        "\xc2\x9b"
+        "5;6H C1 CSI \xc2\xa0\xc3\xa9\a\x1b]2;t\xc3\xaftle\a"
+        "\x1bP1;2|dcs \xc3\xa9\x1b\\end"
+    };
+    const std::wstring_view utf16{
+        L"plain \x20ac text \x1b[12;34mcolored \xd83d\xde00\r\n"
+        L"\x9b"
+        L"5;6H C1 CSI \xa0\xe9\a\x1b]2;t\xeftle\a"
+        L"\x1bP1;2|dcs \xe9\x1b\\end"
+    };
+
+    auto expectedEnginePtr{ std::make_unique<TestStateMachineEngine>() };
+    const auto& expected{ *expectedEnginePtr.get() };
+    StateMachine expectedMachine{ std::move(expectedEnginePtr) };
+    expectedMachine.ProcessString(utf16);
+
+    Log::Comment(L"Splitting the UTF-8 input at any byte should produce the same result as the UTF-16 input.");
+    for (size_t split = 0; split <= utf8.size(); ++split)
+    {
+        auto enginePtr{ std::make_unique<TestStateMachineEngine>() };
+        // this dance is required because StateMachine presumes to take ownership of its engine.
+        const auto& engine{ *enginePtr.get() };
+        StateMachine machine{ std::move(enginePtr) };
+
+        machine.ProcessString(utf8.substr(0, split));
+        machine.ProcessString(utf8.substr(split));
+
+        VERIFY_ARE_EQUAL(expected.printed, engine.printed, NoThrowString().Format(L"split at %zu", split));
+        VERIFY_ARE_EQUAL(expected.executed, engine.executed);
+        VERIFY_ARE_EQUAL(expected.csiParams, engine.csiParams);
+        VERIFY_ARE_EQUAL(expected.dcsParams, engine.dcsParams);
+        VERIFY_ARE_EQUAL(expected.dcsDataString, engine.dcsDataString);
+        VERIFY_ARE_EQUAL(2u, engine.endOfStrings);
+    }
+
+    Log::Comment(L"Every call reaches the end of the string, even one that only holds back part of a code point.");
+    {
+        auto enginePtr{ std::make_unique<TestStateMachineEngine>() };
+        const auto& engine{ *enginePtr.get() };
+        StateMachine machine{ std::move(enginePtr) };
+
+        for (size_t i = 0; i < utf8.size(); ++i)
+        {
+            machine.ProcessString(utf8.substr(i, 1));
+        }
+
+        VERIFY_ARE_EQUAL(expected.printed, engine.printed);
+        VERIFY_ARE_EQUAL(expected.executed, engine.executed);
+        VERIFY_ARE_EQUAL(utf8.size(), engine.endOfStrings);
+    }
+}
+
+void StateMachineTest::Utf8InputReplacesInvalidSequences()
+{
+    auto enginePtr{ std::make_unique<TestStateMachineEngine>() };
+    // this dance is required because StateMachine presumes to take ownership of its engine.
+    const auto& engine{ *enginePtr.get() };
+    StateMachine machine{ std::move(enginePtr) };
+
+    Log::Comment(L"Invalid bytes are printed as U+FFFD.");
+    machine.ProcessString(std::string_view{ "a\xffb" });
+    VERIFY_ARE_EQUAL(L"a\xfffd" L"b", engine.printed);
+
+    Log::Comment(L"A code point interrupted by a control character is printed as U+FFFD, but the control character is still executed.");
+    machine.ProcessString(std::string_view{ "\xe2\x82" });
+    VERIFY_ARE_EQUAL(L"a\xfffd" L"b", engine.printed);
+    machine.ProcessString(std::string_view{ "\r" });
+    const auto replaced = std::wstring_view{ engine.printed }.substr(3);
+    VERIFY_IS_FALSE(replaced.empty());
+    VERIFY_ARE_EQUAL(std::wstring_view::npos, replaced.find_first_not_of(L'\xfffd'));
+    VERIFY_ARE_EQUAL(L"\r", engine.executed);
+}
+
+void StateMachineTest::InstrumentationCountsSequences()
+{
+    StateMachine machine{ std::make_unique<TestStateMachineEngine>() };
+    using Kind = ParserInstrumentation::SequenceKind;
+
+    Log::Comment(L"Instrumentation is disabled by default.");
+    machine.ProcessString(L"\x1b[?25h");
+    VERIFY_IS_NULL(machine.GetInstrumentation());
+
+    machine.EnableInstrumentation(true);
+    machine.ProcessString(L"\x1b[?25h\x1b[?25l\x1b[1mabc\r\n\x1b[?25hdefgh\x1b]8;;\a\x1b7");
+
+    const auto instrumentation = machine.GetInstrumentation();
+    VERIFY_IS_NOT_NULL(instrumentation);
+
+    const auto stats = instrumentation->GetSequenceStats();
+    const auto countOf = [&](const Kind kind, const uint64_t id) {
+        const auto it = std::find_if(stats.begin(), stats.end(), [&](const auto& s) {
+            return s.kind == kind && s.id == id;
+        });
+        return it == stats.end() ? size_t{ 0 } : it->count;
+    };
+
+    Log::Comment(L"Sequences are told apart by their private parameter prefix and final character.");
+    VERIFY_ARE_EQUAL(2u, countOf(Kind::Csi, VTID("?h")));
+    VERIFY_ARE_EQUAL(1u, countOf(Kind::Csi, VTID("?l")));
+    VERIFY_ARE_EQUAL(1u, countOf(Kind::Csi, VTID("m")));
+    VERIFY_ARE_EQUAL(0u, countOf(Kind::Csi, VTID("h")));
+    VERIFY_ARE_EQUAL(1u, countOf(Kind::Execute, L'\r'));
+    VERIFY_ARE_EQUAL(1u, countOf(Kind::Execute, L'\n'));
+    VERIFY_ARE_EQUAL(1u, countOf(Kind::Osc, 8));
+    VERIFY_ARE_EQUAL(1u, countOf(Kind::Escape, VTID("7")));
+    VERIFY_ARE_EQUAL(7u, stats.size());
+
+    const auto& print = instrumentation->GetPrintStats();
+    VERIFY_ARE_EQUAL(2u, print.runs);
+    VERIFY_ARE_EQUAL(8u, print.characters);
+    VERIFY_ARE_EQUAL(5u, print.longestRun);
+    VERIFY_ARE_EQUAL(1u, print.histogram.at(1));
+    VERIFY_ARE_EQUAL(1u, print.histogram.at(2));
+
+    VERIFY_ARE_EQUAL(L"CSI ?h", ParserInstrumentation::FormatSequence(Kind::Csi, VTID("?h")));
+    VERIFY_ARE_EQUAL(L"C0 0x0D", ParserInstrumentation::FormatSequence(Kind::Execute, L'\r'));
+    VERIFY_ARE_EQUAL(L"OSC 8", ParserInstrumentation::FormatSequence(Kind::Osc, 8));
+    VERIFY_ARE_NOT_EQUAL(std::wstring::npos, instrumentation->Format().find(L"CSI ?l"));
+
+    Log::Comment(L"Disabling instrumentation discards the statistics.");
+    machine.EnableInstrumentation(false);
+    VERIFY_IS_NULL(machine.GetInstrumentation());
+}
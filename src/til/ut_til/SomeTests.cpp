@@ -224,6 +224,12 @@ class SomeTests
 
         VERIFY_ARE_EQUAL(one, s.front());
         VERIFY_ARE_EQUAL(two, s.back());
+
+        s.front() = 3;
+        s.back() = 4;
+        VERIFY_ARE_EQUAL(3, s.front());
+        VERIFY_ARE_EQUAL(4, s.back());
+        VERIFY_ARE_EQUAL(2u, s.size());
     }
 
     TEST_METHOD(Indexing)
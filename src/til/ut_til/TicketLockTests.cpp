@@ -0,0 +1,126 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "til/ticket_lock.h"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+class TicketLockTests
+{
+    BEGIN_TEST_CLASS(TicketLockTests)
+        TEST_CLASS_PROPERTY(L"TestTimeout", L"0:0:10") // 10s timeout
+    END_TEST_CLASS()
+
+    TEST_METHOD(SharedReaders)
+    {
+        til::shared_ticket_lock lock;
+
+        {
+            // Multiple readers may hold the lock at the same time.
+            std::shared_lock lock1{ lock };
+            std::shared_lock lock2{ lock };
+        }
+
+        // This is here just to ensure that the prior
+        // shared locks properly unlocked the mutex.
+        std::unique_lock writer{ lock };
+    }
+
+    TEST_METHOD(TryLock)
+    {
+        til::shared_ticket_lock lock;
+
+        VERIFY_IS_TRUE(lock.try_lock_shared());
+        VERIFY_IS_TRUE(lock.try_lock_shared());
+        VERIFY_IS_FALSE(lock.try_lock());
+        lock.unlock_shared();
+        lock.unlock_shared();
+
+        VERIFY_IS_TRUE(lock.try_lock());
+        VERIFY_IS_FALSE(lock.try_lock());
+        VERIFY_IS_FALSE(lock.try_lock_shared());
+        lock.unlock();
+
+        // A failed try_lock() must not leave the lock in a state that blocks others.
+        std::unique_lock writer{ lock };
+    }
+
+    TEST_METHOD(TryLockSharedFailsWhileWriterWaits)
+    {
+        til::shared_ticket_lock lock;
+        lock.lock_shared();
+
+        std::thread writer{ [&]() {
+            std::unique_lock guard{ lock };
+        } };
+
+        // The writer flags the lock as soon as it starts waiting for us,
+        // after which new readers are turned away.
+        while (lock.try_lock_shared())
+        {
+            lock.unlock_shared();
+            std::this_thread::yield();
+        }
+
+        lock.unlock_shared();
+        writer.join();
+
+        VERIFY_IS_TRUE(lock.try_lock_shared());
+        lock.unlock_shared();
+    }
+
+    TEST_METHOD(WriterExcludesReaders)
+    {
+        til::shared_ticket_lock lock;
+        std::atomic<int> readersInside{ 0 };
+        std::atomic<bool> violation{ false };
+        int value = 0;
+
+        std::vector<std::thread> threads;
+
+        for (int i = 0; i < 4; ++i)
+        {
+            threads.emplace_back([&]() {
+                for (int j = 0; j < 10000; ++j)
+                {
+                    std::shared_lock guard{ lock };
+                    readersInside.fetch_add(1, std::memory_order_relaxed);
+                    // A writer always leaves value even.
+                    if (value & 1)
+                    {
+                        violation = true;
+                    }
+                    readersInside.fetch_sub(1, std::memory_order_relaxed);
+                }
+            });
+        }
+
+        for (int i = 0; i < 2; ++i)
+        {
+            threads.emplace_back([&]() {
+                for (int j = 0; j < 10000; ++j)
+                {
+                    std::unique_lock guard{ lock };
+                    if (readersInside.load(std::memory_order_relaxed) != 0)
+                    {
+                        violation = true;
+                    }
+                    value++;
+                    value++;
+                }
+            });
+        }
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        VERIFY_IS_FALSE(violation.load());
+        VERIFY_ARE_EQUAL(40000, value);
+    }
+};
@@ -0,0 +1,136 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "bench.hpp"
+
+#include "../../host/caseInsensitiveMap.h"
+
+namespace
+{
+    constexpr size_t aliasCount = 64;
+    constexpr size_t lineCount = 4096;
+
+    // What the alias table used before: Every hash copies and lowercases the key.
+    struct CopyingHash
+    {
+        size_t operator()(const std::wstring& key) const
+        {
+            std::wstring lower(key);
+            std::transform(lower.begin(), lower.end(), lower.begin(), ::towlower);
+            return std::hash<std::wstring>{}(lower);
+        }
+    };
+
+    struct CopyingEquality
+    {
+        bool operator()(const std::wstring& lhs, const std::wstring& rhs) const
+        {
+            return 0 == _wcsicmp(lhs.data(), rhs.data());
+        }
+    };
+
+    using CopyingMap = std::unordered_map<std::wstring, std::unordered_map<std::wstring, std::wstring, CopyingHash, CopyingEquality>, CopyingHash, CopyingEquality>;
+
+    std::deque<std::wstring> tokenize(const std::wstring& str)
+    {
+        std::deque<std::wstring> result;
+        size_t prevIndex = 0;
+        for (auto spaceIndex = str.find(L' '); spaceIndex != std::wstring::npos; spaceIndex = str.find(L' ', prevIndex))
+        {
+            result.emplace_back(str.substr(prevIndex, spaceIndex - prevIndex));
+            prevIndex = spaceIndex + 1;
+        }
+        result.emplace_back(str.substr(prevIndex));
+        return result;
+    }
+
+    // Alias::s_MatchAndCopyAlias() before: It copied the aliases of the exe,
+    // then trimmed and tokenized a copy of the line before it looked up the first word.
+    bool matchCopying(const CopyingMap& aliases, const std::wstring& line, const std::wstring& exeName)
+    {
+        std::wstring copy{ line };
+        copy.erase(std::min(copy.find_last_of(L'\r'), copy.size()));
+        copy.erase(copy.begin(), std::find_if(copy.begin(), copy.end(), [](wchar_t ch) { return !std::iswspace(ch); }));
+
+        const auto exeIter = aliases.find(exeName);
+        if (exeIter == aliases.end())
+        {
+            return false;
+        }
+
+        const auto exeList = exeIter->second;
+        const auto tokens = tokenize(copy);
+        return exeList.find(tokens.front()) != exeList.end();
+    }
+
+    // Alias::s_MatchAndCopyAlias() now: The first word is looked up in place and
+    // only the lines that start with an alias are copied and tokenized.
+    bool matchInPlace(const CaseInsensitiveMap<CaseInsensitiveMap<std::wstring>>& aliases, const std::wstring& line, const std::wstring& exeName)
+    {
+        const auto exeList = aliases.find(exeName);
+        if (!exeList)
+        {
+            return false;
+        }
+
+        std::wstring_view trimmed{ line };
+        trimmed = trimmed.substr(0, trimmed.find_last_of(L'\r'));
+        const auto firstNonSpace = std::find_if(trimmed.begin(), trimmed.end(), [](wchar_t ch) { return !std::iswspace(ch); });
+        trimmed.remove_prefix(gsl::narrow_cast<size_t>(firstNonSpace - trimmed.begin()));
+
+        if (!exeList->find(trimmed.substr(0, trimmed.find(L' '))))
+        {
+            return false;
+        }
+
+        const auto tokens = tokenize(std::wstring{ trimmed });
+        return !tokens.empty();
+    }
+}
+
+// The lines are what a doskey-heavy cmd.exe session reads: One in eight of them
+// starts with one of the 64 aliases (in a different case), the others don't.
+// Expanding the macros of a matching alias is the same for both and isn't included.
+void RunAliasBenchmarks(bench::runner& runner)
+{
+    static const std::wstring exeName{ L"CMD.EXE" };
+
+    CopyingMap copying;
+    CaseInsensitiveMap<CaseInsensitiveMap<std::wstring>> inPlace;
+    for (size_t i = 0; i < aliasCount; ++i)
+    {
+        const auto alias = L"alias" + std::to_wstring(i);
+        const auto target = L"some\\long\\path\\tool" + std::to_wstring(i) + L".exe $*";
+        copying[L"cmd.exe"][alias] = target;
+        inPlace[L"cmd.exe"][alias] = target;
+    }
+
+    std::vector<std::wstring> lines;
+    lines.reserve(lineCount);
+    for (size_t i = 0; i < lineCount; ++i)
+    {
+        if (i % 8 == 0)
+        {
+            lines.emplace_back(L"  ALIAS" + std::to_wstring(i % aliasCount) + L" first second third\r\n");
+        }
+        else
+        {
+            lines.emplace_back(L"git log --oneline -n " + std::to_wstring(i) + L"\r\n");
+        }
+    }
+
+    runner.run_items("Alias/Match 4096 lines (copying table)", lines.size(), [&]() {
+        for (const auto& line : lines)
+        {
+            bench::do_not_optimize(matchCopying(copying, line, exeName));
+        }
+    });
+
+    runner.run_items("Alias/Match 4096 lines (in-place lookup)", lines.size(), [&]() {
+        for (const auto& line : lines)
+        {
+            bench::do_not_optimize(matchInPlace(inPlace, line, exeName));
+        }
+    });
+}
@@ -0,0 +1,79 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "bench.hpp"
+
+// Unlike the other benchmarks, these don't link against the console's code.
+// Instead they measure the console ConsoleBench is running in, end to end.
+// Run it inside of OpenConsole.exe to measure a locally built host.
+void RunAltBufferBenchmarks(bench::runner& runner)
+{
+    wil::unique_hfile output{ CreateFileW(L"CONOUT$", GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, 0, nullptr) };
+    if (!output)
+    {
+        std::cout << "AltBuffer benchmarks skipped: not attached to a console\n";
+        return;
+    }
+
+    DWORD originalMode = 0;
+    CONSOLE_SCREEN_BUFFER_INFOEX originalInfo{ sizeof(originalInfo) };
+    if (!GetConsoleMode(output.get(), &originalMode) || !GetConsoleScreenBufferInfoEx(output.get(), &originalInfo))
+    {
+        std::cout << "AltBuffer benchmarks skipped: failed to query the console\n";
+        return;
+    }
+
+    SetConsoleMode(output.get(), originalMode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+
+    // The alt buffer is as large as the window. Make it as large as we can
+    // (up to 300x100), since that's where allocating a new buffer hurts the most.
+    const auto largest = GetLargestConsoleWindowSize(output.get());
+    const SHORT width = std::max<SHORT>(originalInfo.srWindow.Right - originalInfo.srWindow.Left + 1, std::min<SHORT>(largest.X, 300));
+    const SHORT height = std::max<SHORT>(originalInfo.srWindow.Bottom - originalInfo.srWindow.Top + 1, std::min<SHORT>(largest.Y, 100));
+
+    auto largeInfo = originalInfo;
+    largeInfo.dwSize.X = std::max(largeInfo.dwSize.X, width);
+    largeInfo.dwSize.Y = std::max(largeInfo.dwSize.Y, height);
+    // SetConsoleScreenBufferInfoEx treats the window rect as exclusive, unlike its getter.
+    largeInfo.srWindow = { 0, 0, width, height };
+    SetConsoleScreenBufferInfoEx(output.get(), &largeInfo);
+
+    auto restore = wil::scope_exit([&]() {
+        originalInfo.srWindow.Right++;
+        originalInfo.srWindow.Bottom++;
+        SetConsoleScreenBufferInfoEx(output.get(), &originalInfo);
+        SetConsoleMode(output.get(), originalMode);
+    });
+
+    CONSOLE_SCREEN_BUFFER_INFO info{};
+    GetConsoleScreenBufferInfo(output.get(), &info);
+    const auto windowWidth = info.srWindow.Right - info.srWindow.Left + 1;
+    const auto windowHeight = info.srWindow.Bottom - info.srWindow.Top + 1;
+
+    const auto write = [&](const std::wstring_view str) {
+        DWORD written = 0;
+        WriteConsoleW(output.get(), str.data(), gsl::narrow_cast<DWORD>(str.size()), &written, nullptr);
+    };
+
+    const auto name = [&](const char* prefix) {
+        return std::string{ prefix } + " (" + std::to_string(windowWidth) + "x" + std::to_string(windowHeight) + ")";
+    };
+
+    runner.run(name("AltBuffer/enter+leave"), 0, [&]() {
+        write(L"\x1b[?1049h\x1b[?1049l");
+    });
+
+    // What a pager does on every invocation: switch, paint a screen of text, switch back.
+    std::wstring screen{ L"\x1b[?1049h\x1b[H" };
+    for (auto row = 0; row < windowHeight; ++row)
+    {
+        screen.append(gsl::narrow_cast<size_t>(windowWidth - 1), L'x');
+        screen.append(L"\r\n");
+    }
+    screen.append(L"\x1b[?1049l");
+
+    runner.run(name("AltBuffer/enter+paint+leave"), screen.size() * sizeof(wchar_t), [&]() {
+        write(screen);
+    });
+}
@@ -0,0 +1,99 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "bench.hpp"
+
+#include "../../buffer/out/textBuffer.hpp"
+#include "../../renderer/inc/DummyRenderTarget.hpp"
+#include "../../types/inc/convert.hpp"
+
+using namespace Microsoft::Console::Types;
+
+namespace
+{
+    constexpr SHORT width = 300;
+    constexpr SHORT height = 100;
+
+    // What a full-screen TUI draws every frame: Short runs of colored text,
+    // separated by frame characters, with a pair of wide glyphs here and there.
+    std::vector<CHAR_INFO> makeFrame(const WORD seed)
+    {
+        std::vector<CHAR_INFO> frame(gsl::narrow_cast<size_t>(width) * height);
+        for (size_t i = 0; i < frame.size(); ++i)
+        {
+            auto& cell = til::at(frame, i);
+            const auto x = i % width;
+            cell.Attributes = gsl::narrow_cast<WORD>(((x / 12 + seed) % 7 + 1) | (x < 40 ? BACKGROUND_BLUE : 0));
+            if (x % 30 == 28)
+            {
+                cell.Char.UnicodeChar = L'\x4e2d';
+                cell.Attributes |= COMMON_LVB_LEADING_BYTE;
+            }
+            else if (x % 30 == 29)
+            {
+                cell.Char.UnicodeChar = L'\x4e2d';
+                cell.Attributes |= COMMON_LVB_TRAILING_BYTE;
+            }
+            else
+            {
+                cell.Char.UnicodeChar = x % 40 == 0 ? L'\x2502' : gsl::narrow_cast<wchar_t>(L'a' + (i + seed) % 26);
+            }
+        }
+        return frame;
+    }
+
+    // CONSOLE_INFORMATION::AsCharInfo(), which ReadConsoleOutput used for every cell before.
+    CHAR_INFO asCharInfo(const OutputCellView& cell)
+    {
+        CHAR_INFO ci{ 0 };
+        ci.Char.UnicodeChar = Utf16ToUcs2(cell.Chars());
+        ci.Attributes = cell.TextAttr().GetLegacyAttributes();
+        ci.Attributes |= cell.DbcsAttr().GeneratePublicApiAttributeFormat();
+        return ci;
+    }
+}
+
+// ReadConsoleOutput/WriteConsoleOutput of a whole 300x100 screen, like far manager
+// and other full-screen apps do every frame. The "cell iterator" variants are what
+// directio.cpp did before: A TextBufferCellIterator for the reads and an
+// OutputCellIterator per row for the writes. The others convert row spans in bulk.
+void RunCharInfoBenchmarks(bench::runner& runner)
+{
+    DummyRenderTarget renderTarget;
+    TextBuffer buffer{ { width, height }, TextAttribute{}, 0, renderTarget };
+    const auto screen = Viewport::FromDimensions({ 0, 0 }, { width, height });
+    const auto frames = std::array<std::vector<CHAR_INFO>, 2>{ makeFrame(0), makeFrame(1) };
+    const auto bytes = til::at(frames, 0).size() * sizeof(CHAR_INFO);
+    size_t frameIndex = 0;
+
+    runner.run("CharInfo/WriteConsoleOutput 300x100 (cell iterator)", bytes, [&]() {
+        const auto& frame = til::at(frames, frameIndex++ % frames.size());
+        for (SHORT y = 0; y < height; ++y)
+        {
+            const gsl::span<const CHAR_INFO> row{ frame.data() + y * width, gsl::narrow_cast<size_t>(width) };
+            buffer.Write(OutputCellIterator{ row }, { 0, y });
+        }
+    });
+
+    runner.run("CharInfo/WriteConsoleOutput 300x100 (row spans)", bytes, [&]() {
+        const auto& frame = til::at(frames, frameIndex++ % frames.size());
+        buffer.WriteCharInfos(frame, gsl::narrow_cast<size_t>(width), screen);
+    });
+
+    std::vector<CHAR_INFO> target(til::at(frames, 0).size());
+
+    runner.run("CharInfo/ReadConsoleOutput 300x100 (cell iterator)", bytes, [&]() {
+        auto out = target.begin();
+        for (auto it = buffer.GetCellDataAt({ 0, 0 }, screen); it && out != target.end(); ++it, ++out)
+        {
+            *out = asCharInfo(*it);
+        }
+        bench::do_not_optimize(target);
+    });
+
+    runner.run("CharInfo/ReadConsoleOutput 300x100 (row spans)", bytes, [&]() {
+        buffer.ReadCharInfos(screen, target, gsl::narrow_cast<size_t>(width));
+        bench::do_not_optimize(target);
+    });
+}
@@ -0,0 +1,100 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "bench.hpp"
+
+namespace
+{
+    void appendKey(std::vector<INPUT_RECORD>& records, const WORD virtualKey, const wchar_t ch)
+    {
+        for (const auto keyDown : { TRUE, FALSE })
+        {
+            INPUT_RECORD record{};
+            record.EventType = KEY_EVENT;
+            record.Event.KeyEvent.bKeyDown = keyDown;
+            record.Event.KeyEvent.wRepeatCount = 1;
+            record.Event.KeyEvent.wVirtualKeyCode = virtualKey;
+            record.Event.KeyEvent.uChar.UnicodeChar = ch;
+            records.push_back(record);
+        }
+    }
+
+    void appendText(std::vector<INPUT_RECORD>& records, const std::wstring_view text)
+    {
+        for (const auto ch : text)
+        {
+            appendKey(records, 0, ch);
+        }
+    }
+}
+
+// Like the AltBuffer benchmarks, these measure the console ConsoleBench is running in.
+// Run it inside of OpenConsole.exe to measure a locally built host. Every iteration
+// writes a paste into the input buffer with WriteConsoleInputW, the way a terminal
+// does, and reads it back with a cooked ReadConsoleW, which echoes it as it goes.
+void RunCookedReadBenchmarks(bench::runner& runner)
+{
+    static constexpr size_t pasteLength = 64 * 1024;
+    static constexpr std::wstring_view tail{ L" > output.txt" };
+
+    wil::unique_hfile input{ CreateFileW(L"CONIN$", GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, 0, nullptr) };
+    DWORD originalMode = 0;
+    if (!input || !GetConsoleMode(input.get(), &originalMode))
+    {
+        std::cout << "CookedRead benchmarks skipped: not attached to a console\n";
+        return;
+    }
+
+    // Insert mode is what makes a paste into the middle of the line shift the rest of it.
+    SetConsoleMode(input.get(), ENABLE_PROCESSED_INPUT | ENABLE_LINE_INPUT | ENABLE_ECHO_INPUT | ENABLE_INSERT_MODE | ENABLE_EXTENDED_FLAGS);
+    FlushConsoleInputBuffer(input.get());
+
+    auto restore = wil::scope_exit([&]() {
+        FlushConsoleInputBuffer(input.get());
+        SetConsoleMode(input.get(), originalMode);
+    });
+
+    std::wstring paste;
+    paste.reserve(pasteLength);
+    for (size_t i = 0; i < pasteLength; ++i)
+    {
+        paste.push_back(static_cast<wchar_t>(L' ' + i % 95));
+    }
+
+    // The line is read in one piece, including the CR LF at its end.
+    std::vector<wchar_t> line(pasteLength + tail.size() + 4);
+
+    const auto pasteAndRead = [&](const std::vector<INPUT_RECORD>& records) {
+        DWORD written = 0;
+        WriteConsoleInputW(input.get(), records.data(), gsl::narrow_cast<DWORD>(records.size()), &written);
+
+        DWORD read = 0;
+        ReadConsoleW(input.get(), line.data(), gsl::narrow_cast<DWORD>(line.size()), &read, nullptr);
+
+        // The key up of the ENTER is left behind.
+        FlushConsoleInputBuffer(input.get());
+        bench::do_not_optimize(line);
+    };
+
+    std::vector<INPUT_RECORD> atEnd;
+    atEnd.reserve((pasteLength + 1) * 2);
+    appendText(atEnd, paste);
+    appendKey(atEnd, VK_RETURN, L'\r');
+
+    runner.run("CookedRead/Paste 64 KB at the end of the line", pasteLength * sizeof(wchar_t), [&]() {
+        pasteAndRead(atEnd);
+    });
+
+    // Type the tail of a command, move to the start of the line and paste in front of it.
+    std::vector<INPUT_RECORD> inMiddle;
+    inMiddle.reserve((tail.size() + pasteLength + 2) * 2);
+    appendText(inMiddle, tail);
+    appendKey(inMiddle, VK_HOME, UNICODE_NULL);
+    appendText(inMiddle, paste);
+    appendKey(inMiddle, VK_RETURN, L'\r');
+
+    runner.run("CookedRead/Paste 64 KB into the middle of the line", pasteLength * sizeof(wchar_t), [&]() {
+        pasteAndRead(inMiddle);
+    });
+}
@@ -0,0 +1,120 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "bench.hpp"
+
+#include "../../types/inc/InputRecordQueue.hpp"
+
+using namespace Microsoft::Console;
+
+namespace
+{
+    // A paste of 32K characters turns into a key down and a key up record for each of them.
+    constexpr size_t pasteLength = 32 * 1024;
+
+    std::vector<INPUT_RECORD> makePaste()
+    {
+        std::vector<INPUT_RECORD> records;
+        records.reserve(pasteLength * 2);
+
+        for (size_t i = 0; i < pasteLength; ++i)
+        {
+            const auto ch = static_cast<wchar_t>(i % 64 == 63 ? L'\r' : L' ' + i % 95);
+            for (const auto keyDown : { TRUE, FALSE })
+            {
+                INPUT_RECORD record{};
+                record.EventType = KEY_EVENT;
+                record.Event.KeyEvent.bKeyDown = keyDown;
+                record.Event.KeyEvent.wRepeatCount = 1;
+                record.Event.KeyEvent.uChar.UnicodeChar = ch;
+                records.push_back(record);
+            }
+        }
+
+        return records;
+    }
+}
+
+// The first benchmarks measure InputRecordQueue, the storage of the InputBuffer,
+// on its own. The drains read the records in chunks of 4096, like a
+// ReadConsoleInputW loop with a reasonably large buffer would.
+//
+// The others measure the InputBuffer of the console ConsoleBench is running in,
+// like the AltBuffer benchmarks. Run it inside of OpenConsole.exe to measure a
+// locally built host.
+void RunInputBufferBenchmarks(bench::runner& runner)
+{
+    const auto paste = makePaste();
+    const auto bytes = paste.size() * sizeof(INPUT_RECORD);
+    constexpr size_t chunkSize = 4096;
+
+    InputRecordQueue queueStorage;
+    std::vector<INPUT_RECORD> chunk(chunkSize);
+
+    runner.run("InputBuffer/Write paste (InputRecordQueue)", bytes, [&]() {
+        InputRecordQueue storage;
+        storage.push_back(paste);
+        bench::do_not_optimize(storage);
+    });
+
+    runner.run("InputBuffer/Write and drain paste (InputRecordQueue)", bytes, [&]() {
+        queueStorage.push_back(paste);
+
+        while (!queueStorage.empty())
+        {
+            queueStorage.pop_front(queueStorage.copy_to(chunk));
+            bench::do_not_optimize(chunk);
+        }
+    });
+
+    runner.run("InputBuffer/Write keystrokes one at a time (InputRecordQueue)", bytes, [&]() {
+        for (const auto& record : paste)
+        {
+            queueStorage.push_back(record);
+        }
+        queueStorage.clear();
+    });
+
+    wil::unique_hfile input{ CreateFileW(L"CONIN$", GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, 0, nullptr) };
+    DWORD originalMode = 0;
+    if (!input || !GetConsoleMode(input.get(), &originalMode))
+    {
+        std::cout << "InputBuffer console benchmarks skipped: not attached to a console\n";
+        return;
+    }
+
+    // Raw mode, so that ReadConsoleInputW returns the records as they were written.
+    SetConsoleMode(input.get(), 0);
+    FlushConsoleInputBuffer(input.get());
+
+    auto restore = wil::scope_exit([&]() {
+        FlushConsoleInputBuffer(input.get());
+        SetConsoleMode(input.get(), originalMode);
+    });
+
+    const auto drain = [&]() {
+        DWORD available = 0;
+        while (GetNumberOfConsoleInputEvents(input.get(), &available) && available)
+        {
+            DWORD read = 0;
+            ReadConsoleInputW(input.get(), chunk.data(), gsl::narrow_cast<DWORD>(chunk.size()), &read);
+            bench::do_not_optimize(chunk);
+        }
+    };
+
+    runner.run("InputBuffer/Write and drain paste (console)", bytes, [&]() {
+        DWORD written = 0;
+        WriteConsoleInputW(input.get(), paste.data(), gsl::narrow_cast<DWORD>(paste.size()), &written);
+        drain();
+    });
+
+    runner.run("InputBuffer/Write keystrokes one at a time (console)", bytes, [&]() {
+        for (const auto& record : paste)
+        {
+            DWORD written = 0;
+            WriteConsoleInputW(input.get(), &record, 1, &written);
+        }
+        drain();
+    });
+}
@@ -0,0 +1,148 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "bench.hpp"
+
+#include "../../terminal/adapter/termDispatch.hpp"
+#include "../../terminal/parser/OutputStateMachineEngine.hpp"
+#include "../../terminal/parser/stateMachine.hpp"
+
+using namespace Microsoft::Console::VirtualTerminal;
+
+namespace
+{
+    // Accepts every sequence the benchmarks use without doing anything,
+    // so that only the cost of the parser itself is measured.
+    class NullDispatch final : public TermDispatch
+    {
+    public:
+        void Print(const wchar_t wchPrintable) override
+        {
+            bench::do_not_optimize(wchPrintable);
+        }
+
+        void PrintString(const std::wstring_view string) override
+        {
+            bench::do_not_optimize(string);
+        }
+
+        bool CursorPosition(const size_t, const size_t) noexcept override { return true; }
+        bool CarriageReturn() noexcept override { return true; }
+        bool LineFeed(const DispatchTypes::LineFeedType) noexcept override { return true; }
+        bool EraseInLine(const DispatchTypes::EraseType) noexcept override { return true; }
+        bool SetGraphicsRendition(const VTParameters) noexcept override { return true; }
+    };
+}
+
+void RunParserBenchmarks(bench::runner& runner)
+{
+    static constexpr size_t lines = 4096;
+
+    StateMachine stateMachine{ std::make_unique<OutputStateMachineEngine>(std::make_unique<NullDispatch>()) };
+
+    // Plain text, like the output of a build or a `cat` of a source file.
+    std::wstring plain;
+    for (size_t i = 0; i < lines; ++i)
+    {
+        fmt::format_to(std::back_inserter(plain), L"[{:4}/{}] Compiling src\\terminal\\parser\\stateMachine{}.cpp\r\n", i, lines, std::wstring(i % 40, L'_'));
+    }
+
+    // Colored text, like the output of `ls --color` or a syntax highlighter.
+    std::wstring colored;
+    for (size_t i = 0; i < lines; ++i)
+    {
+        fmt::format_to(std::back_inserter(colored), L"\x1b[38;5;{}mdrwxr-xr-x\x1b[m \x1b[1;34mdirectory{}\x1b[m \x1b[38;2;{};128;64mfile.txt\x1b[m\r\n", i % 256, i, i % 256);
+    }
+
+    // A cursor heavy TUI redraw, like the output of `htop` or `vim`:
+    // short runs of text, each of them preceded by a CUP and an SGR.
+    std::wstring tui;
+    for (size_t i = 0; i < lines; ++i)
+    {
+        fmt::format_to(std::back_inserter(tui), L"\x1b[{};{}H\x1b[{}m{:5.1f}%\x1b[K", i % 50 + 1, i % 7 * 12 + 1, 30 + i % 8, i % 1000 / 10.0);
+    }
+
+    // A `cmatrix` like stream: every single character is
+    // preceded by a CUP and a change of the foreground color.
+    std::wstring matrix;
+    for (size_t i = 0; i < lines * 8; ++i)
+    {
+        fmt::format_to(std::back_inserter(matrix), L"\x1b[{};{}H\x1b[{};32m{}", i * 7 % 50 + 1, i * 13 % 120 + 1, i % 2, static_cast<wchar_t>(L'!' + i % 94));
+    }
+
+    // Text in which every character has its own SGR, like the output
+    // of a rainbow filter (`lolcat`) or of a true color image viewer.
+    std::wstring sgrPerCharacter;
+    for (size_t i = 0; i < lines * 8; ++i)
+    {
+        fmt::format_to(std::back_inserter(sgrPerCharacter), L"\x1b[38;2;{};{};{}m{}", i % 256, i * 3 % 256, i * 7 % 256, static_cast<wchar_t>(L'a' + i % 26));
+    }
+
+    // The throughput is relative to the size of the UTF-16 input.
+    runner.run("StateMachine/ProcessString (plain text)", plain.size() * sizeof(wchar_t), [&]() {
+        stateMachine.ProcessString(plain);
+    });
+
+    runner.run("StateMachine/ProcessString (SGR colored text)", colored.size() * sizeof(wchar_t), [&]() {
+        stateMachine.ProcessString(colored);
+    });
+
+    runner.run("StateMachine/ProcessString (cursor heavy TUI)", tui.size() * sizeof(wchar_t), [&]() {
+        stateMachine.ProcessString(tui);
+    });
+
+    runner.run("StateMachine/ProcessString (cmatrix)", matrix.size() * sizeof(wchar_t), [&]() {
+        stateMachine.ProcessString(matrix);
+    });
+
+    runner.run("StateMachine/ProcessString (SGR per character)", sgrPerCharacter.size() * sizeof(wchar_t), [&]() {
+        stateMachine.ProcessString(sgrPerCharacter);
+    });
+
+    // The cost of instrumentation, which reads the clock twice per dispatch.
+    // Compare these to the uninstrumented benchmarks of the same input above.
+    stateMachine.EnableInstrumentation(true);
+
+    runner.run("StateMachine/ProcessString instrumented (SGR colored text)", colored.size() * sizeof(wchar_t), [&]() {
+        stateMachine.ProcessString(colored);
+    });
+
+    runner.run("StateMachine/ProcessString instrumented (cmatrix)", matrix.size() * sizeof(wchar_t), [&]() {
+        stateMachine.ProcessString(matrix);
+    });
+
+    stateMachine.EnableInstrumentation(false);
+
+    // The UTF-8 input path, compared to converting all of the input to UTF-16
+    // before parsing it, as ConptyConnection does. The throughput of these
+    // benchmarks is relative to the size of the UTF-8 input.
+    std::wstring international;
+    for (size_t i = 0; i < lines; ++i)
+    {
+        fmt::format_to(std::back_inserter(international), L"\x1b[32m{:4}\x1b[m Gr\xfc\xdf" L"e, \x3053\x3093\x306b\x3061\x306f, \x043f\x0440\x0438\x0432\x0435\x0442 \xd83d\xde00\r\n", i);
+    }
+
+    const std::pair<std::string_view, const std::wstring&> utf8Inputs[]{
+        { "plain text", plain },
+        { "SGR colored text", colored },
+        { "international text", international },
+    };
+
+    til::u8state u8state;
+    std::wstring u16;
+
+    for (const auto& [name, input] : utf8Inputs)
+    {
+        const auto utf8 = til::u16u8(input);
+
+        runner.run(fmt::format("StateMachine/ProcessString via u8u16 ({})", name), utf8.size(), [&]() {
+            THROW_IF_FAILED(til::u8u16(utf8, u16, u8state));
+            stateMachine.ProcessString(u16);
+        });
+
+        runner.run(fmt::format("StateMachine/ProcessString UTF-8 ({})", name), utf8.size(), [&]() {
+            stateMachine.ProcessString(std::string_view{ utf8 });
+        });
+    }
+}
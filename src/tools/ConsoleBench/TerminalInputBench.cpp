@@ -0,0 +1,114 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "bench.hpp"
+
+#include "../../terminal/input/terminalInput.hpp"
+#include "../../terminal/parser/InputStateMachineEngine.hpp"
+#include "../../terminal/parser/stateMachine.hpp"
+
+using namespace Microsoft::Console::VirtualTerminal;
+
+namespace
+{
+    constexpr size_t keyCount = 4096;
+
+    // Counts the records the input engine decodes without writing them anywhere,
+    // so that only the cost of the parser and the engine is measured.
+    class NullInteractDispatch final : public IInteractDispatch
+    {
+    public:
+        bool WriteInput(const gsl::span<const INPUT_RECORD> inputEvents) noexcept override
+        {
+            bench::do_not_optimize(inputEvents);
+            return true;
+        }
+
+        bool WriteCtrlKey(const KeyEvent& event) noexcept override
+        {
+            bench::do_not_optimize(event);
+            return true;
+        }
+
+        bool WriteString(const std::wstring_view string) noexcept override
+        {
+            bench::do_not_optimize(string);
+            return true;
+        }
+
+        bool WindowManipulation(const DispatchTypes::WindowManipulationType, const VTParameter, const VTParameter) noexcept override { return true; }
+        bool MoveCursor(const size_t, const size_t) noexcept override { return true; }
+        bool IsVtInputEnabled() const noexcept override { return false; }
+    };
+
+    std::vector<KeyEvent> makeKeys(const DWORD modifiers, const std::initializer_list<WORD> vkeys)
+    {
+        std::vector<KeyEvent> keys;
+        keys.reserve(keyCount);
+
+        for (size_t i = 0; i < keyCount; ++i)
+        {
+            const auto vkey = *std::next(vkeys.begin(), i % vkeys.size());
+            const auto ch = vkey >= 'A' && vkey <= 'Z' ? gsl::narrow_cast<wchar_t>(vkey - 'A' + 'a') : L'\0';
+            keys.emplace_back(true, 1ui16, vkey, 0ui16, ch, modifiers);
+        }
+
+        return keys;
+    }
+
+    std::wstring repeat(const std::wstring_view sequence)
+    {
+        std::wstring str;
+        str.reserve(sequence.size() * keyCount);
+
+        for (size_t i = 0; i < keyCount; ++i)
+        {
+            str.append(sequence);
+        }
+
+        return str;
+    }
+}
+
+// Measures the number of keys per second that TerminalInput encodes into
+// sequences and that the InputStateMachineEngine decodes back into records.
+// Neither of them should allocate in the steady state.
+void RunTerminalInputBenchmarks(bench::runner& runner)
+{
+    size_t records = 0;
+    TerminalInput terminalInput{ [&](const gsl::span<const INPUT_RECORD> events) noexcept {
+        records += events.size();
+    } };
+
+    const auto typed = makeKeys(0, { 'H', 'E', 'L', 'L', 'O', VK_SPACE, 'W', 'O', 'R', 'L', 'D', VK_RETURN });
+    const auto cursorKeys = makeKeys(0, { VK_UP, VK_DOWN, VK_LEFT, VK_RIGHT, VK_HOME, VK_END, VK_PRIOR, VK_NEXT });
+    const auto modifiedKeys = makeKeys(LEFT_CTRL_PRESSED | SHIFT_PRESSED, { VK_UP, VK_DOWN, VK_LEFT, VK_RIGHT, VK_DELETE, VK_F5 });
+
+    const auto encode = [&](const std::vector<KeyEvent>& keys) {
+        for (const auto& key : keys)
+        {
+            terminalInput.HandleKey(&key);
+        }
+        bench::do_not_optimize(records);
+    };
+
+    runner.run_items("TerminalInput/Encode typed characters", keyCount, [&]() { encode(typed); });
+    runner.run_items("TerminalInput/Encode cursor keys", keyCount, [&]() { encode(cursorKeys); });
+    runner.run_items("TerminalInput/Encode cursor keys with modifiers", keyCount, [&]() { encode(modifiedKeys); });
+
+    terminalInput.ChangeWin32InputMode(true);
+    runner.run_items("TerminalInput/Encode win32-input-mode", keyCount, [&]() { encode(typed); });
+
+    StateMachine stateMachine{ std::make_unique<InputStateMachineEngine>(std::make_unique<NullInteractDispatch>()) };
+
+    const auto cursorSequences = repeat(L"\x1b[A\x1b[B\x1b[C\x1b[D");
+    const auto modifiedSequences = repeat(L"\x1b[1;6A\x1b[1;6B\x1b[3;6~\x1b[15;6~");
+    const auto win32Sequences = repeat(L"\x1b[72;35;104;1;0;1_\x1b[72;35;104;0;0;1_");
+    const auto mouseSequences = repeat(L"\x1b[<35;120;40M\x1b[<0;121;40M");
+
+    runner.run_items("InputStateMachineEngine/Decode cursor keys", keyCount * 4, [&]() { stateMachine.ProcessString(cursorSequences); });
+    runner.run_items("InputStateMachineEngine/Decode cursor keys with modifiers", keyCount * 4, [&]() { stateMachine.ProcessString(modifiedSequences); });
+    runner.run_items("InputStateMachineEngine/Decode win32-input-mode", keyCount * 2, [&]() { stateMachine.ProcessString(win32Sequences); });
+    runner.run_items("InputStateMachineEngine/Decode SGR mouse events", keyCount * 2, [&]() { stateMachine.ProcessString(mouseSequences); });
+}
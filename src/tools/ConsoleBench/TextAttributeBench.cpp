@@ -0,0 +1,111 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "bench.hpp"
+
+#include "../../buffer/out/textBuffer.hpp"
+#include "../../renderer/inc/DummyRenderTarget.hpp"
+
+namespace
+{
+    constexpr SHORT width = 120;
+    constexpr SHORT height = 30;
+
+    // Produces the kind of attributes "rainbow" output generates:
+    // A different 256-color or RGB foreground for every cell, with
+    // some of the cells being bold or underlined.
+    std::vector<TextAttribute> makeRainbowAttributes(const size_t count)
+    {
+        std::vector<TextAttribute> attrs;
+        attrs.reserve(count);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            TextAttribute attr;
+            if (i & 1)
+            {
+                attr.SetIndexedForeground256(gsl::narrow_cast<BYTE>(i));
+            }
+            else
+            {
+                attr.SetForeground(RGB(i * 7, i * 13, i * 17));
+            }
+            attr.SetIndexedBackground(gsl::narrow_cast<BYTE>(i % 8));
+            attr.SetBold(i % 3 == 0);
+            attr.SetUnderlined(i % 5 == 0);
+            attrs.emplace_back(attr);
+        }
+
+        return attrs;
+    }
+}
+
+void RunTextAttributeBenchmarks(bench::runner& runner)
+{
+    const auto attrs = makeRainbowAttributes(4096);
+
+    runner.run("TextAttribute/operator== (4096 adjacent pairs)", 0, [&]() {
+        size_t runs = 0;
+        for (size_t i = 1; i < attrs.size(); ++i)
+        {
+            runs += attrs[i] != attrs[i - 1];
+        }
+        bench::do_not_optimize(runs);
+    });
+
+    runner.run("TextAttribute/HasIdenticalVisualRepresentationForBlankSpace (4096 pairs)", 0, [&]() {
+        size_t identical = 0;
+        for (size_t i = 1; i < attrs.size(); ++i)
+        {
+            identical += attrs[i].HasIdenticalVisualRepresentationForBlankSpace(attrs[i - 1]);
+        }
+        bench::do_not_optimize(identical);
+    });
+
+    runner.run("ATTR_ROW/Replace SGR-per-cell (120 columns)", 0, [&]() {
+        ATTR_ROW row{ width, TextAttribute{} };
+        for (uint16_t col = 0; col < width; ++col)
+        {
+            row.Replace(col, gsl::narrow_cast<uint16_t>(col + 1), attrs[col]);
+        }
+        bench::do_not_optimize(row);
+    });
+
+    DummyRenderTarget renderTarget;
+    TextBuffer buffer{ { width, height }, TextAttribute{}, 0, renderTarget };
+
+    std::vector<OutputCell> cells;
+    cells.reserve(width);
+    for (SHORT col = 0; col < width; ++col)
+    {
+        cells.emplace_back(L"#", DbcsAttribute{}, attrs[col]);
+    }
+
+    runner.run("TextBuffer/WriteLine SGR-per-cell (120x30)", width * height * sizeof(wchar_t), [&]() {
+        for (SHORT row = 0; row < height; ++row)
+        {
+            buffer.WriteLine(OutputCellIterator{ gsl::make_span(cells) }, { 0, row });
+        }
+    });
+
+    // This mimics how the renderer splits a row into runs of identical attributes.
+    runner.run("TextBuffer/attribute runs SGR-per-cell (120x30)", width * height * sizeof(wchar_t), [&]() {
+        size_t runs = 0;
+        for (SHORT row = 0; row < height; ++row)
+        {
+            auto it = buffer.GetCellLineDataAt({ 0, row });
+            auto last = it->TextAttr();
+            for (; it; ++it)
+            {
+                const auto attr = it->TextAttr();
+                if (attr != last)
+                {
+                    last = attr;
+                    ++runs;
+                }
+            }
+        }
+        bench::do_not_optimize(runs);
+    });
+}
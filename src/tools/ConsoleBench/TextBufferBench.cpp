@@ -0,0 +1,139 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "bench.hpp"
+
+#include "../../buffer/out/textBuffer.hpp"
+#include "../../renderer/inc/DummyRenderTarget.hpp"
+
+using namespace Microsoft::Console::Types;
+
+void RunTextBufferBenchmarks(bench::runner& runner)
+{
+    static constexpr SHORT width = 120;
+    static constexpr SHORT height = 30000;
+
+    DummyRenderTarget renderTarget;
+    TextBuffer buffer{ { width, height }, TextAttribute{}, 0, renderTarget };
+
+    // A tall, mostly empty buffer: Only the first screen contains any text.
+    for (SHORT row = 0; row < 30; ++row)
+    {
+        buffer.WriteLine(OutputCellIterator{ L"C:\\Users\\bench> dir /s /b" }, { 0, row });
+    }
+
+    runner.run("TextBuffer/GetLastNonSpaceCharacter (120x30000, 30 rows of text)", 0, [&]() {
+        bench::do_not_optimize(buffer.GetLastNonSpaceCharacter());
+    });
+
+    // Fill every row, so that GetLastNonSpaceCharacter() returns immediately,
+    // but MeasureRight() has to scan the trailing whitespace of each row.
+    for (SHORT row = 0; row < height; ++row)
+    {
+        buffer.WriteLine(OutputCellIterator{ L"text" }, { 0, row });
+    }
+
+    runner.run("CharRow/MeasureRight (120x30000, short lines)", 0, [&]() {
+        size_t sum = 0;
+        for (SHORT row = 0; row < height; ++row)
+        {
+            sum += buffer.GetRowByOffset(row).GetCharRow().MeasureRight();
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    // Word navigation over long lines of prose, as done by screen readers and double clicks.
+    static constexpr std::wstring_view wordDelimiters{ L" /\\()\"'-.,:;<>~!@#$%^&*|+=[]{}~?\u2502" };
+    std::wstring line;
+    while (line.size() < width)
+    {
+        line.append(L"lorem ipsum, dolor sit amet. ");
+    }
+    line.resize(width);
+    for (SHORT row = 0; row < 100; ++row)
+    {
+        buffer.WriteLine(OutputCellIterator{ line }, { 0, row });
+    }
+
+    runner.run("TextBuffer/MoveToNextWord (100 rows of prose)", 0, [&]() {
+        const COORD lastCharPos{ width - 1, 99 };
+        COORD pos{ 0, 0 };
+        size_t words = 0;
+        while (buffer.MoveToNextWord(pos, wordDelimiters, lastCharPos))
+        {
+            ++words;
+        }
+        bench::do_not_optimize(words);
+    });
+
+    runner.run("TextBuffer/GetWordStart+GetWordEnd (every cell of a row)", 0, [&]() {
+        for (SHORT col = 0; col < width; ++col)
+        {
+            bench::do_not_optimize(buffer.GetWordStart({ col, 50 }, wordDelimiters));
+            bench::do_not_optimize(buffer.GetWordEnd({ col, 50 }, wordDelimiters));
+        }
+    });
+
+    // ED 3 with a full scrollback. Since the erased rows are reset lazily, this should
+    // only depend on the viewport height. The first write into the scrollback afterwards
+    // pays for resetting the one row it touches.
+    runner.run("TextBuffer/ClearScrollback (120x30000, 30 row viewport)", 0, [&]() {
+        buffer.WriteLine(OutputCellIterator{ line }, { 0, height - 31 });
+        buffer.ClearScrollback(height - 30, 30, TextAttribute{});
+    });
+
+    // Scrolling a region that doesn't span the entire width, like a split pane in a
+    // TUI, and shifting the rest of a row over like ICH/DCH. The cell by cell copy
+    // is how these were done before CopyRectangle() and serves as the baseline.
+    for (SHORT row = 0; row < 30; ++row)
+    {
+        buffer.WriteLine(OutputCellIterator{ line }, { 0, row });
+    }
+
+    const auto region = Viewport::FromDimensions({ 20, 1 }, { 80, 28 });
+    const COORD regionTarget{ 20, 0 };
+
+    runner.run("TextBuffer/CopyRectangle (80x28 region, up by one row)", 0, [&]() {
+        buffer.CopyRectangle(region, regionTarget);
+    });
+
+    runner.run("TextBuffer/cell by cell copy (80x28 region, up by one row)", 0, [&]() {
+        const auto target = Viewport::FromDimensions(regionTarget, region.Dimensions());
+        const auto walkDirection = Viewport::DetermineWalkDirection(region, target);
+        auto sourcePos = region.GetWalkOrigin(walkDirection);
+        auto targetPos = target.GetWalkOrigin(walkDirection);
+        do
+        {
+            const auto data = OutputCell(*buffer.GetCellDataAt(sourcePos));
+            buffer.Write(OutputCellIterator({ &data, 1 }), targetPos);
+            region.WalkInBounds(sourcePos, walkDirection);
+        } while (target.WalkInBounds(targetPos, walkDirection));
+    });
+
+    runner.run("TextBuffer/CopyRectangle (30 rows, right by one column)", 0, [&]() {
+        for (SHORT row = 0; row < 30; ++row)
+        {
+            buffer.CopyRectangle(Viewport::FromDimensions({ 10, row }, { width - 11, 1 }), { 11, row });
+        }
+    });
+
+    // Erasing a large screen, as done by every frame of `watch` or `top`.
+    // Writing a repeated cell row by row is how this was done before FillRectangle().
+    {
+        static constexpr SHORT screenWidth = 300;
+        static constexpr SHORT screenHeight = 80;
+
+        TextBuffer screen{ { screenWidth, screenHeight }, TextAttribute{}, 0, renderTarget };
+        const auto fullScreen = screen.GetSize();
+        const TextAttribute eraseAttributes{ 0x17 };
+
+        runner.run("TextBuffer/FillRectangle (300x80)", 0, [&]() {
+            screen.FillRectangle(fullScreen, L' ', eraseAttributes);
+        });
+
+        runner.run("TextBuffer/Write repeated cell (300x80)", 0, [&]() {
+            screen.Write(OutputCellIterator{ L' ', eraseAttributes, screenWidth * screenHeight }, { 0, 0 }, false);
+        });
+    }
+}
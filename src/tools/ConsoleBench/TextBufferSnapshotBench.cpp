@@ -0,0 +1,54 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "bench.hpp"
+
+#include "../../buffer/out/textBufferSnapshot.hpp"
+#include "../../renderer/inc/DummyRenderTarget.hpp"
+
+void RunTextBufferSnapshotBenchmarks(bench::runner& runner)
+{
+    static constexpr SHORT width = 120;
+    static constexpr SHORT height = 30000;
+
+    DummyRenderTarget renderTarget;
+    TextBuffer buffer{ { width, height }, TextAttribute{}, 0, renderTarget };
+
+    // A full scrollback of typical build output: lines of varying
+    // length with the occasional colored warning in between.
+    const TextAttribute warning{ FOREGROUND_RED | FOREGROUND_GREEN };
+    for (SHORT row = 0; row < height; ++row)
+    {
+        const auto line = fmt::format(L"[{:5}/30000] Compiling src\\buffer\\out\\textBuffer{}.cpp", row, std::wstring(row % 40, L'_'));
+        buffer.WriteLine(OutputCellIterator{ line }, { 0, row });
+        if (row % 50 == 0)
+        {
+            buffer.WriteLine(OutputCellIterator{ L"warning", warning }, { 0, row });
+        }
+    }
+
+    // The throughput of all benchmarks below is relative to the size of the snapshot.
+    const auto snapshot = TextBufferSnapshot::Save(buffer);
+
+    runner.run("TextBufferSnapshot/Save (120x30000)", snapshot.size(), [&]() {
+        bench::do_not_optimize(TextBufferSnapshot::Save(buffer));
+    });
+
+    TextBuffer restored{ { width, height }, TextAttribute{}, 0, renderTarget };
+
+    runner.run("TextBufferSnapshot/Load (120x30000)", snapshot.size(), [&]() {
+        TextBufferSnapshot::Load(snapshot, restored);
+    });
+
+    std::wstring path(MAX_PATH, L'\0');
+    path.resize(GetTempPathW(gsl::narrow<DWORD>(path.size()), path.data()));
+    path.append(L"ConsoleBench.snapshot");
+    TextBufferSnapshot::SaveToFile(snapshot, path);
+
+    runner.run("TextBufferSnapshot/LoadFromFile (120x30000)", snapshot.size(), [&]() {
+        TextBufferSnapshot::LoadFromFile(path, restored);
+    });
+
+    DeleteFileW(path.c_str());
+}
@@ -0,0 +1,804 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "bench.hpp"
+
+#include "../../buffer/out/textBuffer.hpp"
+#include "../../cascadia/TerminalCore/Terminal.hpp"
+#include "../../renderer/inc/DummyRenderTarget.hpp"
+#include "../../terminal/adapter/adaptDispatch.hpp"
+#include "../../terminal/parser/OutputStateMachineEngine.hpp"
+#include "../../terminal/parser/stateMachine.hpp"
+#include "../../types/inc/Viewport.hpp"
+
+using namespace Microsoft::Console::Types;
+using namespace Microsoft::Console::VirtualTerminal;
+using Microsoft::Terminal::Core::Terminal;
+
+namespace
+{
+    // The size of a default conhost window and buffer.
+    constexpr SHORT viewportWidth = 120;
+    constexpr SHORT viewportHeight = 30;
+    constexpr SHORT scrollbackHeight = 9001 - viewportHeight;
+
+    // A model of conhost's SCREEN_INFORMATION, which allows us to run AdaptDispatch
+    // on a real TextBuffer without the rest of the host. It is not the host: Its
+    // numbers are those of the parser, AdaptDispatch and TextBuffer, plus whatever
+    // this model costs. The host itself is measured through WriteConsole below.
+    // Like a conhost buffer that has been filled once, the viewport sits at the
+    // bottom of the buffer and output that scrolls off of it circles the buffer.
+    // Scrolling is implemented like conhost's ScrollRegion: Entire rows are
+    // rotated with ScrollRows() and anything else is copied with CopyRectangle().
+    class ModelScreenBuffer
+    {
+    public:
+        ModelScreenBuffer() :
+            _buffer{ { viewportWidth, viewportHeight + scrollbackHeight }, TextAttribute{}, 12, _renderTarget },
+            _viewport{ Viewport::FromDimensions({ 0, scrollbackHeight }, { viewportWidth, viewportHeight }) }
+        {
+            _buffer.GetCursor().SetPosition(_viewport.Origin());
+        }
+
+        TextBuffer& GetTextBuffer() noexcept
+        {
+            return _buffer;
+        }
+
+        const Viewport& GetViewport() const noexcept
+        {
+            return _viewport;
+        }
+
+        void SetAutoWrapMode(const bool wrapAtEOL) noexcept
+        {
+            _autoWrap = wrapAtEOL;
+        }
+
+        void SetScrollMargins(const SMALL_RECT& scrollMargins) noexcept
+        {
+            _margins = scrollMargins;
+        }
+
+        // Writes the string at the cursor position and advances the cursor,
+        // wrapping to the next line when a row is full. Without autowrap the
+        // rest of the line is discarded instead of overwriting the last column.
+        void Print(std::wstring_view string)
+        {
+            auto& cursor = _buffer.GetCursor();
+
+            while (!string.empty())
+            {
+                if (cursor.IsDelayedEOLWrap())
+                {
+                    if (!_autoWrap)
+                    {
+                        break;
+                    }
+
+                    _buffer.GetRowByOffset(cursor.GetPosition().Y).SetWrapForced(true);
+                    _NewLine(true);
+                }
+
+                const auto position = cursor.GetPosition();
+                const OutputCellIterator it{ string, _buffer.GetCurrentAttributes() };
+                const auto end = _buffer.WriteLine(it, position);
+                const auto cellDistance = end.GetCellDistance(it);
+                const auto inputDistance = end.GetInputDistance(it);
+
+                if (inputDistance == 0)
+                {
+                    // A wide glyph didn't fit into the remaining columns.
+                    cursor.DelayEOLWrap(position);
+                    continue;
+                }
+
+                string = string.substr(inputDistance);
+
+                const auto column = gsl::narrow_cast<SHORT>(position.X + cellDistance);
+                if (column >= viewportWidth)
+                {
+                    cursor.SetPosition({ viewportWidth - 1, position.Y });
+                    cursor.DelayEOLWrap(cursor.GetPosition());
+                }
+                else
+                {
+                    cursor.SetPosition({ column, position.Y });
+                }
+            }
+        }
+
+        void LineFeed(const bool withReturn)
+        {
+            _buffer.GetRowByOffset(_buffer.GetCursor().GetPosition().Y).SetWrapForced(false);
+            _NewLine(withReturn);
+        }
+
+        void ReverseLineFeed()
+        {
+            auto& cursor = _buffer.GetCursor();
+            auto position = cursor.GetPosition();
+            const auto [top, bottom] = _GetScrollBounds(position.Y);
+
+            if (position.Y == top)
+            {
+                ScrollRegion({ 0, top, viewportWidth - 1, bottom }, SMALL_RECT{ 0, top, viewportWidth - 1, bottom }, { 0, gsl::narrow_cast<SHORT>(top + 1) }, true);
+            }
+            else if (position.Y > _viewport.Top())
+            {
+                position.Y--;
+            }
+
+            cursor.SetPosition(position);
+        }
+
+        // Inserts (or deletes) lines at the cursor position by scrolling the rest of the margins.
+        void ModifyLines(const size_t count, const bool insert)
+        {
+            const auto position = _buffer.GetCursor().GetPosition();
+            const auto [top, bottom] = _GetScrollBounds(position.Y);
+            if (position.Y < top || position.Y > bottom)
+            {
+                return;
+            }
+
+            const SMALL_RECT scrollRect{ 0, position.Y, viewportWidth - 1, bottom };
+            const auto delta = gsl::narrow_cast<SHORT>(std::min<size_t>(count, viewportHeight));
+            const COORD destination{ 0, gsl::narrow_cast<SHORT>(insert ? position.Y + delta : position.Y - delta) };
+            ScrollRegion(scrollRect, scrollRect, destination, true);
+
+            _buffer.GetCursor().SetPosition({ 0, position.Y });
+        }
+
+        void FillRegion(const COORD startPosition, const size_t fillLength, const wchar_t fillChar, const bool standardFillAttrs)
+        {
+            const auto fillAttributes = _GetFillAttributes(standardFillAttrs);
+            const auto bufferSize = _buffer.GetSize();
+            auto spanStart = startPosition;
+            auto remaining = fillLength;
+            while (remaining > 0 && spanStart.Y < bufferSize.BottomExclusive())
+            {
+                const auto spanLength = std::min<size_t>(remaining, bufferSize.RightExclusive() - spanStart.X);
+                _buffer.FillRectangle(Viewport::FromDimensions(spanStart, gsl::narrow_cast<SHORT>(spanLength), 1), fillChar, fillAttributes);
+                remaining -= spanLength;
+                spanStart = { 0, gsl::narrow_cast<SHORT>(spanStart.Y + 1) };
+            }
+        }
+
+        // Moves the scrollRect to the destination, limited to the clipRect, and fills the uncovered cells.
+        void ScrollRegion(const SMALL_RECT scrollRect, const std::optional<SMALL_RECT> clipRect, const COORD destination, const bool standardFillAttrs)
+        {
+            const auto bufferSize = _buffer.GetSize();
+
+            const auto originalSource = Viewport::FromInclusive(scrollRect);
+            auto source = Viewport::Intersect(originalSource, bufferSize);
+            const auto clip = Viewport::Intersect(bufferSize, Viewport::FromInclusive(clipRect.value_or(bufferSize.ToInclusive())));
+            const auto fill = Viewport::Intersect(clip, source);
+            if (!source.IsValid() || !fill.IsValid())
+            {
+                return;
+            }
+
+            auto target = Viewport::FromDimensions({ gsl::narrow_cast<SHORT>(destination.X + source.Left() - originalSource.Left()),
+                                                     gsl::narrow_cast<SHORT>(destination.Y + source.Top() - originalSource.Top()) },
+                                                   source.Dimensions());
+            const auto unclippedTargetOrigin = target.Origin();
+            target = Viewport::Intersect(clip, target);
+            source = Viewport::FromDimensions({ gsl::narrow_cast<SHORT>(source.Left() + target.Left() - unclippedTargetOrigin.X),
+                                                gsl::narrow_cast<SHORT>(source.Top() + target.Top() - unclippedTargetOrigin.Y) },
+                                              target.Dimensions());
+
+            if (target.IsValid())
+            {
+                _CopyRectangle(source, target.Origin());
+            }
+
+            const auto fillAttributes = _GetFillAttributes(standardFillAttrs);
+            for (const auto& area : Viewport::Subtract(fill, target))
+            {
+                _buffer.FillRectangle(area, L' ', fillAttributes);
+            }
+        }
+
+        // Pushes the contents of the viewport into the scrollback.
+        void EraseAll()
+        {
+            for (auto row = 0; row < viewportHeight; ++row)
+            {
+                _buffer.IncrementCircularBuffer(true);
+            }
+        }
+
+    private:
+        TextAttribute _GetFillAttributes(const bool standardFillAttrs) const noexcept
+        {
+            auto fillAttributes = TextAttribute{};
+            if (standardFillAttrs)
+            {
+                fillAttributes = _buffer.GetCurrentAttributes();
+                fillAttributes.SetStandardErase();
+            }
+            return fillAttributes;
+        }
+
+        // Returns the first and last row (inclusive) that a line feed on the given row scrolls.
+        std::pair<SHORT, SHORT> _GetScrollBounds(const SHORT row) const noexcept
+        {
+            const auto marginTop = gsl::narrow_cast<SHORT>(_viewport.Top() + _margins.Top);
+            const auto marginBottom = gsl::narrow_cast<SHORT>(_viewport.Top() + _margins.Bottom);
+            if (_margins.Bottom > _margins.Top && row >= marginTop && row <= marginBottom)
+            {
+                return { marginTop, marginBottom };
+            }
+            return { _viewport.Top(), _viewport.BottomInclusive() };
+        }
+
+        void _NewLine(const bool withReturn)
+        {
+            auto& cursor = _buffer.GetCursor();
+            auto position = cursor.GetPosition();
+            const auto [top, bottom] = _GetScrollBounds(position.Y);
+
+            if (withReturn)
+            {
+                position.X = 0;
+            }
+
+            if (position.Y != bottom)
+            {
+                position.Y = std::min<SHORT>(position.Y + 1, _viewport.BottomInclusive());
+            }
+            else if (top == _viewport.Top() && bottom == _viewport.BottomInclusive())
+            {
+                // Scrolling the entire viewport moves its top row into the scrollback.
+                _buffer.IncrementCircularBuffer(true);
+            }
+            else
+            {
+                ScrollRegion({ 0, top, viewportWidth - 1, bottom }, SMALL_RECT{ 0, top, viewportWidth - 1, bottom }, { 0, gsl::narrow_cast<SHORT>(top - 1) }, true);
+            }
+
+            cursor.SetPosition(position);
+        }
+
+        void _CopyRectangle(const Viewport& source, const COORD targetOrigin)
+        {
+            if (source.Origin() == targetOrigin)
+            {
+                return;
+            }
+
+            if (source.Width() == _buffer.GetSize().Width() && targetOrigin.X == 0)
+            {
+                _buffer.ScrollRows(source.Top(), source.Height(), gsl::narrow_cast<SHORT>(targetOrigin.Y - source.Top()));
+                return;
+            }
+
+            _buffer.CopyRectangle(source, targetOrigin);
+        }
+
+        DummyRenderTarget _renderTarget;
+        TextBuffer _buffer;
+        Viewport _viewport;
+        SMALL_RECT _margins{};
+        bool _autoWrap = true;
+    };
+
+    class ModelDefaults final : public AdaptDefaults
+    {
+    public:
+        explicit ModelDefaults(ModelScreenBuffer& console) noexcept :
+            _console{ console }
+        {
+        }
+
+        void Print(const wchar_t wch) override
+        {
+            _console.Print({ &wch, 1 });
+        }
+
+        void PrintString(const std::wstring_view string) override
+        {
+            _console.Print(string);
+        }
+
+        void Execute(const wchar_t /*wch*/) noexcept override
+        {
+        }
+
+    private:
+        ModelScreenBuffer& _console;
+    };
+
+    // Implements the output related parts of ConGetSet on top of the ModelScreenBuffer,
+    // in place of conhost's ConhostInternalGetSet.
+    // Everything that would need a window, an input queue or the alt buffer is refused.
+    class ModelGetSet final : public ConGetSet
+    {
+    public:
+        explicit ModelGetSet(ModelScreenBuffer& console) noexcept :
+            _console{ console },
+            _buffer{ console.GetTextBuffer() }
+        {
+        }
+
+        bool GetConsoleScreenBufferInfoEx(CONSOLE_SCREEN_BUFFER_INFOEX& screenBufferInfo) const override
+        {
+            screenBufferInfo.dwSize = _buffer.GetSize().Dimensions();
+            screenBufferInfo.dwCursorPosition = _buffer.GetCursor().GetPosition();
+            screenBufferInfo.srWindow = _console.GetViewport().ToExclusive();
+            screenBufferInfo.dwMaximumWindowSize = _console.GetViewport().Dimensions();
+            screenBufferInfo.wAttributes = _buffer.GetCurrentAttributes().GetLegacyAttributes();
+            return true;
+        }
+
+        bool PrivateGetScreenBufferState(ScreenBufferState& state) const override
+        {
+            state.cursorPosition = _buffer.GetCursor().GetPosition();
+            state.viewport = _console.GetViewport().ToExclusive();
+            state.bufferSize = _buffer.GetSize().Dimensions();
+            return true;
+        }
+
+        bool SetConsoleScreenBufferInfoEx(const CONSOLE_SCREEN_BUFFER_INFOEX& /*screenBufferInfo*/) noexcept override { return false; }
+
+        bool SetConsoleCursorPosition(const COORD position) override
+        {
+            _buffer.GetCursor().SetPosition(_buffer.ClampPositionWithinLine(position));
+            return true;
+        }
+
+        bool PrivateIsVtInputEnabled() const noexcept override { return false; }
+
+        bool PrivateGetTextAttributes(TextAttribute& attrs) const override
+        {
+            attrs = _buffer.GetCurrentAttributes();
+            return true;
+        }
+
+        bool PrivateSetTextAttributes(const TextAttribute& attrs) override
+        {
+            _buffer.SetCurrentAttributes(attrs);
+            return true;
+        }
+
+        bool PrivateSetCurrentLineRendition(const LineRendition lineRendition) override
+        {
+            _buffer.SetCurrentLineRendition(lineRendition);
+            return true;
+        }
+
+        bool PrivateResetLineRenditionRange(const size_t startRow, const size_t endRow) override
+        {
+            _buffer.ResetLineRenditionRange(startRow, endRow);
+            return true;
+        }
+
+        SHORT PrivateGetLineWidth(const size_t row) const override
+        {
+            return _buffer.GetLineWidth(row);
+        }
+
+        bool PrivateWriteConsoleInputW(const gsl::span<const INPUT_RECORD> /*events*/, size_t& eventsWritten) noexcept override
+        {
+            eventsWritten = 0;
+            return true;
+        }
+
+        bool SetConsoleWindowInfo(const bool /*absolute*/, const SMALL_RECT& /*window*/) noexcept override { return false; }
+        bool PrivateSetCursorKeysMode(const bool /*applicationMode*/) noexcept override { return true; }
+        bool PrivateSetKeypadMode(const bool /*applicationMode*/) noexcept override { return true; }
+        bool PrivateEnableWin32InputMode(const bool /*win32InputMode*/) noexcept override { return true; }
+        bool PrivateSetAnsiMode(const bool /*ansiMode*/) noexcept override { return true; }
+        bool PrivateSetScreenMode(const bool /*reverseMode*/) noexcept override { return true; }
+
+        bool PrivateSetAutoWrapMode(const bool wrapAtEOL) noexcept override
+        {
+            _console.SetAutoWrapMode(wrapAtEOL);
+            return true;
+        }
+
+        bool PrivateShowCursor(const bool show) noexcept override
+        {
+            _buffer.GetCursor().SetIsVisible(show);
+            return true;
+        }
+
+        bool PrivateAllowCursorBlinking(const bool enable) noexcept override
+        {
+            _buffer.GetCursor().SetBlinkingAllowed(enable);
+            return true;
+        }
+
+        bool PrivateSetScrollingRegion(const SMALL_RECT& scrollMargins) noexcept override
+        {
+            if (scrollMargins.Top > scrollMargins.Bottom)
+            {
+                return false;
+            }
+            _console.SetScrollMargins(scrollMargins);
+            return true;
+        }
+
+        bool PrivateWarningBell() noexcept override { return true; }
+        bool PrivateGetLineFeedMode() const noexcept override { return false; }
+
+        bool PrivateLineFeed(const bool withReturn) override
+        {
+            _console.LineFeed(withReturn);
+            return true;
+        }
+
+        bool PrivateReverseLineFeed() override
+        {
+            _console.ReverseLineFeed();
+            return true;
+        }
+
+        bool SetConsoleTitleW(const std::wstring_view /*title*/) noexcept override { return true; }
+        bool PrivateUseAlternateScreenBuffer() noexcept override { return false; }
+        bool PrivateUseMainScreenBuffer() noexcept override { return false; }
+
+        bool PrivateEnableVT200MouseMode(const bool /*enabled*/) noexcept override { return true; }
+        bool PrivateEnableUTF8ExtendedMouseMode(const bool /*enabled*/) noexcept override { return true; }
+        bool PrivateEnableSGRExtendedMouseMode(const bool /*enabled*/) noexcept override { return true; }
+        bool PrivateEnableButtonEventMouseMode(const bool /*enabled*/) noexcept override { return true; }
+        bool PrivateEnableAnyEventMouseMode(const bool /*enabled*/) noexcept override { return true; }
+        bool PrivateEnableAlternateScroll(const bool /*enabled*/) noexcept override { return true; }
+
+        bool PrivateEraseAll() override
+        {
+            _console.EraseAll();
+            return true;
+        }
+
+        bool GetUserDefaultCursorStyle(CursorType& style) noexcept override
+        {
+            style = CursorType::Legacy;
+            return true;
+        }
+
+        bool SetCursorStyle(const CursorType /*style*/) noexcept override { return true; }
+        bool SetCursorColor(const COLORREF /*color*/) noexcept override { return true; }
+        bool PrivateWriteConsoleControlInput(const KeyEvent /*key*/) noexcept override { return true; }
+        bool PrivateRefreshWindow() noexcept override { return true; }
+
+        bool SetConsoleOutputCP(const unsigned int /*codepage*/) noexcept override { return true; }
+
+        bool GetConsoleOutputCP(unsigned int& codepage) noexcept override
+        {
+            codepage = CP_UTF8;
+            return true;
+        }
+
+        bool PrivateSuppressResizeRepaint() noexcept override { return true; }
+        bool IsConsolePty() const noexcept override { return false; }
+
+        bool DeleteLines(const size_t count) override
+        {
+            _console.ModifyLines(count, false);
+            return true;
+        }
+
+        bool InsertLines(const size_t count) override
+        {
+            _console.ModifyLines(count, true);
+            return true;
+        }
+
+        bool MoveToBottom() const noexcept override { return true; }
+
+        bool PrivateGetColorTableEntry(const size_t /*index*/, COLORREF& value) const noexcept override
+        {
+            value = 0;
+            return true;
+        }
+
+        bool PrivateSetColorTableEntry(const size_t /*index*/, const COLORREF /*value*/) const noexcept override { return true; }
+        bool PrivateSetDefaultForeground(const COLORREF /*value*/) const noexcept override { return true; }
+        bool PrivateSetDefaultBackground(const COLORREF /*value*/) const noexcept override { return true; }
+
+        bool PrivateFillRegion(const COORD startPosition, const size_t fillLength, const wchar_t fillChar, const bool standardFillAttrs) override
+        {
+            _console.FillRegion(startPosition, fillLength, fillChar, standardFillAttrs);
+            return true;
+        }
+
+        bool PrivateScrollRegion(const SMALL_RECT scrollRect, const std::optional<SMALL_RECT> clipRect, const COORD destinationOrigin, const bool standardFillAttrs) override
+        {
+            _console.ScrollRegion(scrollRect, clipRect, destinationOrigin, standardFillAttrs);
+            return true;
+        }
+
+        bool PrivateClearScrollback(const SHORT /*viewportTop*/, const SHORT /*viewportHeight*/) noexcept override { return false; }
+
+        bool PrivateAddHyperlink(const std::wstring_view uri, const std::wstring_view params) const override
+        {
+            auto attr = _buffer.GetCurrentAttributes();
+            const auto id = _buffer.GetHyperlinkId(uri, params);
+            attr.SetHyperlinkId(id);
+            _buffer.SetCurrentAttributes(attr);
+            _buffer.AddHyperlinkToMap(uri, id);
+            return true;
+        }
+
+        bool PrivateEndHyperlink() const override
+        {
+            auto attr = _buffer.GetCurrentAttributes();
+            attr.SetHyperlinkId(0);
+            _buffer.SetCurrentAttributes(attr);
+            return true;
+        }
+
+    private:
+        ModelScreenBuffer& _console;
+        TextBuffer& _buffer;
+    };
+
+    struct corpus
+    {
+        std::string name;
+        std::string utf8;
+    };
+
+    // Synthetic stand-ins for recordings of typical terminal output.
+    // They're generated deterministically, so that results are comparable across runs.
+    std::vector<corpus> GenerateCorpora()
+    {
+        static constexpr size_t lines = 4096;
+        std::vector<corpus> corpora;
+
+        const auto add = [&](const char* name, const std::wstring& text) {
+            corpora.push_back({ name, til::u16u8(text) });
+        };
+
+        // A plain log file, like the output of `cat` or `tail -f`.
+        std::wstring log;
+        for (size_t i = 0; i < lines; ++i)
+        {
+            fmt::format_to(std::back_inserter(log), L"2021-04-{:02}T12:{:02}:{:02}.{:03}Z INFO [worker-{}] processed request {} in {}ms\r\n", i % 30 + 1, i % 60, i * 7 % 60, i * 13 % 1000, i % 8, i * 7919, i % 97);
+        }
+        add("plain log", log);
+
+        // `ls --color` with the default dircolors: A couple of colored entries per line.
+        std::wstring ls;
+        static constexpr std::wstring_view colors[]{ L"01;34", L"01;32", L"01;36", L"00", L"01;31", L"40;33;01" };
+        for (size_t i = 0; i < lines; ++i)
+        {
+            for (size_t j = 0; j < 4; ++j)
+            {
+                fmt::format_to(std::back_inserter(ls), L"\x1b[0m\x1b[{}mentry_{:05}\x1b[0m{:>16}", colors[(i + j) % std::size(colors)], i * 4 + j, L"");
+            }
+            ls.append(L"\r\n");
+        }
+        add("ls --color", ls);
+
+        // Compiler diagnostics, where each file name is a hyperlink (OSC 8).
+        std::wstring compiler;
+        for (size_t i = 0; i < lines / 4; ++i)
+        {
+            fmt::format_to(std::back_inserter(compiler),
+                           L"\x1b]8;;file:///C:/src/project/module{0}/source{1}.cpp\x1b\\src\\module{0}\\source{1}.cpp({2},{3})\x1b]8;;\x1b\\: "
+                           L"\x1b[1;{4}m{5}\x1b[0m C{6}: '\x1b[1mvalue{1}\x1b[0m': undeclared identifier\r\n"
+                           L"    {2:5} | auto result = value{1} + offset;\r\n"
+                           L"          | \x1b[32m              ^~~~~~{7}\x1b[0m\r\n",
+                           i % 17, i, i * 31 % 2000 + 1, i % 40 + 1, i % 3 ? 35 : 31, i % 3 ? L"warning" : L"error", 2000 + i % 900, std::wstring(i % 6, L'~'));
+        }
+        add("compiler output with hyperlinks", compiler);
+
+        // A vim redraw: The whole screen is repainted line by line, followed
+        // by scrolling the text area (without the status line) by one line.
+        std::wstring vim;
+        for (size_t frame = 0; frame < 64; ++frame)
+        {
+            vim.append(L"\x1b[?25l");
+            for (SHORT row = 1; row < viewportHeight; ++row)
+            {
+                fmt::format_to(std::back_inserter(vim), L"\x1b[{};1H\x1b[33m{:4} \x1b[m\x1b[38;5;{}mif\x1b[m (value{} \x1b[1m==\x1b[m \x1b[31m\"string {}\"\x1b[m) {{\x1b[K", row, frame + row, 130 + row % 8, row, frame);
+            }
+            fmt::format_to(std::back_inserter(vim), L"\x1b[{};1H\x1b[7m  NORMAL  file{}.cpp [+]{:>80}{},1  Top\x1b[m", viewportHeight, frame, L"", frame);
+            fmt::format_to(std::back_inserter(vim), L"\x1b[1;{}r\x1b[{};1H\n\x1b[r\x1b[{};1H\x1b[33m{:4} \x1b[mnew line{}\x1b[K\x1b[?25h", viewportHeight - 1, viewportHeight - 1, viewportHeight - 1, frame, frame);
+        }
+        add("vim redraw", vim);
+
+        // tmux: Output scrolls inside of a scrolling region above the status line,
+        // which is updated every couple of lines with the cursor saved and restored.
+        std::wstring tmux;
+        fmt::format_to(std::back_inserter(tmux), L"\x1b[1;{}r\x1b[{};1H", viewportHeight - 1, viewportHeight - 1);
+        for (size_t i = 0; i < lines; ++i)
+        {
+            fmt::format_to(std::back_inserter(tmux), L"\r\n$ make -j8 target{}\x1b[K", i);
+            if (i % 8 == 0)
+            {
+                fmt::format_to(std::back_inserter(tmux), L"\x1b" L"7\x1b[{};1H\x1b[30;42m[0] 0:bash* 1:vim-  \"host\" 12:{:02} 18-Oct-26\x1b[K\x1b[m\x1b" L"8", viewportHeight, i % 60);
+            }
+        }
+        tmux.append(L"\x1b[r");
+        add("tmux redraw", tmux);
+
+        // Emoji and CJK text, which is mostly made up of wide glyphs and surrogate pairs.
+        std::wstring international;
+        for (size_t i = 0; i < lines; ++i)
+        {
+            fmt::format_to(std::back_inserter(international), L"{:4} \x65e5\x672c\x8a9e\x306e\x30c6\x30ad\x30b9\x30c8 \xd55c\xad6d\xc5b4 \x4e2d\x6587 \xd83d\xde00\xd83d\xdc4d\xd83c\xdf89 caf\xe9 na\xefve\r\n", i);
+        }
+        add("emoji and CJK", international);
+
+        // A rainbow (`lolcat`): Every single cell has its own true color SGR.
+        std::wstring rainbow;
+        for (size_t i = 0; i < lines; ++i)
+        {
+            for (size_t j = 0; j < 80; ++j)
+            {
+                fmt::format_to(std::back_inserter(rainbow), L"\x1b[38;2;{};{};{}m\x2588", (i + j) * 3 % 256, (i + j) * 5 % 256, (i + j) * 7 % 256);
+            }
+            rainbow.append(L"\x1b[m\r\n");
+        }
+        add("SGR per cell (rainbow)", rainbow);
+
+        // Scrolling region torture: Small scrolling regions that are scrolled
+        // in every direction with LF, RI, IL, DL, SU and SD.
+        std::wstring scrolling;
+        for (size_t i = 0; i < lines / 4; ++i)
+        {
+            const auto top = i % 10 + 1;
+            const auto bottom = top + i % 15 + 2;
+            fmt::format_to(std::back_inserter(scrolling),
+                           L"\x1b[{0};{1}r\x1b[{1};1Hline {2}\n\n\x1b[{0};1H\x1bM\x1bMrow {2}\x1b[2L\x1b[{3}M\x1b[{3}S\x1b[2T\x1b[{4};5Hmid\x1b[1P\x1b[3@\x1b[5X",
+                           top, bottom, i, i % 3 + 1, (top + bottom) / 2);
+        }
+        scrolling.append(L"\x1b[r");
+        add("scrolling region torture", scrolling);
+
+        // Cursor movement: Relative and absolute movements, tabs and erases with
+        // barely any text, like a progress display or a full screen editor's status line.
+        std::wstring cursor;
+        for (size_t i = 0; i < lines; ++i)
+        {
+            const auto row = i % viewportHeight + 1;
+            const auto column = i * 7 % viewportWidth + 1;
+            fmt::format_to(std::back_inserter(cursor),
+                           L"\x1b[{};{}H*\x1b[2A\x1b[3C\x1b[B\x1b[2D\x1b[{}G\x1b[{}d\t\t\x1b[Z\x1b[K\x1b[E\x1b[F\x1b[3X\x1b[2a\x1b[e",
+                           row, column, (column + 40) % viewportWidth + 1, row);
+        }
+        add("cursor movement", cursor);
+
+        // Inserting and deleting characters in the middle of full lines, like a
+        // line editor does, which scrolls the rest of the row left and right.
+        std::wstring shifting;
+        for (size_t i = 0; i < lines; ++i)
+        {
+            const auto row = i % viewportHeight + 1;
+            fmt::format_to(std::back_inserter(shifting),
+                           L"\x1b[{};1H{:-<100}\x1b[{}G\x1b[{}@ins\x1b[{}G\x1b[{}P",
+                           row, i, i % 60 + 1, i % 4 + 1, i % 50 + 10, i % 3 + 1);
+        }
+        add("insert/delete characters", shifting);
+
+        // A full screen that is erased and redrawn over and over (`watch`, `top`).
+        std::wstring top;
+        for (size_t frame = 0; frame < lines / viewportHeight; ++frame)
+        {
+            top.append(L"\x1b[H\x1b[J");
+            for (SHORT row = 1; row < viewportHeight; ++row)
+            {
+                fmt::format_to(std::back_inserter(top), L"\x1b[{};1H{:5} user  20   0 {:8} {:6} S {:4.1f} bench{}\x1b[K", row, frame + row, frame * row, row * 64, row * 0.3, row);
+            }
+        }
+        add("erase and redraw (top)", top);
+
+        // Boxes drawn with the DEC Special Graphics character set, like curses
+        // does for window borders, with the frame around the text switched in and out.
+        std::wstring lineDrawing;
+        for (size_t i = 0; i < lines; ++i)
+        {
+            fmt::format_to(std::back_inserter(lineDrawing),
+                           L"\x1b(0x\x1b(B {:<20} \x1b(0x\x1b(B {:>10} \x1b(0x{:q<60}x\x1b(B\r\n",
+                           L"item", i, L"");
+        }
+        add("DEC line drawing", lineDrawing);
+
+        return corpora;
+    }
+
+    // Reads a recording, like the output of `script` or of a ConPTY pipe, as is.
+    corpus LoadRecording(const std::filesystem::path& path)
+    {
+        std::ifstream file{ path, std::ios::binary };
+        THROW_LAST_ERROR_IF(!file);
+
+        corpus recording;
+        recording.name = "recording " + path.filename().string();
+        recording.utf8.assign(std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{});
+        return recording;
+    }
+}
+
+// Runs each corpus through the output pipelines, from UTF-8 input to the TextBuffer:
+// * StateMachine, OutputStateMachineEngine and AdaptDispatch, as used by conhost,
+//   on top of the ModelScreenBuffer, with and without command batching.
+// * Terminal::Write, as used by TerminalCore.
+// * WriteConsoleA into the console ConsoleBench is running in, which is the whole
+//   host including its rendering, like the AltBuffer benchmarks. Run it inside of
+//   OpenConsole.exe to measure a locally built host.
+// The throughput is relative to the size of the UTF-8 input.
+void RunVtPipelineBenchmarks(bench::runner& runner, const std::vector<std::filesystem::path>& recordings)
+{
+    auto corpora = GenerateCorpora();
+    for (const auto& path : recordings)
+    {
+        corpora.emplace_back(LoadRecording(path));
+    }
+
+    // The corpora are written into a screen buffer of their own, so that
+    // they don't end up in the scrollback of the one we're started from.
+    wil::unique_hfile output{ CreateConsoleScreenBuffer(GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, CONSOLE_TEXTMODE_BUFFER, nullptr) };
+    wil::unique_hfile originalOutput{ CreateFileW(L"CONOUT$", GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, 0, nullptr) };
+    const auto originalCodepage = GetConsoleOutputCP();
+    const auto attached = output.is_valid() && originalOutput.is_valid();
+    if (attached)
+    {
+        SetConsoleMode(output.get(), ENABLE_PROCESSED_OUTPUT | ENABLE_WRAP_AT_EOL_OUTPUT | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+        SetConsoleScreenBufferSize(output.get(), { viewportWidth, viewportHeight + scrollbackHeight });
+        SetConsoleOutputCP(CP_UTF8);
+        SetConsoleActiveScreenBuffer(output.get());
+    }
+    else
+    {
+        std::cout << "VtPipeline console benchmarks skipped: not attached to a console\n";
+    }
+
+    auto restore = wil::scope_exit([&]() {
+        if (attached)
+        {
+            SetConsoleActiveScreenBuffer(originalOutput.get());
+            SetConsoleOutputCP(originalCodepage);
+        }
+    });
+
+    for (const auto& [name, utf8] : corpora)
+    {
+        // All pipelines start out with an empty buffer for every corpus,
+        // so that modes set by one corpus don't leak into the next one.
+        ModelScreenBuffer model;
+        StateMachine stateMachine{ std::make_unique<OutputStateMachineEngine>(
+            std::make_unique<AdaptDispatch>(std::make_unique<ModelGetSet>(model),
+                                            std::make_unique<ModelDefaults>(model))) };
+
+        runner.run(fmt::format("VtPipeline/AdaptDispatch+model host ({})", name), utf8.size(), [&]() {
+            stateMachine.ProcessString(std::string_view{ utf8 });
+        });
+
+        ModelScreenBuffer batchedModel;
+        auto batchedEngine = std::make_unique<OutputStateMachineEngine>(
+            std::make_unique<AdaptDispatch>(std::make_unique<ModelGetSet>(batchedModel),
+                                            std::make_unique<ModelDefaults>(batchedModel)));
+        batchedEngine->SetCommandBatching(true);
+        StateMachine batchedStateMachine{ std::move(batchedEngine) };
+
+        runner.run(fmt::format("VtPipeline/AdaptDispatch+model host batched ({})", name), utf8.size(), [&]() {
+            batchedStateMachine.ProcessString(std::string_view{ utf8 });
+        });
+
+        DummyRenderTarget renderTarget;
+        Terminal terminal;
+        terminal.Create({ viewportWidth, viewportHeight }, scrollbackHeight, renderTarget);
+
+        runner.run(fmt::format("VtPipeline/Terminal::Write ({})", name), utf8.size(), [&]() {
+            terminal.Write(std::string_view{ utf8 });
+        });
+
+        if (attached)
+        {
+            // Reset the modes the previous corpus may have left behind and clear the buffer.
+            static constexpr std::string_view reset{ "\x1bc" };
+            DWORD written = 0;
+            WriteConsoleA(output.get(), reset.data(), gsl::narrow_cast<DWORD>(reset.size()), &written, nullptr);
+
+            runner.run(fmt::format("VtPipeline/WriteConsoleA ({})", name), utf8.size(), [&]() {
+                WriteConsoleA(output.get(), utf8.data(), gsl::narrow_cast<DWORD>(utf8.size()), &written, nullptr);
+            });
+        }
+    }
+}
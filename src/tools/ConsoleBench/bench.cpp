@@ -0,0 +1,32 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "bench.hpp"
+
+// ConsoleBench replaces the global allocation functions in order to report the
+// number of allocations made by each benchmark. The array and nothrow variants
+// forward to these by default, so they're counted as well.
+static std::atomic<uint64_t> s_allocationCount{ 0 };
+
+void* operator new(size_t size)
+{
+    s_allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+    if (const auto ptr = malloc(size ? size : 1))
+    {
+        return ptr;
+    }
+
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept
+{
+    free(ptr);
+}
+
+uint64_t bench::allocation_count() noexcept
+{
+    return s_allocationCount.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,209 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- bench.hpp
+
+Abstract:
+- A minimal micro-benchmark harness for ConsoleBench.
+- Each benchmark is a callable that's run repeatedly until at least
+  runner::minimumDuration has passed. The mean time and the mean number of
+  heap allocations per call are reported, alongside the throughput if the
+  number of bytes (or items, like key presses) processed per call is known.
+- The results can additionally be written as JSON for regression tracking.
+  The format is versioned and only ever extended with new keys:
+    { "version": 1, "results": [ { "name": "...", "iterations": 123,
+      "ns_per_iteration": 1.5, "bytes_per_iteration": 4096,
+      "mb_per_second": 2604.2, "ns_per_byte": 0.0004,
+      "allocations_per_iteration": 0.0, "items_per_iteration": 0,
+      "items_per_second": null }, ... ] }
+  The throughput keys are null if the benchmark doesn't process any bytes (or items).
+--*/
+
+#pragma once
+
+namespace bench
+{
+    using clock = std::chrono::steady_clock;
+
+    // The number of calls to the global operator new so far. ConsoleBench
+    // replaces the allocation functions in order to count them (see bench.cpp).
+    uint64_t allocation_count() noexcept;
+
+    // Prevents the compiler from optimizing away the computation of value.
+    template<typename T>
+    void do_not_optimize(const T& value) noexcept
+    {
+        static volatile const void* sink;
+        sink = &value;
+    }
+
+    struct result
+    {
+        std::string name;
+        uint64_t iterations = 0;
+        double nsPerIteration = 0;
+        // 0 if the benchmark doesn't process a meaningful amount of bytes.
+        size_t bytesPerIteration = 0;
+        double allocationsPerIteration = 0;
+        // 0 if the benchmark doesn't process a countable number of items.
+        size_t itemsPerIteration = 0;
+
+        double mbPerSecond() const noexcept
+        {
+            return bytesPerIteration / nsPerIteration * 1e9 / (1024 * 1024);
+        }
+
+        double nsPerByte() const noexcept
+        {
+            return nsPerIteration / bytesPerIteration;
+        }
+
+        double itemsPerSecond() const noexcept
+        {
+            return itemsPerIteration / nsPerIteration * 1e9;
+        }
+    };
+
+    class runner
+    {
+    public:
+        static constexpr auto minimumDuration = std::chrono::milliseconds{ 500 };
+
+        explicit runner(std::string_view filter) :
+            _filter{ filter }
+        {
+        }
+
+        // Runs func() repeatedly and records the mean duration per call.
+        // bytesPerIteration is used to calculate the throughput in MB/s.
+        template<typename Func>
+        void run(const std::string_view name, const size_t bytesPerIteration, Func&& func)
+        {
+            _run(name, bytesPerIteration, 0, std::forward<Func>(func));
+        }
+
+        // Like run(), but reports the throughput in items per second instead,
+        // for benchmarks that process key presses or events instead of text.
+        template<typename Func>
+        void run_items(const std::string_view name, const size_t itemsPerIteration, Func&& func)
+        {
+            _run(name, 0, itemsPerIteration, std::forward<Func>(func));
+        }
+
+        const std::vector<result>& results() const noexcept
+        {
+            return _results;
+        }
+
+        // Writes the results in the JSON format described at the top of this file.
+        void write_json(std::ostream& os) const
+        {
+            // Throughput figures are null for benchmarks that don't process any bytes (or items).
+            const auto number = [&](const double value, const bool valid = true) {
+                if (valid)
+                {
+                    os << std::defaultfloat << std::setprecision(9) << value;
+                }
+                else
+                {
+                    os << "null";
+                }
+            };
+
+            os << "{\n  \"version\": 1,\n  \"results\": [";
+
+            for (size_t i = 0; i < _results.size(); ++i)
+            {
+                const auto& r = _results[i];
+
+                os << (i ? ",\n" : "\n") << "    { \"name\": \"";
+                for (const auto ch : r.name)
+                {
+                    if (ch == '"' || ch == '\\')
+                    {
+                        os << '\\';
+                    }
+                    os << ch;
+                }
+                os << "\", \"iterations\": " << r.iterations << ", \"ns_per_iteration\": ";
+                number(r.nsPerIteration);
+                os << ", \"bytes_per_iteration\": " << r.bytesPerIteration << ", \"mb_per_second\": ";
+                number(r.mbPerSecond(), r.bytesPerIteration != 0);
+                os << ", \"ns_per_byte\": ";
+                number(r.nsPerByte(), r.bytesPerIteration != 0);
+                os << ", \"allocations_per_iteration\": ";
+                number(r.allocationsPerIteration);
+                os << ", \"items_per_iteration\": " << r.itemsPerIteration << ", \"items_per_second\": ";
+                number(r.itemsPerSecond(), r.itemsPerIteration != 0);
+                os << " }";
+            }
+
+            os << "\n  ]\n}\n";
+        }
+
+    private:
+        template<typename Func>
+        void _run(const std::string_view name, const size_t bytesPerIteration, const size_t itemsPerIteration, Func&& func)
+        {
+            if (!_filter.empty() && name.find(_filter) == std::string_view::npos)
+            {
+                return;
+            }
+
+            // Warm up the caches and any lazily allocated state.
+            func();
+
+            uint64_t iterations = 0;
+            const auto allocationsBefore = allocation_count();
+            const auto start = clock::now();
+            auto elapsed = clock::duration::zero();
+
+            do
+            {
+                func();
+                ++iterations;
+                elapsed = clock::now() - start;
+            } while (elapsed < minimumDuration);
+
+            const auto allocations = allocation_count() - allocationsBefore;
+
+            auto& r = _results.emplace_back();
+            r.name = name;
+            r.iterations = iterations;
+            r.nsPerIteration = std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+            r.bytesPerIteration = bytesPerIteration;
+            r.allocationsPerIteration = static_cast<double>(allocations) / iterations;
+            r.itemsPerIteration = itemsPerIteration;
+            _print(r);
+        }
+
+        static void _print(const result& r)
+        {
+            std::cout << std::left << std::setw(64) << r.name
+                      << std::right << std::setw(14) << std::fixed << std::setprecision(1) << r.nsPerIteration << " ns/iter";
+
+            if (r.bytesPerIteration)
+            {
+                std::cout << std::setw(12) << std::setprecision(1) << r.mbPerSecond() << " MB/s"
+                          << std::setw(10) << std::setprecision(3) << r.nsPerByte() << " ns/B";
+            }
+
+            if (r.itemsPerIteration)
+            {
+                std::cout << std::setw(12) << std::setprecision(1) << r.itemsPerSecond() / 1e6 << " M items/s";
+            }
+
+            if (r.allocationsPerIteration)
+            {
+                std::cout << std::setw(12) << std::setprecision(1) << r.allocationsPerIteration << " allocs/iter";
+            }
+
+            std::cout << '\n';
+        }
+
+        std::string_view _filter;
+        std::vector<result> _results;
+    };
+}
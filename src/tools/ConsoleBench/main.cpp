@@ -0,0 +1,76 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+//
+// TEST TOOL ConsoleBench
+// Micro-benchmarks for the console's text buffer, parser and host data structures.
+//
+// Usage: ConsoleBench.exe [filter] [--json <path>] [--corpus <path>]...
+// Only benchmarks whose name contains the (case-sensitive) filter string are run.
+// --json writes the results to the given file in the format described in bench.hpp.
+// --corpus adds a recording of raw (UTF-8) terminal output to the VtPipeline benchmarks.
+
+#include "precomp.h"
+#include "bench.hpp"
+
+void RunAliasBenchmarks(bench::runner& runner);
+void RunAltBufferBenchmarks(bench::runner& runner);
+void RunCharInfoBenchmarks(bench::runner& runner);
+void RunCookedReadBenchmarks(bench::runner& runner);
+void RunInputBufferBenchmarks(bench::runner& runner);
+void RunParserBenchmarks(bench::runner& runner);
+void RunTerminalInputBenchmarks(bench::runner& runner);
+void RunTextAttributeBenchmarks(bench::runner& runner);
+void RunTextBufferBenchmarks(bench::runner& runner);
+void RunTextBufferSnapshotBenchmarks(bench::runner& runner);
+void RunVtPipelineBenchmarks(bench::runner& runner, const std::vector<std::filesystem::path>& recordings);
+
+int main(int argc, char** argv)
+{
+    std::string_view filter;
+    std::filesystem::path jsonPath;
+    std::vector<std::filesystem::path> recordings;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view arg{ argv[i] };
+        if (arg == "--json" && i + 1 < argc)
+        {
+            jsonPath = argv[++i];
+        }
+        else if (arg == "--corpus" && i + 1 < argc)
+        {
+            recordings.emplace_back(argv[++i]);
+        }
+        else
+        {
+            filter = arg;
+        }
+    }
+
+    bench::runner runner{ filter };
+
+    RunTextAttributeBenchmarks(runner);
+    RunTextBufferBenchmarks(runner);
+    RunTextBufferSnapshotBenchmarks(runner);
+    RunAltBufferBenchmarks(runner);
+    RunParserBenchmarks(runner);
+    RunVtPipelineBenchmarks(runner, recordings);
+    RunInputBufferBenchmarks(runner);
+    RunTerminalInputBenchmarks(runner);
+    RunCookedReadBenchmarks(runner);
+    RunAliasBenchmarks(runner);
+    RunCharInfoBenchmarks(runner);
+
+    if (!jsonPath.empty())
+    {
+        std::ofstream json{ jsonPath };
+        runner.write_json(json);
+        if (!json)
+        {
+            std::cerr << "Failed to write " << jsonPath.string() << '\n';
+            return 1;
+        }
+    }
+
+    return 0;
+}
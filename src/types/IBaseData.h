@@ -15,6 +15,7 @@ Author(s):
 #pragma once
 
 #include "inc/viewport.hpp"
+#include "inc/LockCallSite.hpp"
 
 class TextBuffer;
 
@@ -41,8 +42,15 @@ namespace Microsoft::Console::Types
 
         virtual std::vector<Microsoft::Console::Types::Viewport> GetSelectionRects() noexcept = 0;
 
-        virtual void LockConsole() noexcept = 0;
+        // The call site is only used for diagnostics. Leave it defaulted.
+        virtual void LockConsole(const LockCallSite& site = LockCallSite::Current()) noexcept = 0;
         virtual void UnlockConsole() noexcept = 0;
+
+        // Taken by callers that only read through this interface, like the
+        // renderer and UIA queries. Implementations without a reader/writer
+        // lock may forward these to LockConsole/UnlockConsole.
+        virtual void LockConsoleShared(const LockCallSite& site = LockCallSite::Current()) noexcept = 0;
+        virtual void UnlockConsoleShared() noexcept = 0;
     };
 
     // See docs/virtual-dtors.md for an explanation of why this is weird.
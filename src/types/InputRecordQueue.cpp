@@ -0,0 +1,211 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "inc/InputRecordQueue.hpp"
+
+using namespace Microsoft::Console;
+
+bool InputRecordQueue::empty() const noexcept
+{
+    return _size == 0;
+}
+
+size_t InputRecordQueue::size() const noexcept
+{
+    return _size;
+}
+
+size_t InputRecordQueue::capacity() const noexcept
+{
+    return _buffer.size();
+}
+
+// Routine Description:
+// - Removes all records. Unusually large buffers are released as well.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void InputRecordQueue::clear() noexcept
+{
+    _Reset();
+}
+
+// Routine Description:
+// - Returns the record at the given position, counted from the front of the queue.
+// Arguments:
+// - index - the position of the record. Must be less than size().
+// Return Value:
+// - A reference to the record.
+INPUT_RECORD& InputRecordQueue::operator[](const size_t index) noexcept
+{
+    return til::at(_buffer, (_head + index) & _Mask());
+}
+
+const INPUT_RECORD& InputRecordQueue::operator[](const size_t index) const noexcept
+{
+    return til::at(_buffer, (_head + index) & _Mask());
+}
+
+INPUT_RECORD& InputRecordQueue::front() noexcept
+{
+    return (*this)[0];
+}
+
+const INPUT_RECORD& InputRecordQueue::front() const noexcept
+{
+    return (*this)[0];
+}
+
+INPUT_RECORD& InputRecordQueue::back() noexcept
+{
+    return (*this)[_size - 1];
+}
+
+const INPUT_RECORD& InputRecordQueue::back() const noexcept
+{
+    return (*this)[_size - 1];
+}
+
+// Routine Description:
+// - Appends a single record to the end of the queue.
+// Arguments:
+// - record - the record to append
+// Return Value:
+// - <none>
+void InputRecordQueue::push_back(const INPUT_RECORD& record)
+{
+    _Reserve(_size + 1);
+    til::at(_buffer, (_head + _size) & _Mask()) = record;
+    ++_size;
+}
+
+// Routine Description:
+// - Appends a run of records to the end of the queue.
+// Arguments:
+// - records - the records to append, in order
+// Return Value:
+// - <none>
+void InputRecordQueue::push_back(const gsl::span<const INPUT_RECORD> records)
+{
+    const auto count = records.size();
+    _Reserve(_size + count);
+
+    // The free space starts after the last record and may wrap
+    // around to the beginning of the buffer, so copy in two parts.
+    const auto start = (_head + _size) & _Mask();
+    const auto first = std::min(count, _buffer.size() - start);
+    std::copy_n(records.begin(), first, _buffer.begin() + start);
+    std::copy(records.begin() + first, records.end(), _buffer.begin());
+    _size += count;
+}
+
+// Routine Description:
+// - Inserts a run of records before the front of the queue,
+//   so that records[0] becomes the new front.
+// Arguments:
+// - records - the records to insert, in order
+// Return Value:
+// - <none>
+void InputRecordQueue::push_front(const gsl::span<const INPUT_RECORD> records)
+{
+    const auto count = records.size();
+    _Reserve(_size + count);
+
+    const auto start = (_head - count) & _Mask();
+    const auto first = std::min(count, _buffer.size() - start);
+    std::copy_n(records.begin(), first, _buffer.begin() + start);
+    std::copy(records.begin() + first, records.end(), _buffer.begin());
+    _head = start;
+    _size += count;
+}
+
+// Routine Description:
+// - Removes records from the front of the queue.
+// Arguments:
+// - count - the number of records to remove. Clamped to size().
+// Return Value:
+// - <none>
+void InputRecordQueue::pop_front(const size_t count) noexcept
+{
+    if (count >= _size)
+    {
+        _Reset();
+        return;
+    }
+
+    _head = (_head + count) & _Mask();
+    _size -= count;
+}
+
+// Routine Description:
+// - Copies records out of the queue without removing them.
+// Arguments:
+// - destination - where to copy the records to. As many records as fit are copied.
+// - offset - the position of the first record to copy, counted from the front.
+// Return Value:
+// - The number of records that were copied.
+size_t InputRecordQueue::copy_to(const gsl::span<INPUT_RECORD> destination, const size_t offset) const noexcept
+{
+    if (offset >= _size)
+    {
+        return 0;
+    }
+
+    const auto count = std::min(destination.size(), _size - offset);
+    const auto start = (_head + offset) & _Mask();
+    const auto first = std::min(count, _buffer.size() - start);
+    std::copy_n(_buffer.begin() + start, first, destination.begin());
+    std::copy_n(_buffer.begin(), count - first, destination.begin() + first);
+    return count;
+}
+
+size_t InputRecordQueue::_Mask() const noexcept
+{
+    // An empty buffer results in a mask of all ones, which is fine,
+    // since nothing is ever read from or written to it before _Reserve().
+    return _buffer.size() - 1;
+}
+
+// Routine Description:
+// - Grows the buffer so that it can hold at least the given number of records,
+//   while moving the stored records to the start of the new buffer.
+// Arguments:
+// - minimumCapacity - the number of records the buffer needs to be able to hold
+// Return Value:
+// - <none>
+void InputRecordQueue::_Reserve(const size_t minimumCapacity)
+{
+    if (minimumCapacity <= _buffer.size())
+    {
+        return;
+    }
+
+    size_t newCapacity = std::max<size_t>(_buffer.size() * 2, 64);
+    while (newCapacity < minimumCapacity)
+    {
+        newCapacity *= 2;
+    }
+
+    std::vector<INPUT_RECORD> newBuffer(newCapacity);
+    copy_to({ newBuffer.data(), _size });
+    _buffer = std::move(newBuffer);
+    _head = 0;
+}
+
+// Routine Description:
+// - Empties the queue and releases the buffer, if it grew unusually large.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void InputRecordQueue::_Reset() noexcept
+{
+    if (_buffer.size() > s_maxRetainedCapacity)
+    {
+        _buffer = std::vector<INPUT_RECORD>{};
+    }
+    _head = 0;
+    _size = 0;
+}
@@ -383,14 +383,17 @@ const Viewport ScreenInfoUiaProviderBase::_getViewport() const noexcept
     return _pData->GetViewport();
 }
 
-void ScreenInfoUiaProviderBase::_LockConsole() noexcept
+// The provider only ever reads the data (see GetSelection and GetVisibleRanges),
+// so it can share the lock with the renderer and other UIA queries.
+// The site is forwarded, so that the diagnostics attribute the lock to our caller.
+void ScreenInfoUiaProviderBase::_LockConsole(const LockCallSite& site) noexcept
 {
     // TODO GitHub #2141: Lock and Unlock in conhost should decouple Ctrl+C dispatch and use smarter handling
-    _pData->LockConsole();
+    _pData->LockConsoleShared(site);
 }
 
 void ScreenInfoUiaProviderBase::_UnlockConsole() noexcept
 {
     // TODO GitHub #2141: Lock and Unlock in conhost should decouple Ctrl+C dispatch and use smarter handling
-    _pData->UnlockConsole();
+    _pData->UnlockConsoleShared();
 }
@@ -126,7 +126,7 @@ namespace Microsoft::Console::Types
         const COORD _getScreenBufferCoords() const noexcept;
         const TextBuffer& _getTextBuffer() const noexcept;
         const Viewport _getViewport() const noexcept;
-        void _LockConsole() noexcept;
+        void _LockConsole(const LockCallSite& site = LockCallSite::Current()) noexcept;
         void _UnlockConsole() noexcept;
     };
 }
@@ -196,9 +196,9 @@ const bool UiaTextRangeBase::IsDegenerate() const noexcept
 
 IFACEMETHODIMP UiaTextRangeBase::Compare(_In_opt_ ITextRangeProvider* pRange, _Out_ BOOL* pRetVal) noexcept
 {
-    _pData->LockConsole();
+    _pData->LockConsoleShared();
     auto Unlock = wil::scope_exit([&]() noexcept {
-        _pData->UnlockConsole();
+        _pData->UnlockConsoleShared();
     });
 
     RETURN_HR_IF(E_INVALIDARG, pRetVal == nullptr);
@@ -255,6 +255,8 @@ CATCH_RETURN();
 
 IFACEMETHODIMP UiaTextRangeBase::ExpandToEnclosingUnit(_In_ TextUnit unit) noexcept
 {
+    // This only reads the buffer, but it modifies this range's endpoints, which
+    // UIA may access from other threads. The exclusive lock serializes those, too.
     _pData->LockConsole();
     auto Unlock = wil::scope_exit([&]() noexcept {
         _pData->UnlockConsole();
@@ -807,9 +809,9 @@ CATCH_RETURN();
 
 IFACEMETHODIMP UiaTextRangeBase::GetBoundingRectangles(_Outptr_result_maybenull_ SAFEARRAY** ppRetVal) noexcept
 {
-    _pData->LockConsole();
+    _pData->LockConsoleShared();
     auto Unlock = wil::scope_exit([&]() noexcept {
-        _pData->UnlockConsole();
+        _pData->UnlockConsoleShared();
     });
 
     RETURN_HR_IF(E_INVALIDARG, ppRetVal == nullptr);
@@ -946,9 +948,9 @@ CATCH_RETURN();
 #pragma warning(disable : 26447) // compiler isn't filtering throws inside the try/catch
 std::wstring UiaTextRangeBase::_getTextValue(std::optional<unsigned int> maxLength) const
 {
-    _pData->LockConsole();
+    _pData->LockConsoleShared();
     auto Unlock = wil::scope_exit([&]() noexcept {
-        _pData->UnlockConsole();
+        _pData->UnlockConsoleShared();
     });
 
     std::wstring textData{};
@@ -1002,6 +1004,7 @@ IFACEMETHODIMP UiaTextRangeBase::Move(_In_ TextUnit unit,
         return S_OK;
     }
 
+    // Like ExpandToEnclosingUnit, this modifies this range's endpoints, so the lock must be exclusive.
     _pData->LockConsole();
     auto Unlock = wil::scope_exit([&]() noexcept {
         _pData->UnlockConsole();
@@ -1064,6 +1067,7 @@ IFACEMETHODIMP UiaTextRangeBase::MoveEndpointByUnit(_In_ TextPatternRangeEndpoin
         return S_OK;
     }
 
+    // Like ExpandToEnclosingUnit, this modifies this range's endpoints, so the lock must be exclusive.
     _pData->LockConsole();
     auto Unlock = wil::scope_exit([&]() noexcept {
         _pData->UnlockConsole();
@@ -1099,6 +1103,7 @@ IFACEMETHODIMP UiaTextRangeBase::MoveEndpointByRange(_In_ TextPatternRangeEndpoi
                                                      _In_ TextPatternRangeEndpoint targetEndpoint) noexcept
 try
 {
+    // Like ExpandToEnclosingUnit, this modifies this range's endpoints, so the lock must be exclusive.
     _pData->LockConsole();
     auto Unlock = wil::scope_exit([&]() noexcept {
         _pData->UnlockConsole();
@@ -1131,6 +1136,7 @@ CATCH_RETURN();
 IFACEMETHODIMP UiaTextRangeBase::Select() noexcept
 try
 {
+    // Selecting modifies the terminal's state and requires the exclusive lock.
     _pData->LockConsole();
     auto Unlock = wil::scope_exit([&]() noexcept {
         _pData->UnlockConsole();
@@ -1175,6 +1181,7 @@ IFACEMETHODIMP UiaTextRangeBase::RemoveFromSelection() noexcept
 IFACEMETHODIMP UiaTextRangeBase::ScrollIntoView(_In_ BOOL alignToTop) noexcept
 try
 {
+    // Scrolling modifies the terminal's viewport and requires the exclusive lock.
     _pData->LockConsole();
     auto Unlock = wil::scope_exit([&]() noexcept {
         _pData->UnlockConsole();
@@ -0,0 +1,82 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- InputRecordQueue.hpp
+
+Abstract:
+- A FIFO queue of INPUT_RECORDs, stored by value in a single growable ring buffer.
+- Unlike a std::deque<std::unique_ptr<IInputEvent>>, storing an event doesn't
+  allocate, and runs of events are appended, prepended and copied out with at
+  most two memcpy()s each, which is what large pastes and bulk reads need.
+- The capacity is always a power of two, so that positions wrap with a mask.
+--*/
+
+#pragma once
+
+#include <wtypes.h>
+
+namespace Microsoft::Console
+{
+    class InputRecordQueue final
+    {
+    public:
+        bool empty() const noexcept;
+        size_t size() const noexcept;
+        size_t capacity() const noexcept;
+        void clear() noexcept;
+
+        INPUT_RECORD& operator[](const size_t index) noexcept;
+        const INPUT_RECORD& operator[](const size_t index) const noexcept;
+        INPUT_RECORD& front() noexcept;
+        const INPUT_RECORD& front() const noexcept;
+        INPUT_RECORD& back() noexcept;
+        const INPUT_RECORD& back() const noexcept;
+
+        void push_back(const INPUT_RECORD& record);
+        void push_back(const gsl::span<const INPUT_RECORD> records);
+        void push_front(const gsl::span<const INPUT_RECORD> records);
+        void pop_front(const size_t count = 1) noexcept;
+
+        size_t copy_to(const gsl::span<INPUT_RECORD> destination, const size_t offset = 0) const noexcept;
+
+        // Method Description:
+        // - Removes all records the predicate returns true for, keeping the order of the others.
+        // Arguments:
+        // - predicate - called with a const INPUT_RECORD& for every record
+        // Return Value:
+        // - The number of removed records.
+        template<typename Predicate>
+        size_t remove_if(Predicate predicate)
+        {
+            size_t kept = 0;
+            for (size_t i = 0; i < _size; ++i)
+            {
+                const auto& record = (*this)[i];
+                if (!predicate(record))
+                {
+                    (*this)[kept++] = record;
+                }
+            }
+
+            const auto removed = _size - kept;
+            _size = kept;
+            return removed;
+        }
+
+    private:
+        // When the queue is emptied, buffers larger than this (about
+        // 1 MB worth of records) are released instead of being kept
+        // around after an unusually large paste.
+        static constexpr size_t s_maxRetainedCapacity = 1 << 16;
+
+        size_t _Mask() const noexcept;
+        void _Reserve(const size_t minimumCapacity);
+        void _Reset() noexcept;
+
+        std::vector<INPUT_RECORD> _buffer;
+        size_t _head = 0;
+        size_t _size = 0;
+    };
+}
@@ -0,0 +1,29 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- LockCallSite.hpp
+
+Abstract:
+- Identifies the function and line a lock was acquired from. It's passed
+  through IBaseData::LockConsole, so that the Terminal's lock diagnostics
+  can attribute the renderer's and UIA's acquisitions to their callers.
+--*/
+
+#pragma once
+
+namespace Microsoft::Console::Types
+{
+    // Use it as a defaulted argument, similar to C++20's std::source_location.
+    struct LockCallSite
+    {
+        const char* function = nullptr;
+        uint32_t line = 0;
+
+        static constexpr LockCallSite Current(const char* function = __builtin_FUNCTION(), const uint32_t line = __builtin_LINE()) noexcept
+        {
+            return { function, line };
+        }
+    };
+}
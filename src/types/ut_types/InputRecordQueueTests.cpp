@@ -0,0 +1,137 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "../inc/InputRecordQueue.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+using namespace Microsoft::Console;
+
+class InputRecordQueueTests
+{
+    TEST_CLASS(InputRecordQueueTests);
+
+    static INPUT_RECORD _MakeRecord(const size_t id)
+    {
+        INPUT_RECORD record{};
+        record.EventType = MENU_EVENT;
+        record.Event.MenuEvent.dwCommandId = gsl::narrow_cast<UINT>(id);
+        return record;
+    }
+
+    static std::vector<INPUT_RECORD> _MakeRecords(const size_t first, const size_t count)
+    {
+        std::vector<INPUT_RECORD> records;
+        for (size_t i = 0; i < count; ++i)
+        {
+            records.push_back(_MakeRecord(first + i));
+        }
+        return records;
+    }
+
+    static void _VerifyContents(const InputRecordQueue& queue, const std::vector<UINT>& expected)
+    {
+        VERIFY_ARE_EQUAL(expected.size(), queue.size());
+
+        std::vector<INPUT_RECORD> copied(queue.size());
+        VERIFY_ARE_EQUAL(queue.size(), queue.copy_to(copied));
+
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            VERIFY_ARE_EQUAL(expected[i], queue[i].Event.MenuEvent.dwCommandId);
+            VERIFY_ARE_EQUAL(expected[i], copied[i].Event.MenuEvent.dwCommandId);
+        }
+    }
+
+    TEST_METHOD(PushAndPopAcrossTheEnd)
+    {
+        InputRecordQueue queue;
+        VERIFY_IS_TRUE(queue.empty());
+
+        queue.push_back(_MakeRecords(0, 60));
+        const auto capacity = queue.capacity();
+        queue.pop_front(50);
+
+        Log::Comment(L"These records wrap around the end of the buffer without growing it.");
+        queue.push_back(_MakeRecords(60, 20));
+        VERIFY_ARE_EQUAL(capacity, queue.capacity());
+
+        std::vector<UINT> expected(30);
+        std::iota(expected.begin(), expected.end(), 50u);
+        _VerifyContents(queue, expected);
+        VERIFY_ARE_EQUAL(50u, queue.front().Event.MenuEvent.dwCommandId);
+        VERIFY_ARE_EQUAL(79u, queue.back().Event.MenuEvent.dwCommandId);
+
+        Log::Comment(L"Copying with an offset starts at that record.");
+        std::array<INPUT_RECORD, 4> partial{};
+        VERIFY_ARE_EQUAL(4u, queue.copy_to(partial, 12));
+        VERIFY_ARE_EQUAL(62u, partial[0].Event.MenuEvent.dwCommandId);
+        VERIFY_ARE_EQUAL(2u, queue.copy_to(partial, 28));
+        VERIFY_ARE_EQUAL(0u, queue.copy_to(partial, 30));
+    }
+
+    TEST_METHOD(PushFrontAcrossTheStart)
+    {
+        InputRecordQueue queue;
+        queue.push_back(_MakeRecords(10, 5));
+        queue.push_front(_MakeRecords(0, 10));
+        _VerifyContents(queue, { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14 });
+
+        queue.pop_front(3);
+        queue.push_front(_MakeRecords(100, 2));
+        _VerifyContents(queue, { 100, 101, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14 });
+    }
+
+    TEST_METHOD(GrowingKeepsTheOrder)
+    {
+        InputRecordQueue queue;
+        queue.push_back(_MakeRecords(0, 40));
+        queue.pop_front(30);
+        queue.push_back(_MakeRecords(40, 40));
+
+        Log::Comment(L"The records wrap around the end of the buffer when it has to grow.");
+        for (size_t i = 80; i < 1000; ++i)
+        {
+            queue.push_back(_MakeRecord(i));
+        }
+
+        std::vector<UINT> expected(970);
+        std::iota(expected.begin(), expected.end(), 30u);
+        _VerifyContents(queue, expected);
+    }
+
+    TEST_METHOD(RemoveIfKeepsTheOrder)
+    {
+        InputRecordQueue queue;
+        queue.push_back(_MakeRecords(0, 60));
+        queue.pop_front(55);
+        queue.push_back(_MakeRecords(60, 10));
+
+        const auto removed = queue.remove_if([](const INPUT_RECORD& record) {
+            return record.Event.MenuEvent.dwCommandId % 2 != 0;
+        });
+        VERIFY_ARE_EQUAL(8u, removed);
+        _VerifyContents(queue, { 56, 58, 60, 62, 64, 66, 68 });
+    }
+
+    TEST_METHOD(ClearReleasesLargeBuffers)
+    {
+        InputRecordQueue queue;
+        queue.push_back(_MakeRecords(0, 100));
+        const auto capacity = queue.capacity();
+        queue.clear();
+        VERIFY_IS_TRUE(queue.empty());
+        VERIFY_ARE_EQUAL(capacity, queue.capacity());
+
+        queue.push_back(_MakeRecords(0, 100000));
+        queue.pop_front(100000);
+        VERIFY_IS_TRUE(queue.empty());
+        VERIFY_ARE_EQUAL(0u, queue.capacity());
+    }
+};